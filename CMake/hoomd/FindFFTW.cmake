@@ -0,0 +1,20 @@
+# Find the single precision FFTW3 library (fftw3f)
+
+find_path(FFTW_INCLUDE_DIR fftw3.h)
+
+find_library(FFTW_FLOAT_LIBRARY fftw3f
+             HINTS ${FFTW_INCLUDE_DIR}/../lib )
+
+# handle the QUIETLY and REQUIRED arguments and set FFTW_FOUND to TRUE if
+# all listed variables are TRUE
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(FFTW
+                                  REQUIRED_VARS FFTW_FLOAT_LIBRARY FFTW_INCLUDE_DIR)
+
+if(FFTW_FLOAT_LIBRARY AND NOT TARGET FFTW::fftw3f)
+    add_library(FFTW::fftw3f UNKNOWN IMPORTED)
+    set_target_properties(FFTW::fftw3f PROPERTIES
+        IMPORTED_LOCATION_RELEASE "${FFTW_FLOAT_LIBRARY}"
+        IMPORTED_LOCATION "${FFTW_FLOAT_LIBRARY}"
+        INTERFACE_INCLUDE_DIRECTORIES "${FFTW_INCLUDE_DIR}")
+endif()
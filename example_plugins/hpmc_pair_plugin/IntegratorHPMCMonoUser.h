@@ -0,0 +1,106 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include "PairPotentialUser.h"
+
+#include "hoomd/hpmc/IntegratorHPMCMono.h"
+#include "hoomd/hpmc/UpdaterClusters.h"
+
+#include <pybind11/pybind11.h>
+
+namespace hoomd
+    {
+namespace hpmc
+    {
+/// Find the first compiled pair potential in a list of pair potentials.
+inline const PairPotentialUser*
+findPairPotentialUser(const std::vector<std::shared_ptr<PairPotential>>& pair_potentials)
+    {
+    for (const auto& pair : pair_potentials)
+        {
+        if (auto user = dynamic_cast<const PairPotentialUser*>(pair.get()))
+            {
+            return user;
+            }
+        }
+    return nullptr;
+    }
+
+/*** HPMC integrator with PairPotentialUser inlined into the trial move loop.
+
+    IntegratorHPMCMonoUser is instantiated in the plugin for each shape it supports, so the trial
+    moves are compiled together with the user energy function. When a PairPotentialUser is one of
+    the integrator's pair potentials, its energy is evaluated without a virtual call. Other pair
+    potentials and the patch energy are evaluated as in IntegratorHPMCMono.
+*/
+template<class Shape> class IntegratorHPMCMonoUser : public IntegratorHPMCMono<Shape>
+    {
+    public:
+    IntegratorHPMCMonoUser(std::shared_ptr<SystemDefinition> sysdef)
+        : IntegratorHPMCMono<Shape>(sysdef)
+        {
+        }
+
+    virtual ~IntegratorHPMCMonoUser() { }
+
+    /// Take one timestep forward.
+    virtual void update(uint64_t timestep)
+        {
+        this->updateWithPair(timestep, findPairPotentialUser(this->m_pair_potentials));
+        }
+    };
+
+/// Cluster updater with PairPotentialUser inlined into the pair interaction search.
+template<class Shape> class UpdaterClustersUser : public UpdaterClusters<Shape>
+    {
+    public:
+    UpdaterClustersUser(std::shared_ptr<SystemDefinition> sysdef,
+                        std::shared_ptr<Trigger> trigger,
+                        std::shared_ptr<IntegratorHPMCMono<Shape>> mc)
+        : UpdaterClusters<Shape>(sysdef, trigger, mc)
+        {
+        }
+
+    virtual ~UpdaterClustersUser() { }
+
+    protected:
+    /// Find interactions between particles due to overlaps and pair energies.
+    virtual void
+    findInteractions(uint64_t timestep, const quat<Scalar> q, const vec3<Scalar> pivot, bool line)
+        {
+        this->findInteractionsWithPair(timestep,
+                                       q,
+                                       pivot,
+                                       line,
+                                       findPairPotentialUser(this->m_mc->getPairPotentials()));
+        }
+    };
+
+namespace detail
+    {
+/// Export IntegratorHPMCMonoUser and UpdaterClustersUser for one shape.
+template<class Shape> void export_HPMCUser(pybind11::module& m, const std::string& shape_name)
+    {
+    pybind11::class_<IntegratorHPMCMonoUser<Shape>,
+                     IntegratorHPMCMono<Shape>,
+                     std::shared_ptr<IntegratorHPMCMonoUser<Shape>>>(
+        m,
+        ("IntegratorHPMCMono" + shape_name).c_str())
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>>());
+
+    pybind11::class_<UpdaterClustersUser<Shape>,
+                     UpdaterClusters<Shape>,
+                     std::shared_ptr<UpdaterClustersUser<Shape>>>(
+        m,
+        ("UpdaterClusters" + shape_name).c_str())
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<Trigger>,
+                            std::shared_ptr<IntegratorHPMCMono<Shape>>>());
+    }
+
+    } // end namespace detail
+
+    } // end namespace hpmc
+    } // end namespace hoomd
@@ -0,0 +1,7 @@
+# Copyright (c) 2009-2024 The Regents of the University of Michigan.
+# Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+"""Example HPMC pair potential plugin compiled ahead of time."""
+
+from . import integrate
+from . import pair
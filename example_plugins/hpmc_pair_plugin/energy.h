@@ -0,0 +1,24 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+// Body of the pair energy function compiled into PairPotentialUser. The following variables are
+// in scope:
+//
+//   r_squared    (LongReal)               dot(r_ij, r_ij)
+//   r_ij         (vec3<LongReal>)         vector pointing from particle i to particle j
+//   type_i       (unsigned int)           type id of particle i
+//   q_i          (quat<LongReal>)         orientation of particle i
+//   charge_i     (LongReal)               charge of particle i
+//   type_j       (unsigned int)           type id of particle j
+//   q_j          (quat<LongReal>)         orientation of particle j
+//   charge_j     (LongReal)               charge of particle j
+//   param_array  (const LongReal*)        user parameters set in Python
+//   n_params     (unsigned int)           number of elements in param_array
+//
+// The code must return the pair energy. PairPotentialUser only calls it for r_squared < r_cut^2.
+
+// Square well of depth param_array[0] out to the cutoff.
+if (n_params < 1)
+    return 0;
+
+return param_array[0];
@@ -0,0 +1,32 @@
+# Copyright (c) 2009-2024 The Regents of the University of Michigan.
+# Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+"""HPMC integrators compiled with the user-defined pair potential inlined."""
+
+# Import the C++ module.
+from . import _hpmc_pair_plugin
+
+# Import the hoomd Python package.
+import hoomd
+
+
+class Sphere(hoomd.hpmc.integrate.Sphere):
+    """Sphere integrator with `pair.User` inlined into the trial moves.
+
+    `Sphere` takes the same arguments and has the same attributes as
+    `hoomd.hpmc.integrate.Sphere`. When a `pair.User` potential is in
+    `pair_potentials`, the integrator and `hoomd.hpmc.update.Clusters` evaluate
+    its energy without a virtual function call. Use it in place of
+    `hoomd.hpmc.integrate.Sphere` for production runs.
+    """
+
+    _ext_module = _hpmc_pair_plugin
+
+
+class ConvexPolyhedron(hoomd.hpmc.integrate.ConvexPolyhedron):
+    """Convex polyhedron integrator with `pair.User` inlined.
+
+    See `Sphere` for details.
+    """
+
+    _ext_module = _hpmc_pair_plugin
@@ -0,0 +1,35 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+// Include the defined classes that are to be exported to python
+#include "IntegratorHPMCMonoUser.h"
+#include "PairPotentialUser.h"
+
+#include "hoomd/hpmc/ShapeConvexPolyhedron.h"
+#include "hoomd/hpmc/ShapeSphere.h"
+
+using namespace hoomd::hpmc::detail;
+
+namespace hoomd
+    {
+namespace hpmc
+    {
+//! Export the compiled pair potential and the integrators it is inlined into
+PYBIND11_MODULE(_hpmc_pair_plugin, m)
+    {
+    pybind11::class_<PairPotentialUser, PairPotential, std::shared_ptr<PairPotentialUser>>(
+        m,
+        "PairPotentialUser")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>>())
+        .def_property("r_cut", &PairPotentialUser::getRCut, &PairPotentialUser::setRCut)
+        .def_property("param_array",
+                      &PairPotentialUser::getParamArray,
+                      &PairPotentialUser::setParamArray);
+
+    // Add a line here (and a class in integrate.py) for each shape to inline the energy into.
+    export_HPMCUser<ShapeSphere>(m, "Sphere");
+    export_HPMCUser<ShapeConvexPolyhedron>(m, "ConvexPolyhedron");
+    }
+
+    } // namespace hpmc
+    } // namespace hoomd
@@ -0,0 +1,43 @@
+# Copyright (c) 2009-2024 The Regents of the University of Michigan.
+# Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+"""Compiled user-defined pair potential for HPMC."""
+
+# Import the C++ module.
+from . import _hpmc_pair_plugin
+
+# Import the hoomd Python package and other necessary components.
+import hoomd
+from hoomd.data.parameterdicts import ParameterDict
+
+
+class User(hoomd.hpmc.pair.Pair):
+    """User-defined pair potential compiled into the plugin (HPMC).
+
+    Args:
+        r_cut (float): Particle center to center distance cutoff beyond which
+            all pair interactions are 0 :math:`[\\mathrm{length}]`.
+        param_array (list[float]): Parameter values to make available in
+            ``param_array`` in the compiled code.
+
+    `User` evaluates the C++ function body in the file given by the CMake
+    variable ``HPMC_PAIR_PLUGIN_ENERGY`` when the plugin was configured. See
+    ``energy.h`` for the variables available to the code. The code is compiled
+    with the plugin, so `User` needs neither LLVM nor compilation at run time.
+
+    Attributes:
+        r_cut (float): Particle center to center distance cutoff beyond which
+            all pair interactions are 0 :math:`[\\mathrm{length}]`.
+        param_array (list[float]): Parameter values available in the compiled
+            code.
+    """
+
+    def __init__(self, r_cut, param_array=()):
+        param_dict = ParameterDict(r_cut=float, param_array=[float])
+        param_dict['r_cut'] = r_cut
+        param_dict['param_array'] = list(param_array)
+        self._param_dict.update(param_dict)
+
+    def _make_cpp_obj(self):
+        cpp_sys_def = self._simulation.state._cpp_sys_def
+        return _hpmc_pair_plugin.PairPotentialUser(cpp_sys_def)
@@ -0,0 +1,96 @@
+# Copyright (c) 2009-2024 The Regents of the University of Michigan.
+# Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+# Import the plugin module.
+from hoomd import hpmc_pair_plugin
+
+# Import the hoomd Python package.
+import hoomd
+
+import numpy
+import pytest
+
+# These tests assume the default square well energy function in energy.h.
+
+# (r_cut, param_array, distance, expected energy)
+testdata = [
+    (1.5, [-1.0], 1.0, -1.0),
+    (1.5, [-2.5], 1.4, -2.5),
+    (1.5, [-1.0], 1.6, 0.0),
+    (1.5, [], 1.0, 0.0),
+]
+
+
+@pytest.mark.parametrize("r_cut, param_array, distance, expected_energy",
+                         testdata)
+@pytest.mark.cpu
+def test_energy(simulation_factory, two_particle_snapshot_factory, r_cut,
+                param_array, distance, expected_energy):
+
+    # Build the simulation from the factory fixtures defined in
+    # hoomd/conftest.py.
+    sim = simulation_factory(two_particle_snapshot_factory(d=distance))
+
+    mc = hoomd.hpmc.integrate.Sphere()
+    mc.shape['A'] = dict(diameter=0)
+    sim.operations.integrator = mc
+
+    user_pair = hpmc_pair_plugin.pair.User(r_cut=r_cut,
+                                           param_array=param_array)
+    mc.pair_potentials = [user_pair]
+
+    sim.run(0)
+
+    assert user_pair.energy == pytest.approx(expected_energy)
+
+
+@pytest.mark.cpu
+def test_set_params(simulation_factory, two_particle_snapshot_factory):
+    sim = simulation_factory(two_particle_snapshot_factory(d=1.0))
+
+    mc = hoomd.hpmc.integrate.Sphere()
+    mc.shape['A'] = dict(diameter=0)
+    sim.operations.integrator = mc
+
+    user_pair = hpmc_pair_plugin.pair.User(r_cut=1.5, param_array=[-1.0])
+    mc.pair_potentials = [user_pair]
+    sim.run(0)
+
+    # Parameters can be changed without recompiling.
+    user_pair.param_array = [-3.0]
+    assert user_pair.param_array == [-3.0]
+    assert user_pair.energy == pytest.approx(-3.0)
+
+    # Particles beyond the cutoff do not interact.
+    user_pair.r_cut = 0.5
+    assert user_pair.energy == pytest.approx(0.0)
+
+
+@pytest.mark.cpu
+@pytest.mark.serial
+def test_inlined_integrator(simulation_factory, lattice_snapshot_factory):
+    """The inlined integrator and updater reproduce the base classes."""
+    snapshots = []
+    for integrator_cls in [
+            hoomd.hpmc.integrate.Sphere, hpmc_pair_plugin.integrate.Sphere
+    ]:
+        sim = simulation_factory(lattice_snapshot_factory(a=1.2, n=5))
+        sim.seed = 10
+
+        mc = integrator_cls(default_d=0.1)
+        mc.shape['A'] = dict(diameter=1.0)
+        mc.pair_potentials = [
+            hpmc_pair_plugin.pair.User(r_cut=1.5, param_array=[-0.5])
+        ]
+        sim.operations.integrator = mc
+        sim.operations.updaters.append(
+            hoomd.hpmc.update.Clusters(trigger=hoomd.trigger.Periodic(5)))
+
+        sim.run(20)
+        assert mc.overlaps == 0
+        snapshots.append(sim.state.get_snapshot())
+
+    # Only the dispatch of the energy function differs, so the trajectories
+    # are identical.
+    numpy.testing.assert_array_equal(snapshots[0].particles.position,
+                                     snapshots[1].particles.position)
@@ -42,7 +42,7 @@ template<unsigned int group_size, typename Group, const char* name, bool has_typ
 BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
     std::shared_ptr<ParticleData> pdata)
     : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0),
-      m_groups_dirty(true)
+      m_groups_dirty(true), m_local_table_dirty(true)
     {
     }
 
@@ -55,7 +55,7 @@ BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
     std::shared_ptr<ParticleData> pdata,
     unsigned int n_group_types)
     : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0),
-      m_groups_dirty(true)
+      m_groups_dirty(true), m_local_table_dirty(true)
     {
     m_exec_conf->msg->notice(5) << "Constructing BondedGroupData (" << name << "s, n=" << group_size
                                 << ") " << endl;
@@ -98,7 +98,7 @@ BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
     std::shared_ptr<ParticleData> pdata,
     const Snapshot& snapshot)
     : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0),
-      m_groups_dirty(true)
+      m_groups_dirty(true), m_local_table_dirty(true)
     {
     m_exec_conf->msg->notice(5) << "Constructing BondedGroupData (" << name << ") " << endl;
 
@@ -753,6 +753,52 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::maybe_rebuild_t
     m_invalid_cached_tags = false;
     }
 
+/*! The table holds one entry per local group with the member tags resolved to particle indices,
+    counting-sorted by the index of the first member. Because particles are kept in spatial order
+    by the sorter, iterating over the table walks through the particle arrays nearly sequentially.
+ */
+template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::rebuildLocalIndexTable()
+    {
+    const unsigned int n_groups = m_n_groups;
+    const unsigned int n_ptl = m_pdata->getN() + m_pdata->getNGhosts();
+    const size_t n_tags = m_pdata->getRTags().size();
+
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    ArrayHandle<members_t> h_groups(m_groups, access_location::host, access_mode::read);
+
+    // count groups per first member, groups with a non-local first member go into the last bin
+    std::vector<unsigned int> offset(n_ptl + 2, 0);
+    for (unsigned int group_idx = 0; group_idx < n_groups; ++group_idx)
+        {
+        unsigned int tag = h_groups.data[group_idx].tag[0];
+        unsigned int idx = tag < n_tags ? h_rtag.data[tag] : NOT_LOCAL;
+        offset[(idx < n_ptl ? idx : n_ptl) + 1]++;
+        }
+
+    for (unsigned int i = 0; i <= n_ptl; ++i)
+        offset[i + 1] += offset[i];
+
+    m_local_table.resize(n_groups);
+    m_local_table_groups.resize(n_groups);
+
+    // scatter groups into their sorted position, keeping storage order within a bin
+    for (unsigned int group_idx = 0; group_idx < n_groups; ++group_idx)
+        {
+        const members_t& g = h_groups.data[group_idx];
+        members_t h;
+        for (unsigned int j = 0; j < group_size; ++j)
+            {
+            unsigned int idx = g.tag[j] < n_tags ? h_rtag.data[g.tag[j]] : NOT_LOCAL;
+            h.idx[j] = idx < n_ptl ? idx : NOT_LOCAL;
+            }
+
+        unsigned int pos = offset[h.idx[0] < n_ptl ? h.idx[0] : n_ptl]++;
+        m_local_table[pos] = h;
+        m_local_table_groups[pos] = group_idx;
+        }
+    }
+
 template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
 void BondedGroupData<group_size, Group, name, has_type_mapping>::rebuildGPUTable()
     {
@@ -585,6 +585,38 @@ class BondedGroupData
         return m_gpu_n_groups;
         }
 
+    /*
+     * CPU local index table
+     */
+
+    //! Return local groups with member local indices, sorted by the index of the first member
+    /*! Members that are not present on this rank are stored as NOT_LOCAL.
+     */
+    const std::vector<members_t>& getLocalIndexTable()
+        {
+        // rebuild lookup table if necessary
+        if (m_local_table_dirty)
+            {
+            rebuildLocalIndexTable();
+            m_local_table_dirty = false;
+            }
+
+        return m_local_table;
+        }
+
+    //! Return the group index of every entry in the local index table
+    const std::vector<unsigned int>& getLocalIndexTableGroups()
+        {
+        // rebuild lookup table if necessary
+        if (m_local_table_dirty)
+            {
+            rebuildLocalIndexTable();
+            m_local_table_dirty = false;
+            }
+
+        return m_local_table_groups;
+        }
+
     /*
      * add/remove groups globally
      */
@@ -616,6 +648,7 @@ class BondedGroupData
         {
         // set flag to trigger rebuild of GPU table
         m_groups_dirty = true;
+        m_local_table_dirty = true;
 
         // notify subscribers
         m_group_reorder_signal.emit();
@@ -625,6 +658,7 @@ class BondedGroupData
     void setDirty()
         {
         m_groups_dirty = true;
+        m_local_table_dirty = true;
         }
 
 #ifdef ENABLE_MPI
@@ -683,6 +717,10 @@ class BondedGroupData
 #endif
     private:
     bool m_groups_dirty; //!< Check if it is necessary to rebuild the lookup-by-index table
+    bool m_local_table_dirty; //!< Check if it is necessary to rebuild the local index table
+
+    std::vector<members_t> m_local_table;           //!< Local groups by member index
+    std::vector<unsigned int> m_local_table_groups; //!< Group index of each local table entry
 
     Nano::Signal<void()> m_group_reorder_signal; //!< Signal that is triggered when groups are added
                                                  //!< or deleted locally
@@ -693,6 +731,9 @@ class BondedGroupData
     //! Helper function to rebuild lookup by index table
     virtual void rebuildGPUTable();
 
+    //! Helper function to rebuild the sorted local index table
+    void rebuildLocalIndexTable();
+
     //! Resize internal tables
     /*! \param new_size New size of local group tables, new_size = n_local + n_ghost
      */
@@ -1187,7 +1187,8 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
       m_nettorque_copybuf(m_exec_conf), m_netvirial_copybuf(m_exec_conf),
       m_netvirial_recvbuf(m_exec_conf), m_plan(m_exec_conf), m_plan_reverse(m_exec_conf),
       m_tag_reverse(m_exec_conf), m_netforce_reverse_copybuf(m_exec_conf),
-      m_netforce_reverse_recvbuf(m_exec_conf), m_r_ghost_max(Scalar(0.0)), m_ghosts_added(0),
+      m_netforce_reverse_recvbuf(m_exec_conf), m_virial_reverse_copybuf(m_exec_conf),
+      m_virial_reverse_recvbuf(m_exec_conf), m_r_ghost_max(Scalar(0.0)), m_ghosts_added(0),
       m_has_ghost_particles(false), m_last_flags(0), m_comm_pending(false),
       m_bond_comm(*this, m_sysdef->getBondData()), m_angle_comm(*this, m_sysdef->getAngleData()),
       m_dihedral_comm(*this, m_sysdef->getDihedralData()),
@@ -1238,6 +1239,9 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
     m_pdata->getGhostParticlesRemovedSignal()
         .connect<Communicator, &Communicator::slotGhostParticlesRemoved>(this);
 
+    // connect to shrink to fit signal
+    m_pdata->getShrinkToFitSignal().connect<Communicator, &Communicator::shrinkToFit>(this);
+
     // allocate per type ghost width
     GlobalArray<Scalar> r_ghost(m_pdata->getNTypes(), m_exec_conf);
     m_r_ghost.swap(r_ghost);
@@ -1347,6 +1351,7 @@ Communicator::~Communicator()
     m_pdata->getParticleSortSignal().disconnect<Communicator, &Communicator::forceMigrate>(this);
     m_pdata->getGhostParticlesRemovedSignal()
         .disconnect<Communicator, &Communicator::slotGhostParticlesRemoved>(this);
+    m_pdata->getShrinkToFitSignal().disconnect<Communicator, &Communicator::shrinkToFit>(this);
 
     m_sysdef->getBondData()
         ->getGroupNumChangeSignal()
@@ -1381,6 +1386,55 @@ Communicator::~Communicator()
     MPI_Type_free(&m_mpi_pdata_element);
     }
 
+/*! \param ratio Ratio of allocated to required memory above which buffers are shrunk
+
+    The copy buffers grow to hold the largest exchange seen, such as a burst of ghosts, and keep
+    that size. Each buffer whose allocation exceeds \a ratio times its current size is shrunk to
+    fit. The buffers keep their contents, so the ghosts can still be updated without a new exchange.
+*/
+void Communicator::shrinkToFit(Scalar ratio)
+    {
+    auto shrink = [ratio](auto& buf)
+    {
+        if (Scalar(buf.getNumElements()) > ratio * Scalar(std::max(buf.size(), size_t(1))))
+            buf.shrink_to_fit();
+    };
+
+    shrink(m_pos_copybuf);
+    shrink(m_charge_copybuf);
+    shrink(m_diameter_copybuf);
+    shrink(m_body_copybuf);
+    shrink(m_image_copybuf);
+    shrink(m_velocity_copybuf);
+    shrink(m_orientation_copybuf);
+    shrink(m_plan_copybuf);
+    shrink(m_tag_copybuf);
+    shrink(m_netforce_copybuf);
+    shrink(m_nettorque_copybuf);
+    shrink(m_netvirial_copybuf);
+    shrink(m_netvirial_recvbuf);
+    shrink(m_plan);
+    shrink(m_plan_reverse);
+    shrink(m_tag_reverse);
+    shrink(m_netforce_reverse_copybuf);
+    shrink(m_netforce_reverse_recvbuf);
+    shrink(m_virial_reverse_copybuf);
+    shrink(m_virial_reverse_recvbuf);
+    for (unsigned int dir = 0; dir < 6; ++dir)
+        {
+        shrink(m_copy_ghosts[dir]);
+        shrink(m_copy_ghosts_reverse[dir]);
+        shrink(m_plan_reverse_copybuf[dir]);
+        shrink(m_forward_ghosts_reverse[dir]);
+        }
+
+    // migration buffers are only in use during migrateParticles()
+    m_sendbuf.clear();
+    m_sendbuf.shrink_to_fit();
+    m_recvbuf.clear();
+    m_recvbuf.shrink_to_fit();
+    }
+
 void Communicator::updateMeshDefinition()
     {
     m_meshbond_comm.setGroupData(m_meshdef->getMeshBondData());
@@ -2624,6 +2678,9 @@ void Communicator::exchangeGhosts()
 
             } // end dir loop
         }
+
+    // fill in the structure-of-arrays positions of the received ghosts
+    m_pdata->updatePositionComponents(m_pdata->getN(), m_pdata->getN() + m_pdata->getNGhosts());
     }
 
 //! update positions of ghost particles
@@ -2851,6 +2908,13 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
             }
 
         } // end dir loop
+
+    if (getFlags()[comm_flag::position])
+        {
+        // update the structure-of-arrays positions of the ghosts
+        m_pdata->updatePositionComponents(m_pdata->getN(),
+                                          m_pdata->getN() + m_pdata->getNGhosts());
+        }
     }
 
 void Communicator::updateNetForce(uint64_t timestep)
@@ -3280,6 +3344,242 @@ void Communicator::updateNetForce(uint64_t timestep)
         } // end dir loop
     }
 
+/*! The forces are routed along the reverse ghost plans built in exchangeGhosts(), in the same way
+    as the reverse net force in updateNetForce(). Ghosts that were forwarded through several domains
+    are forwarded back through the same domains.
+*/
+void Communicator::addGhostForces(GlobalArray<Scalar4>& force,
+                                  GlobalArray<Scalar>& virial,
+                                  bool include_virial)
+    {
+    if (!getFlags()[comm_flag::reverse_net_force])
+        {
+        throw std::runtime_error("Ghost forces require the reverse_net_force communication flag.");
+        }
+
+    m_exec_conf->msg->notice(7) << "Communicator: add ghost forces" << std::endl;
+
+    unsigned int pitch = (unsigned int)virial.getPitch();
+    unsigned int n_local = m_pdata->getN();
+    unsigned int num_tot_recv_ghosts_reverse = 0;
+
+    for (unsigned int dir = 0; dir < 6; dir++)
+        {
+        if (!isCommunicating(dir))
+            continue;
+
+        unsigned int n_copy_local = m_num_copy_local_ghosts_reverse[dir];
+        unsigned int n_send = n_copy_local + m_num_forward_ghosts_reverse[dir];
+        unsigned int n_recv
+            = m_num_recv_local_ghosts_reverse[dir] + m_num_recv_forward_ghosts_reverse[dir];
+
+        // forwarded ghosts refer to entries received in previous directions, so the receive
+        // buffers keep the data of all directions
+        unsigned int start_idx = num_tot_recv_ghosts_reverse;
+        num_tot_recv_ghosts_reverse += n_recv;
+
+        m_netforce_reverse_copybuf.resize(n_send);
+        m_netforce_reverse_recvbuf.resize(num_tot_recv_ghosts_reverse);
+        if (include_virial)
+            {
+            m_virial_reverse_copybuf.resize(6 * n_send);
+            m_virial_reverse_recvbuf.resize(6 * num_tot_recv_ghosts_reverse);
+            }
+
+            // copy the forces of local ghosts and of the ghosts forwarded to this domain
+            {
+            ArrayHandle<Scalar4> h_force(force, access_location::host, access_mode::read);
+            ArrayHandle<Scalar4> h_copybuf(m_netforce_reverse_copybuf,
+                                           access_location::host,
+                                           access_mode::overwrite);
+            ArrayHandle<Scalar4> h_recvbuf(m_netforce_reverse_recvbuf,
+                                           access_location::host,
+                                           access_mode::read);
+            ArrayHandle<unsigned int> h_copy_ghosts_reverse(m_copy_ghosts_reverse[dir],
+                                                            access_location::host,
+                                                            access_mode::read);
+            ArrayHandle<unsigned int> h_forward_ghosts_reverse(m_forward_ghosts_reverse[dir],
+                                                               access_location::host,
+                                                               access_mode::read);
+            ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
+                                             access_location::host,
+                                             access_mode::read);
+
+            for (unsigned int i = 0; i < n_copy_local; i++)
+                {
+                unsigned int idx = h_rtag.data[h_copy_ghosts_reverse.data[i]];
+                assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+                h_copybuf.data[i] = h_force.data[idx];
+                }
+
+            for (unsigned int i = 0; i < n_send - n_copy_local; i++)
+                {
+                h_copybuf.data[n_copy_local + i] = h_recvbuf.data[h_forward_ghosts_reverse.data[i]];
+                }
+            }
+
+        if (include_virial)
+            {
+            ArrayHandle<Scalar> h_virial(virial, access_location::host, access_mode::read);
+            ArrayHandle<Scalar> h_copybuf(m_virial_reverse_copybuf,
+                                          access_location::host,
+                                          access_mode::overwrite);
+            ArrayHandle<Scalar> h_recvbuf(m_virial_reverse_recvbuf,
+                                          access_location::host,
+                                          access_mode::read);
+            ArrayHandle<unsigned int> h_copy_ghosts_reverse(m_copy_ghosts_reverse[dir],
+                                                            access_location::host,
+                                                            access_mode::read);
+            ArrayHandle<unsigned int> h_forward_ghosts_reverse(m_forward_ghosts_reverse[dir],
+                                                               access_location::host,
+                                                               access_mode::read);
+            ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
+                                             access_location::host,
+                                             access_mode::read);
+
+            // copy into the send buffer, transposing
+            for (unsigned int i = 0; i < n_copy_local; i++)
+                {
+                unsigned int idx = h_rtag.data[h_copy_ghosts_reverse.data[i]];
+                for (unsigned int k = 0; k < 6; k++)
+                    h_copybuf.data[6 * i + k] = h_virial.data[k * pitch + idx];
+                }
+
+            for (unsigned int i = 0; i < n_send - n_copy_local; i++)
+                {
+                unsigned int src = h_forward_ghosts_reverse.data[i];
+                for (unsigned int k = 0; k < 6; k++)
+                    h_copybuf.data[6 * (n_copy_local + i) + k] = h_recvbuf.data[6 * src + k];
+                }
+            }
+
+        unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
+
+        // we receive from the direction opposite to the one we send to
+        unsigned int recv_neighbor;
+        if (dir % 2 == 0)
+            recv_neighbor = m_decomposition->getNeighborRank(dir + 1);
+        else
+            recv_neighbor = m_decomposition->getNeighborRank(dir - 1);
+
+            {
+            ArrayHandle<Scalar4> h_copybuf(m_netforce_reverse_copybuf,
+                                           access_location::host,
+                                           access_mode::read);
+            ArrayHandle<Scalar4> h_recvbuf(m_netforce_reverse_recvbuf,
+                                           access_location::host,
+                                           access_mode::readwrite);
+
+            m_reqs.resize(2);
+            m_stats.resize(2);
+            MPI_Isend(h_copybuf.data,
+                      (unsigned int)(n_send * sizeof(Scalar4)),
+                      MPI_BYTE,
+                      send_neighbor,
+                      2,
+                      m_mpi_comm,
+                      &m_reqs[0]);
+            MPI_Irecv(h_recvbuf.data + start_idx,
+                      (unsigned int)(n_recv * sizeof(Scalar4)),
+                      MPI_BYTE,
+                      recv_neighbor,
+                      2,
+                      m_mpi_comm,
+                      &m_reqs[1]);
+            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+            }
+
+        if (include_virial)
+            {
+            ArrayHandle<Scalar> h_copybuf(m_virial_reverse_copybuf,
+                                          access_location::host,
+                                          access_mode::read);
+            ArrayHandle<Scalar> h_recvbuf(m_virial_reverse_recvbuf,
+                                          access_location::host,
+                                          access_mode::readwrite);
+
+            m_reqs.resize(2);
+            m_stats.resize(2);
+            MPI_Isend(h_copybuf.data,
+                      (unsigned int)(6 * n_send * sizeof(Scalar)),
+                      MPI_BYTE,
+                      send_neighbor,
+                      4,
+                      m_mpi_comm,
+                      &m_reqs[0]);
+            MPI_Irecv(h_recvbuf.data + 6 * start_idx,
+                      (unsigned int)(6 * n_recv * sizeof(Scalar)),
+                      MPI_BYTE,
+                      recv_neighbor,
+                      4,
+                      m_mpi_comm,
+                      &m_reqs[1]);
+            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+            }
+
+        // add the received forces to the local particles, the remaining entries are forwarded in
+        // a later direction
+        ArrayHandle<unsigned int> h_tag_reverse(m_tag_reverse,
+                                                access_location::host,
+                                                access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
+
+            {
+            ArrayHandle<Scalar4> h_force(force, access_location::host, access_mode::readwrite);
+            ArrayHandle<Scalar4> h_recvbuf(m_netforce_reverse_recvbuf,
+                                           access_location::host,
+                                           access_mode::read);
+
+            for (unsigned int i = start_idx; i < start_idx + n_recv; i++)
+                {
+                unsigned int idx = h_rtag.data[h_tag_reverse.data[i]];
+                if (idx < n_local)
+                    {
+                    Scalar4 f = h_recvbuf.data[i];
+                    h_force.data[idx].x += f.x;
+                    h_force.data[idx].y += f.y;
+                    h_force.data[idx].z += f.z;
+                    h_force.data[idx].w += f.w;
+                    }
+                }
+            }
+
+        if (include_virial)
+            {
+            ArrayHandle<Scalar> h_virial(virial, access_location::host, access_mode::readwrite);
+            ArrayHandle<Scalar> h_recvbuf(m_virial_reverse_recvbuf,
+                                          access_location::host,
+                                          access_mode::read);
+
+            for (unsigned int i = start_idx; i < start_idx + n_recv; i++)
+                {
+                unsigned int idx = h_rtag.data[h_tag_reverse.data[i]];
+                if (idx < n_local)
+                    {
+                    for (unsigned int k = 0; k < 6; k++)
+                        h_virial.data[k * pitch + idx] += h_recvbuf.data[6 * i + k];
+                    }
+                }
+            }
+        } // end dir loop
+
+    // the ghost contributions are now accounted for on their owners
+    unsigned int n_ghosts = m_pdata->getNGhosts();
+    ArrayHandle<Scalar4> h_force(force, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_virial(virial, access_location::host, access_mode::readwrite);
+    for (unsigned int i = n_local; i < n_local + n_ghosts; i++)
+        {
+        h_force.data[i] = make_scalar4(0, 0, 0, 0);
+        if (include_virial)
+            {
+            for (unsigned int k = 0; k < 6; k++)
+                h_virial.data[k * pitch + i] = Scalar(0.0);
+            }
+        }
+    }
+
 void Communicator::removeGhostParticleTags()
     {
     // wipe out reverse-lookup tag -> idx for old ghost atoms
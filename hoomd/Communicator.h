@@ -333,6 +333,17 @@ class PYBIND11_EXPORT Communicator
      */
     virtual void updateNetForce(uint64_t timestep);
 
+    /*! Add the forces, energies and virials of ghost particles to the local particles they are
+     *  copies of and zero them on the ghosts. Requires comm_flag::reverse_net_force at the last
+     *  ghost exchange.
+     * \param force Per-particle force and energy of a force compute
+     * \param virial Per-particle virial of the same force compute
+     * \param include_virial True if the virial is also communicated
+     */
+    void addGhostForces(GlobalArray<Scalar4>& force,
+                        GlobalArray<Scalar>& virial,
+                        bool include_virial);
+
     /*! This methods finds all the particles that are no longer inside the domain
      * boundaries and transfers them to neighboring processors.
      *
@@ -552,6 +563,8 @@ class PYBIND11_EXPORT Communicator
     GlobalVector<Scalar4> m_netforce_reverse_copybuf; //!< Buffer for reverse net force from ghosts
     GlobalVector<Scalar4> m_netforce_reverse_recvbuf; //!< Buffer for the reverse net force. Receive
                                                       //!< buffer for m_netforce_reverse_copybuf
+    GlobalVector<Scalar> m_virial_reverse_copybuf; //!< Buffer for the reverse virial from ghosts
+    GlobalVector<Scalar> m_virial_reverse_recvbuf; //!< Receive buffer for m_virial_reverse_copybuf
 
     BoxDim m_global_box;                //!< Global simulation box
     GlobalArray<Scalar> m_r_ghost;      //!< Width of ghost layer
@@ -717,6 +730,9 @@ class PYBIND11_EXPORT Communicator
     //! Helper function to initialize adjacency arrays
     void initializeNeighborArrays();
 
+    //! Release the buffer memory held beyond the last exchange
+    virtual void shrinkToFit(Scalar ratio);
+
     //! Method that is called when ghost particles are requested to be removed
     void slotGhostParticlesRemoved()
         {
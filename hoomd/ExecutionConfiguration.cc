@@ -660,6 +660,17 @@ int ExecutionConfiguration::guessLocalRank()
 #endif
     }
 
+/*! \returns A map from the tag of each array to the number of bytes it holds, or an empty map when
+    memory tracing is disabled
+*/
+std::map<std::string, size_t> ExecutionConfiguration::getMemoryUsage() const
+    {
+    if (!m_memory_traceback)
+        return std::map<std::string, size_t>();
+
+    return m_memory_traceback->getUsage();
+    }
+
 namespace detail
     {
 void export_ExecutionConfiguration(pybind11::module& m)
@@ -691,6 +702,7 @@ void export_ExecutionConfiguration(pybind11::module& m)
         .def("getNumThreads", &ExecutionConfiguration::getNumThreads)
         .def("setMemoryTracing", &ExecutionConfiguration::setMemoryTracing)
         .def("memoryTracingEnabled", &ExecutionConfiguration::memoryTracingEnabled)
+        .def("getMemoryUsage", &ExecutionConfiguration::getMemoryUsage)
         .def_static("getCapableDevices", &ExecutionConfiguration::getCapableDevices)
         .def_static("getScanMessages", &ExecutionConfiguration::getScanMessages)
         .def("getActiveDevices", &ExecutionConfiguration::getActiveDevices);
@@ -12,7 +12,9 @@
 #endif
 
 #include "MPIConfiguration.h"
+#include "MemoryTraceback.h"
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -295,16 +297,36 @@ class PYBIND11_EXPORT ExecutionConfiguration
 #endif
 
     //! Set up memory tracing
+    /*! \param enable Set to true to record array allocations in a MemoryTraceback
+
+        Only allocations made after tracing is enabled are recorded. Disabling tracing discards the
+        registry.
+    */
     void setMemoryTracing(bool enable)
         {
-        m_memory_tracing = enable;
+        if (enable && !m_memory_traceback)
+            m_memory_traceback.reset(new MemoryTraceback());
+        else if (!enable)
+            m_memory_traceback.reset();
         }
 
+    //! Returns true if memory tracing is enabled
     bool memoryTracingEnabled() const
         {
-        return m_memory_tracing;
+        return bool(m_memory_traceback);
         }
 
+    //! Get the memory allocation registry
+    /*! \returns The registry, or nullptr when memory tracing is disabled
+     */
+    MemoryTraceback* getMemoryTraceback() const
+        {
+        return m_memory_traceback.get();
+        }
+
+    //! Get the number of bytes in recorded array allocations on this rank, summed by tag
+    std::map<std::string, size_t> getMemoryUsage() const;
+
     //! Returns true if we are in a multi-GPU block
     bool inMultiGPUBlock() const
         {
@@ -409,7 +431,7 @@ class PYBIND11_EXPORT ExecutionConfiguration
     //! Setup and print out stats on the chosen CPUs/GPUs
     void setupStats();
 
-    bool m_memory_tracing = false;
+    std::unique_ptr<MemoryTraceback> m_memory_traceback; //!< Allocation registry, if tracing
     };
 
 #if defined(ENABLE_HIP)
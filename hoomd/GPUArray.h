@@ -29,6 +29,7 @@
 
 #include <cxxabi.h>
 #include <sstream>
+#include <typeinfo>
 
 namespace hoomd
     {
@@ -75,6 +76,39 @@ template<class T> class GPUArray;
 
 namespace detail
     {
+//! Record an allocation in the memory traceback, when memory tracing is enabled
+/*! \param exec_conf Execution configuration
+    \param ptr Start of the allocation
+    \param nbytes Size of the allocation in bytes
+    \param space Memory space of the allocation
+    \param tag Name of the owning array
+ */
+template<class T>
+inline void trace_allocation(const std::shared_ptr<const ExecutionConfiguration>& exec_conf,
+                             const T* ptr,
+                             size_t nbytes,
+                             MemoryTraceback::Space space,
+                             const std::string& tag = std::string())
+    {
+    if (exec_conf && exec_conf->getMemoryTraceback())
+        exec_conf->getMemoryTraceback()->registerAllocation(ptr,
+                                                            nbytes,
+                                                            space,
+                                                            typeid(T).name(),
+                                                            tag);
+    }
+
+//! Remove an allocation from the memory traceback, when memory tracing is enabled
+/*! \param exec_conf Execution configuration
+    \param ptr Start of the allocation
+ */
+inline void untrace_allocation(const std::shared_ptr<const ExecutionConfiguration>& exec_conf,
+                               const void* ptr)
+    {
+    if (exec_conf && exec_conf->getMemoryTraceback())
+        exec_conf->getMemoryTraceback()->unregisterAllocation(ptr);
+    }
+
 template<class T> class device_deleter
     {
     public:
@@ -106,6 +140,7 @@ template<class T> class device_deleter
             assert(m_exec_conf);
             this->m_exec_conf->msg->notice(10)
                 << "Freeing " << m_N * sizeof(T) << " bytes of CUDA memory." << std::endl;
+            untrace_allocation(m_exec_conf, ptr);
 
 #ifdef ENABLE_HIP
             hipFree(ptr);
@@ -148,6 +183,7 @@ template<class T> class host_deleter
         if (m_exec_conf)
             m_exec_conf->msg->notice(10)
                 << "Freeing " << m_N * sizeof(T) << " bytes of host memory." << std::endl;
+        untrace_allocation(m_exec_conf, ptr);
 
         if (m_use_device)
             {
@@ -998,6 +1034,10 @@ template<class T> void GPUArray<T>::allocate()
     hoomd::detail::host_deleter<T> host_deleter(m_exec_conf, use_device, m_num_elements);
     h_data = std::unique_ptr<T, hoomd::detail::host_deleter<T>>(reinterpret_cast<T*>(host_ptr),
                                                                 host_deleter);
+    hoomd::detail::trace_allocation(m_exec_conf,
+                                    h_data.get(),
+                                    m_num_elements * sizeof(T),
+                                    MemoryTraceback::Space::host);
 
 #if defined(ENABLE_HIP)
     if (m_exec_conf && m_exec_conf->isCUDAEnabled())
@@ -1043,6 +1083,11 @@ template<class T> void GPUArray<T>::allocate()
         d_data
             = std::unique_ptr<T, hoomd::detail::device_deleter<T>>(reinterpret_cast<T*>(device_ptr),
                                                                    device_deleter);
+        if (!m_mapped)
+            hoomd::detail::trace_allocation(m_exec_conf,
+                                            d_data.get(),
+                                            m_num_elements * sizeof(T),
+                                            MemoryTraceback::Space::device);
         }
 #endif
     }
@@ -1368,6 +1413,10 @@ template<class T> T* GPUArray<T>::resizeHostArray(size_t num_elements)
     bool use_device = m_exec_conf && m_exec_conf->isCUDAEnabled();
     hoomd::detail::host_deleter<T> host_deleter(m_exec_conf, use_device, num_elements);
     h_data = std::unique_ptr<T, hoomd::detail::host_deleter<T>>(h_tmp, host_deleter);
+    hoomd::detail::trace_allocation(m_exec_conf,
+                                    h_tmp,
+                                    num_elements * sizeof(T),
+                                    MemoryTraceback::Space::host);
 
 #ifdef ENABLE_HIP
     // update device pointer
@@ -1436,6 +1485,7 @@ T* GPUArray<T>::resize2DHostArray(size_t pitch, size_t new_pitch, size_t height,
     bool use_device = m_exec_conf && m_exec_conf->isCUDAEnabled();
     hoomd::detail::host_deleter<T> host_deleter(m_exec_conf, use_device, new_pitch * new_height);
     h_data = std::unique_ptr<T, hoomd::detail::host_deleter<T>>(h_tmp, host_deleter);
+    hoomd::detail::trace_allocation(m_exec_conf, h_tmp, size, MemoryTraceback::Space::host);
 
 #ifdef ENABLE_HIP
     // update device pointer
@@ -1508,6 +1558,11 @@ template<class T> T* GPUArray<T>::resizeDeviceArray(size_t num_elements)
                                                     num_elements,
                                                     m_mapped);
     d_data = std::unique_ptr<T, hoomd::detail::device_deleter<T>>(d_tmp, device_deleter);
+    if (!m_mapped)
+        hoomd::detail::trace_allocation(m_exec_conf,
+                                        d_tmp,
+                                        num_elements * sizeof(T),
+                                        MemoryTraceback::Space::device);
 
     return d_data.get();
 #else
@@ -1575,6 +1630,11 @@ T* GPUArray<T>::resize2DDeviceArray(size_t pitch,
                                                     new_pitch * new_height,
                                                     m_mapped);
     d_data = std::unique_ptr<T, hoomd::detail::device_deleter<T>>(d_tmp, device_deleter);
+    if (!m_mapped)
+        hoomd::detail::trace_allocation(m_exec_conf,
+                                        d_tmp,
+                                        new_pitch * new_height * sizeof(T),
+                                        MemoryTraceback::Space::device);
 
     return d_data.get();
 #else
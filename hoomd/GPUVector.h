@@ -31,8 +31,8 @@ template<class T> class GlobalVector;
     It uses a GPUArray as the underlying storage class, thus the data in a GPUVectorBase can also be
    accessed directly using ArrayHandles.
 
-    In the current implementation, a GPUVectorBase can only grow (but not shrink) in size until it
-   is destroyed.
+    The allocated memory grows with the size of the vector, but is only released on request with
+   shrink_to_fit().
 
     \ingroup data_structs
 */
@@ -87,6 +87,9 @@ template<class T, class Array> class GPUVectorBase : public Array
     //! Clear the list
     virtual void clear();
 
+    //! Release the allocated memory beyond the current size
+    void shrink_to_fit();
+
     //! Proxy class to provide access to the data elements of the vector
     class data_proxy
         {
@@ -354,6 +357,16 @@ template<class T, class Array> void GPUVectorBase<T, Array>::clear()
     m_size = 0;
     }
 
+/*! \post The allocated memory holds max(size(), 1) elements. The elements of the vector are
+          preserved.
+*/
+template<class T, class Array> void GPUVectorBase<T, Array>::shrink_to_fit()
+    {
+    size_t new_allocated_size = m_size ? m_size : 1;
+    if (Array::getNumElements() > new_allocated_size)
+        Array::resize(new_allocated_size);
+    }
+
 /*! \param mode Access mode for the GPUArray
  */
 template<class T, class Array>
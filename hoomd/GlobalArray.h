@@ -117,6 +117,8 @@ template<class T> class managed_deleter
         if (!m_exec_conf)
             return;
 
+        untrace_allocation(m_exec_conf, ptr);
+
 #ifdef ENABLE_HIP
         if (m_use_device)
             {
@@ -237,7 +239,10 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
         {
 #ifndef ALWAYS_USE_MANAGED_MEMORY
         if (!(m_is_managed))
+            {
+            updateTraceTag();
             return;
+            }
 #endif
 
         assert(this->m_exec_conf);
@@ -285,6 +290,8 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
 
             std::copy(from.m_data.get(), from.m_data.get() + from.m_num_elements, m_data.get());
             }
+
+        updateTraceTag();
         }
 
     //! = operator
@@ -327,6 +334,8 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
                 {
                 m_data.reset();
                 }
+
+            updateTraceTag();
             }
 
         return *this;
@@ -526,6 +535,7 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
         if (!this->m_exec_conf || !m_is_managed)
             {
             m_fallback.resize(num_elements);
+            updateTraceTag();
             this->outputRepresentation();
             return;
             }
@@ -578,6 +588,7 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
         if (!m_is_managed)
             {
             m_fallback.resize(width, height);
+            updateTraceTag();
             outputRepresentation();
             return;
             }
@@ -640,6 +651,8 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
         if (!isNull() && m_data)
             m_data.get_deleter().setTag(tag);
 
+        updateTraceTag();
+
         // for debugging
         this->outputRepresentation();
         }
@@ -750,6 +763,26 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
         m_event; //! CUDA event for synchronization
 #endif
 
+    //! Set the tag of the allocations held by this array in the memory traceback
+    void updateTraceTag()
+        {
+        if (!m_exec_conf || !m_exec_conf->getMemoryTraceback())
+            return;
+
+        MemoryTraceback* traceback = m_exec_conf->getMemoryTraceback();
+#ifndef ALWAYS_USE_MANAGED_MEMORY
+        if (!m_is_managed)
+            {
+            traceback->updateTag(m_fallback.h_data.get(), m_tag);
+#ifdef ENABLE_HIP
+            traceback->updateTag(m_fallback.d_data.get(), m_tag);
+#endif
+            return;
+            }
+#endif
+        traceback->updateTag(m_data.get(), m_tag);
+        }
+
     //! Allocate the managed array and construct the items
     void allocate()
         {
@@ -841,6 +874,12 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
                                                   allocation_bytes);
         deleter.setTag(m_tag);
         m_data = std::unique_ptr<T, decltype(deleter)>(reinterpret_cast<T*>(ptr), deleter);
+        hoomd::detail::trace_allocation(this->m_exec_conf,
+                                        m_data.get(),
+                                        allocation_bytes,
+                                        use_device ? MemoryTraceback::Space::managed
+                                                   : MemoryTraceback::Space::host,
+                                        m_tag);
 
         // construct objects explicitly using placement new
         for (std::size_t i = 0; i < m_num_elements; ++i)
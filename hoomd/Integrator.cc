@@ -11,6 +11,12 @@
 #include "Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
+#include <memory>
+
 #include <pybind11/stl_bind.h>
 PYBIND11_MAKE_OPAQUE(std::vector<std::shared_ptr<hoomd::ForceConstraint>>);
 PYBIND11_MAKE_OPAQUE(std::vector<std::shared_ptr<hoomd::ForceCompute>>);
@@ -165,6 +171,9 @@ vec3<double> Integrator::computeLinearMomentum()
 */
 void Integrator::computeNetForce(uint64_t timestep)
     {
+    // the integration methods write the Scalar4 positions of the local particles
+    m_pdata->updatePositionComponents(0, m_pdata->getN());
+
     for (auto& force : m_forces)
         {
         force->compute(timestep);
@@ -172,69 +181,17 @@ void Integrator::computeNetForce(uint64_t timestep)
 
     Scalar external_virial[6];
     Scalar external_energy;
-        {
-        // access the net force and virial arrays
-        const GlobalArray<Scalar4>& net_force = m_pdata->getNetForce();
-        const GlobalArray<Scalar>& net_virial = m_pdata->getNetVirial();
-        const GlobalArray<Scalar4>& net_torque = m_pdata->getNetTorqueArray();
-        ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar4> h_net_torque(net_torque,
-                                          access_location::host,
-                                          access_mode::overwrite);
-
-        // start by zeroing the net force and virial arrays
-        memset((void*)h_net_force.data, 0, sizeof(Scalar4) * net_force.getNumElements());
-        memset((void*)h_net_virial.data, 0, sizeof(Scalar) * net_virial.getNumElements());
-        memset((void*)h_net_torque.data, 0, sizeof(Scalar4) * net_torque.getNumElements());
-
-        for (unsigned int i = 0; i < 6; ++i)
-            external_virial[i] = Scalar(0.0);
-
-        external_energy = Scalar(0.0);
 
-        // now, add up the net forces
-        // also sum up forces for ghosts, in case they are needed by the communicator
-        unsigned int nparticles = m_pdata->getN() + m_pdata->getNGhosts();
-        size_t net_virial_pitch = net_virial.getPitch();
+    for (unsigned int i = 0; i < 6; ++i)
+        external_virial[i] = Scalar(0.0);
 
-        assert(nparticles <= net_force.getNumElements());
-        assert(6 * nparticles <= net_virial.getNumElements());
-        assert(nparticles <= net_torque.getNumElements());
+    external_energy = Scalar(0.0);
 
+        {
+        std::vector<ForceCompute*> forces;
         for (const auto& force : m_forces)
             {
-            const GlobalArray<Scalar4>& h_force_array = force->getForceArray();
-            const GlobalArray<Scalar>& h_virial_array = force->getVirialArray();
-            const GlobalArray<Scalar4>& h_torque_array = force->getTorqueArray();
-
-            assert(nparticles <= h_force_array.getNumElements());
-            assert(6 * nparticles <= h_virial_array.getNumElements());
-            assert(nparticles <= h_torque_array.getNumElements());
-
-            ArrayHandle<Scalar4> h_force(h_force_array, access_location::host, access_mode::read);
-            ArrayHandle<Scalar> h_virial(h_virial_array, access_location::host, access_mode::read);
-            ArrayHandle<Scalar4> h_torque(h_torque_array, access_location::host, access_mode::read);
-
-            size_t virial_pitch = h_virial_array.getPitch();
-            for (unsigned int j = 0; j < nparticles; j++)
-                {
-                h_net_force.data[j].x += h_force.data[j].x;
-                h_net_force.data[j].y += h_force.data[j].y;
-                h_net_force.data[j].z += h_force.data[j].z;
-                h_net_force.data[j].w += h_force.data[j].w;
-
-                h_net_torque.data[j].x += h_torque.data[j].x;
-                h_net_torque.data[j].y += h_torque.data[j].y;
-                h_net_torque.data[j].z += h_torque.data[j].z;
-                h_net_torque.data[j].w += h_torque.data[j].w;
-
-                for (unsigned int k = 0; k < 6; k++)
-                    {
-                    h_net_virial.data[k * net_virial_pitch + j]
-                        += h_virial.data[k * virial_pitch + j];
-                    }
-                }
+            forces.push_back(force.get());
 
             for (unsigned int k = 0; k < 6; k++)
                 {
@@ -243,6 +200,9 @@ void Integrator::computeNetForce(uint64_t timestep)
 
             external_energy += force->getExternalEnergy();
             }
+
+        // also sum up forces for ghosts, in case they are needed by the communicator
+        accumulateNetForce(forces, m_pdata->getN() + m_pdata->getNGhosts(), true, m_force_scale);
         }
 
     for (unsigned int k = 0; k < 6; k++)
@@ -272,53 +232,11 @@ void Integrator::computeNetForce(uint64_t timestep)
         }
 
         {
-        // access the net force and virial arrays
-        const GlobalArray<Scalar4>& net_force = m_pdata->getNetForce();
-        const GlobalArray<Scalar>& net_virial = m_pdata->getNetVirial();
-        const GlobalArray<Scalar4>& net_torque = m_pdata->getNetTorqueArray();
-        ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::readwrite);
-        ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, access_mode::readwrite);
-        ArrayHandle<Scalar4> h_net_torque(net_torque,
-                                          access_location::host,
-                                          access_mode::readwrite);
-        size_t net_virial_pitch = net_virial.getPitch();
-
-        // now, add up the net forces
-        unsigned int nparticles = m_pdata->getN();
-        assert(nparticles <= net_force.getNumElements());
-        assert(6 * nparticles <= net_virial.getNumElements());
+        std::vector<ForceCompute*> forces;
         for (const auto& constraint_force : m_constraint_forces)
             {
-            const GlobalArray<Scalar4>& h_force_array = constraint_force->getForceArray();
-            const GlobalArray<Scalar>& h_virial_array = constraint_force->getVirialArray();
-            const GlobalArray<Scalar4>& h_torque_array = constraint_force->getTorqueArray();
-            ArrayHandle<Scalar4> h_force(h_force_array, access_location::host, access_mode::read);
-            ArrayHandle<Scalar> h_virial(h_virial_array, access_location::host, access_mode::read);
-            ArrayHandle<Scalar4> h_torque(h_torque_array, access_location::host, access_mode::read);
-            size_t virial_pitch = h_virial_array.getPitch();
-
-            assert(nparticles <= h_force_array.getNumElements());
-            assert(6 * nparticles <= h_virial_array.getNumElements());
-            assert(nparticles <= h_torque_array.getNumElements());
-
-            for (unsigned int j = 0; j < nparticles; j++)
-                {
-                h_net_force.data[j].x += h_force.data[j].x;
-                h_net_force.data[j].y += h_force.data[j].y;
-                h_net_force.data[j].z += h_force.data[j].z;
-                h_net_force.data[j].w += h_force.data[j].w;
-
-                h_net_torque.data[j].x += h_torque.data[j].x;
-                h_net_torque.data[j].y += h_torque.data[j].y;
-                h_net_torque.data[j].z += h_torque.data[j].z;
-                h_net_torque.data[j].w += h_torque.data[j].w;
-
-                for (unsigned int k = 0; k < 6; k++)
-                    {
-                    h_net_virial.data[k * net_virial_pitch + j]
-                        += h_virial.data[k * virial_pitch + j];
-                    }
-                }
+            forces.push_back(constraint_force.get());
+
             for (unsigned int k = 0; k < 6; k++)
                 {
                 external_virial[k] += constraint_force->getExternalVirial(k);
@@ -326,6 +244,8 @@ void Integrator::computeNetForce(uint64_t timestep)
 
             external_energy += constraint_force->getExternalEnergy();
             }
+
+        accumulateNetForce(forces, m_pdata->getN(), false);
         }
 
     for (unsigned int k = 0; k < 6; k++)
@@ -336,6 +256,137 @@ void Integrator::computeNetForce(uint64_t timestep)
     m_pdata->setExternalEnergy(external_energy);
     }
 
+/** @param forces Force computes to sum
+    @param nparticles Number of particles to sum over
+    @param overwrite When true, replace the net arrays by the sum, otherwise add to them
+    @param force_scale Factor applied to the force and torque of each force compute, an empty
+           vector applies no scaling
+
+    The loop runs over particles and sums all force computes for each particle, so that each net
+    array element is read (at most) and written once per call regardless of the number of forces.
+    Elements beyond nparticles are zeroed when overwriting.
+*/
+void Integrator::accumulateNetForce(const std::vector<ForceCompute*>& forces,
+                                    unsigned int nparticles,
+                                    bool overwrite,
+                                    const std::vector<Scalar>& force_scale)
+    {
+    const GlobalArray<Scalar4>& net_force = m_pdata->getNetForce();
+    const GlobalArray<Scalar>& net_virial = m_pdata->getNetVirial();
+    const GlobalArray<Scalar4>& net_torque = m_pdata->getNetTorqueArray();
+    access_mode::Enum mode = overwrite ? access_mode::overwrite : access_mode::readwrite;
+    ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, mode);
+    ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, mode);
+    ArrayHandle<Scalar4> h_net_torque(net_torque, access_location::host, mode);
+    size_t net_virial_pitch = net_virial.getPitch();
+
+    assert(nparticles <= net_force.getNumElements());
+    assert(6 * nparticles <= net_virial.getNumElements());
+    assert(nparticles <= net_torque.getNumElements());
+
+    // acquire all per-force arrays up front
+    unsigned int n_forces = (unsigned int)forces.size();
+    assert(force_scale.empty() || force_scale.size() == n_forces);
+    std::vector<Scalar> scale(force_scale);
+    scale.resize(n_forces, Scalar(1.0));
+    std::vector<std::unique_ptr<ArrayHandle<Scalar4>>> force_handles;
+    std::vector<std::unique_ptr<ArrayHandle<Scalar>>> virial_handles;
+    std::vector<std::unique_ptr<ArrayHandle<Scalar4>>> torque_handles;
+    std::vector<const Scalar4*> h_force(n_forces);
+    std::vector<const Scalar*> h_virial(n_forces);
+    std::vector<const Scalar4*> h_torque(n_forces);
+    std::vector<size_t> virial_pitch(n_forces);
+
+    for (unsigned int i = 0; i < n_forces; ++i)
+        {
+        const GlobalArray<Scalar4>& h_force_array = forces[i]->getForceArray();
+        const GlobalArray<Scalar>& h_virial_array = forces[i]->getVirialArray();
+        const GlobalArray<Scalar4>& h_torque_array = forces[i]->getTorqueArray();
+
+        assert(nparticles <= h_force_array.getNumElements());
+        assert(6 * nparticles <= h_virial_array.getNumElements());
+        assert(nparticles <= h_torque_array.getNumElements());
+
+        force_handles.emplace_back(new ArrayHandle<Scalar4>(h_force_array,
+                                                            access_location::host,
+                                                            access_mode::read));
+        virial_handles.emplace_back(new ArrayHandle<Scalar>(h_virial_array,
+                                                            access_location::host,
+                                                            access_mode::read));
+        torque_handles.emplace_back(new ArrayHandle<Scalar4>(h_torque_array,
+                                                             access_location::host,
+                                                             access_mode::read));
+        h_force[i] = force_handles.back()->data;
+        h_virial[i] = virial_handles.back()->data;
+        h_torque[i] = torque_handles.back()->data;
+        virial_pitch[i] = h_virial_array.getPitch();
+        }
+
+    Scalar4* net_force_data = h_net_force.data;
+    Scalar* net_virial_data = h_net_virial.data;
+    Scalar4* net_torque_data = h_net_torque.data;
+
+    auto sum_particle = [&](unsigned int j)
+    {
+        Scalar4 f = make_scalar4(0, 0, 0, 0);
+        Scalar4 t = make_scalar4(0, 0, 0, 0);
+        Scalar v[6] = {0, 0, 0, 0, 0, 0};
+        if (!overwrite)
+            {
+            f = net_force_data[j];
+            t = net_torque_data[j];
+            for (unsigned int k = 0; k < 6; k++)
+                v[k] = net_virial_data[k * net_virial_pitch + j];
+            }
+
+        for (unsigned int i = 0; i < n_forces; ++i)
+            {
+            f.x += scale[i] * h_force[i][j].x;
+            f.y += scale[i] * h_force[i][j].y;
+            f.z += scale[i] * h_force[i][j].z;
+            f.w += h_force[i][j].w;
+
+            t.x += scale[i] * h_torque[i][j].x;
+            t.y += scale[i] * h_torque[i][j].y;
+            t.z += scale[i] * h_torque[i][j].z;
+            t.w += h_torque[i][j].w;
+
+            for (unsigned int k = 0; k < 6; k++)
+                v[k] += h_virial[i][k * virial_pitch[i] + j];
+            }
+
+        net_force_data[j] = f;
+        net_torque_data[j] = t;
+        for (unsigned int k = 0; k < 6; k++)
+            net_virial_data[k * net_virial_pitch + j] = v[k];
+    };
+
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&] { tbb::parallel_for((unsigned int)0, nparticles, sum_particle); });
+#else
+    for (unsigned int j = 0; j < nparticles; j++)
+        sum_particle(j);
+#endif
+
+    if (overwrite)
+        {
+        // zero the remainder of the net arrays
+        size_t n_force = net_force.getNumElements();
+        size_t n_torque = net_torque.getNumElements();
+        memset((void*)(net_force_data + nparticles), 0, sizeof(Scalar4) * (n_force - nparticles));
+        memset((void*)(net_torque_data + nparticles),
+               0,
+               sizeof(Scalar4) * (n_torque - nparticles));
+        for (unsigned int k = 0; k < 6; k++)
+            {
+            memset((void*)(net_virial_data + k * net_virial_pitch + nparticles),
+                   0,
+                   sizeof(Scalar) * (net_virial_pitch - nparticles));
+            }
+        }
+    }
+
 #ifdef ENABLE_HIP
 /** @param timestep Current time step of the simulation
     \post All added force computes in \a m_forces are computed and totaled up in \a m_net_force and
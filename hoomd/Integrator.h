@@ -186,6 +186,11 @@ class PYBIND11_EXPORT Integrator : public Updater
     /// List of all the constraints
     std::vector<std::shared_ptr<ForceConstraint>> m_constraint_forces;
 
+    /// Factor applied to the force and torque (not energy or virial) of each entry in m_forces
+    /** Leave empty to sum all forces with unit weight.
+     */
+    std::vector<Scalar> m_force_scale;
+
     /// The HalfStepHook, if active
     std::shared_ptr<HalfStepHook> m_half_step_hook;
 
@@ -195,6 +200,12 @@ class PYBIND11_EXPORT Integrator : public Updater
     /// helper function to compute net force/virial
     virtual void computeNetForce(uint64_t timestep);
 
+    /// Sum the per-force arrays into the net force, virial, and torque in a single pass
+    void accumulateNetForce(const std::vector<ForceCompute*>& forces,
+                            unsigned int nparticles,
+                            bool overwrite,
+                            const std::vector<Scalar>& force_scale = std::vector<Scalar>());
+
 #ifdef ENABLE_HIP
     /// helper function to compute net force/virial on the GPU
     virtual void computeNetForceGPU(uint64_t timestep);
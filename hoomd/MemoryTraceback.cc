@@ -0,0 +1,126 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file MemoryTraceback.cc
+    \brief Defines the MemoryTraceback class
+*/
+
+#include "MemoryTraceback.h"
+
+#include <cxxabi.h>
+#include <cstdlib>
+
+namespace hoomd
+    {
+/*! \param ptr Start of the allocation
+    \param nbytes Size of the allocation in bytes
+    \param space Memory space of the allocation
+    \param type_name Mangled name of the element type, as returned by typeid(T).name()
+    \param tag Name of the owning array
+*/
+void MemoryTraceback::registerAllocation(const void* ptr,
+                                         size_t nbytes,
+                                         Space space,
+                                         const char* type_name,
+                                         const std::string& tag)
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_allocations[ptr] = Allocation {nbytes, space, type_name, tag};
+    }
+
+/*! \param ptr Start of the allocation
+ */
+void MemoryTraceback::unregisterAllocation(const void* ptr)
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_allocations.erase(ptr);
+    }
+
+/*! \param ptr Start of the allocation
+    \param tag New name of the owning array
+*/
+void MemoryTraceback::updateTag(const void* ptr, const std::string& tag)
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_allocations.find(ptr);
+    if (it != m_allocations.end())
+        it->second.tag = tag;
+    }
+
+size_t MemoryTraceback::getTotalBytes() const
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t total = 0;
+    for (const auto& allocation : m_allocations)
+        total += allocation.second.nbytes;
+    return total;
+    }
+
+/*! \returns A map from the tag of each array to the number of bytes it holds
+
+    Untagged allocations are summed under "anonymous [type]", where type is the demangled name of
+    the element type.
+*/
+std::map<std::string, size_t> MemoryTraceback::getUsage() const
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::map<std::string, size_t> usage;
+    for (const auto& allocation : m_allocations)
+        usage[getKey(allocation.second)] += allocation.second.nbytes;
+    return usage;
+    }
+
+/*! \param o Stream to write to
+
+    Writes one line per tag, with the number of allocations and bytes in each memory space, followed
+    by the total.
+*/
+void MemoryTraceback::outputTraces(std::ostream& o) const
+    {
+    struct Summary
+        {
+        size_t count = 0;
+        size_t nbytes[3] = {0, 0, 0};
+        };
+
+    std::map<std::string, Summary> summary;
+    size_t total = 0;
+        {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& allocation : m_allocations)
+            {
+            const Allocation& a = allocation.second;
+            Summary& s = summary[getKey(a)];
+            s.count++;
+            s.nbytes[static_cast<unsigned int>(a.space)] += a.nbytes;
+            total += a.nbytes;
+            }
+        }
+
+    o << "Memory usage by array:" << std::endl;
+    for (const auto& entry : summary)
+        {
+        const Summary& s = entry.second;
+        o << "  " << entry.first << ": " << s.count << " allocation(s), " << s.nbytes[0]
+          << " host bytes, " << s.nbytes[1] << " device bytes, " << s.nbytes[2]
+          << " managed bytes" << std::endl;
+        }
+    o << "Total: " << total << " bytes" << std::endl;
+    }
+
+/*! \param a The allocation
+    \returns The tag of the allocation, or "anonymous [type]" when it has no tag
+*/
+std::string MemoryTraceback::getKey(const Allocation& a)
+    {
+    if (a.tag != "")
+        return a.tag;
+
+    int status;
+    char* realname = abi::__cxa_demangle(a.type_name, 0, 0, &status);
+    std::string key = "anonymous [" + std::string(status == 0 ? realname : a.type_name) + "]";
+    free(realname);
+    return key;
+    }
+
+    } // end namespace hoomd
@@ -0,0 +1,89 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file MemoryTraceback.h
+    \brief Declares the MemoryTraceback class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __MEMORY_TRACEBACK_H__
+#define __MEMORY_TRACEBACK_H__
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+namespace hoomd
+    {
+//! Registry of the live GPUArray and GlobalArray allocations
+/*! MemoryTraceback records the size, element type, and tag of every array allocation made while it
+    is active. ExecutionConfiguration owns the registry when memory tracing is enabled, and the
+    allocation and deallocation code paths of GPUArray and GlobalArray register and unregister
+    their memory with it.
+
+    The tag names the array (see TAG_ALLOCATION), so the usage summed by tag reports which object
+    holds how many bytes. Allocations without a tag are summarized by their element type.
+
+    Allocations are identified by their starting address. Memory that was allocated before the
+    registry was created is not recorded, and unregistering an unknown address is a no-op.
+
+    All methods are thread safe.
+*/
+class MemoryTraceback
+    {
+    public:
+    //! Where an allocation resides
+    enum class Space
+        {
+        host,    //!< Host memory
+        device,  //!< Device memory
+        managed, //!< Managed memory, accessible from host and device
+        };
+
+    //! Record an allocation
+    void registerAllocation(const void* ptr,
+                            size_t nbytes,
+                            Space space,
+                            const char* type_name,
+                            const std::string& tag = std::string());
+
+    //! Remove an allocation from the registry
+    void unregisterAllocation(const void* ptr);
+
+    //! Change the tag of a recorded allocation
+    void updateTag(const void* ptr, const std::string& tag);
+
+    //! Get the total number of bytes in recorded allocations
+    size_t getTotalBytes() const;
+
+    //! Get the number of bytes in recorded allocations, summed by tag
+    std::map<std::string, size_t> getUsage() const;
+
+    //! Write a summary of the recorded allocations to a stream
+    void outputTraces(std::ostream& o) const;
+
+    private:
+    //! Data stored for each allocation
+    struct Allocation
+        {
+        size_t nbytes;         //!< Size of the allocation in bytes
+        Space space;           //!< Memory space of the allocation
+        const char* type_name; //!< Mangled name of the element type
+        std::string tag;       //!< Name of the owning array
+        };
+
+    mutable std::mutex m_mutex;                      //!< Protects m_allocations
+    std::map<const void*, Allocation> m_allocations; //!< Live allocations by address
+
+    //! Get the key that an allocation is summarized by
+    static std::string getKey(const Allocation& a);
+    };
+
+    } // end namespace hoomd
+
+#endif // __MEMORY_TRACEBACK_H__
@@ -290,6 +290,65 @@ void ParticleData::notifyParticleSort()
     m_sort_signal.emit();
     }
 
+/*! \param enable true to also store the positions and types in structure-of-arrays layout
+
+    The components are allocated for the current maximum number of particles and initialized from
+    the positions of the local and ghost particles. Disabling them releases the memory.
+*/
+void ParticleData::setPositionComponentsEnabled(bool enable)
+    {
+    if (!enable)
+        {
+        m_pos_x = GlobalArray<Scalar>();
+        m_pos_y = GlobalArray<Scalar>();
+        m_pos_z = GlobalArray<Scalar>();
+        m_type_idx = GlobalArray<unsigned int>();
+        return;
+        }
+
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        throw std::runtime_error("Position components are only available on the CPU.");
+        }
+
+    if (getPositionComponentsEnabled())
+        return;
+
+    allocatePositionComponents(std::max(m_max_nparticles, 1u));
+    updatePositionComponents(0, getN() + getNGhosts());
+    }
+
+/*! \param first Index of the first particle to copy
+    \param last One past the index of the last particle to copy
+
+    Does nothing when the structure-of-arrays copy is not enabled. The caller must not hold a handle
+    to the positions.
+*/
+void ParticleData::updatePositionComponents(unsigned int first, unsigned int last)
+    {
+    if (!getPositionComponentsEnabled() || first >= last)
+        return;
+
+    assert(last <= m_max_nparticles);
+
+    ArrayHandle<Scalar4> h_pos(m_pos, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_pos_x(m_pos_x, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_pos_y(m_pos_y, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_pos_z(m_pos_z, access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_type_idx(m_type_idx,
+                                         access_location::host,
+                                         access_mode::readwrite);
+
+    for (unsigned int i = first; i < last; ++i)
+        {
+        const Scalar4 postype = h_pos.data[i];
+        h_pos_x.data[i] = postype.x;
+        h_pos_y.data[i] = postype.y;
+        h_pos_z.data[i] = postype.z;
+        h_type_idx.data[i] = __scalar_as_int(postype.w);
+        }
+    }
+
 /*! This function is called any time the ghost particles are removed
  *
  * The rationale is that a subscriber (i.e. the Communicator) can perform clean-up for ghost
@@ -501,12 +560,37 @@ void ParticleData::allocate(unsigned int N)
     // allocate alternate particle data arrays (for swapping in-out)
     allocateAlternateArrays(N);
 
+    if (getPositionComponentsEnabled())
+        allocatePositionComponents(N);
+
     // notify observers
     m_max_particle_num_signal.emit();
 
     m_arrays_allocated = true;
     }
 
+/*! \param N Number of particles to allocate memory for
+    \post The structure-of-arrays copy of the positions is allocated, its values are undefined
+*/
+void ParticleData::allocatePositionComponents(unsigned int N)
+    {
+    GlobalArray<Scalar> pos_x(N, m_exec_conf);
+    m_pos_x.swap(pos_x);
+    TAG_ALLOCATION(m_pos_x);
+
+    GlobalArray<Scalar> pos_y(N, m_exec_conf);
+    m_pos_y.swap(pos_y);
+    TAG_ALLOCATION(m_pos_y);
+
+    GlobalArray<Scalar> pos_z(N, m_exec_conf);
+    m_pos_z.swap(pos_z);
+    TAG_ALLOCATION(m_pos_z);
+
+    GlobalArray<unsigned int> type_idx(N, m_exec_conf);
+    m_type_idx.swap(type_idx);
+    TAG_ALLOCATION(m_type_idx);
+    }
+
 /*! \param N Number of particles to allocate memory for
     \pre No memory is allocated and the alternate per-particle GPUArrays are uninitialized
     \post All alternate per-particle GPUArrays are allocated
@@ -771,6 +855,14 @@ void ParticleData::reallocate(unsigned int max_n)
 
     m_comm_flags.resize(max_n);
 
+    if (getPositionComponentsEnabled())
+        {
+        m_pos_x.resize(max_n);
+        m_pos_y.resize(max_n);
+        m_pos_z.resize(max_n);
+        m_type_idx.resize(max_n);
+        }
+
 #if defined(ENABLE_HIP) && defined(__HIP_PLATFORM_NVCC__)
     if (m_exec_conf->isCUDAEnabled() && m_exec_conf->allConcurrentManagedAccess())
         {
@@ -1348,6 +1440,8 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
     // set global number of particles
     setNGlobal(nglobal);
 
+    updatePositionComponents(0, getN());
+
     // notify listeners about resorting of local particles
     notifyParticleSort();
 
@@ -2129,6 +2223,9 @@ void ParticleData::setPosition(unsigned int tag, const Scalar3& pos, bool move)
         h_image.data[idx] = img;
         }
 
+    if (ptl_local)
+        updatePositionComponents(idx, idx + 1);
+
 #ifdef ENABLE_MPI
     if (m_decomposition && move)
         {
@@ -2349,8 +2446,12 @@ void ParticleData::setType(unsigned int tag, unsigned int typ)
 #endif
     if (found)
         {
-        ArrayHandle<Scalar4> h_pos(m_pos, access_location::host, access_mode::readwrite);
-        h_pos.data[idx].w = __int_as_scalar(typ);
+            {
+            ArrayHandle<Scalar4> h_pos(m_pos, access_location::host, access_mode::readwrite);
+            h_pos.data[idx].w = __int_as_scalar(typ);
+            }
+        updatePositionComponents(idx, idx + 1);
+
         // signal that the types have changed
         notifyParticleSort();
         }
@@ -2529,6 +2630,9 @@ unsigned int ParticleData::addParticle(unsigned int type)
         h_comm_flag.data[idx] = 0;
         }
 
+    if (m_exec_conf->getRank() == 0)
+        updatePositionComponents(getN() - 1, getN());
+
     // update global number of particles
     setNGlobal(getNGlobal() + 1);
 
@@ -2645,6 +2749,9 @@ void ParticleData::removeParticle(unsigned int tag)
             h_rtag.data[last_tag] = idx;
             }
 
+        if (idx < (size - 1))
+            updatePositionComponents(idx, idx + 1);
+
         // update particle number
         resize(getN() - 1);
         }
@@ -2684,6 +2791,39 @@ unsigned int ParticleData::getNthTag(unsigned int n)
     return m_cached_tag_set[n];
     }
 
+/*! \param ratio Ratio of allocated to required memory above which buffers are shrunk
+
+    The particle data arrays are reallocated to hold the current local and ghost particles with the
+    usual amortized resizing headroom when getMaxN() exceeds \a ratio times the number of local and
+    ghost particles.
+
+    The shrink-to-fit signal is then emitted with \a ratio so that other classes can release the
+    memory held in their own buffers.
+
+    Reallocating the arrays resets the net force, virial, and torque. The particle sort signal is
+    then emitted so that all force computes evaluate their forces again at the next compute.
+*/
+void ParticleData::shrinkToFit(Scalar ratio)
+    {
+    if (!m_arrays_allocated)
+        return;
+
+    const unsigned int n_required = std::max(getN() + getNGhosts(), 1u);
+    const unsigned int max_n = ((unsigned int)(((float)n_required) * m_resize_factor)) + 1;
+    if (Scalar(m_max_nparticles) > ratio * Scalar(n_required) && max_n < m_max_nparticles)
+        {
+        m_exec_conf->msg->notice(4) << "Shrinking particle data arrays " << m_max_nparticles
+                                    << " -> " << max_n << " ptls" << std::endl;
+        reallocate(max_n);
+
+        // reallocating resets the net force and the arrays of the force computes, flag a sort so
+        // that the forces are computed again even if they were already computed at this step
+        notifyParticleSort();
+        }
+
+    m_shrink_to_fit_signal.emit(ratio);
+    }
+
 namespace detail
     {
 void export_BoxDim(pybind11::module& m)
@@ -2774,6 +2914,7 @@ void export_ParticleData(pybind11::module& m)
         .def("setGlobalBoxL", &ParticleData::setGlobalBoxL)
         .def("setGlobalBox", setGlobalBox_overload)
         .def("getN", &ParticleData::getN)
+        .def("getMaxN", &ParticleData::getMaxN)
         .def("getNGhosts", &ParticleData::getNGhosts)
         .def("getNGlobal", &ParticleData::getNGlobal)
         .def("getNTypes", &ParticleData::getNTypes)
@@ -2814,6 +2955,8 @@ void export_ParticleData(pybind11::module& m)
         .def("addParticle", &ParticleData::addParticle)
         .def("removeParticle", &ParticleData::removeParticle)
         .def("getNthTag", &ParticleData::getNthTag)
+        .def("setPositionComponentsEnabled", &ParticleData::setPositionComponentsEnabled)
+        .def("getPositionComponentsEnabled", &ParticleData::getPositionComponentsEnabled)
 #ifdef ENABLE_MPI
         .def("setDomainDecomposition", &ParticleData::setDomainDecomposition)
         .def("getDomainDecomposition", &ParticleData::getDomainDecomposition)
@@ -3076,6 +3219,32 @@ void ParticleData::removeParticles(std::vector<detail::pdata_element>& out,
         std::fill(h_comm_flags.data, h_comm_flags.data + new_nparticles, 0);
         }
 
+    // compact the structure-of-arrays positions in place, particles only move to lower indices
+    if (getPositionComponentsEnabled())
+        {
+        ArrayHandle<unsigned int> h_tag(getTags(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(getRTags(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_pos_x(m_pos_x, access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar> h_pos_y(m_pos_y, access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar> h_pos_z(m_pos_z, access_location::host, access_mode::readwrite);
+        ArrayHandle<unsigned int> h_type_idx(m_type_idx,
+                                             access_location::host,
+                                             access_mode::readwrite);
+
+        unsigned int n = 0;
+        for (unsigned int i = 0; i < old_nparticles; ++i)
+            {
+            if (h_rtag.data[h_tag.data[i]] != NOT_LOCAL)
+                {
+                h_pos_x.data[n] = h_pos_x.data[i];
+                h_pos_y.data[n] = h_pos_y.data[i];
+                h_pos_z.data[n] = h_pos_z.data[i];
+                h_type_idx.data[n] = h_type_idx.data[i];
+                ++n;
+                }
+            }
+        }
+
     // swap particle data arrays
     swapPositions();
     swapVelocities();
@@ -3198,6 +3367,9 @@ void ParticleData::addParticles(const std::vector<detail::pdata_element>& in)
             }
         }
 
+    // append the received particles to the structure-of-arrays positions
+    updatePositionComponents(old_nparticles, new_nparticles);
+
     // notify subscribers that particle data order has been changed
     notifyParticleSort();
     }
@@ -348,6 +348,13 @@ struct pdata_element
    which is returned by getMaxN().  This size changes only infrequently (by amortized array
    resizing). Note that getMaxN() can return a higher number than the actual number of particles.
 
+    The arrays are not reallocated to a smaller size when the number of particles decreases.
+   shrinkToFit() releases the memory held beyond the current number of local and ghost particles
+   and then triggers a shrink-to-fit signal, so that other classes can release the memory held in
+   their own buffers. Subscribe to this signal with getShrinkToFitSignal(). Because reallocating
+   the arrays resets the net force, shrinkToFit() then calls notifyParticleSort() so that the
+   forces are recomputed before they are used.
+
     Particle data also stores temporary particles ('ghost atoms'). These are added after the local
    particle data (i.e. with indices starting at getN()). It keeps track of those particles using the
    addGhostParticles() and removeAllGhostParticles() methods. The caller is responsible for updating
@@ -414,6 +421,18 @@ struct pdata_element
    acceleration data is valid. When it is not valid, the integrator will compute accelerations and
    make it valid in prepRun(). When it is valid, the integrator will do nothing. On initialization
    from a snapshot, ParticleData will inherit its valid flag.
+
+    ## Structure-of-arrays positions
+
+    CPU kernels that load only some components of the positions can enable a structure-of-arrays
+   copy of them with setPositionComponentsEnabled(). ParticleData then stores the x, y, and z
+   coordinates and the type index of every local and ghost particle in separate contiguous arrays,
+   available through getPositionsX(), getPositionsY(), getPositionsZ(), and getTypeIndices(). The
+   Scalar4 positions remain the primary storage. The components move with the particles when they
+   are sorted, migrated, added, or removed, and the communicator fills them in for the ghost
+   particles it receives. Code that writes the Scalar4 positions directly calls
+   updatePositionComponents() for the range it changed; Integrator does so for all local particles
+   before it computes the forces. The components are only available on the CPU.
 */
 class PYBIND11_EXPORT ParticleData
     {
@@ -645,6 +664,42 @@ class PYBIND11_EXPORT ParticleData
         return m_body;
         }
 
+    //! Enable or disable the structure-of-arrays copy of the positions and types
+    void setPositionComponentsEnabled(bool enable);
+
+    //! Test if the structure-of-arrays copy of the positions and types is enabled
+    bool getPositionComponentsEnabled() const
+        {
+        return !m_pos_x.isNull();
+        }
+
+    //! Return x coordinates of the positions
+    const GlobalArray<Scalar>& getPositionsX() const
+        {
+        return m_pos_x;
+        }
+
+    //! Return y coordinates of the positions
+    const GlobalArray<Scalar>& getPositionsY() const
+        {
+        return m_pos_y;
+        }
+
+    //! Return z coordinates of the positions
+    const GlobalArray<Scalar>& getPositionsZ() const
+        {
+        return m_pos_z;
+        }
+
+    //! Return type indices
+    const GlobalArray<unsigned int>& getTypeIndices() const
+        {
+        return m_type_idx;
+        }
+
+    //! Copy a range of positions and types into the structure-of-arrays copy
+    void updatePositionComponents(unsigned int first, unsigned int last);
+
     /*!
      * Access methods to stand-by arrays for fast swapping in of reordered particle data
      *
@@ -861,6 +916,15 @@ class PYBIND11_EXPORT ParticleData
         return m_max_particle_num_signal;
         }
 
+    //! Connects a function to be called when memory is released by shrinkToFit()
+    /*! The slot receives the ratio of allocated to required memory above which buffers should
+        be shrunk.
+     */
+    Nano::Signal<void(Scalar ratio)>& getShrinkToFitSignal()
+        {
+        return m_shrink_to_fit_signal;
+        }
+
     //! Connects a function to be called every time the ghost particles become invalid
     Nano::Signal<void()>& getGhostParticlesRemovedSignal()
         {
@@ -1216,6 +1280,9 @@ class PYBIND11_EXPORT ParticleData
     //! Return the nth active global tag
     unsigned int getNthTag(unsigned int n);
 
+    //! Release memory held beyond the current requirements
+    void shrinkToFit(Scalar ratio);
+
     //! Translate the box origin
     /*! \param a vector to apply in the translation
      */
@@ -1269,6 +1336,8 @@ class PYBIND11_EXPORT ParticleData
                                                            //!< particles are removed
     Nano::Signal<void()> m_global_particle_num_signal; //!< Signal that is triggered when the global
                                                        //!< number of particles changes
+    Nano::Signal<void(Scalar ratio)>
+        m_shrink_to_fit_signal; //!< Signal that is triggered by shrinkToFit()
 
 #ifdef ENABLE_MPI
     Nano::Signal<void(unsigned int, unsigned int, unsigned int)>
@@ -1297,6 +1366,11 @@ class PYBIND11_EXPORT ParticleData
     GlobalArray<Scalar3> m_inertia;         //!< Principal moments of inertia for each particle
     GlobalArray<unsigned int> m_comm_flags; //!< Array of communication flags
 
+    GlobalArray<Scalar> m_pos_x;          //!< x coordinates (structure-of-arrays copy of m_pos)
+    GlobalArray<Scalar> m_pos_y;          //!< y coordinates (structure-of-arrays copy of m_pos)
+    GlobalArray<Scalar> m_pos_z;          //!< z coordinates (structure-of-arrays copy of m_pos)
+    GlobalArray<unsigned int> m_type_idx; //!< type indices (structure-of-arrays copy of m_pos)
+
     std::stack<unsigned int> m_recycled_tags; //!< Global tags of removed particles
     std::set<unsigned int> m_tag_set;         //!< Lookup table for tags by active index
     std::vector<unsigned int>
@@ -1355,6 +1429,9 @@ class PYBIND11_EXPORT ParticleData
     //! Helper function to allocate alternate particle data
     void allocateAlternateArrays(unsigned int N);
 
+    //! Helper function to allocate the structure-of-arrays copy of the positions
+    void allocatePositionComponents(unsigned int N);
+
     //! Helper function for amortized array resizing
     void resize(unsigned int new_nparticles);
 
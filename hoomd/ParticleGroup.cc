@@ -13,8 +13,13 @@
 #include <hip/hip_runtime.h>
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 #include <algorithm>
 #include <iostream>
+#include <numeric>
 using namespace std;
 
 namespace hoomd
@@ -193,7 +198,25 @@ void ParticleGroup::updateMemberTags(bool force_update)
 
         // assign all of the particles that belong to the group
         // for each particle in the (global) data
-        vector<unsigned int> member_tags = m_selector->getSelectedTags(m_sysdef);
+        vector<unsigned int> member_tags;
+        if (m_selector->hasSelectedFlags())
+            {
+            // evaluate the filter in parallel, then compact the tags of the flagged particles
+            const unsigned int N = m_pdata->getN();
+            m_selected_flags.resize(N);
+            m_selector->getSelectedFlags(m_sysdef, m_selected_flags.data());
+
+            ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                            access_location::host,
+                                            access_mode::read);
+            member_tags.resize(N);
+            member_tags.resize(
+                compactFlags(m_selected_flags.data(), N, h_tag.data, member_tags.data()));
+            }
+        else
+            {
+            member_tags = m_selector->getSelectedTags(m_sysdef);
+            }
 
 #ifdef ENABLE_MPI
         if (m_pdata->getDomainDecomposition())
@@ -204,27 +227,36 @@ void ParticleGroup::updateMemberTags(bool force_update)
 
             assert(member_tags_proc.size() == m_exec_conf->getNRanks());
 
-            // combine all tags into an ordered set
+            // combine all tags into one list, duplicates are removed below
             unsigned int n_ranks = m_exec_conf->getNRanks();
-            std::set<unsigned int> tag_set;
+            member_tags.clear();
             for (unsigned int irank = 0; irank < n_ranks; ++irank)
                 {
-                tag_set.insert(member_tags_proc[irank].begin(), member_tags_proc[irank].end());
+                member_tags.insert(member_tags.end(),
+                                   member_tags_proc[irank].begin(),
+                                   member_tags_proc[irank].end());
                 }
-
-            // construct list
-            member_tags.clear();
-            member_tags.insert(member_tags.begin(), tag_set.begin(), tag_set.end());
             }
 #endif
 
-        // store member tags in GlobalArray
-        GlobalArray<unsigned int> member_tags_array(member_tags.size(), m_pdata->getExecConf());
-        m_member_tags.swap(member_tags_array);
-        TAG_ALLOCATION(m_member_tags);
-
         // sort member tags
         std::sort(member_tags.begin(), member_tags.end());
+#ifdef ENABLE_MPI
+        if (m_pdata->getDomainDecomposition())
+            {
+            member_tags.erase(std::unique(member_tags.begin(), member_tags.end()),
+                              member_tags.end());
+            }
+#endif
+
+        // store member tags in GlobalArray, reusing the storage if the size is unchanged
+        if (m_member_tags.getNumElements() != member_tags.size())
+            {
+            GlobalArray<unsigned int> member_tags_array(member_tags.size(),
+                                                        m_pdata->getExecConf());
+            m_member_tags.swap(member_tags_array);
+            TAG_ALLOCATION(m_member_tags);
+            }
 
             {
             ArrayHandle<unsigned int> h_member_tags(m_member_tags,
@@ -233,20 +265,30 @@ void ParticleGroup::updateMemberTags(bool force_update)
             std::copy(member_tags.begin(), member_tags.end(), h_member_tags.data);
             }
 
-        GlobalArray<unsigned int> member_idx(member_tags.size(), m_pdata->getExecConf());
-        m_member_idx.swap(member_idx);
-        TAG_ALLOCATION(m_member_idx);
+        if (m_member_idx.getNumElements() != member_tags.size())
+            {
+            GlobalArray<unsigned int> member_idx(member_tags.size(), m_pdata->getExecConf());
+            m_member_idx.swap(member_idx);
+            TAG_ALLOCATION(m_member_idx);
+            }
         }
 
     // one byte per particle to indicate membership in the group, initialize with current number of
     // local particles
-    GlobalArray<unsigned int> is_member(m_pdata->getMaxN(), m_pdata->getExecConf());
-    m_is_member.swap(is_member);
-    TAG_ALLOCATION(m_is_member);
+    if (m_is_member.getNumElements() != m_pdata->getMaxN())
+        {
+        GlobalArray<unsigned int> is_member(m_pdata->getMaxN(), m_pdata->getExecConf());
+        m_is_member.swap(is_member);
+        TAG_ALLOCATION(m_is_member);
+        }
 
-    GlobalArray<unsigned int> is_member_tag(m_pdata->getRTags().size(), m_pdata->getExecConf());
-    m_is_member_tag.swap(is_member_tag);
-    TAG_ALLOCATION(m_is_member_tag);
+    if (m_is_member_tag.getNumElements() != m_pdata->getRTags().size())
+        {
+        GlobalArray<unsigned int> is_member_tag(m_pdata->getRTags().size(),
+                                                m_pdata->getExecConf());
+        m_is_member_tag.swap(is_member_tag);
+        TAG_ALLOCATION(m_is_member_tag);
+        }
 
     // build the reverse lookup table for tags
     buildTagHash();
@@ -520,11 +562,89 @@ void ParticleGroup::buildTagHash()
     // reset member ship flags
     memset(h_is_member_tag.data, 0, sizeof(unsigned int) * (m_pdata->getRTags().size()));
 
-    size_t num_members = m_member_tags.getNumElements();
-    for (size_t member = 0; member < num_members; member++)
+    // member tags are unique, so each flag is written by only one member
+    unsigned int num_members = (unsigned int)m_member_tags.getNumElements();
+    auto flag_member = [&](unsigned int member)
+    { h_is_member_tag.data[h_member_tags.data[member]] = 1; };
+
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&] { tbb::parallel_for((unsigned int)0, num_members, flag_member); });
+#else
+    for (unsigned int member = 0; member < num_members; member++)
+        flag_member(member);
+#endif
+    }
+
+/*! \param flags Flag for each entry, nonzero if the entry is kept
+    \param N Number of entries
+    \param values Value to store for each kept entry, or NULL to store the entry index
+    \param out List of kept values in index order, with space for up to \a N entries
+    \returns Number of entries kept
+
+    With TBB, each thread counts the flags in a contiguous range of entries, and the ranges are then
+    written at the prefix sum of the counts so that the order matches the serial compaction.
+*/
+unsigned int ParticleGroup::compactFlags(const unsigned int* flags,
+                                         unsigned int N,
+                                         const unsigned int* values,
+                                         unsigned int* out)
+    {
+    auto compact_range = [&](unsigned int first, unsigned int last, unsigned int offset)
+    {
+        for (unsigned int idx = first; idx < last; ++idx)
+            {
+            if (flags[idx])
+                {
+                out[offset++] = (values) ? values[idx] : idx;
+                }
+            }
+        return offset;
+    };
+
+#ifdef ENABLE_TBB
+    const unsigned int n_chunks = std::min(m_exec_conf->getNumThreads(), N);
+    if (n_chunks > 1)
         {
-        h_is_member_tag.data[h_member_tags.data[member]] = 1;
+        m_chunk_counts.resize(n_chunks + 1);
+        m_chunk_counts[0] = 0;
+        auto chunk_begin = [&](unsigned int chunk)
+        { return (unsigned int)(size_t(N) * chunk / n_chunks); };
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for((unsigned int)0,
+                                  n_chunks,
+                                  [&](unsigned int chunk)
+                                  {
+                                      const unsigned int first = chunk_begin(chunk);
+                                      const unsigned int last = chunk_begin(chunk + 1);
+                                      m_chunk_counts[chunk + 1]
+                                          = (unsigned int)std::count_if(flags + first,
+                                                                        flags + last,
+                                                                        [](unsigned int f)
+                                                                        { return f != 0; });
+                                  });
+            });
+        std::partial_sum(m_chunk_counts.begin(), m_chunk_counts.end(), m_chunk_counts.begin());
+
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for((unsigned int)0,
+                                  n_chunks,
+                                  [&](unsigned int chunk)
+                                  {
+                                      compact_range(chunk_begin(chunk),
+                                                    chunk_begin(chunk + 1),
+                                                    m_chunk_counts[chunk]);
+                                  });
+            });
+        return m_chunk_counts[n_chunks];
         }
+#endif
+
+    return compact_range(0, N, 0);
     }
 
 /*! \pre m_member_tags has been filled out, listing all particle tags in the group
@@ -560,20 +680,21 @@ void ParticleGroup::rebuildIndexList()
                                                access_location::host,
                                                access_mode::readwrite);
         unsigned int nparticles = m_pdata->getN();
-        unsigned int cur_member = 0;
-        for (unsigned int idx = 0; idx < nparticles; idx++)
-            {
+        auto flag_particle = [&](unsigned int idx)
+        {
             assert(h_tag.data[idx] <= m_pdata->getMaximumTag());
-            unsigned int is_member = h_is_member_tag.data[h_tag.data[idx]];
-            h_is_member.data[idx] = is_member;
-            if (is_member)
-                {
-                h_member_idx.data[cur_member] = idx;
-                cur_member++;
-                }
-            }
+            h_is_member.data[idx] = h_is_member_tag.data[h_tag.data[idx]];
+        };
+
+#ifdef ENABLE_TBB
+        m_exec_conf->getTaskArena()->execute(
+            [&] { tbb::parallel_for((unsigned int)0, nparticles, flag_particle); });
+#else
+        for (unsigned int idx = 0; idx < nparticles; idx++)
+            flag_particle(idx);
+#endif
 
-        m_num_local_members = cur_member;
+        m_num_local_members = compactFlags(h_is_member.data, nparticles, NULL, h_member_idx.data);
         assert(m_num_local_members <= m_member_tags.getNumElements());
         }
 
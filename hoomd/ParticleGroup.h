@@ -320,6 +320,12 @@ class PYBIND11_EXPORT ParticleGroup
     /// Number of central and free particles in the group (global)
     unsigned int m_n_central_and_free_global = 0;
 
+    /// Selection flags by local index from the filter, reused between rebuilds
+    std::vector<unsigned int> m_selected_flags;
+
+    /// Exclusive prefix sum of the flags in each thread's range during compaction
+    std::vector<unsigned int> m_chunk_counts;
+
     //! Helper function to resize array of member tags
     void reallocate();
 
@@ -377,6 +383,12 @@ class PYBIND11_EXPORT ParticleGroup
     //! Helper function to build the 1:1 hash for tag membership
     void buildTagHash();
 
+    //! Helper function to compact the flagged entries of a list in index order
+    unsigned int compactFlags(const unsigned int* flags,
+                              unsigned int N,
+                              const unsigned int* values,
+                              unsigned int* out);
+
 #ifdef ENABLE_HIP
     //! Helper function to rebuild the index lists after the particles have been sorted
     void rebuildIndexListGPU();
@@ -70,6 +70,8 @@ struct RNGIdentifier
     static const uint8_t HPMCShapeMoveUpdateOrder = 44;
     static const uint8_t BussiThermostat = 45;
     static const uint8_t ConstantPressure = 46;
+    static const uint8_t HPMCMonoChainCheckerboard = 47;
+    static const uint8_t MeshGeometryFiller = 48;
     };
 
     } // namespace hoomd
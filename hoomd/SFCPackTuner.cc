@@ -277,6 +277,43 @@ void SFCPackTuner::applySortOrder()
         h_rtag.data[h_tag.data[i]] = i;
         }
 
+    // sort the structure-of-arrays positions and types
+    if (m_pdata->getPositionComponentsEnabled())
+        {
+        ArrayHandle<Scalar> h_pos_x(m_pdata->getPositionsX(),
+                                    access_location::host,
+                                    access_mode::readwrite);
+        ArrayHandle<Scalar> h_pos_y(m_pdata->getPositionsY(),
+                                    access_location::host,
+                                    access_mode::readwrite);
+        ArrayHandle<Scalar> h_pos_z(m_pdata->getPositionsZ(),
+                                    access_location::host,
+                                    access_mode::readwrite);
+        ArrayHandle<unsigned int> h_type_idx(m_pdata->getTypeIndices(),
+                                             access_location::host,
+                                             access_mode::readwrite);
+
+        for (unsigned int i = 0; i < m_pdata->getN(); i++)
+            scal_tmp[i] = h_pos_x.data[m_sort_order[i]];
+        for (unsigned int i = 0; i < m_pdata->getN(); i++)
+            h_pos_x.data[i] = scal_tmp[i];
+
+        for (unsigned int i = 0; i < m_pdata->getN(); i++)
+            scal_tmp[i] = h_pos_y.data[m_sort_order[i]];
+        for (unsigned int i = 0; i < m_pdata->getN(); i++)
+            h_pos_y.data[i] = scal_tmp[i];
+
+        for (unsigned int i = 0; i < m_pdata->getN(); i++)
+            scal_tmp[i] = h_pos_z.data[m_sort_order[i]];
+        for (unsigned int i = 0; i < m_pdata->getN(); i++)
+            h_pos_z.data[i] = scal_tmp[i];
+
+        for (unsigned int i = 0; i < m_pdata->getN(); i++)
+            uint_tmp[i] = h_type_idx.data[m_sort_order[i]];
+        for (unsigned int i = 0; i < m_pdata->getN(); i++)
+            h_type_idx.data[i] = uint_tmp[i];
+        }
+
     delete[] scal_tmp;
     delete[] scal4_tmp;
     delete[] scal3_tmp;
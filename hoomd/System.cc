@@ -100,6 +100,19 @@ void System::run(uint64_t nsteps, bool write_at_start)
         }
 #endif
 
+    // release memory held beyond the current requirements, shrinkToFit flags the forces for
+    // recomputation in prepRun
+    if (m_shrink_to_fit_ratio > Scalar(0))
+        {
+        m_sysdef->getParticleData()->shrinkToFit(m_shrink_to_fit_ratio);
+        }
+
+    // report the memory held by each array on the root rank
+    if (m_exec_conf->getMemoryTraceback())
+        {
+        m_exec_conf->getMemoryTraceback()->outputTraces(m_exec_conf->msg->notice(4));
+        }
+
     if (m_update_group_dof_next_step)
         {
         updateGroupDOF();
@@ -279,6 +292,8 @@ void export_System(pybind11::module& m)
         .def("getCurrentTimeStep", &System::getCurrentTimeStep)
         .def("setPressureFlag", &System::setPressureFlag)
         .def("getPressureFlag", &System::getPressureFlag)
+        .def("setShrinkToFitRatio", &System::setShrinkToFitRatio)
+        .def("getShrinkToFitRatio", &System::getShrinkToFitRatio)
         .def_property_readonly("walltime", &System::getCurrentWalltime)
         .def_property_readonly("final_timestep", &System::getEndStep)
         .def_property_readonly("initial_timestep", &System::getStartStep)
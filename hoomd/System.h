@@ -8,6 +8,7 @@
 #include "Updater.h"
 
 #include <map>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -176,6 +177,22 @@ class PYBIND11_EXPORT System
         return m_default_flags[pdata_flag::pressure_tensor];
         }
 
+    /// Set the ratio of allocated to required memory above which buffers are shrunk (0: never).
+    void setShrinkToFitRatio(Scalar ratio)
+        {
+        if (ratio != Scalar(0) && ratio < Scalar(1))
+            {
+            throw std::domain_error("The shrink to fit ratio must be 0 or at least 1.");
+            }
+        m_shrink_to_fit_ratio = ratio;
+        }
+
+    /// Get the ratio of allocated to required memory above which buffers are shrunk.
+    Scalar getShrinkToFitRatio() const
+        {
+        return m_shrink_to_fit_ratio;
+        }
+
     /// Get the particle group cache.
     std::vector<std::shared_ptr<ParticleGroup>>& getGroupCache()
         {
@@ -245,6 +262,9 @@ class PYBIND11_EXPORT System
 
     /// Flag to trigger update of group degrees of freedom
     bool m_update_group_dof_next_step = false;
+
+    /// Shrink buffers at the start of each run when over this ratio of allocated to required memory
+    Scalar m_shrink_to_fit_ratio = 0;
     };
 
 namespace detail
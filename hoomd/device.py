@@ -249,6 +249,46 @@ class Device:
         else:
             self._cpp_exec_conf.setNumThreads(int(num_cpu_threads))
 
+    @property
+    def memory_traceback(self):
+        """bool: Record the memory held by each array (defaults to ``False``).
+
+        When `True`, HOOMD records the size and owner of every array it
+        allocates. Only arrays allocated after `memory_traceback` is set are
+        recorded, so set it before creating the simulation state. Setting
+        `memory_traceback` to `False` discards the records. When
+        `notice_level` is 4 or greater, `hoomd.Simulation.run` writes a summary
+        of the recorded memory at the start of each run.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            device.memory_traceback = True
+        """
+        return self._cpp_exec_conf.memoryTracingEnabled()
+
+    @memory_traceback.setter
+    def memory_traceback(self, enable):
+        self._cpp_exec_conf.setMemoryTracing(bool(enable))
+
+    @property
+    def memory_usage(self):
+        """dict[str, int]: Bytes held by each array on this rank.
+
+        The keys name the owning array and the values are the number of bytes
+        it holds in host, device, or managed memory. Arrays without a name are
+        summed by element type under ``'anonymous [type]'``. Empty when
+        `memory_traceback` is `False`.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            total_bytes = sum(device.memory_usage.values())
+        """
+        return self._cpp_exec_conf.getMemoryUsage()
+
     def notice(self, message, level=1):
         """Write a notice message.
 
@@ -6,8 +6,13 @@
 #include "../SystemDefinition.h"
 #include <memory>
 #include <pybind11/pybind11.h>
+#include <stdexcept>
 #include <vector>
 
+#ifdef ENABLE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 namespace hoomd
     {
 /// Utility class to select particles based on given conditions
@@ -31,6 +36,12 @@ namespace hoomd
     rank.
 
     The base class getSelectedTags() method returns an empty vector.
+
+    Filters that decide membership from the data of each particle alone can
+    also implement getSelectedFlags(), which flags the selected local particles
+    by index. The flags are evaluated in parallel over the particles, and
+    ParticleGroup prefers them over getSelectedTags() when
+    hasSelectedFlags() is true.
 */
 class PYBIND11_EXPORT ParticleFilter
     {
@@ -47,6 +58,59 @@ class PYBIND11_EXPORT ParticleFilter
         {
         return std::vector<unsigned int>();
         }
+
+    /// Test if the filter implements getSelectedFlags()
+    virtual bool hasSelectedFlags() const
+        {
+        return false;
+        }
+
+    /** Flag the rank local particles that meet the selection criteria.
+     *  sysdef: system definition to find flags for
+     *  flags: set to 1 for selected particles and 0 otherwise, indexed by
+     *  local particle index and with space for at least N particles
+     *
+     *  The base case throws, because it does not have a per-particle test.
+     */
+    virtual void getSelectedFlags(std::shared_ptr<SystemDefinition> sysdef,
+                                  unsigned int* flags) const
+        {
+        throw std::runtime_error("ParticleFilter does not support per-particle selection.");
+        }
+
+    protected:
+    /** Evaluate a predicate on each rank local particle in parallel.
+     *  sysdef: system definition to find flags for
+     *  flags: set to 1 where the predicate is true and 0 otherwise
+     *  predicate: callable taking the local particle index
+     */
+    template<class Predicate>
+    static void evaluateFlags(std::shared_ptr<SystemDefinition> sysdef,
+                              unsigned int* flags,
+                              const Predicate& predicate)
+        {
+        const auto pdata = sysdef->getParticleData();
+        const unsigned int N = pdata->getN();
+        auto evaluate_range = [&](unsigned int first, unsigned int last)
+        {
+            for (unsigned int idx = first; idx < last; ++idx)
+                {
+                flags[idx] = predicate(idx) ? 1 : 0;
+                }
+        };
+
+#ifdef ENABLE_TBB
+        pdata->getExecConf()->getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+                                  [&](const tbb::blocked_range<unsigned int>& r)
+                                  { evaluate_range(r.begin(), r.end()); });
+            });
+#else
+        evaluate_range(0, N);
+#endif
+        }
     };
 
     } // end namespace hoomd
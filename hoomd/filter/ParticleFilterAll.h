@@ -5,6 +5,7 @@
 #define __PARTICLE_FILTER_ALL_H__
 
 #include "ParticleFilter.h"
+#include <algorithm>
 
 namespace hoomd
     {
@@ -38,6 +39,21 @@ class PYBIND11_EXPORT ParticleFilterAll : public ParticleFilter
         std::copy_n(h_tag.data, N, member_tags.begin());
         return member_tags;
         }
+
+    virtual bool hasSelectedFlags() const
+        {
+        return true;
+        }
+
+    /** Args:
+     *  sysdef: the System Definition
+     *  flags: set to 1 for all particles in the local rank
+     */
+    virtual void getSelectedFlags(std::shared_ptr<SystemDefinition> sysdef,
+                                  unsigned int* flags) const
+        {
+        std::fill_n(flags, sysdef->getParticleData()->getN(), 1);
+        }
     };
 
     } // end namespace hoomd
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "ParticleFilter.h"
+#include <algorithm>
 
 namespace hoomd
     {
@@ -27,6 +28,21 @@ class PYBIND11_EXPORT ParticleFilterNull : public ParticleFilter
         std::vector<unsigned int> member_tags;
         return member_tags;
         }
+
+    virtual bool hasSelectedFlags() const
+        {
+        return true;
+        }
+
+    /** Args:
+     *  sysdef: the System Definition
+     *  flags: set to 0 for all particles in the local rank
+     */
+    virtual void getSelectedFlags(std::shared_ptr<SystemDefinition> sysdef,
+                                  unsigned int* flags) const
+        {
+        std::fill_n(flags, sysdef->getParticleData()->getN(), 0);
+        }
     };
 
     } // end namespace hoomd
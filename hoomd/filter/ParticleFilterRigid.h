@@ -95,21 +95,7 @@ class PYBIND11_EXPORT ParticleFilterRigid : public ParticleFilter
             unsigned int body = h_body.data[idx];
 
             // see if it matches the criteria
-            bool include_particle = false;
-            if (toBool(m_current_selection & RigidBodySelection::CENTERS))
-                {
-                include_particle = include_particle || (tag == body);
-                }
-            if (toBool(m_current_selection & RigidBodySelection::CONSTITUENT))
-                {
-                include_particle = include_particle || (body < MIN_FLOPPY && body != tag);
-                }
-            if (toBool(m_current_selection & RigidBodySelection::FREE))
-                {
-                include_particle = include_particle || (body == NO_BODY);
-                }
-
-            if (include_particle)
+            if (isSelected(tag, body))
                 {
                 member_tags.push_back(tag);
                 }
@@ -117,7 +103,47 @@ class PYBIND11_EXPORT ParticleFilterRigid : public ParticleFilter
         return member_tags;
         }
 
+    virtual bool hasSelectedFlags() const
+        {
+        return true;
+        }
+
+    virtual void getSelectedFlags(std::shared_ptr<SystemDefinition> sysdef,
+                                  unsigned int* flags) const
+        {
+        auto pdata = sysdef->getParticleData();
+
+        ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_body(pdata->getBodies(),
+                                         access_location::host,
+                                         access_mode::read);
+
+        evaluateFlags(sysdef,
+                      flags,
+                      [&](unsigned int idx)
+                      { return isSelected(h_tag.data[idx], h_body.data[idx]); });
+        }
+
     private:
+    /// Test if a particle with the given tag and body meets the selection criteria
+    bool isSelected(unsigned int tag, unsigned int body) const
+        {
+        bool include_particle = false;
+        if (toBool(m_current_selection & RigidBodySelection::CENTERS))
+            {
+            include_particle = include_particle || (tag == body);
+            }
+        if (toBool(m_current_selection & RigidBodySelection::CONSTITUENT))
+            {
+            include_particle = include_particle || (body < MIN_FLOPPY && body != tag);
+            }
+        if (toBool(m_current_selection & RigidBodySelection::FREE))
+            {
+            include_particle = include_particle || (body == NO_BODY);
+            }
+        return include_particle;
+        }
+
     /// Current selection of particles to chose from rigid body center, constituent particles,
     /// and free bodies.
     RigidBodySelection m_current_selection;
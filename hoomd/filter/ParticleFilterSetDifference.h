@@ -6,10 +6,11 @@
 
 #include "ParticleFilter.h"
 #include <algorithm>
+#include <vector>
 
 namespace hoomd
     {
-/// Takes the set difference of two other filters
+    /// Takes the set difference of two other filters
 class PYBIND11_EXPORT ParticleFilterSetDifference : public ParticleFilter
     {
     public:
@@ -51,9 +52,32 @@ class PYBIND11_EXPORT ParticleFilterSetDifference : public ParticleFilter
         return tags;
         }
 
+    virtual bool hasSelectedFlags() const
+        {
+        return m_f->hasSelectedFlags() && m_g->hasSelectedFlags();
+        }
+
+    /** Flag the rank local particles that are in filter m_f but not in filter m_g
+     *  sysdef: the System Definition
+     *  flags: set to 1 for selected particles and 0 otherwise
+     */
+    virtual void getSelectedFlags(std::shared_ptr<SystemDefinition> sysdef,
+                                  unsigned int* flags) const
+        {
+        m_g_flags.resize(sysdef->getParticleData()->getN());
+        m_f->getSelectedFlags(sysdef, flags);
+        m_g->getSelectedFlags(sysdef, m_g_flags.data());
+        evaluateFlags(sysdef,
+                      flags,
+                      [&](unsigned int idx) { return flags[idx] && !m_g_flags[idx]; });
+        }
+
     protected:
     std::shared_ptr<ParticleFilter> m_f;
     std::shared_ptr<ParticleFilter> m_g;
+
+    /// Particles selected by m_g, kept between calls to getSelectedFlags()
+    mutable std::vector<unsigned int> m_g_flags;
     };
 
     } // end namespace hoomd
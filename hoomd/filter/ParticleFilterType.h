@@ -69,6 +69,40 @@ class PYBIND11_EXPORT ParticleFilterType : public ParticleFilter
         return member_tags;
         }
 
+    virtual bool hasSelectedFlags() const
+        {
+        return true;
+        }
+
+    /** Flag the particles of types in m_types
+     *  sysdef: system definition to find flags for
+     *  flags: set to 1 for selected particles and 0 otherwise
+     */
+    virtual void getSelectedFlags(std::shared_ptr<SystemDefinition> sysdef,
+                                  unsigned int* flags) const
+        {
+        const auto pdata = sysdef->getParticleData();
+        const ArrayHandle<Scalar4> h_postype(pdata->getPositions(),
+                                             access_location::host,
+                                             access_mode::read);
+
+        // lookup table by type index, so that the test is a load per particle
+        const unsigned int n_types = pdata->getNTypes();
+        std::vector<unsigned int> selected(n_types, 0);
+        for (auto type_str : m_types)
+            {
+            selected[pdata->getTypeByName(type_str)] = 1;
+            }
+
+        evaluateFlags(sysdef,
+                      flags,
+                      [&](unsigned int idx)
+                      {
+                          const unsigned int typ = __scalar_as_int(h_postype.data[idx].w);
+                          return typ < n_types && selected[typ];
+                      });
+        }
+
     protected:
     std::unordered_set<std::string> m_types; ///< Set of types to select
     };
@@ -23,6 +23,7 @@
 
 #ifndef __HIPCC__
 #include <sstream>
+#include <vector>
 #endif
 
 #include "hoomd/ManagedArray.h"
@@ -40,6 +41,12 @@ class GPUTree
     //! Empty constructor
     HOSTDEVICE GPUTree() : m_num_nodes(0), m_num_leaves(0), m_leaf_capacity(0) { }
 
+    //! Number of children per node in the collapsed (wide) tree
+    static constexpr unsigned int wide_width = 4;
+
+    //! Number of ShortReal fields per child in the wide node layout (center, lengths, rotation)
+    static constexpr unsigned int wide_fields = 15;
+
 #ifndef __HIPCC__
     //! Constructor
     /*! \param tree OBBTree to construct from
@@ -109,6 +116,8 @@ class GPUTree
 
         // recursively initialize ancestor indices
         initializeAncestorCounts(0, tree, 0);
+
+        initializeWideNodes();
         }
 #endif
 
@@ -134,6 +143,194 @@ class GPUTree
 
         m_ancestors[idx] = ancestors;
         }
+
+    //! Initialize the collapsed, four-wide node layout used by the CPU tandem traversal
+    /*! Every internal node stores the OBBs of its grandchildren (or of its children, if those are
+        leaves) in structure-of-arrays layout, so that one query OBB can be tested against all of
+        them in a single loop over lanes. Unused lanes have a zero mask and never overlap.
+     */
+    void initializeWideNodes()
+        {
+        m_wide_child = ManagedArray<unsigned int>(m_num_nodes * wide_width, false);
+        m_wide_mask = ManagedArray<unsigned int>(m_num_nodes * wide_width, false);
+        m_wide_is_sphere = ManagedArray<unsigned int>(m_num_nodes * wide_width, false);
+        m_wide_obb = ManagedArray<ShortReal>(m_num_nodes * wide_width * wide_fields, false);
+
+        for (unsigned int i = 0; i < m_num_nodes * wide_width; ++i)
+            {
+            m_wide_child[i] = OBB_INVALID_NODE;
+            m_wide_mask[i] = 0;
+            m_wide_is_sphere[i] = 0;
+            }
+        for (unsigned int i = 0; i < m_num_nodes * wide_width * wide_fields; ++i)
+            m_wide_obb[i] = ShortReal(0.0);
+
+        for (unsigned int node = 0; node < m_num_nodes; ++node)
+            {
+            if (isLeaf(node))
+                continue;
+
+            unsigned int children[2];
+            children[0] = m_left[node];
+            children[1] = m_escape[children[0]];
+
+            unsigned int n_lanes = 0;
+            for (unsigned int c = 0; c < 2; ++c)
+                {
+                if (isLeaf(children[c]))
+                    {
+                    setWideChild(node, n_lanes++, children[c]);
+                    }
+                else
+                    {
+                    unsigned int left = m_left[children[c]];
+                    setWideChild(node, n_lanes++, left);
+                    setWideChild(node, n_lanes++, m_escape[left]);
+                    }
+                }
+            }
+        }
+
+    //! Store the OBB of a tree node in a lane of a wide node
+    void setWideChild(unsigned int node, unsigned int lane, unsigned int child)
+        {
+        const OBB obb = getOBB(child);
+        const rotmat3<ShortReal> r(obb.rotation);
+        const ShortReal fields[wide_fields] = {obb.center.x,
+                                               obb.center.y,
+                                               obb.center.z,
+                                               obb.lengths.x,
+                                               obb.lengths.y,
+                                               obb.lengths.z,
+                                               r.row0.x,
+                                               r.row0.y,
+                                               r.row0.z,
+                                               r.row1.x,
+                                               r.row1.y,
+                                               r.row1.z,
+                                               r.row2.x,
+                                               r.row2.y,
+                                               r.row2.z};
+
+        m_wide_child[node * wide_width + lane] = child;
+        m_wide_mask[node * wide_width + lane] = obb.mask;
+        m_wide_is_sphere[node * wide_width + lane] = obb.is_sphere;
+        for (unsigned int f = 0; f < wide_fields; ++f)
+            m_wide_obb[(node * wide_fields + f) * wide_width + lane] = fields[f];
+        }
+
+    //! Test a query OBB against all children of a wide node at once
+    /*! \param node Internal node of the tree
+        \param obb Query OBB, in the body frame of this tree
+        \returns A bit mask with bit i set if the child in lane i overlaps the query
+
+        The lane loop is free of branches and early exits so that the compiler can evaluate all
+        separating axis tests of the lanes in SIMD registers. Apart from the epsilon padding, the
+        result is identical to overlap(child, obb) for every lane.
+     */
+    inline unsigned int overlapWideNode(unsigned int node, const OBB& obb) const
+        {
+        const ShortReal* p = m_wide_obb.get() + node * wide_fields * wide_width;
+        const unsigned int* lane_mask = m_wide_mask.get() + node * wide_width;
+        const unsigned int* lane_is_sphere = m_wide_is_sphere.get() + node * wide_width;
+
+        const ShortReal eps(ShortReal(1e-6));
+        const rotmat3<ShortReal> rq(obb.rotation);
+        const ShortReal mq[3][3] = {{rq.row0.x, rq.row0.y, rq.row0.z},
+                                    {rq.row1.x, rq.row1.y, rq.row1.z},
+                                    {rq.row2.x, rq.row2.y, rq.row2.z}};
+        const ShortReal b[3] = {obb.lengths.x, obb.lengths.y, obb.lengths.z};
+        const ShortReal cq[3] = {obb.center.x, obb.center.y, obb.center.z};
+        const unsigned int query_is_sphere = obb.is_sphere;
+
+        unsigned int result = 0;
+        for (unsigned int lane = 0; lane < wide_width; ++lane)
+            {
+            ShortReal m[3][3];
+            for (unsigned int j = 0; j < 3; ++j)
+                for (unsigned int k = 0; k < 3; ++k)
+                    m[j][k] = p[(6 + 3 * j + k) * wide_width + lane];
+
+            const ShortReal a[3]
+                = {p[3 * wide_width + lane], p[4 * wide_width + lane], p[5 * wide_width + lane]};
+            const ShortReal d[3] = {cq[0] - p[lane],
+                                    cq[1] - p[wide_width + lane],
+                                    cq[2] - p[2 * wide_width + lane]};
+
+            // translation and relative rotation in the frame of the lane
+            ShortReal t[3], u[3];
+            ShortReal r[3][3], rabs[3][3];
+            for (unsigned int j = 0; j < 3; ++j)
+                {
+                t[j] = m[0][j] * d[0] + m[1][j] * d[1] + m[2][j] * d[2];
+                u[j] = -(mq[0][j] * d[0] + mq[1][j] * d[1] + mq[2][j] * d[2]);
+                for (unsigned int k = 0; k < 3; ++k)
+                    {
+                    r[j][k] = m[0][j] * mq[0][k] + m[1][j] * mq[1][k] + m[2][j] * mq[2][k];
+                    rabs[j][k] = fabs(r[j][k]) + eps;
+                    }
+                }
+
+            // separating axis test of two boxes
+            bool separated = false;
+            for (unsigned int j = 0; j < 3; ++j)
+                {
+                // axes of the lane box
+                separated |= fabs(t[j])
+                             > a[j] + b[0] * rabs[j][0] + b[1] * rabs[j][1] + b[2] * rabs[j][2];
+
+                // axes of the query box
+                separated |= fabs(t[0] * r[0][j] + t[1] * r[1][j] + t[2] * r[2][j])
+                             > a[0] * rabs[0][j] + a[1] * rabs[1][j] + a[2] * rabs[2][j] + b[j];
+                }
+            for (unsigned int i = 0; i < 3; ++i)
+                {
+                const unsigned int i1 = (i + 1) % 3;
+                const unsigned int i2 = (i + 2) % 3;
+                for (unsigned int k = 0; k < 3; ++k)
+                    {
+                    const unsigned int k1 = (k + 1) % 3;
+                    const unsigned int k2 = (k + 2) % 3;
+                    const ShortReal ra = a[i1] * rabs[i2][k] + a[i2] * rabs[i1][k];
+                    const ShortReal rb = b[k1] * rabs[i][k2] + b[k2] * rabs[i][k1];
+                    separated |= fabs(t[i2] * r[i1][k] - t[i1] * r[i2][k]) > ra + rb;
+                    }
+                }
+            const bool box_box = !separated;
+
+            // sphere tests, squared distance of a center to the other box
+            ShortReal dsq = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+            ShortReal excess_lane_sq(0.0), excess_query_sq(0.0);
+            for (unsigned int j = 0; j < 3; ++j)
+                {
+                // query center relative to lane box
+                const ShortReal el = std::max(fabs(t[j]) - a[j], ShortReal(0.0));
+                excess_lane_sq += el * el;
+
+                // lane center relative to query box
+                const ShortReal eq = std::max(fabs(u[j]) - b[j], ShortReal(0.0));
+                excess_query_sq += eq * eq;
+                }
+            const bool sphere_sphere = dsq <= (a[0] + b[0]) * (a[0] + b[0]);
+            const bool lane_sphere_box = excess_query_sq <= a[0] * a[0];
+            const bool box_query_sphere = excess_lane_sq <= b[0] * b[0];
+
+            const bool lane_sphere = lane_is_sphere[lane];
+            const bool overlap_lane
+                = lane_sphere ? (query_is_sphere ? sphere_sphere : lane_sphere_box)
+                              : (query_is_sphere ? box_query_sphere : box_box);
+
+            result |= (unsigned int)((lane_mask[lane] & obb.mask) && overlap_lane) << lane;
+            }
+
+        return result;
+        }
+
+    //! Return the node stored in a lane of a wide node
+    inline unsigned int getWideChild(unsigned int node, unsigned int lane) const
+        {
+        return m_wide_child[node * wide_width + lane];
+        }
 #endif
 
     //! Fetch the next node in the tree and test against overlap
@@ -358,6 +555,11 @@ class GPUTree
     ManagedArray<unsigned int> m_escape;    //!< Escape indices
     ManagedArray<unsigned int> m_ancestors; //!< Number of right-most ancestors
 
+    ManagedArray<unsigned int> m_wide_child;     //!< Children of the wide nodes (host only)
+    ManagedArray<unsigned int> m_wide_mask;      //!< OBB masks of the wide node children
+    ManagedArray<unsigned int> m_wide_is_sphere; //!< Sphere flags of the wide node children
+    ManagedArray<ShortReal> m_wide_obb;          //!< OBBs of the wide node children (SoA)
+
     unsigned int m_num_nodes;     //!< Number of nodes in the tree
     unsigned int m_num_leaves;    //!< Number of leaf nodes
     unsigned int m_leaf_capacity; //!< Capacity of OBB leaf nodes
@@ -639,6 +841,145 @@ DEVICE inline bool traverseBinaryStackIntersection(const GPUTree& a,
     return leaf;
     }
 
+#ifndef __HIPCC__
+//! Traverse a pair of subtrees in tandem with a fixed-size stack
+/*! Returns true if narrow_phase returned true for any pair of overlapping leaf nodes
+ * \param a First tree
+ * \param b Second tree
+ * \param q Rotation of a's body frame into b's body frame
+ * \param dr Translation of a's body frame in b's body frame
+ * \param q_inv Rotation of b's body frame into a's body frame
+ * \param dr_inv Translation of b's body frame in a's body frame
+ * \param root_a Root of the subtree in a, its OBB must overlap the one of root_b
+ * \param root_b Root of the subtree in b
+ * \param narrow_phase Callable (node_a, node_b) -> bool testing a pair of leaf nodes
+ *
+ * Every step replaces one pair by up to four pairs one or two levels further down, so the stack
+ * needs 3 * (height_a + height_b) + 1 entries. Pairs that do not fit on the stack are traversed by
+ * a recursive call with a stack of its own, so the traversal never allocates memory.
+ */
+template<class NarrowPhase>
+inline bool traverseWideStackFrom(const GPUTree& a,
+                                  const GPUTree& b,
+                                  const quat<ShortReal>& q,
+                                  const vec3<ShortReal>& dr,
+                                  const quat<ShortReal>& q_inv,
+                                  const vec3<ShortReal>& dr_inv,
+                                  unsigned int root_a,
+                                  unsigned int root_b,
+                                  const NarrowPhase& narrow_phase)
+    {
+    const unsigned int max_stack_size = 64;
+    unsigned int stack[2 * max_stack_size];
+
+    unsigned int stack_size = 0;
+    stack[2 * stack_size] = root_a;
+    stack[2 * stack_size + 1] = root_b;
+    stack_size++;
+
+    while (stack_size > 0)
+        {
+        stack_size--;
+        const unsigned int node_a = stack[2 * stack_size];
+        const unsigned int node_b = stack[2 * stack_size + 1];
+
+        const bool leaf_a = a.isLeaf(node_a);
+        const bool leaf_b = b.isLeaf(node_b);
+        if (leaf_a && leaf_b)
+            {
+            if (narrow_phase(node_a, node_b))
+                return true;
+            continue;
+            }
+
+        OBB obb_a = a.getOBB(node_a);
+        obb_a.affineTransform(q, dr);
+        OBB obb_b = b.getOBB(node_b);
+
+        // descend into subtree with larger volume first (unless there are no children)
+        const bool descend_A = obb_a.getVolume() > obb_b.getVolume() ? !leaf_a : leaf_b;
+
+        unsigned int hits;
+        if (descend_A)
+            {
+            obb_b.affineTransform(q_inv, dr_inv);
+            hits = a.overlapWideNode(node_a, obb_b);
+            }
+        else
+            {
+            hits = b.overlapWideNode(node_b, obb_a);
+            }
+
+        // push in reverse order so that the left-most child is visited first
+        for (unsigned int lane = GPUTree::wide_width; lane-- > 0;)
+            {
+            if (!(hits & (1u << lane)))
+                continue;
+
+            const unsigned int child_a = descend_A ? a.getWideChild(node_a, lane) : node_a;
+            const unsigned int child_b = descend_A ? node_b : b.getWideChild(node_b, lane);
+
+            if (stack_size == max_stack_size)
+                {
+                // only very deep trees get here
+                if (traverseWideStackFrom(a,
+                                          b,
+                                          q,
+                                          dr,
+                                          q_inv,
+                                          dr_inv,
+                                          child_a,
+                                          child_b,
+                                          narrow_phase))
+                    return true;
+                continue;
+                }
+
+            stack[2 * stack_size] = child_a;
+            stack[2 * stack_size + 1] = child_b;
+            stack_size++;
+            }
+        }
+
+    return false;
+    }
+
+//! Traverse two hierarchies in tandem using the collapsed four-wide node layout
+/*! Returns true if narrow_phase returned true for any pair of overlapping leaf nodes
+ * \param a First tree
+ * \param b Second tree
+ * \param q Rotation of a's body frame into b's body frame
+ * \param dr Translation of a's body frame in b's body frame
+ * \param narrow_phase Callable (node_a, node_b) -> bool testing a pair of leaf nodes
+ *
+ * This is the CPU counterpart of traverseBinaryStack. Pairs of overlapping nodes are kept on an
+ * explicit stack. Descending into a node tests the other node's OBB against up to four children at
+ * once with GPUTree::overlapWideNode, which skips every other level of the binary hierarchy.
+ */
+template<class NarrowPhase>
+inline bool traverseWideStack(const GPUTree& a,
+                              const GPUTree& b,
+                              const quat<ShortReal>& q,
+                              const vec3<ShortReal>& dr,
+                              const NarrowPhase& narrow_phase)
+    {
+    if (a.getNumNodes() == 0 || b.getNumNodes() == 0)
+        return false;
+
+    OBB obb_a = a.getOBB(0);
+    obb_a.affineTransform(q, dr);
+    OBB obb_b = b.getOBB(0);
+    if (!overlap(obb_a, obb_b))
+        return false;
+
+    // inverse transformation, from b's frame into a's frame
+    const quat<ShortReal> q_inv = conj(q);
+    const vec3<ShortReal> dr_inv = -rotate(q_inv, dr);
+
+    return traverseWideStackFrom(a, b, q, dr, q_inv, dr_inv, 0, 0, narrow_phase);
+    }
+#endif
+
     } // end namespace detail
 
     } // end namespace hpmc
@@ -487,6 +487,43 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
                                                                         LongReal d_j,
                                                                         LongReal charge_j)
         {
+        return computeOnePairEnergy<PairPotential>(nullptr,
+                                                   r_squared,
+                                                   r_ij,
+                                                   type_i,
+                                                   q_i,
+                                                   d_i,
+                                                   charge_i,
+                                                   type_j,
+                                                   q_j,
+                                                   d_j,
+                                                   charge_j);
+        }
+
+    /*** Compute the pair energy with one potential evaluated without virtual dispatch
+
+        @param inline_pair Pair potential to call directly, or null.
+
+        When \a inline_pair is one of the pair potentials, its energy() is called through the
+        static type InlinePair. With a final InlinePair, the compiler inlines the energy function
+        into the calling loop. Plugins that compile a pair potential ahead of time instantiate the
+        trial move loops with their potential type to avoid one virtual call per pair. All other
+        interactions are evaluated as usual.
+    */
+    template<class InlinePair>
+    __attribute__((always_inline)) inline LongReal
+    computeOnePairEnergy(const InlinePair* inline_pair,
+                         const LongReal r_squared,
+                         const vec3<LongReal>& r_ij,
+                         unsigned int type_i,
+                         const quat<LongReal>& q_i,
+                         LongReal d_i,
+                         LongReal charge_i,
+                         unsigned int type_j,
+                         const quat<LongReal>& q_j,
+                         LongReal d_j,
+                         LongReal charge_j)
+        {
         LongReal energy = 0;
         if (m_patch)
             {
@@ -511,8 +548,28 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
             {
             if (r_squared < pair->getRCutSquaredTotal(type_i, type_j))
                 {
-                energy
-                    += pair->energy(r_squared, r_ij, type_i, q_i, charge_i, type_j, q_j, charge_j);
+                if (pair.get() == inline_pair)
+                    {
+                    energy += inline_pair->InlinePair::energy(r_squared,
+                                                              r_ij,
+                                                              type_i,
+                                                              q_i,
+                                                              charge_i,
+                                                              type_j,
+                                                              q_j,
+                                                              charge_j);
+                    }
+                else
+                    {
+                    energy += pair->energy(r_squared,
+                                           r_ij,
+                                           type_i,
+                                           q_i,
+                                           charge_i,
+                                           type_j,
+                                           q_j,
+                                           charge_j);
+                    }
                 }
             }
 
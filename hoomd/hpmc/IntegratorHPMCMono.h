@@ -149,6 +149,10 @@ class IntegratorHPMCMono : public IntegratorHPMC
         //! Take one timestep forward
         virtual void update(uint64_t timestep);
 
+        //! Take one timestep forward, calling the pair potential inline_pair without virtual dispatch
+        template<class InlinePair>
+        void updateWithPair(uint64_t timestep, const InlinePair* inline_pair);
+
         /*
          * Depletant related options
          */
@@ -603,6 +607,20 @@ void IntegratorHPMCMono<Shape>::resetStats()
 
 template <class Shape>
 void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
+    {
+    updateWithPair<PairPotential>(timestep, nullptr);
+    }
+
+/*! \param timestep Current time step
+    \param inline_pair Pair potential evaluated through its static type, or null
+
+    Plugins that compile a final PairPotential subclass ahead of time override update() to call this
+    method with their potential, which inlines its energy function into the trial move loop. See
+    IntegratorHPMC::computeOnePairEnergy().
+*/
+template <class Shape>
+template <class InlinePair>
+void IntegratorHPMCMono<Shape>::updateWithPair(uint64_t timestep, const InlinePair* inline_pair)
     {
     Integrator::update(timestep);
     m_exec_conf->msg->notice(10) << "HPMCMono update: " << timestep << std::endl;
@@ -833,7 +851,7 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                                     }
 
                                 // deltaU = U_old - U_new: subtract energy of new configuration
-                                patch_field_energy_diff -= computeOnePairEnergy(r_squared, r_ij, typ_i,
+                                patch_field_energy_diff -= computeOnePairEnergy(inline_pair, r_squared, r_ij, typ_i,
                                                         shape_i.orientation,
                                                         h_diameter.data[i],
                                                         h_charge.data[i],
@@ -911,7 +929,8 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                                     Shape shape_j(orientation_j, m_params[typ_j]);
 
                                     // deltaU = U_old - U_new: add energy of old configuration
-                                    patch_field_energy_diff += computeOnePairEnergy(dot(r_ij, r_ij),
+                                    patch_field_energy_diff += computeOnePairEnergy(inline_pair,
+                                                            dot(r_ij, r_ij),
                                                             r_ij,
                                                             typ_i,
                                                             shape_old.orientation,
@@ -7,6 +7,10 @@
 #include "IntegratorHPMCMono.h"
 #include "hoomd/Autotuner.h"
 
+#ifdef ENABLE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 /*! \file IntegratorHPMCMonoNEC.h
     \brief Defines the template class for HPMC with Newtonian event chains
     \note This header cannot be compiled by nvcc
@@ -22,7 +26,12 @@ namespace hpmc
     {
 //! Template class for HPMC update with Newtonian event chains
 /*!
-
+    By default, chains are performed one at a time. In checkerboard mode, the box is divided into
+    cells that are at least one circumsphere diameter wide and the cells are split into 2^d sets
+    so that no two cells in a set are adjacent. The chains in all cells of one set run
+    concurrently: particles outside of the active cells are frozen, and chains reflect off the
+    frozen particles and off the cell walls (reflective event chains). The grid is shifted randomly
+    every sweep.
 
     \ingroup hpmc_integrators
 */
@@ -33,6 +42,9 @@ template<class Shape> class IntegratorHPMCMonoNEC : public IntegratorHPMCMono<Sh
     unsigned int
         m_chain_probability;  //!< how often we do a chain. Replaces translation_move_probability
     Scalar m_update_fraction; //!< if we perform chains we update several particles as one move
+    bool m_checkerboard;      //!< True when chains run concurrently in a checkerboard of cells
+
+    unsigned int m_max_chain_events; //!< Safe-guard limit on the number of events in one chain
 
     GlobalArray<hpmc_nec_counters_t> m_nec_count_total; //!< counters for chain statistics
 
@@ -130,6 +142,32 @@ template<class Shape> class IntegratorHPMCMonoNEC : public IntegratorHPMCMono<Sh
         return m_update_fraction;
         }
 
+    //! Set whether chains run concurrently in a checkerboard of cells
+    void setCheckerboard(bool checkerboard)
+        {
+        m_checkerboard = checkerboard;
+        }
+
+    //! Get whether chains run concurrently in a checkerboard of cells
+    bool getCheckerboard()
+        {
+        return m_checkerboard;
+        }
+
+    //! Set the safe-guard limit on the number of events in one chain
+    void setMaxChainEvents(unsigned int max_chain_events)
+        {
+        if (max_chain_events < 1)
+            throw std::domain_error("max_chain_events must be at least 1");
+        m_max_chain_events = max_chain_events;
+        }
+
+    //! Get the safe-guard limit on the number of events in one chain
+    unsigned int getMaxChainEvents()
+        {
+        return m_max_chain_events;
+        }
+
     //! Get pressure from virial expression
     //! We follow the equations of Isobe and Krauth, Journal of Chemical Physics 143, 084509 (2015)
     //! \returns pressure
@@ -167,6 +205,19 @@ template<class Shape> class IntegratorHPMCMonoNEC : public IntegratorHPMCMono<Sh
                          ArrayHandle<Scalar4>& h_orientation,
                          hpmc_counters_t& counters);
 
+    //! A potential collision partner of a sweeping particle
+    struct SweepCandidate
+        {
+        unsigned int j;             //!< Index of the particle
+        vec3<Scalar> r_ij;          //!< Vector from the sweeping particle to the candidate
+        quat<Scalar> orientation_j; //!< Orientation of the candidate
+        unsigned int typ_j;         //!< Type of the candidate
+        Scalar lower_bound; //!< Sweep distance at which the circumspheres collide (lower bound)
+        };
+
+    //! Candidate buffer reused by serial sweeps
+    std::vector<SweepCandidate> m_sweep_candidates;
+
     /*!
      This function measures the distance sphere 'i' could move in
      'direction' until it would hit another particle.
@@ -203,6 +254,118 @@ template<class Shape> class IntegratorHPMCMonoNEC : public IntegratorHPMCMono<Sh
                          hpmc_nec_counters_t& nec_counters,
                          vec3<Scalar>& collisionPlaneVector);
 
+    /*!
+     Add a particle to the list of candidates for a sweep when the swept circumsphere of the
+     sweeping particle reaches the particle's circumsphere within maxSweep.
+     */
+    void addSweepCandidate(std::vector<SweepCandidate>& candidates,
+                           unsigned int j,
+                           const vec3<Scalar>& r_ij,
+                           const quat<Scalar>& orientation_j,
+                           unsigned int typ_j,
+                           const Shape& shape_i,
+                           const vec3<Scalar>& direction,
+                           double maxSweep);
+
+    /*!
+     Evaluate the sweep distance to the candidates in order of increasing lower bound and stop as
+     soon as no remaining candidate can be hit earlier than the current collision.
+     \returns The distance to the first collision (maxSweep when there is none)
+     */
+    double evaluateSweepCandidates(std::vector<SweepCandidate>& candidates,
+                                   const vec3<Scalar>& direction,
+                                   double maxSweep,
+                                   const Shape& shape_i,
+                                   int& next,
+                                   hpmc_nec_counters_t& nec_counters,
+                                   vec3<Scalar>& collisionPlaneVector,
+                                   unsigned int& n_ties);
+
+    //! Data shared by all cells in one pass of the checkerboard update
+    struct CheckerboardPass
+        {
+        Index3D cell_indexer;        //!< Indexes the cells
+        Scalar3 shift;               //!< Fractional offset of the cell grid
+        const unsigned char* active; //!< Flags particles in active cells
+        Scalar4* postype;            //!< Particle positions and types
+        Scalar4* velocities;         //!< Particle velocities
+        Scalar4* orientation;        //!< Particle orientations
+        int3* image;                 //!< Particle images
+        const unsigned int* overlaps; //!< Interaction matrix
+        const Scalar* d;              //!< Search distance per type
+        const Scalar* a;              //!< Rotation move size per type
+        };
+
+    //! Statistics accumulated by one cell in the checkerboard update
+    struct CellStatistics
+        {
+        hpmc_counters_t counters;
+        hpmc_nec_counters_t nec_counters;
+        Scalar pressurevirial = 0;
+        Scalar movelength = 0;
+        unsigned int n_ties = 0;
+        bool chain_limit_exceeded = false;
+        bool zero_velocity = false;
+        };
+
+    /*!
+     Perform one sweep of chains in checkerboard mode.
+     \returns false when the box is too small for a checkerboard of at least two cells per
+              direction. The caller then performs a serial sweep.
+     */
+    bool updateCheckerboard(uint64_t timestep,
+                            unsigned int i_nselect,
+                            Scalar4* h_postype,
+                            Scalar4* h_velocities,
+                            Scalar4* h_orientation,
+                            int3* h_image,
+                            const unsigned int* h_overlaps,
+                            const Scalar* h_d,
+                            const Scalar* h_a,
+                            hpmc_counters_t& counters,
+                            hpmc_nec_counters_t& nec_counters);
+
+    //! Run the chains and rotation moves of one active cell
+    void updateCell(uint64_t timestep,
+                    unsigned int i_nselect,
+                    unsigned int cell,
+                    const std::vector<unsigned int>& members,
+                    const CheckerboardPass& pass,
+                    std::vector<SweepCandidate>& candidates,
+                    CellStatistics& stats);
+
+    /*!
+     Compute the distance a particle in an active cell can move in 'direction' until its center
+     reaches the cell boundary.
+     \param normal Set to the normal of the boundary plane that is hit
+     */
+    Scalar cellWallDistance(const vec3<Scalar>& pos,
+                            const vec3<Scalar>& direction,
+                            unsigned int cell,
+                            const CheckerboardPass& pass,
+                            vec3<Scalar>& normal);
+
+    /*!
+     Collect the potential collision partners of particle i in an active cell: the other members
+     of the cell and the frozen particles found in the AABB tree.
+     */
+    void collectCellCandidates(unsigned int i,
+                               const vec3<Scalar>& pos_i,
+                               const Shape& shape_i,
+                               const vec3<Scalar>& direction,
+                               double maxSweep,
+                               const std::vector<unsigned int>& members,
+                               const CheckerboardPass& pass,
+                               std::vector<SweepCandidate>& candidates);
+
+    //! Check for overlaps of particle i in an active cell with its cell members and frozen particles
+    bool checkForOverlapCell(unsigned int i,
+                             const vec3<Scalar>& pos_i,
+                             const Shape& shape_i,
+                             const std::vector<unsigned int>& members,
+                             const CheckerboardPass& pass,
+                             hpmc_counters_t& counters);
+
     public:
     //! Take one timestep forward
     virtual void update(uint64_t timestep);
@@ -234,6 +397,8 @@ IntegratorHPMCMonoNEC<Shape>::IntegratorHPMCMonoNEC(std::shared_ptr<SystemDefini
     count_movelength = 0.0;
 
     m_update_fraction = 1.0;
+    m_checkerboard = false;
+    m_max_chain_events = 100000;
     m_chain_probability = static_cast<unsigned int>(0.01 * 65535);
     m_chain_time = 1.0;
 
@@ -333,6 +498,22 @@ template<class Shape> void IntegratorHPMCMonoNEC<Shape>::update(uint64_t timeste
         // update the image list
         this->updateImageList();
 
+        if (m_checkerboard
+            && updateCheckerboard(timestep,
+                                  i_nselect,
+                                  h_postype.data,
+                                  h_velocities.data,
+                                  h_orientation.data,
+                                  h_image.data,
+                                  h_overlaps.data,
+                                  h_d.data,
+                                  h_a.data,
+                                  counters,
+                                  nec_counters))
+            {
+            continue;
+            }
+
         // loop through N particles in a shuffled order
         for (unsigned int cur_chain = 0; cur_chain < this->m_pdata->getN() * m_update_fraction;
              cur_chain++)
@@ -379,8 +560,7 @@ template<class Shape> void IntegratorHPMCMonoNEC<Shape>::update(uint64_t timeste
                 double chain_time = m_chain_time;
                 double sweep;
 
-                int debug_max_chain = 1e5;
-                int count_chain = 0;
+                unsigned int count_chain = 0;
 
                 // perform the chain in a loop.
                 // next denotes the next particle, where -1 means there is no further particle.
@@ -388,11 +568,11 @@ template<class Shape> void IntegratorHPMCMonoNEC<Shape>::update(uint64_t timeste
                 while (next > -1)
                     {
                     count_chain++;
-                    if (count_chain == debug_max_chain)
+                    if (count_chain == m_max_chain_events)
                         {
                         this->m_exec_conf->msg->error()
                             << "The number of chain elements exceeded safe-guard limit of "
-                            << debug_max_chain << ".\n";
+                            << m_max_chain_events << ".\n";
                         this->m_exec_conf->msg->error()
                             << "Shorten chain_time if this message appears regularly." << std::endl;
                         break;
@@ -757,8 +937,6 @@ double IntegratorHPMCMonoNEC<Shape>::sweepDistance(vec3<Scalar>& direction,
                                                    hpmc_nec_counters_t& nec_counters,
                                                    vec3<Scalar>& collisionPlaneVector)
     {
-    double sweepableDistance = maxSweep;
-
     direction *= fast::rsqrt(dot(direction, direction));
 
     hoomd::detail::AABB aabb_i_current = shape_i.getAABB(vec3<Scalar>(0, 0, 0));
@@ -767,7 +945,7 @@ double IntegratorHPMCMonoNEC<Shape>::sweepDistance(vec3<Scalar>& direction,
 
     hoomd::detail::AABB aabb_i_test = hoomd::detail::merge(aabb_i_current, aabb_i_future);
 
-    vec3<Scalar> newCollisionPlaneVector;
+    m_sweep_candidates.clear();
 
     // All image boxes (including the primary)
     const unsigned int n_images = static_cast<unsigned int>(this->m_image_list.size());
@@ -818,55 +996,789 @@ double IntegratorHPMCMonoNEC<Shape>::sweepDistance(vec3<Scalar>& direction,
                                 }
                             }
 
+                        unsigned int typ_j = __scalar_as_int(postype_j.w);
+                        if (!h_overlaps.data[this->m_overlap_idx(typ_i, typ_j)])
+                            continue;
+
                         // put particles in coordinate system of particle i
                         vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
 
-                        unsigned int typ_j = __scalar_as_int(postype_j.w);
-                        Shape shape_j(quat<Scalar>(orientation_j), this->m_params[typ_j]);
+                        addSweepCandidate(m_sweep_candidates,
+                                          j,
+                                          r_ij,
+                                          quat<Scalar>(orientation_j),
+                                          typ_j,
+                                          shape_i,
+                                          direction,
+                                          maxSweep);
+                        }
+                    }
+                }
+            else
+                {
+                // skip ahead
+                cur_node_idx += this->m_aabb_tree.getNodeSkip(cur_node_idx);
+                }
+            } // end loop over AABB nodes
+        } // end loop over images
+
+    unsigned int n_ties = 0;
+    double sweepableDistance = evaluateSweepCandidates(m_sweep_candidates,
+                                                       direction,
+                                                       maxSweep,
+                                                       shape_i,
+                                                       next,
+                                                       nec_counters,
+                                                       collisionPlaneVector,
+                                                       n_ties);
+    if (n_ties)
+        {
+        this->m_exec_conf->msg->error() << "Two particles with the same distance\n";
+        }
+
+    return sweepableDistance;
+    }
+
+template<class Shape>
+void IntegratorHPMCMonoNEC<Shape>::addSweepCandidate(std::vector<SweepCandidate>& candidates,
+                                                     unsigned int j,
+                                                     const vec3<Scalar>& r_ij,
+                                                     const quat<Scalar>& orientation_j,
+                                                     unsigned int typ_j,
+                                                     const Shape& shape_i,
+                                                     const vec3<Scalar>& direction,
+                                                     double maxSweep)
+    {
+    Shape shape_j(orientation_j, this->m_params[typ_j]);
+    Scalar R = (shape_i.getCircumsphereDiameter() + shape_j.getCircumsphereDiameter()) / Scalar(2.0);
+
+    // Sweep the circumsphere of i against the circumsphere of j. The shapes cannot collide
+    // earlier than their circumspheres.
+    Scalar rsq = dot(r_ij, r_ij);
+    Scalar lower_bound(0.0);
+    if (rsq >= R * R)
+        {
+        Scalar d_parallel = dot(r_ij, direction);
+        if (d_parallel <= 0)
+            {
+            // moving apart
+            return;
+            }
+
+        Scalar discriminant = R * R - rsq + d_parallel * d_parallel;
+        if (discriminant < 0)
+            {
+            // passing by
+            return;
+            }
+
+        lower_bound = d_parallel - fast::sqrt(discriminant);
+        if (lower_bound >= maxSweep)
+            {
+            return;
+            }
+        }
+
+    SweepCandidate candidate;
+    candidate.j = j;
+    candidate.r_ij = r_ij;
+    candidate.orientation_j = orientation_j;
+    candidate.typ_j = typ_j;
+    candidate.lower_bound = lower_bound;
+    candidates.push_back(candidate);
+    }
+
+template<class Shape>
+double IntegratorHPMCMonoNEC<Shape>::evaluateSweepCandidates(
+    std::vector<SweepCandidate>& candidates,
+    const vec3<Scalar>& direction,
+    double maxSweep,
+    const Shape& shape_i,
+    int& next,
+    hpmc_nec_counters_t& nec_counters,
+    vec3<Scalar>& collisionPlaneVector,
+    unsigned int& n_ties)
+    {
+    double sweepableDistance = maxSweep;
+    vec3<Scalar> newCollisionPlaneVector;
+
+    // the nearest candidates are the most likely collision partners
+    std::stable_sort(candidates.begin(),
+                     candidates.end(),
+                     [](const SweepCandidate& a, const SweepCandidate& b)
+                     { return a.lower_bound < b.lower_bound; });
+
+    for (const SweepCandidate& candidate : candidates)
+        {
+        if (candidate.lower_bound >= sweepableDistance)
+            {
+            // no remaining candidate can be hit earlier
+            break;
+            }
+
+        Shape shape_j(candidate.orientation_j, this->m_params[candidate.typ_j]);
+
+        nec_counters.distance_queries++;
+        double newDist = sweep_distance(candidate.r_ij,
+                                        shape_i,
+                                        shape_j,
+                                        direction,
+                                        nec_counters.overlap_err_count,
+                                        newCollisionPlaneVector);
+
+        if (newDist >= 0.0 and newDist < sweepableDistance)
+            {
+            collisionPlaneVector = newCollisionPlaneVector;
+            sweepableDistance = newDist;
+            next = candidate.j;
+            }
+        else
+            {
+            if (newDist < -3.5) // resultOverlapping = -3.0;
+                {
+                if (dot(candidate.r_ij, direction) > 0)
+                    {
+                    collisionPlaneVector = newCollisionPlaneVector;
+                    next = candidate.j;
+                    sweepableDistance = 0.0;
+                    }
+                }
+
+            if (newDist == sweepableDistance)
+                {
+                n_ties++;
+                }
+            }
+        }
+
+    return sweepableDistance;
+    }
+
+template<class Shape>
+bool IntegratorHPMCMonoNEC<Shape>::updateCheckerboard(uint64_t timestep,
+                                                      unsigned int i_nselect,
+                                                      Scalar4* h_postype,
+                                                      Scalar4* h_velocities,
+                                                      Scalar4* h_orientation,
+                                                      int3* h_image,
+                                                      const unsigned int* h_overlaps,
+                                                      const Scalar* h_d,
+                                                      const Scalar* h_a,
+                                                      hpmc_counters_t& counters,
+                                                      hpmc_nec_counters_t& nec_counters)
+    {
+    const BoxDim& box = this->m_pdata->getBox();
+    const unsigned int ndim = this->m_sysdef->getNDimensions();
+    const unsigned int N = this->m_pdata->getN();
+
+    // Particles in two cells of the same set are separated by at least one cell width. They
+    // cannot interact when the cell width is at least the largest circumsphere diameter.
+    Scalar cell_width = this->getMaxCoreDiameter();
+    if (cell_width <= Scalar(0.0))
+        {
+        return false;
+        }
+
+    // use an even number of cells in every direction so that the sets tile the periodic box
+    Scalar3 L = box.getNearestPlaneDistance();
+    uint3 dim = make_uint3(2 * (unsigned int)(L.x / (Scalar(2.0) * cell_width)),
+                           2 * (unsigned int)(L.y / (Scalar(2.0) * cell_width)),
+                           2 * (unsigned int)(L.z / (Scalar(2.0) * cell_width)));
+    if (ndim == 2)
+        {
+        dim.z = 1;
+        }
+
+    if (dim.x < 2 || dim.y < 2 || (ndim == 3 && dim.z < 2))
+        {
+        this->m_exec_conf->msg->notice(6)
+            << "IntegratorHPMCMonoNEC: box too small for checkerboard, using serial chains"
+            << std::endl;
+        return false;
+        }
+
+    CheckerboardPass pass;
+    pass.cell_indexer = Index3D(dim.x, dim.y, dim.z);
+    pass.postype = h_postype;
+    pass.velocities = h_velocities;
+    pass.orientation = h_orientation;
+    pass.image = h_image;
+    pass.overlaps = h_overlaps;
+    pass.d = h_d;
+    pass.a = h_a;
+
+    // shift the grid randomly and process the sets in random order
+    hoomd::RandomGenerator rng(hoomd::Seed(hoomd::RNGIdentifier::HPMCMonoChainCheckerboard,
+                                           timestep,
+                                           this->m_sysdef->getSeed()),
+                               hoomd::Counter(i_nselect));
+    pass.shift.x = hoomd::detail::generate_canonical<Scalar>(rng) / Scalar(dim.x);
+    pass.shift.y = hoomd::detail::generate_canonical<Scalar>(rng) / Scalar(dim.y);
+    pass.shift.z
+        = (ndim == 2) ? Scalar(0.0) : hoomd::detail::generate_canonical<Scalar>(rng) / Scalar(dim.z);
+
+    const unsigned int n_sets = (ndim == 2) ? 4 : 8;
+    std::vector<unsigned int> set_order(n_sets);
+    for (unsigned int set = 0; set < n_sets; ++set)
+        {
+        set_order[set] = set;
+        }
+    for (unsigned int set = n_sets - 1; set > 0; --set)
+        {
+        std::swap(set_order[set], set_order[hoomd::UniformIntDistribution(set)(rng)]);
+        }
+
+    // Assign particles to cells. Chains reflect at the cell walls, so particles stay in their
+    // cells for the whole sweep.
+    const unsigned int n_cells = pass.cell_indexer.getNumElements();
+    std::vector<std::vector<unsigned int>> cell_members(n_cells);
+    std::vector<unsigned int> cell_set(n_cells);
+    for (unsigned int cell = 0; cell < n_cells; ++cell)
+        {
+        uint3 c = pass.cell_indexer.getTriple(cell);
+        cell_set[cell] = (c.x % 2) + 2 * (c.y % 2) + 4 * (c.z % 2);
+        }
+
+    std::vector<unsigned int> particle_cell(N);
+    for (unsigned int i = 0; i < N; ++i)
+        {
+        Scalar3 f = box.makeFraction(make_scalar3(h_postype[i].x, h_postype[i].y, h_postype[i].z));
+        int cx = int(slow::floor((f.x - pass.shift.x) * Scalar(dim.x)));
+        int cy = int(slow::floor((f.y - pass.shift.y) * Scalar(dim.y)));
+        int cz = int(slow::floor((f.z - pass.shift.z) * Scalar(dim.z)));
+        cx = ((cx % int(dim.x)) + int(dim.x)) % int(dim.x);
+        cy = ((cy % int(dim.y)) + int(dim.y)) % int(dim.y);
+        cz = ((cz % int(dim.z)) + int(dim.z)) % int(dim.z);
+        particle_cell[i] = pass.cell_indexer(cx, cy, cz);
+        cell_members[particle_cell[i]].push_back(i);
+        }
+
+    std::vector<unsigned char> active(N);
+    pass.active = active.data();
+
+    for (unsigned int set : set_order)
+        {
+        std::vector<unsigned int> active_cells;
+        for (unsigned int cell = 0; cell < n_cells; ++cell)
+            {
+            if (cell_set[cell] == set && cell_members[cell].size() > 0)
+                {
+                active_cells.push_back(cell);
+                }
+            }
+
+        for (unsigned int i = 0; i < N; ++i)
+            {
+            active[i] = cell_set[particle_cell[i]] == set;
+            }
+
+        // The AABB tree locates the frozen particles, which do not move during this pass.
+        this->m_aabb_tree_invalid = true;
+        this->buildAABBTree();
+
+        const unsigned int n_active = (unsigned int)active_cells.size();
+        std::vector<CellStatistics> stats(n_active);
+
+#ifdef ENABLE_TBB
+        this->m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for(
+                    (unsigned int)0,
+                    n_active,
+                    [&](unsigned int active_idx)
+#else
+        for (unsigned int active_idx = 0; active_idx < n_active; ++active_idx)
+#endif
+                    {
+                        std::vector<SweepCandidate> candidates;
+                        unsigned int cell = active_cells[active_idx];
+                        updateCell(timestep,
+                                   i_nselect,
+                                   cell,
+                                   cell_members[cell],
+                                   pass,
+                                   candidates,
+                                   stats[active_idx]);
+                    }
+#ifdef ENABLE_TBB
+                );
+            });
+#endif
+
+        // reduce the statistics in a fixed order
+        bool chain_limit_exceeded = false;
+        bool zero_velocity = false;
+        unsigned int n_ties = 0;
+        for (const CellStatistics& cell_stats : stats)
+            {
+            counters = counters + cell_stats.counters;
+            nec_counters = nec_counters + cell_stats.nec_counters;
+            count_pressurevirial += cell_stats.pressurevirial;
+            count_movelength += cell_stats.movelength;
+            n_ties += cell_stats.n_ties;
+            chain_limit_exceeded = chain_limit_exceeded || cell_stats.chain_limit_exceeded;
+            zero_velocity = zero_velocity || cell_stats.zero_velocity;
+            }
+
+        if (n_ties)
+            {
+            this->m_exec_conf->msg->error() << "Two particles with the same distance\n";
+            }
+        if (chain_limit_exceeded)
+            {
+            this->m_exec_conf->msg->error()
+                << "The number of chain elements exceeded safe-guard limit of "
+                << m_max_chain_events << ".\n";
+            this->m_exec_conf->msg->error()
+                << "Shorten chain_time if this message appears regularly." << std::endl;
+            }
+        if (zero_velocity)
+            {
+            this->m_exec_conf->msg->error() << "NEC requires non-zero velocities." << std::endl;
+            }
+        }
+
+    // particles have moved, the tree is out of date
+    this->m_aabb_tree_invalid = true;
+
+    return true;
+    }
+
+template<class Shape>
+void IntegratorHPMCMonoNEC<Shape>::updateCell(uint64_t timestep,
+                                              unsigned int i_nselect,
+                                              unsigned int cell,
+                                              const std::vector<unsigned int>& members,
+                                              const CheckerboardPass& pass,
+                                              std::vector<SweepCandidate>& candidates,
+                                              CellStatistics& stats)
+    {
+    const BoxDim& box = this->m_pdata->getBox();
+    const unsigned int ndim = this->m_sysdef->getNDimensions();
+    const uint16_t seed = this->m_sysdef->getSeed();
+    const unsigned int n_members = (unsigned int)members.size();
+
+    const unsigned int n_chains
+        = (unsigned int)std::ceil(Scalar(n_members) * Scalar(m_update_fraction));
+
+    for (unsigned int cur_chain = 0; cur_chain < n_chains; cur_chain++)
+        {
+        hoomd::RandomGenerator rng_chain_i(
+            hoomd::Seed(hoomd::RNGIdentifier::HPMCMonoChainMove, timestep, seed),
+            hoomd::Counter(cell, cur_chain, i_nselect, 0xffff));
+
+        unsigned int i = members[hoomd::UniformIntDistribution(n_members - 1)(rng_chain_i)];
+
+        Scalar4 postype_i = pass.postype[i];
+        int typ_i = __scalar_as_int(postype_i.w);
+        Shape shape_i(quat<Scalar>(pass.orientation[i]), this->m_params[typ_i]);
+
+        unsigned int move_type_select = hoomd::UniformIntDistribution(0xffff)(rng_chain_i);
+        bool move_type_translate
+            = !shape_i.hasOrientation() || (move_type_select < m_chain_probability);
+
+        if (move_type_translate)
+            {
+            stats.nec_counters.chain_start_count++;
 
-                        nec_counters.distance_queries++;
+            vec3<Scalar> direction = vec3<Scalar>(pass.velocities[i]);
+            Scalar velocity = fast::sqrt(dot(direction, direction));
 
-                        if (h_overlaps.data[this->m_overlap_idx(typ_i, typ_j)])
+            if (velocity == 0.0)
+                {
+                stats.zero_velocity = true;
+                continue;
+                }
+
+            direction /= velocity;
+
+            double chain_time = m_chain_time;
+            unsigned int count_chain = 0;
+
+            int next = i;
+            while (next > -1)
+                {
+                count_chain++;
+                if (count_chain == m_max_chain_events)
+                    {
+                    stats.chain_limit_exceeded = true;
+                    break;
+                    }
+
+                int k = next;
+                Scalar4 postype_k = pass.postype[k];
+                int typ_k = __scalar_as_int(postype_k.w);
+                vec3<Scalar> pos_k = vec3<Scalar>(postype_k);
+                Shape shape_k(quat<Scalar>(pass.orientation[k]), this->m_params[typ_k]);
+
+                double maxSweep = pass.d[typ_k];
+
+                // find the first collision with a cell member or a frozen particle
+                vec3<Scalar> collisionPlaneVector;
+                collectCellCandidates(k,
+                                      pos_k,
+                                      shape_k,
+                                      direction,
+                                      maxSweep,
+                                      members,
+                                      pass,
+                                      candidates);
+                double sweep = evaluateSweepCandidates(candidates,
+                                                       direction,
+                                                       maxSweep,
+                                                       shape_k,
+                                                       next,
+                                                       stats.nec_counters,
+                                                       collisionPlaneVector,
+                                                       stats.n_ties);
+
+                if (sweep >= maxSweep)
+                    {
+                    sweep = maxSweep;
+                    next = k;
+                    }
+
+                // reflect at the cell wall when it comes first
+                vec3<Scalar> wall_normal;
+                Scalar wall = cellWallDistance(pos_k, direction, cell, pass, wall_normal);
+                bool hit_wall = false;
+                if (wall < sweep)
+                    {
+                    sweep = wall;
+                    next = k;
+                    hit_wall = true;
+                    }
+
+                if (sweep > chain_time * velocity)
+                    {
+                    sweep = chain_time * velocity;
+                    next = -1;
+                    hit_wall = false;
+                    }
+
+                stats.movelength += sweep;
+
+                pos_k += sweep * direction;
+                chain_time -= sweep / velocity;
+
+                bool collision = next != k && next > -1;
+                bool hit_frozen = collision && !pass.active[next];
+
+                if (!shape_k.ignoreStatistics())
+                    {
+                    if (collision)
+                        {
+                        stats.counters.translate_reject_count++;
+                        stats.nec_counters.chain_at_collision_count++;
+                        }
+                    else
+                        {
+                        if (next != -1)
                             {
-                            double maxR = shape_i.getCircumsphereDiameter()
-                                          + shape_j.getCircumsphereDiameter();
-                            maxR /= 2;
-                            maxR += sweepableDistance;
+                            stats.counters.translate_accept_count++;
+                            }
+                        stats.nec_counters.chain_no_collision_count++;
+                        }
+                    }
 
-                            if (dot(r_ij, r_ij) < maxR * maxR)
-                                {
-                                double newDist = sweep_distance(r_ij,
-                                                                shape_i,
-                                                                shape_j,
-                                                                direction,
-                                                                nec_counters.overlap_err_count,
-                                                                newCollisionPlaneVector);
-
-                                if (newDist >= 0.0 and newDist < sweepableDistance)
-                                    {
-                                    collisionPlaneVector = newCollisionPlaneVector;
-                                    sweepableDistance = newDist;
-                                    next = j;
-                                    }
-                                else
-                                    {
-                                    if (newDist < -3.5) // resultOverlapping = -3.0;
-                                        {
-                                        if (dot(r_ij, direction) > 0)
-                                            {
-                                            collisionPlaneVector = newCollisionPlaneVector;
-                                            next = j;
-                                            sweepableDistance = 0.0;
-                                            }
-                                        }
-
-                                    if (newDist == sweepableDistance)
-                                        {
-                                        this->m_exec_conf->msg->error()
-                                            << "Two particles with the same distance\n";
-                                        }
-                                    }
-                                }
+                pass.postype[k] = make_scalar4(pos_k.x, pos_k.y, pos_k.z, postype_k.w);
+                box.wrap(pass.postype[k], pass.image[k]);
+
+                vec3<Scalar> vel_k = vec3<Scalar>(pass.velocities[k]);
+                if (hit_wall || hit_frozen)
+                    {
+                    // reflect off the static obstacle and continue the chain with k
+                    vec3<Scalar> normal = hit_wall ? wall_normal : collisionPlaneVector;
+                    // A contact with a frozen particle enters the virial like any other
+                    // collision. A cell wall acts as a collision with the mirror image of k at zero
+                    // separation and adds no virial. Positions along the chain stay uniform in the
+                    // cell, so the contact rate per unit movelength still estimates the bulk
+                    // pressure.
+                    if (hit_frozen)
+                        {
+                        vec3<Scalar> delta_pos
+                            = box.minImage(vec3<Scalar>(pass.postype[next]) - pos_k);
+                        stats.pressurevirial += dot(delta_pos, direction);
+                        }
+
+                    vel_k -= Scalar(2.0) * normal * (dot(vel_k, normal) / dot(normal, normal));
+                    pass.velocities[k]
+                        = make_scalar4(vel_k.x, vel_k.y, vel_k.z, pass.velocities[k].w);
+                    direction = vel_k / velocity;
+                    next = k;
+                    }
+                else if (collision)
+                    {
+                    // elastic collision with a member of the same cell
+                    vec3<Scalar> pos_n = vec3<Scalar>(pass.postype[next]);
+                    vec3<Scalar> vel_n = vec3<Scalar>(pass.velocities[next]);
+
+                    vec3<Scalar> delta_pos = box.minImage(pos_n - pos_k);
+                    stats.pressurevirial += dot(delta_pos, direction);
+
+                    vec3<Scalar> delta_vel = vel_n - vel_k;
+                    vec3<Scalar> vel_change
+                        = collisionPlaneVector
+                          * (dot(delta_vel, collisionPlaneVector)
+                             / dot(collisionPlaneVector, collisionPlaneVector));
+
+                    vel_n -= vel_change;
+                    vel_k += vel_change;
+
+                    pass.velocities[next]
+                        = make_scalar4(vel_n.x, vel_n.y, vel_n.z, pass.velocities[next].w);
+                    pass.velocities[k]
+                        = make_scalar4(vel_k.x, vel_k.y, vel_k.z, pass.velocities[k].w);
+
+                    velocity = fast::sqrt(dot(vel_n, vel_n));
+                    direction = vel_n / velocity;
+                    if (velocity == 0.0)
+                        {
+                        next = -1;
+                        }
+                    }
+                } // end loop over chain elements
+            }
+        else
+            {
+            vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
+
+            if (ndim == 2)
+                move_rotate<2>(shape_i.orientation, rng_chain_i, pass.a[typ_i]);
+            else
+                move_rotate<3>(shape_i.orientation, rng_chain_i, pass.a[typ_i]);
+
+            bool overlap = checkForOverlapCell(i, pos_i, shape_i, members, pass, stats.counters);
+
+            if (!overlap)
+                {
+                if (!shape_i.ignoreStatistics())
+                    stats.counters.rotate_accept_count++;
+
+                pass.orientation[i] = quat_to_scalar4(shape_i.orientation);
+                }
+            else
+                {
+                if (!shape_i.ignoreStatistics())
+                    stats.counters.rotate_reject_count++;
+                }
+            }
+        } // end loop over chains
+    }
+
+template<class Shape>
+Scalar IntegratorHPMCMonoNEC<Shape>::cellWallDistance(const vec3<Scalar>& pos,
+                                                      const vec3<Scalar>& direction,
+                                                      unsigned int cell,
+                                                      const CheckerboardPass& pass,
+                                                      vec3<Scalar>& normal)
+    {
+    const BoxDim& box = this->m_pdata->getBox();
+    const unsigned int ndim = this->m_sysdef->getNDimensions();
+
+    uint3 c = pass.cell_indexer.getTriple(cell);
+    const Scalar cell_coord[3] = {Scalar(c.x), Scalar(c.y), Scalar(c.z)};
+    const Scalar n_cells[3] = {Scalar(pass.cell_indexer.getW()),
+                               Scalar(pass.cell_indexer.getH()),
+                               Scalar(pass.cell_indexer.getD())};
+    const Scalar shift[3] = {pass.shift.x, pass.shift.y, pass.shift.z};
+
+    // fractional position and velocity (makeFraction is affine)
+    Scalar3 f = box.makeFraction(vec_to_scalar3(pos));
+    Scalar3 g = box.makeFraction(vec_to_scalar3(direction)) - box.makeFraction(make_scalar3(0, 0, 0));
+    const Scalar frac[3] = {f.x, f.y, f.z};
+    const Scalar frac_dir[3] = {g.x, g.y, g.z};
+
+    Scalar distance = std::numeric_limits<Scalar>::max();
+    unsigned int wall_dim = 0;
+    for (unsigned int d = 0; d < ndim; ++d)
+        {
+        // local coordinate in the cell, in [0,1]
+        Scalar x = (frac[d] - shift[d]) * n_cells[d] - cell_coord[d];
+        x -= n_cells[d] * slow::floor((x + Scalar(0.5)) / n_cells[d]);
+        x = std::min(std::max(x, Scalar(0.0)), Scalar(1.0));
+
+        Scalar v = frac_dir[d] * n_cells[d];
+        Scalar t = std::numeric_limits<Scalar>::max();
+        if (v > Scalar(0.0))
+            t = (Scalar(1.0) - x) / v;
+        else if (v < Scalar(0.0))
+            t = -x / v;
+
+        if (t < distance)
+            {
+            distance = t;
+            wall_dim = d;
+            }
+        }
+
+    // the boundary plane of fractional coordinate d is spanned by the other two lattice vectors
+    vec3<Scalar> a1(box.getLatticeVector((wall_dim + 1) % 3));
+    vec3<Scalar> a2(box.getLatticeVector((wall_dim + 2) % 3));
+    normal = cross(a1, a2);
+
+    return distance;
+    }
+
+template<class Shape>
+void IntegratorHPMCMonoNEC<Shape>::collectCellCandidates(unsigned int i,
+                                                         const vec3<Scalar>& pos_i,
+                                                         const Shape& shape_i,
+                                                         const vec3<Scalar>& direction,
+                                                         double maxSweep,
+                                                         const std::vector<unsigned int>& members,
+                                                         const CheckerboardPass& pass,
+                                                         std::vector<SweepCandidate>& candidates)
+    {
+    const BoxDim& box = this->m_pdata->getBox();
+    const unsigned int typ_i = __scalar_as_int(pass.postype[i].w);
+
+    candidates.clear();
+
+    // The members of the cell move during the pass and are not up to date in the AABB tree. The
+    // box is at least two cells wide, so the minimum image is the only one that can interact.
+    for (unsigned int j : members)
+        {
+        if (j == i)
+            continue;
+
+        Scalar4 postype_j = pass.postype[j];
+        unsigned int typ_j = __scalar_as_int(postype_j.w);
+        if (!pass.overlaps[this->m_overlap_idx(typ_i, typ_j)])
+            continue;
+
+        vec3<Scalar> r_ij = box.minImage(vec3<Scalar>(postype_j) - pos_i);
+        addSweepCandidate(candidates,
+                          j,
+                          r_ij,
+                          quat<Scalar>(pass.orientation[j]),
+                          typ_j,
+                          shape_i,
+                          direction,
+                          maxSweep);
+        }
+
+    // frozen particles
+    hoomd::detail::AABB aabb_i_current = shape_i.getAABB(vec3<Scalar>(0, 0, 0));
+    hoomd::detail::AABB aabb_i_future = aabb_i_current;
+    aabb_i_future.translate(maxSweep * direction);
+    hoomd::detail::AABB aabb_i_test = hoomd::detail::merge(aabb_i_current, aabb_i_future);
+
+    const unsigned int n_images = static_cast<unsigned int>(this->m_image_list.size());
+    for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+        {
+        vec3<Scalar> pos_i_image = pos_i + this->m_image_list[cur_image];
+        hoomd::detail::AABB aabb = aabb_i_test;
+        aabb.translate(pos_i_image);
+
+        // stackless search
+        for (unsigned int cur_node_idx = 0; cur_node_idx < this->m_aabb_tree.getNumNodes();
+             cur_node_idx++)
+            {
+            if (aabb.overlaps(this->m_aabb_tree.getNodeAABB(cur_node_idx)))
+                {
+                if (this->m_aabb_tree.isNodeLeaf(cur_node_idx))
+                    {
+                    for (unsigned int cur_p = 0;
+                         cur_p < this->m_aabb_tree.getNodeNumParticles(cur_node_idx);
+                         cur_p++)
+                        {
+                        unsigned int j = this->m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+                        if (pass.active[j])
+                            continue;
+
+                        Scalar4 postype_j = pass.postype[j];
+                        unsigned int typ_j = __scalar_as_int(postype_j.w);
+                        if (!pass.overlaps[this->m_overlap_idx(typ_i, typ_j)])
+                            continue;
+
+                        vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+                        addSweepCandidate(candidates,
+                                          j,
+                                          r_ij,
+                                          quat<Scalar>(pass.orientation[j]),
+                                          typ_j,
+                                          shape_i,
+                                          direction,
+                                          maxSweep);
+                        }
+                    }
+                }
+            else
+                {
+                // skip ahead
+                cur_node_idx += this->m_aabb_tree.getNodeSkip(cur_node_idx);
+                }
+            } // end loop over AABB nodes
+        } // end loop over images
+    }
+
+template<class Shape>
+bool IntegratorHPMCMonoNEC<Shape>::checkForOverlapCell(unsigned int i,
+                                                       const vec3<Scalar>& pos_i,
+                                                       const Shape& shape_i,
+                                                       const std::vector<unsigned int>& members,
+                                                       const CheckerboardPass& pass,
+                                                       hpmc_counters_t& counters)
+    {
+    const BoxDim& box = this->m_pdata->getBox();
+    const unsigned int typ_i = __scalar_as_int(pass.postype[i].w);
+
+    for (unsigned int j : members)
+        {
+        if (j == i)
+            continue;
+
+        Scalar4 postype_j = pass.postype[j];
+        unsigned int typ_j = __scalar_as_int(postype_j.w);
+        vec3<Scalar> r_ij = box.minImage(vec3<Scalar>(postype_j) - pos_i);
+        Shape shape_j(quat<Scalar>(pass.orientation[j]), this->m_params[typ_j]);
+
+        counters.overlap_checks++;
+        if (pass.overlaps[this->m_overlap_idx(typ_i, typ_j)]
+            && check_circumsphere_overlap(r_ij, shape_i, shape_j)
+            && test_overlap(r_ij, shape_i, shape_j, counters.overlap_err_count))
+            {
+            return true;
+            }
+        }
+
+    hoomd::detail::AABB aabb_i_local = shape_i.getAABB(vec3<Scalar>(0, 0, 0));
+    const unsigned int n_images = static_cast<unsigned int>(this->m_image_list.size());
+    for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+        {
+        vec3<Scalar> pos_i_image = pos_i + this->m_image_list[cur_image];
+        hoomd::detail::AABB aabb = aabb_i_local;
+        aabb.translate(pos_i_image);
+
+        // stackless search
+        for (unsigned int cur_node_idx = 0; cur_node_idx < this->m_aabb_tree.getNumNodes();
+             cur_node_idx++)
+            {
+            if (aabb.overlaps(this->m_aabb_tree.getNodeAABB(cur_node_idx)))
+                {
+                if (this->m_aabb_tree.isNodeLeaf(cur_node_idx))
+                    {
+                    for (unsigned int cur_p = 0;
+                         cur_p < this->m_aabb_tree.getNodeNumParticles(cur_node_idx);
+                         cur_p++)
+                        {
+                        unsigned int j = this->m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+                        if (pass.active[j])
+                            continue;
+
+                        Scalar4 postype_j = pass.postype[j];
+                        unsigned int typ_j = __scalar_as_int(postype_j.w);
+                        vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+                        Shape shape_j(quat<Scalar>(pass.orientation[j]), this->m_params[typ_j]);
+
+                        counters.overlap_checks++;
+                        if (pass.overlaps[this->m_overlap_idx(typ_i, typ_j)]
+                            && check_circumsphere_overlap(r_ij, shape_i, shape_j)
+                            && test_overlap(r_ij, shape_i, shape_j, counters.overlap_err_count))
+                            {
+                            return true;
                             }
                         }
                     }
@@ -879,7 +1791,7 @@ double IntegratorHPMCMonoNEC<Shape>::sweepDistance(vec3<Scalar>& direction,
             } // end loop over AABB nodes
         } // end loop over images
 
-    return sweepableDistance;
+    return false;
     }
 
 //! Export this hpmc integrator to python
@@ -904,6 +1816,12 @@ void export_IntegratorHPMCMonoNEC(pybind11::module& m, const std::string& name)
         .def_property("update_fraction",
                       &IntegratorHPMCMonoNEC<Shape>::getUpdateFraction,
                       &IntegratorHPMCMonoNEC<Shape>::setUpdateFraction)
+        .def_property("checkerboard",
+                      &IntegratorHPMCMonoNEC<Shape>::getCheckerboard,
+                      &IntegratorHPMCMonoNEC<Shape>::setCheckerboard)
+        .def_property("max_chain_events",
+                      &IntegratorHPMCMonoNEC<Shape>::getMaxChainEvents,
+                      &IntegratorHPMCMonoNEC<Shape>::setMaxChainEvents)
         .def_property_readonly("virial_pressure", &IntegratorHPMCMonoNEC<Shape>::getPressure)
         .def("getNECCounters", &IntegratorHPMCMonoNEC<Shape>::getNECCounters);
     }
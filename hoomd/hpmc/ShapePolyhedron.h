@@ -900,60 +900,6 @@ DEVICE inline bool IntersectRayTriangle(const vec3<ShortReal>& p,
     return true;
     }
 
-#ifndef __HIPCC__
-//! Traverse the bounding volume test tree recursively
-inline bool BVHCollision(const ShapePolyhedron& a,
-                         const ShapePolyhedron& b,
-                         unsigned int cur_node_a,
-                         unsigned int cur_node_b,
-                         const quat<ShortReal>& q,
-                         const vec3<ShortReal>& dr,
-                         unsigned int& err,
-                         ShortReal abs_tol)
-    {
-    detail::OBB obb_a = a.tree.getOBB(cur_node_a);
-    obb_a.affineTransform(q, dr);
-    detail::OBB obb_b = b.tree.getOBB(cur_node_b);
-    if (!overlap(obb_a, obb_b))
-        return false;
-    if (a.tree.isLeaf(cur_node_a))
-        {
-        if (b.tree.isLeaf(cur_node_b))
-            {
-            return test_narrow_phase_overlap(dr, a, b, cur_node_a, cur_node_b, err, abs_tol);
-            }
-        else
-            {
-            unsigned int left_b = b.tree.getLeftChild(cur_node_b);
-            unsigned int right_b = b.tree.getEscapeIndex(left_b);
-            return BVHCollision(a, b, cur_node_a, left_b, q, dr, err, abs_tol)
-                   || BVHCollision(a, b, cur_node_a, right_b, q, dr, err, abs_tol);
-            }
-        }
-    else
-        {
-        if (b.tree.isLeaf(cur_node_b))
-            {
-            unsigned int left_a = a.tree.getLeftChild(cur_node_a);
-            unsigned int right_a = a.tree.getEscapeIndex(left_a);
-            return BVHCollision(a, b, left_a, cur_node_b, q, dr, err, abs_tol)
-                   || BVHCollision(a, b, right_a, cur_node_b, q, dr, err, abs_tol);
-            }
-        else
-            {
-            unsigned int left_a = a.tree.getLeftChild(cur_node_a);
-            unsigned int right_a = a.tree.getEscapeIndex(left_a);
-            unsigned int left_b = b.tree.getLeftChild(cur_node_b);
-            unsigned int right_b = b.tree.getEscapeIndex(left_b);
-            return BVHCollision(a, b, left_a, left_b, q, dr, err, abs_tol)
-                   || BVHCollision(a, b, left_a, right_b, q, dr, err, abs_tol)
-                   || BVHCollision(a, b, right_a, left_b, q, dr, err, abs_tol)
-                   || BVHCollision(a, b, right_a, right_b, q, dr, err, abs_tol);
-            }
-        }
-    }
-#endif
-
 /** Polyhedron overlap test
     @param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
     @param a first shape
@@ -1051,7 +997,22 @@ DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
     quat<ShortReal> q(conj(b.orientation) * a.orientation);
 
 #ifndef __HIPCC__
-    if (BVHCollision(a, b, 0, 0, q, dr_rot, err, abs_tol))
+    // batched tandem traversal over the four-wide node layout on the CPU
+    if (detail::traverseWideStack(
+            a.tree,
+            b.tree,
+            q,
+            dr_rot,
+            [&](unsigned int query_node_a, unsigned int query_node_b)
+            {
+                return test_narrow_phase_overlap(dr_rot,
+                                                 a,
+                                                 b,
+                                                 query_node_a,
+                                                 query_node_b,
+                                                 err,
+                                                 abs_tol);
+            }))
         return true;
 #else
 
@@ -535,14 +535,30 @@ DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
     const detail::GPUTree& tree_a = a.members.tree;
     const detail::GPUTree& tree_b = b.members.tree;
 
+    vec3<ShortReal> dr_rot(rotate(conj(b.orientation), -r_ab));
+    quat<ShortReal> q(conj(b.orientation) * a.orientation);
+
+#ifndef __HIPCC__
+    // batched tandem traversal over the four-wide node layout on the CPU
+    return detail::traverseWideStack(tree_a,
+                                     tree_b,
+                                     q,
+                                     dr_rot,
+                                     [&](unsigned int query_node_a, unsigned int query_node_b)
+                                     {
+                                         return test_narrow_phase_overlap(r_ab,
+                                                                          a,
+                                                                          b,
+                                                                          query_node_a,
+                                                                          query_node_b,
+                                                                          err);
+                                     });
+#else
     // perform a tandem tree traversal
     unsigned long int stack = 0;
     unsigned int cur_node_a = 0;
     unsigned int cur_node_b = 0;
 
-    vec3<ShortReal> dr_rot(rotate(conj(b.orientation), -r_ab));
-    quat<ShortReal> q(conj(b.orientation) * a.orientation);
-
     detail::OBB obb_a = tree_a.getOBB(cur_node_a);
     obb_a.affineTransform(q, dr_rot);
 
@@ -570,6 +586,7 @@ DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
         }
 
     return false;
+#endif
     }
 
 template<class Shape>
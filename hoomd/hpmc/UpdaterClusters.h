@@ -12,26 +12,22 @@
 #include "hoomd/RandomNumbers.h"
 #include "hoomd/RNGIdentifiers.h"
 
-#include <set>
+#include <algorithm>
 #include <list>
+#include <set>
 
 #include "Moves.h"
 #include "HPMCCounters.h"
 #include "IntegratorHPMCMono.h"
 
 #ifdef ENABLE_TBB
-#include <tbb/concurrent_unordered_map.h>
-#include <tbb/concurrent_unordered_set.h>
 #include <tbb/concurrent_vector.h>
 #include <tbb/parallel_for.h>
-#include <tbb/task.h>
-#include <atomic>
-
-#if TBB_VERSION_MAJOR < 2021
-#define ENABLE_TBB_TASK
+#include <tbb/task_arena.h>
 #endif
 
-#endif
+#include <atomic>
+#include <memory>
 
 namespace hoomd {
 
@@ -41,53 +37,12 @@ namespace hpmc
 namespace detail
 {
 
-#ifdef ENABLE_TBB_TASK
-//! Wrapper around std::atomic_flag to allow use in a std::vector
-class my_atomic_flag
-    {
-    public:
-        //! Default constructor
-        my_atomic_flag()
-            {
-            f.clear();
-            }
-
-        //! Copy constructor
-        /*! \note this constructor doesn't really copy the value of its argument,
-            it just reset's the flag to zero
-         */
-        my_atomic_flag(const my_atomic_flag& other)
-            {
-            f.clear();
-            }
-
-        //! Assignment operator (non-atomic)
-        /*! \note this assignment operator doesn't really copy the value of its argument,
-            it just reset's the flag to zero
-         */
-        my_atomic_flag& operator =( const my_atomic_flag& other)
-            {
-            f.clear();
-            return *this;
-            }
-
-        //! Sets flag and returns old value
-        bool test_and_set()
-            {
-            return f.test_and_set();
-            }
-
-    private:
-        std::atomic_flag f;
-    };
-#endif
-
-// Graph class represents a undirected graph
-// using adjacency list representation
+// Graph class represents an undirected graph using an edge list
 class Graph
     {
     public:
         Graph()
+            : m_n_vertices(0), m_capacity(0)
             {
             }
 
@@ -95,15 +50,12 @@ class Graph
 
         inline void resize(unsigned int V);
 
+        //! Add an edge (may be called concurrently from multiple threads)
         inline void addEdge(unsigned int v, unsigned int w);
 
-        #ifdef ENABLE_TBB_TASK
-        inline void connectedComponents(std::vector<tbb::concurrent_vector<unsigned int> >& cc);
-        #else
         inline void connectedComponents(std::vector<std::vector<unsigned int> >& cc);
-        #endif
 
-        #ifdef ENABLE_TBB_TASK
+        #ifdef ENABLE_TBB
         void setTaskArena(std::shared_ptr<tbb::task_arena> task_arena)
             {
             m_task_arena = task_arena;
@@ -111,161 +63,141 @@ class Graph
         #endif
 
     private:
-        #ifndef ENABLE_TBB_TASK
-        std::multimap<unsigned int,unsigned int> adj;
-        #else
-        tbb::concurrent_unordered_multimap<unsigned int, unsigned int> adj;
-        #endif
+        unsigned int m_n_vertices;  //!< Number of vertices
+        unsigned int m_capacity;    //!< Allocated size of the union-find forest
+
+        //! Union-find forest, every vertex points to a vertex with lower or equal index
+        std::unique_ptr<std::atomic<unsigned int>[]> m_parent;
+
+        std::vector<unsigned int> m_component; //!< Component index of every root vertex
 
-        #ifndef ENABLE_TBB_TASK
-        std::vector<unsigned int> visited;
+        #ifndef ENABLE_TBB
+        std::vector<std::pair<unsigned int, unsigned int> > m_edges;
         #else
-        std::vector<my_atomic_flag> visited;
-        #endif
+        tbb::concurrent_vector<std::pair<unsigned int, unsigned int> > m_edges;
 
-        #ifdef ENABLE_TBB_TASK
         /// The TBB task arena
         std::shared_ptr<tbb::task_arena> m_task_arena;
         #endif
 
-        #ifndef ENABLE_TBB_TASK
-        // A function used by DFS
-        inline void DFSUtil(unsigned int v, std::vector<unsigned int>& visited, std::vector<unsigned int>& cur_cc);
-        #endif
-
-        #ifdef ENABLE_TBB_TASK
-        class DFSTask : public tbb::task
-            {
-            public:
-                DFSTask(unsigned int _root, std::vector<my_atomic_flag>& _visited,
-                    tbb::concurrent_vector<unsigned int>& _cc,
-                    const tbb::concurrent_unordered_multimap<unsigned int, unsigned int>& _adj)
-                    : root(_root), visited(_visited), cc(_cc), adj(_adj)
-                    { }
-
-                tbb::task* execute()
-                    {
-                    cc.push_back(root);
-
-                    unsigned int count = 0;
-                    tbb::task_list list;
+        //! Find the root of a vertex, halving the path along the way
+        inline unsigned int findRoot(unsigned int v);
 
-                    auto begin = adj.equal_range(root).first;
-                    auto end = adj.equal_range(root).second;
-
-                    for (auto it = begin; it != end; ++it)
-                        {
-                        unsigned int neighbor = it->second;
-                        if (!visited[neighbor].test_and_set())
-                            {
-                            if (count++ == 0)
-                                {
-                                root = neighbor; // for task recycling
-                                continue;
-                                }
-                            list.push_back(*new(allocate_child()) DFSTask(neighbor, visited, cc, adj));
-                            }
-                        }
+        //! Merge the trees of two vertices
+        inline void unite(unsigned int v, unsigned int w);
+    };
 
-                    if (count)
-                        {
-                        set_ref_count(count);
-                        spawn(list);
+/*! Lock-free find with path halving. Concurrent finds and unions only ever move a
+    parent pointer closer to the root, so a failed compare-and-swap is harmless.
+ */
+unsigned int Graph::findRoot(unsigned int v)
+    {
+    unsigned int p = m_parent[v].load(std::memory_order_relaxed);
+    while (p != v)
+        {
+        unsigned int gp = m_parent[p].load(std::memory_order_relaxed);
+        if (p != gp)
+            {
+            unsigned int expected = p;
+            m_parent[v].compare_exchange_weak(expected, gp);
+            }
+        v = gp;
+        p = m_parent[v].load(std::memory_order_relaxed);
+        }
+    return v;
+    }
 
-                        recycle_as_safe_continuation();
-                        }
+/*! Lock-free union. The root with the larger index is always linked below the root with the
+    smaller index, so that the final root of every component is its lowest vertex index.
+ */
+void Graph::unite(unsigned int v, unsigned int w)
+    {
+    while (true)
+        {
+        v = findRoot(v);
+        w = findRoot(w);
 
-                    return NULL;
-                    }
+        if (v == w)
+            return;
 
-            private:
-                unsigned int root;
-                std::vector<my_atomic_flag> & visited;
-                tbb::concurrent_vector<unsigned int>& cc;
-                const tbb::concurrent_unordered_multimap<unsigned int, unsigned int>& adj;
-            };
-        #endif // ENABLE_TBB_TASK
+        if (v < w)
+            std::swap(v, w);
 
-    };
+        // link v below w, unless another thread has linked v in the meantime
+        unsigned int expected = v;
+        if (m_parent[v].compare_exchange_strong(expected, w))
+            return;
+        }
+    }
 
 // Gather connected components in an undirected graph
-#ifdef ENABLE_TBB_TASK
-void Graph::connectedComponents(std::vector<tbb::concurrent_vector<unsigned int> >& cc)
-#else
 void Graph::connectedComponents(std::vector<std::vector<unsigned int> >& cc)
-#endif
     {
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
     this->m_task_arena->execute([&]{
-    for (unsigned int v = 0; v < visited.size(); ++v)
+    tbb::parallel_for(m_edges.range(), [&] (decltype(m_edges.range()) r)
         {
-        if (! visited[v].test_and_set())
-            {
-            tbb::concurrent_vector<unsigned int> component;
-            DFSTask& a = *new(tbb::task::allocate_root()) DFSTask(v, visited, component, adj);
-            tbb::task::spawn_root_and_wait(a);
-            cc.push_back(component);
-            }
-        }
+        for (auto it = r.begin(); it != r.end(); ++it)
+            unite(it->first, it->second);
+        });
+
+    // compress all paths, so that every vertex points directly to its root
+    tbb::parallel_for((unsigned int)0, m_n_vertices, [&](unsigned int v)
+        {
+        m_parent[v].store(findRoot(v), std::memory_order_relaxed);
+        });
     }); // end task arena execute()
     #else
-    std::fill(visited.begin(), visited.end(), 0);
+    for (auto it = m_edges.begin(); it != m_edges.end(); ++it)
+        unite(it->first, it->second);
 
-    // Depth first search
-    for (unsigned int v=0; v<visited.size(); v++)
+    for (unsigned int v = 0; v < m_n_vertices; ++v)
+        m_parent[v].store(findRoot(v), std::memory_order_relaxed);
+    #endif
+
+    // every root precedes the other vertices of its component, components are therefore
+    // ordered by their lowest vertex index and list their vertices in ascending order
+    m_component.resize(m_n_vertices);
+    for (unsigned int v = 0; v < m_n_vertices; ++v)
         {
-        if (visited[v] == false)
+        unsigned int root = m_parent[v].load(std::memory_order_relaxed);
+        if (root == v)
             {
-            std::vector<unsigned int> cur_cc;
-            DFSUtil(v, visited, cur_cc);
-            cc.push_back(cur_cc);
+            m_component[v] = (unsigned int) cc.size();
+            cc.push_back(std::vector<unsigned int>(1, v));
+            }
+        else
+            {
+            cc[m_component[root]].push_back(v);
             }
         }
-    #endif
     }
 
-#ifndef ENABLE_TBB_TASK
-void Graph::DFSUtil(unsigned int v, std::vector<unsigned int>& visited, std::vector<unsigned int>& cur_cc)
-    {
-    visited[v] = 1;
-    cur_cc.push_back(v);
-
-    // Recur for all the vertices
-    // adjacent to this vertex
-    auto begin = adj.equal_range(v).first;
-    auto end = adj.equal_range(v).second;
-    for(auto i = begin; i != end; ++i)
-        {
-        if(!visited[i->second])
-            DFSUtil(i->second, visited, cur_cc);
-        }
-    }
-#endif
 Graph::Graph(unsigned int V)
+    : m_n_vertices(0), m_capacity(0)
     {
-    #ifndef ENABLE_TBB_TASK
-    visited.resize(V, 0);
-    #else
-    visited.resize(V);
-    #endif
+    resize(V);
     }
 
 void Graph::resize(unsigned int V)
     {
-    #ifndef ENABLE_TBB_TASK
-    visited.resize(V, 0);
-    #else
-    visited.clear();
-    visited.resize(V);
-    #endif
+    if (V > m_capacity)
+        {
+        m_parent.reset(new std::atomic<unsigned int>[V]);
+        m_capacity = V;
+        }
 
-    adj.clear();
+    m_n_vertices = V;
+    for (unsigned int v = 0; v < V; ++v)
+        m_parent[v].store(v, std::memory_order_relaxed);
+
+    m_edges.clear();
     }
 
-// method to add a directed edge
+// method to add an undirected edge
 void Graph::addEdge(unsigned int v, unsigned int w)
     {
-    adj.insert(std::make_pair(v,w));
+    m_edges.push_back(std::make_pair(v,w));
     }
 } // end namespace detail
 
@@ -365,13 +297,9 @@ class UpdaterClusters : public Updater
 
         unsigned int m_instance=0;                  //!< Unique ID for RNG seeding
 
-        #ifdef ENABLE_TBB_TASK
-        std::vector<tbb::concurrent_vector<unsigned int> > m_clusters; //!< Cluster components
-        #else
         std::vector<std::vector<unsigned int> > m_clusters; //!< Cluster components
-        #endif
 
-        detail::Graph m_G; //!< The graph
+        detail::Graph m_G; //!< The graph, edges are added concurrently by findInteractions()
 
         hoomd::detail::AABBTree m_aabb_tree_old;              //!< Locality lookup for old configuration
 
@@ -379,16 +307,6 @@ class UpdaterClusters : public Updater
         GlobalVector<Scalar4> m_orientation_backup;    //!< Old local orientations
         GlobalVector<int3> m_image_backup;             //!< Old local images
 
-        #ifndef ENABLE_TBB_TASK
-        std::set<std::pair<unsigned int, unsigned int> > m_overlap;   //!< A local vector of particle pairs due to overlap
-        std::map<std::pair<unsigned int, unsigned int>,LongReal > m_energy_old_old;    //!< Energy of interaction old-old
-        std::map<std::pair<unsigned int, unsigned int>,LongReal > m_energy_new_old;    //!< Energy of interaction old-old
-        #else
-        tbb::concurrent_unordered_set<std::pair<unsigned int, unsigned int> > m_overlap;
-        tbb::concurrent_unordered_map<std::pair<unsigned int, unsigned int>,LongReal > m_energy_old_old;
-        tbb::concurrent_unordered_map<std::pair<unsigned int, unsigned int>,LongReal > m_energy_new_old;
-        #endif
-
         hpmc_clusters_counters_t m_count_total;                 //!< Total count since initialization
         hpmc_clusters_counters_t m_count_run_start;             //!< Count saved at run() start
         hpmc_clusters_counters_t m_count_step_start;            //!< Count saved at the start of the last step
@@ -407,6 +325,11 @@ class UpdaterClusters : public Updater
         */
         virtual void findInteractions(uint64_t timestep, const quat<Scalar> q, const vec3<Scalar> pivot, bool line);
 
+        //! Find interactions, calling the pair potential inline_pair without virtual dispatch
+        template<class InlinePair>
+        void findInteractionsWithPair(uint64_t timestep, const quat<Scalar> q, const vec3<Scalar> pivot, bool line,
+            const InlinePair* inline_pair);
+
         //! Determine connected components of the interaction graph
         virtual void connectedComponents();
 
@@ -426,7 +349,7 @@ UpdaterClusters<Shape>::UpdaterClusters(std::shared_ptr<SystemDefinition> sysdef
     {
     m_exec_conf->msg->notice(5) << "Constructing UpdaterClusters" << std::endl;
 
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
     m_G.setTaskArena(sysdef->getParticleData()->getExecConf()->getTaskArena());
     #endif
 
@@ -494,7 +417,7 @@ inline void UpdaterClusters<Shape>::checkDepletantOverlap(unsigned int i, vec3<S
         }
     img_i = box.getImage(pos_i_transf);
 
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
     this->m_exec_conf->getTaskArena()->execute([&]{
     tbb::parallel_for(tbb::blocked_range<unsigned int>(0, this->m_pdata->getNTypes()),
         [=, &shape_i](const tbb::blocked_range<unsigned int>& x) {
@@ -507,7 +430,7 @@ inline void UpdaterClusters<Shape>::checkDepletantOverlap(unsigned int i, vec3<S
             {
             continue;
             }
-        #ifdef ENABLE_TBB_TASK
+        #ifdef ENABLE_TBB
         tbb::parallel_for(tbb::blocked_range<unsigned int>(type_a, this->m_pdata->getNTypes()),
             [=, &shape_i](const tbb::blocked_range<unsigned int>& w) {
         for (unsigned int type_b = w.begin(); type_b != w.end(); ++type_b)
@@ -655,7 +578,7 @@ inline void UpdaterClusters<Shape>::checkDepletantOverlap(unsigned int i, vec3<S
                 }
 
             // for every depletant
-            #ifdef ENABLE_TBB_TASK
+            #ifdef ENABLE_TBB
             tbb::parallel_for(tbb::blocked_range<unsigned int>(0, (unsigned int)n),
                 [=, &shape_i,
                     &pos_j, &orientation_j, &type_j, &V_all,
@@ -1043,23 +966,20 @@ inline void UpdaterClusters<Shape>::checkDepletantOverlap(unsigned int i, vec3<S
                         if ((overlap_i_a && !overlap_transf_a && overlap_j_b) || (overlap_i_b && !overlap_transf_b & overlap_j_a))
                             {
                             // add bond
-                            this->m_overlap.insert(std::make_pair(i,idx_j[m]));
-
-                            // since i<=j by construction, make matrix symmetric explicitly
-                            this->m_overlap.insert(std::make_pair(idx_j[m],i));
+                            this->m_G.addEdge(i,idx_j[m]);
                             }
                         }
                     } // end loop over intersections
                 } // end loop over depletants
-            #ifdef ENABLE_TBB_TASK
+            #ifdef ENABLE_TBB
                 });
             #endif
             } // end loop over type_b
-        #ifdef ENABLE_TBB_TASK
+        #ifdef ENABLE_TBB
             });
         #endif
         } // end loop over type_a
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
         });
     }); // end task arena execute()
     #endif
@@ -1152,6 +1072,18 @@ void UpdaterClusters<Shape>::flip(uint64_t timestep)
 
 template< class Shape >
 void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scalar> q, const vec3<Scalar> pivot, bool line)
+    {
+    findInteractionsWithPair<PairPotential>(timestep, q, pivot, line, nullptr);
+    }
+
+/*! \param inline_pair Pair potential evaluated through its static type, or null
+
+    See IntegratorHPMCMono::updateWithPair().
+*/
+template< class Shape >
+template< class InlinePair >
+void UpdaterClusters<Shape>::findInteractionsWithPair(uint64_t timestep, const quat<Scalar> q, const vec3<Scalar> pivot,
+    bool line, const InlinePair* inline_pair)
     {
     // access parameters
     auto& params = m_mc->getParams();
@@ -1165,17 +1097,15 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
     Index2D overlap_idx = m_mc->getOverlapIndexer();
     ArrayHandle<unsigned int> h_overlaps(m_mc->getInteractionMatrix(), access_location::host, access_mode::read);
 
-    // clear the local bond and rejection lists
-    m_overlap.clear();
-
+    const bool has_pair_interactions = m_mc->hasPairInteractions();
     Scalar r_cut_patch(0.0);
-    if (m_mc->hasPairInteractions())
+    if (has_pair_interactions)
         {
-        m_energy_old_old.clear();
-        m_energy_new_old.clear();
         r_cut_patch = m_mc->getMaxPairEnergyRCutNonAdditive();
         }
 
+    const uint16_t seed = m_sysdef->getSeed();
+
     // cluster according to overlap of excluded volume shells
     // loop over local particles
     unsigned int nptl = m_pdata->getN();
@@ -1189,111 +1119,10 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
     ArrayHandle<Scalar4> h_postype_backup(m_postype_backup, access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_orientation_backup(m_orientation_backup, access_location::host, access_mode::read);
 
-    if (m_mc->hasPairInteractions())
-        {
-        // test old configuration against itself
-        #ifdef ENABLE_TBB_TASK
-        this->m_exec_conf->getTaskArena()->execute([&]{
-        tbb::parallel_for((unsigned int)0,this->m_pdata->getN(), [&](unsigned int i)
-        #else
-        for (unsigned int i = 0; i < this->m_pdata->getN(); ++i)
-        #endif
-            {
-            unsigned int typ_i = __scalar_as_int(h_postype_backup.data[i].w);
-
-            vec3<Scalar> pos_i(h_postype_backup.data[i]);
-            quat<Scalar> orientation_i(h_orientation_backup.data[i]);
-
-            Scalar d_i(h_diameter.data[i]);
-            Scalar charge_i(h_charge.data[i]);
-
-            // subtract minimum AABB extent from search radius
-            Scalar extent_i = 0.5*m_mc->getMaxPairInteractionAdditiveRCut(typ_i);
-            Scalar R_query = std::max(0.0,r_cut_patch+extent_i-min_core_diameter/(ShortReal)2.0);
-            hoomd::detail::AABB aabb_local = hoomd::detail::AABB(vec3<Scalar>(0,0,0), R_query);
-
-            const unsigned int n_images = (unsigned int) image_list.size();
-
-            for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
-                {
-                vec3<Scalar> pos_i_image = pos_i + image_list[cur_image];
-
-                hoomd::detail::AABB aabb_i_image = aabb_local;
-                aabb_i_image.translate(pos_i_image);
-
-                // stackless search
-                for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree_old.getNumNodes(); cur_node_idx++)
-                    {
-                    if (aabb_i_image.overlaps(m_aabb_tree_old.getNodeAABB(cur_node_idx)))
-                        {
-                        if (m_aabb_tree_old.isNodeLeaf(cur_node_idx))
-                            {
-                            for (unsigned int cur_p = 0; cur_p < m_aabb_tree_old.getNodeNumParticles(cur_node_idx); cur_p++)
-                                {
-                                // read in its position and orientation
-                                unsigned int j = m_aabb_tree_old.getNodeParticle(cur_node_idx, cur_p);
-
-                                if (i == j && cur_image == 0) continue;
-
-                                // load the position and orientation of the j particle
-                                vec3<Scalar> pos_j = vec3<Scalar>(h_postype_backup.data[j]);
-                                unsigned int typ_j = __scalar_as_int(h_postype_backup.data[j].w);
-
-                                // put particles in coordinate system of particle i
-                                vec3<Scalar> r_ij = pos_j - pos_i_image;
-                                Scalar rsq_ij = dot(r_ij, r_ij);
-
-                                Scalar rcut_ij = r_cut_patch + extent_i + 0.5*m_mc->getMaxPairInteractionAdditiveRCut(typ_j);
-
-                                if (rsq_ij <= rcut_ij*rcut_ij)
-                                    {
-                                    // the particle pair
-                                    auto p = std::make_pair(i,j);
-
-                                    // if particle interacts in different image already, add to that energy
-                                    LongReal U = 0.0;
-                                        {
-                                        auto it_energy = m_energy_old_old.find(p);
-                                        if (it_energy != m_energy_old_old.end())
-                                            U = it_energy->second;
-                                        }
-
-                                    U += m_mc->computeOnePairEnergy(rsq_ij,
-                                                        r_ij, typ_i,
-                                                        orientation_i,
-                                                        d_i,
-                                                        charge_i,
-                                                        typ_j,
-                                                        quat<LongReal>(h_orientation_backup.data[j]),
-                                                        h_diameter.data[j],
-                                                        h_charge.data[j]);
-
-                                    // update map
-                                    m_energy_old_old[p] = U;
-                                    } // end if overlap
-
-                                } // end loop over AABB tree leaf
-                            } // end is leaf
-                        } // end if overlap
-                    else
-                        {
-                        // skip ahead
-                        cur_node_idx += m_aabb_tree_old.getNodeSkip(cur_node_idx);
-                        }
-
-                    } // end loop over nodes
-
-                } // end loop over images
-
-            } // end loop over old configuration
-        #ifdef ENABLE_TBB_TASK
-            );
-        }); // end task arena execute()
-        #endif
-        }
-
-    // loop over new configuration
-    #ifdef ENABLE_TBB_TASK
+    // Every particle i owns the pairs (i,j), hence the overlap tests, the interaction energies and
+    // the bond probabilities of one particle can be evaluated independently of all others.
+    // Edges are inserted directly into the (concurrent) edge list of the graph.
+    #ifdef ENABLE_TBB
     this->m_exec_conf->getTaskArena()->execute([&]{
     tbb::parallel_for((unsigned int)0,nptl, [&](unsigned int i)
     #else
@@ -1356,7 +1185,7 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
                                     && test_overlap(r_ij, shape_i, shape_j, err))
                                     {
                                     // add connection
-                                    m_overlap.insert(std::make_pair(i,j));
+                                    m_G.addEdge(i,j);
                                     } // end if overlap
                                 }
 
@@ -1372,87 +1201,112 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
                 } // end loop over nodes
             } // end loop over images
 
-        if (m_mc->hasPairInteractions())
+        if (has_pair_interactions)
             {
+            // energy differences new-old minus old-old, per partner j (summed over images)
+            std::vector< std::pair<unsigned int, LongReal> > delta_U;
+
             // subtract minimum AABB extent from search radius
             Scalar extent_i = 0.5*m_mc->getMaxPairInteractionAdditiveRCut(typ_i);
             Scalar R_query = std::max(0.0,r_cut_patch+extent_i-min_core_diameter/(LongReal)2.0);
             hoomd::detail::AABB aabb_local = hoomd::detail::AABB(vec3<Scalar>(0,0,0), R_query);
 
-            // compute V(r'-r)
-            for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+            // test old configuration against itself, V(r-r), and new configuration against old, V(r'-r)
+            for (unsigned int config = 0; config < 2; ++config)
                 {
-                vec3<Scalar> pos_i_image = pos_i_new + image_list[cur_image];
-
-                hoomd::detail::AABB aabb_i_image = aabb_local;
-                aabb_i_image.translate(pos_i_image);
+                bool old_config = config == 0;
+                vec3<Scalar> pos_i(old_config ? h_postype_backup.data[i] : h_postype.data[i]);
+                quat<LongReal> orientation_i(old_config ? h_orientation_backup.data[i] : h_orientation.data[i]);
+                LongReal sign = old_config ? -1.0 : 1.0;
 
-                // stackless search
-                for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree_old.getNumNodes(); cur_node_idx++)
+                for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
                     {
-                    if (aabb_i_image.overlaps(m_aabb_tree_old.getNodeAABB(cur_node_idx)))
+                    vec3<Scalar> pos_i_image = pos_i + image_list[cur_image];
+
+                    hoomd::detail::AABB aabb_i_image = aabb_local;
+                    aabb_i_image.translate(pos_i_image);
+
+                    // stackless search
+                    for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree_old.getNumNodes(); cur_node_idx++)
                         {
-                        if (m_aabb_tree_old.isNodeLeaf(cur_node_idx))
+                        if (aabb_i_image.overlaps(m_aabb_tree_old.getNodeAABB(cur_node_idx)))
                             {
-                            for (unsigned int cur_p = 0; cur_p < m_aabb_tree_old.getNodeNumParticles(cur_node_idx); cur_p++)
+                            if (m_aabb_tree_old.isNodeLeaf(cur_node_idx))
                                 {
-                                // read in its position and orientation
-                                unsigned int j = m_aabb_tree_old.getNodeParticle(cur_node_idx, cur_p);
-
-                                if (i == j && cur_image == 0) continue;
+                                for (unsigned int cur_p = 0; cur_p < m_aabb_tree_old.getNodeNumParticles(cur_node_idx); cur_p++)
+                                    {
+                                    // read in its position and orientation
+                                    unsigned int j = m_aabb_tree_old.getNodeParticle(cur_node_idx, cur_p);
 
-                                vec3<Scalar> pos_j(h_postype_backup.data[j]);
-                                unsigned int typ_j = __scalar_as_int(h_postype_backup.data[j].w);
+                                    if (i == j && cur_image == 0) continue;
 
-                                // put particles in coordinate system of particle i
-                                vec3<Scalar> r_ij = pos_j - pos_i_image;
+                                    vec3<Scalar> pos_j(h_postype_backup.data[j]);
+                                    unsigned int typ_j = __scalar_as_int(h_postype_backup.data[j].w);
 
-                                // check for excluded volume sphere overlap
-                                Scalar rsq_ij = dot(r_ij, r_ij);
+                                    // put particles in coordinate system of particle i
+                                    vec3<Scalar> r_ij = pos_j - pos_i_image;
 
-                                Scalar rcut_ij = r_cut_patch + extent_i + 0.5*m_mc->getMaxPairInteractionAdditiveRCut(typ_j);
+                                    // check for excluded volume sphere overlap
+                                    Scalar rsq_ij = dot(r_ij, r_ij);
 
-                                if (rsq_ij <= rcut_ij*rcut_ij)
-                                    {
-                                    auto p = std::make_pair(i, j);
+                                    Scalar rcut_ij = r_cut_patch + extent_i + 0.5*m_mc->getMaxPairInteractionAdditiveRCut(typ_j);
 
-                                    // if particle interacts in different image already, add to that energy
-                                    LongReal U = 0.0;
+                                    if (rsq_ij <= rcut_ij*rcut_ij)
                                         {
-                                        auto it_energy = m_energy_new_old.find(p);
-                                        if (it_energy != m_energy_new_old.end())
-                                            U = it_energy->second;
+                                        LongReal U = m_mc->computeOnePairEnergy(inline_pair,
+                                                            rsq_ij,
+                                                            r_ij,
+                                                            typ_i,
+                                                            orientation_i,
+                                                            h_diameter.data[i],
+                                                            h_charge.data[i],
+                                                            typ_j,
+                                                            quat<LongReal>(h_orientation_backup.data[j]),
+                                                            h_diameter.data[j],
+                                                            h_charge.data[j]);
+
+                                        delta_U.push_back(std::make_pair(j, sign*U));
                                         }
+                                    } // end loop over AABB tree leaf
+                                } // end is leaf
+                            } // end if overlap
+                        else
+                            {
+                            // skip ahead
+                            cur_node_idx += m_aabb_tree_old.getNodeSkip(cur_node_idx);
+                            }
 
-                                    U += m_mc->computeOnePairEnergy(rsq_ij,
-                                                        r_ij,
-                                                        typ_i,
-                                                        shape_i.orientation,
-                                                        h_diameter.data[i],
-                                                        h_charge.data[i],
-                                                        typ_j,
-                                                        quat<LongReal>(h_orientation_backup.data[j]),
-                                                        h_diameter.data[j],
-                                                        h_charge.data[j]);
-
-                                    // update map
-                                    m_energy_new_old[p] = U;
-                                    }
-                                } // end loop over AABB tree leaf
-                            } // end is leaf
-                        } // end if overlap
-                    else
-                        {
-                        // skip ahead
-                        cur_node_idx += m_aabb_tree_old.getNodeSkip(cur_node_idx);
-                        }
+                        } // end loop over nodes
 
-                    } // end loop over nodes
+                    } // end loop over images
+                } // end loop over configurations
 
-                } // end loop over images
+            // sum up interaction energies per pair (stable sort keeps the summation order deterministic)
+            std::stable_sort(delta_U.begin(), delta_U.end(),
+                [](const std::pair<unsigned int, LongReal>& a, const std::pair<unsigned int, LongReal>& b)
+                    { return a.first < b.first; });
+
+            for (auto it = delta_U.begin(); it != delta_U.end();)
+                {
+                unsigned int j = it->first;
+                LongReal delU = 0.0;
+                for (; it != delta_U.end() && it->first == j; ++it)
+                    delU += it->second;
+
+                // create a RNG specific to this particle pair
+                hoomd::RandomGenerator rng_ij(hoomd::Seed(hoomd::RNGIdentifier::UpdaterClustersPairwise, timestep, seed),
+                                              hoomd::Counter(std::min(i,j), std::max(i,j)));
+
+                LongReal pij = 1.0f-exp(-delU);
+                if (hoomd::detail::generate_canonical<LongReal>(rng_ij) <= pij) // GCA
+                    {
+                    // add bond
+                    m_G.addEdge(i,j);
+                    }
+                }
             } // end if patch
         } // end loop over local particles
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
         );
     }); // end task arena execute()
     #endif
@@ -1476,7 +1330,7 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
         return;
 
     // test old configuration against itself
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
     this->m_exec_conf->getTaskArena()->execute([&]{
     tbb::parallel_for((unsigned int)0,this->m_pdata->getN(), [&](unsigned int i) {
     #else
@@ -1494,7 +1348,7 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
             h_overlaps.data, h_fugacity.data,
             timestep, q, pivot, line);
         }
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
         });
     }); // end task arena execute()
     #endif
@@ -1623,107 +1477,11 @@ void UpdaterClusters<Shape>::update(uint64_t timestep)
     // signal that AABB tree is invalid
     m_mc->invalidateAABBTree();
 
-    // determine which particles interact
-    findInteractions(timestep, q, pivot, line);
-
-    // resize the number of graph nodes in place
+    // resize the number of graph nodes in place, and clear the edges
     m_G.resize(this->m_pdata->getN());
 
-    #ifdef ENABLE_TBB_TASK
-    this->m_exec_conf->getTaskArena()->execute([&]{
-    tbb::parallel_for(m_overlap.range(), [&] (decltype(m_overlap.range()) r)
-    #else
-    auto &r = m_overlap;
-    #endif
-        {
-        for (auto it = r.begin(); it != r.end(); ++it)
-            {
-            unsigned int i = it->first;
-            unsigned int j = it->second;
-
-            // we're adding a directed edge, but the actual graph will be undirected
-            // if the symmetry operation is self-inverse
-            m_G.addEdge(i,j);
-            }
-        }
-    #ifdef ENABLE_TBB_TASK
-        );
-    }); // end task arena execute()
-    #endif
-
-    if (m_mc->hasPairInteractions())
-        {
-        // sum up interaction energies
-        #ifdef ENABLE_TBB_TASK
-        tbb::concurrent_unordered_map< std::pair<unsigned int, unsigned int>, LongReal> delta_U;
-        #else
-        std::map< std::pair<unsigned int, unsigned int>, LongReal> delta_U;
-        #endif
-
-        for (auto it = m_energy_old_old.begin(); it != m_energy_old_old.end(); ++it)
-            {
-            LongReal delU = -it->second;
-            unsigned int i = it->first.first;
-            unsigned int j = it->first.second;
-
-            auto p = std::make_pair(i,j);
-
-            // add to energy
-            auto itj = delta_U.find(p);
-            if (itj != delta_U.end())
-                delU += itj->second;
-
-            // update map with new interaction energy
-            delta_U[p] = delU;
-            }
-
-        for (auto it = m_energy_new_old.begin(); it != m_energy_new_old.end(); ++it)
-            {
-            LongReal delU = it->second;
-            unsigned int i = it->first.first;
-            unsigned int j = it->first.second;
-
-            auto p = std::make_pair(i,j);
-
-            // add to energy
-            auto itj = delta_U.find(p);
-            if (itj != delta_U.end())
-                delU += itj->second;
-
-            // update map with new interaction energy
-            delta_U[p] = delU;
-            }
-
-        #ifdef ENABLE_TBB_TASK
-        this->m_exec_conf->getTaskArena()->execute([&]{
-        tbb::parallel_for(delta_U.range(), [&] (decltype(delta_U.range()) r)
-        #else
-        auto &r = delta_U;
-        #endif
-            {
-            for (auto it = r.begin(); it != r.end(); ++it)
-                {
-                LongReal delU = it->second;
-                unsigned int i = it->first.first;
-                unsigned int j = it->first.second;
-
-                // create a RNG specific to this particle pair
-                hoomd::RandomGenerator rng_ij(hoomd::Seed(hoomd::RNGIdentifier::UpdaterClustersPairwise, timestep, seed),
-                                              hoomd::Counter(std::min(i,j), std::max(i,j)));
-
-                LongReal pij = 1.0f-exp(-delU);
-                if (hoomd::detail::generate_canonical<LongReal>(rng_ij) <= pij) // GCA
-                    {
-                    // add bond
-                    m_G.addEdge(i,j);
-                    }
-                }
-            }
-        #ifdef ENABLE_TBB_TASK
-            );
-        }); // end task arena execute()
-        #endif
-        } // end if (m_mc->hasPairInteractions)
+    // determine which particles interact
+    findInteractions(timestep, q, pivot, line);
 
     // compute connected components
     connectedComponents();
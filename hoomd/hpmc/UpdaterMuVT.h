@@ -13,6 +13,10 @@
 #include "Moves.h"
 #include "hoomd/RandomNumbers.h"
 
+#ifdef ENABLE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 #ifndef __HIPCC__
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
@@ -147,6 +151,22 @@ template<class Shape> class UpdaterMuVT : public Updater
         return m_n_trial;
         }
 
+    //! Set the number of trial positions per insertion (and removal) attempt
+    void setNInsertionTrials(unsigned int n_insertion_trials)
+        {
+        if (n_insertion_trials == 0)
+            {
+            throw std::runtime_error("n_insertion_trials must be at least 1.\n");
+            }
+        m_n_insertion_trials = n_insertion_trials;
+        }
+
+    //! Get the number of trial positions per insertion attempt
+    unsigned int getNInsertionTrials()
+        {
+        return m_n_insertion_trials;
+        }
+
     //! Get the current counter values
     hpmc_muvt_counters_t getCounters(unsigned int mode = 0);
 
@@ -179,6 +199,8 @@ template<class Shape> class UpdaterMuVT : public Updater
 
     unsigned int m_n_trial;
 
+    unsigned int m_n_insertion_trials; //!< Number of trial positions per insertion attempt
+
     /*! Check for overlaps of a fictitious particle
      * \param timestep Current time step
      * \param type Type of particle to test
@@ -193,6 +215,80 @@ template<class Shape> class UpdaterMuVT : public Updater
                                    quat<Scalar> orientation,
                                    Scalar& lnboltzmann);
 
+    /*! Check for overlaps of a batch of independent fictitious particles (concurrently)
+     * \param timestep Current time step
+     * \param type Type of particles to test
+     * \param pos Positions of the fictitious particles
+     * \param orientation Orientations of the fictitious particles
+     * \param skip_tag Tag of a particle that is ignored in the overlap checks (UINT_MAX if none)
+     * \param lnboltzmann Log of Boltzmann weight of every insertion attempt (return value)
+     * \param overlap Non-zero if the insertion attempt generates an overlap (return value)
+     *
+     * Depletants are not supported.
+     */
+    virtual void tryInsertParticles(uint64_t timestep,
+                                    unsigned int type,
+                                    const std::vector<vec3<Scalar>>& pos,
+                                    const std::vector<quat<Scalar>>& orientation,
+                                    unsigned int skip_tag,
+                                    std::vector<Scalar>& lnboltzmann,
+                                    std::vector<unsigned int>& overlap);
+
+    /*! Compute the local overlaps and energy of a fictitious particle
+     * \param type Type of particle to test
+     * \param pos Position of fictitious particle
+     * \param orientation Orientation of particle
+     * \param skip_tag Tag of a particle that is ignored (UINT_MAX if none)
+     * \param aabb_tree AABB tree of the local particles (nullptr if there are none)
+     * \param image_list Periodic images to check
+     * \param h_tag Particle tags
+     * \param h_postype Particle positions and types
+     * \param h_orientation Particle orientations
+     * \param h_diameter Particle diameters
+     * \param h_charge Particle charges
+     * \param h_overlaps Interaction matrix
+     * \param lnboltzmann Log of Boltzmann weight of insertion attempt (return value)
+     * \returns True if the particle overlaps
+     *
+     * This method does not modify any state and may be called concurrently.
+     */
+    bool computeInsertionLocal(unsigned int type,
+                               const vec3<Scalar>& pos,
+                               const quat<Scalar>& orientation,
+                               unsigned int skip_tag,
+                               const hoomd::detail::AABBTree* aabb_tree,
+                               const std::vector<vec3<Scalar>>& image_list,
+                               const unsigned int* h_tag,
+                               const Scalar4* h_postype,
+                               const Scalar4* h_orientation,
+                               const Scalar* h_diameter,
+                               const Scalar* h_charge,
+                               const unsigned int* h_overlaps,
+                               Scalar& lnboltzmann);
+
+    /*! Generate trial positions and orientations uniformly in the box
+     * \param rng The random number generator
+     * \param type Type of particle to insert
+     * \param n Number of trials to append
+     * \param pos List of trial positions (appended to)
+     * \param orientation List of trial orientations (appended to)
+     */
+    void generateInsertionTrials(hoomd::RandomGenerator& rng,
+                                 unsigned int type,
+                                 unsigned int n,
+                                 std::vector<vec3<Scalar>>& pos,
+                                 std::vector<quat<Scalar>>& orientation);
+
+    /*! Compute the Rosenbluth weight of a set of trials, W = 1/k sum_l exp(lnboltzmann_l)
+     * \param lnboltzmann Log of Boltzmann weight of every trial
+     * \param overlap Non-zero for trials with vanishing weight
+     * \param ln_W Log of the Rosenbluth weight (return value)
+     * \returns True if W is non-zero
+     */
+    bool computeRosenbluthWeight(const std::vector<Scalar>& lnboltzmann,
+                                 const std::vector<unsigned int>& overlap,
+                                 Scalar& ln_W);
+
     /*! Try removing a particle
         \param timestep Current time step
         \param tag Tag of particle being removed
@@ -334,7 +430,8 @@ UpdaterMuVT<Shape>::UpdaterMuVT(std::shared_ptr<SystemDefinition> sysdef,
                                 std::shared_ptr<IntegratorHPMCMono<Shape>> mc,
                                 unsigned int npartition)
     : Updater(sysdef, trigger), m_mc(mc), m_npartition(npartition), m_gibbs(false),
-      m_max_vol_rescale(0.1), m_volume_move_probability(0.5), m_gibbs_other(0), m_n_trial(1)
+      m_max_vol_rescale(0.1), m_volume_move_probability(0.5), m_gibbs_other(0), m_n_trial(1),
+      m_n_insertion_trials(1)
     {
     m_fugacity.resize(m_pdata->getNTypes(), std::shared_ptr<Variant>(new VariantConstant(0.0)));
     m_type_map.resize(m_pdata->getNTypes());
@@ -972,6 +1069,23 @@ template<class Shape> void UpdaterMuVT<Shape>::update(uint64_t timestep)
             }
 #endif
 
+        if (m_n_insertion_trials > 1)
+            {
+            if (m_gibbs)
+                {
+                throw std::runtime_error(
+                    "Multiple insertion trials are not supported in the Gibbs ensemble.\n");
+                }
+            for (unsigned int type_d = 0; type_d < this->m_pdata->getNTypes(); ++type_d)
+                {
+                if (m_mc->getDepletantFugacity(type_d) != 0.0)
+                    {
+                    throw std::runtime_error(
+                        "Multiple insertion trials are not supported with depletants.\n");
+                    }
+                }
+            }
+
         // whether we insert or remove a particle
         bool insert = m_gibbs ? mod : hoomd::UniformIntDistribution(1)(rng);
 
@@ -1086,14 +1200,70 @@ template<class Shape> void UpdaterMuVT<Shape>::update(uint64_t timestep)
                     lnboltzmann = log(fugacity * V / (Scalar)(nptl_type + 1));
                     }
 
-                // check if particle can be inserted without overlaps
-                Scalar lnb(0.0);
-                unsigned int nonzero
-                    = tryInsertParticle(timestep, type, pos_test, shape_test.orientation, lnb);
+                unsigned int nonzero;
+                if (m_n_insertion_trials == 1)
+                    {
+                    // check if particle can be inserted without overlaps
+                    Scalar lnb(0.0);
+                    nonzero
+                        = tryInsertParticle(timestep, type, pos_test, shape_test.orientation, lnb);
 
-                if (nonzero)
+                    if (nonzero)
+                        {
+                        lnboltzmann += lnb;
+                        }
+                    }
+                else
                     {
-                    lnboltzmann += lnb;
+                    // multiple-trial insertion: evaluate k independent trial positions (the first
+                    // one drawn above), accept with the Rosenbluth weight W = 1/k sum_l w_l and
+                    // insert at trial l with probability w_l / (k W)
+                    std::vector<vec3<Scalar>> pos_trial(1, pos_test);
+                    std::vector<quat<Scalar>> orientation_trial(1, shape_test.orientation);
+                    generateInsertionTrials(rng,
+                                            type,
+                                            m_n_insertion_trials - 1,
+                                            pos_trial,
+                                            orientation_trial);
+
+                    std::vector<Scalar> lnb;
+                    std::vector<unsigned int> overlap;
+                    tryInsertParticles(timestep,
+                                       type,
+                                       pos_trial,
+                                       orientation_trial,
+                                       UINT_MAX,
+                                       lnb,
+                                       overlap);
+
+                    Scalar ln_W(0.0);
+                    nonzero = computeRosenbluthWeight(lnb, overlap, ln_W);
+
+                    if (nonzero)
+                        {
+                        lnboltzmann += ln_W;
+
+                        // select one of the trials according to its weight
+                        Scalar w_sum(0.0);
+                        for (unsigned int l = 0; l < m_n_insertion_trials; ++l)
+                            {
+                            if (!overlap[l])
+                                w_sum += exp(lnb[l] - ln_W);
+                            }
+                        Scalar u = hoomd::detail::generate_canonical<Scalar>(rng) * w_sum;
+                        unsigned int selected = 0;
+                        for (unsigned int l = 0; l < m_n_insertion_trials; ++l)
+                            {
+                            if (overlap[l])
+                                continue;
+                            selected = l;
+                            u -= exp(lnb[l] - ln_W);
+                            if (u < Scalar(0.0))
+                                break;
+                            }
+                        pos_test = pos_trial[selected];
+                        shape_test.orientation = orientation_trial[selected];
+                        }
                     }
 
 #ifdef ENABLE_MPI
@@ -1274,7 +1444,38 @@ template<class Shape> void UpdaterMuVT<Shape>::update(uint64_t timestep)
             Scalar lnb(0.0);
             if (tryRemoveParticle(timestep, tag, lnb))
                 {
-                lnboltzmann += lnb;
+                if (m_n_insertion_trials == 1)
+                    {
+                    lnboltzmann += lnb;
+                    }
+                else
+                    {
+                    // the reverse move is a multiple-trial insertion into the system without the
+                    // particle, where the particle being removed is one of the k trials
+                    std::vector<vec3<Scalar>> pos_trial;
+                    std::vector<quat<Scalar>> orientation_trial;
+                    generateInsertionTrials(rng_local,
+                                            type,
+                                            m_n_insertion_trials - 1,
+                                            pos_trial,
+                                            orientation_trial);
+
+                    std::vector<Scalar> lnb_trial;
+                    std::vector<unsigned int> overlap;
+                    tryInsertParticles(timestep,
+                                       type,
+                                       pos_trial,
+                                       orientation_trial,
+                                       tag,
+                                       lnb_trial,
+                                       overlap);
+                    lnb_trial.push_back(-lnb);
+                    overlap.push_back(0);
+
+                    Scalar ln_W(0.0);
+                    computeRosenbluthWeight(lnb_trial, overlap, ln_W);
+                    lnboltzmann -= ln_W;
+                    }
                 }
             else
                 {
@@ -1948,12 +2149,6 @@ bool UpdaterMuVT<Shape>::tryInsertParticle(uint64_t timestep,
         {
         // get some data structures from the integrator
         auto& image_list = m_mc->updateImageList();
-        const unsigned int n_images = (unsigned int)image_list.size();
-        auto& params = m_mc->getParams();
-
-        const Index2D& overlap_idx = m_mc->getOverlapIndexer();
-
-        LongReal r_cut_patch(0.0);
 
         unsigned int p = m_exec_conf->getPartition() % m_npartition;
 
@@ -1969,165 +2164,43 @@ bool UpdaterMuVT<Shape>::tryInsertParticle(uint64_t timestep,
             );
             }
 
-        if (m_mc->hasPairInteractions())
-            {
-            r_cut_patch = m_mc->getMaxPairEnergyRCutNonAdditive()
-                          + LongReal(0.5) * m_mc->getMaxPairInteractionAdditiveRCut(type);
-            }
-
-        unsigned int err_count = 0;
-
-            {
-            // check for overlaps
-            ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
-                                           access_location::host,
-                                           access_mode::read);
-            ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
-                                               access_location::host,
-                                               access_mode::read);
-            ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
-                                           access_location::host,
-                                           access_mode::read);
-            ArrayHandle<Scalar> h_charge(m_pdata->getCharges(),
-                                         access_location::host,
-                                         access_mode::read);
-
-            ArrayHandle<unsigned int> h_overlaps(m_mc->getInteractionMatrix(),
-                                                 access_location::host,
-                                                 access_mode::read);
-
-            // read in the current position and orientation
-            Shape shape(orientation, params[type]);
-
-            for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
-                {
-                vec3<Scalar> pos_image = pos + image_list[cur_image];
-
-                if (cur_image != 0)
-                    {
-                    // check for self-overlap with all images except the original
-                    vec3<Scalar> r_ij = pos - pos_image;
-                    if (h_overlaps.data[overlap_idx(type, type)]
-                        && check_circumsphere_overlap(r_ij, shape, shape)
-                        && test_overlap(r_ij, shape, shape, err_count))
-                        {
-                        overlap = 1;
-                        break;
-                        }
-
-                    // self-energy
-                    lnboltzmann -= m_mc->computeOnePairEnergy(dot(r_ij, r_ij),
-                                                              r_ij,
-                                                              type,
-                                                              orientation,
-                                                              1.0, // diameter i
-                                                              0.0, // charge i
-                                                              type,
-                                                              orientation,
-                                                              1.0, // diameter i
-                                                              0.0  // charge i
-                    );
-                    }
-                }
-            }
-
         // we cannot rely on a valid AABB tree when there are 0 particles
-        if (!overlap && nptl_local > 0)
+        const hoomd::detail::AABBTree* aabb_tree = nullptr;
+        if (nptl_local > 0)
             {
-            // Check particle against AABB tree for neighbors
-            const hoomd::detail::AABBTree& aabb_tree = m_mc->buildAABBTree();
+            aabb_tree = &m_mc->buildAABBTree();
+            }
 
-            ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
-                                           access_location::host,
-                                           access_mode::read);
-            ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
-                                               access_location::host,
-                                               access_mode::read);
-            ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
+                                       access_location::host,
+                                       access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
                                            access_location::host,
                                            access_mode::read);
-            ArrayHandle<Scalar> h_charge(m_pdata->getCharges(),
-                                         access_location::host,
-                                         access_mode::read);
-            ArrayHandle<unsigned int> h_overlaps(m_mc->getInteractionMatrix(),
-                                                 access_location::host,
-                                                 access_mode::read);
-
-            Shape shape(orientation, params[type]);
-            LongReal R_query = std::max(shape.getCircumsphereDiameter() / LongReal(2.0),
-                                        r_cut_patch - m_mc->getMinCoreDiameter() / LongReal(2.0));
-            hoomd::detail::AABB aabb_local = hoomd::detail::AABB(vec3<Scalar>(0, 0, 0), R_query);
-
-            for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
-                {
-                vec3<Scalar> pos_image = pos + image_list[cur_image];
-
-                hoomd::detail::AABB aabb = aabb_local;
-                aabb.translate(pos_image);
-
-                // stackless search
-                for (unsigned int cur_node_idx = 0; cur_node_idx < aabb_tree.getNumNodes();
-                     cur_node_idx++)
-                    {
-                    if (aabb.overlaps(aabb_tree.getNodeAABB(cur_node_idx)))
-                        {
-                        if (aabb_tree.isNodeLeaf(cur_node_idx))
-                            {
-                            for (unsigned int cur_p = 0;
-                                 cur_p < aabb_tree.getNodeNumParticles(cur_node_idx);
-                                 cur_p++)
-                                {
-                                // read in its position and orientation
-                                unsigned int j = aabb_tree.getNodeParticle(cur_node_idx, cur_p);
-
-                                Scalar4 postype_j = h_postype.data[j];
-                                quat<LongReal> orientation_j(h_orientation.data[j]);
-
-                                // put particles in coordinate system of particle i
-                                vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_image;
-
-                                unsigned int typ_j = __scalar_as_int(postype_j.w);
-                                Shape shape_j(orientation_j, params[typ_j]);
-
-                                if (h_overlaps.data[overlap_idx(type, typ_j)]
-                                    && check_circumsphere_overlap(r_ij, shape, shape_j)
-                                    && test_overlap(r_ij, shape, shape_j, err_count))
-                                    {
-                                    overlap = 1;
-                                    break;
-                                    }
-
-                                lnboltzmann -= m_mc->computeOnePairEnergy(dot(r_ij, r_ij),
-                                                                          r_ij,
-                                                                          type,
-                                                                          orientation,
-                                                                          1.0, // diameter i
-                                                                          0.0, // charge i
-                                                                          typ_j,
-                                                                          orientation_j,
-                                                                          h_diameter.data[j],
-                                                                          h_charge.data[j]);
-                                }
-                            }
-                        }
-                    else
-                        {
-                        // skip ahead
-                        cur_node_idx += aabb_tree.getNodeSkip(cur_node_idx);
-                        }
-
-                    if (overlap)
-                        {
-                        break;
-                        }
-                    } // end loop over AABB nodes
+        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                       access_location::host,
+                                       access_mode::read);
+        ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_overlaps(m_mc->getInteractionMatrix(),
+                                             access_location::host,
+                                             access_mode::read);
 
-                if (overlap)
-                    {
-                    break;
-                    }
-                } // end loop over images
-            } // end if nptl_local > 0
+        Scalar lnb(0.0);
+        overlap = computeInsertionLocal(type,
+                                        pos,
+                                        orientation,
+                                        UINT_MAX,
+                                        aabb_tree,
+                                        image_list,
+                                        h_tag.data,
+                                        h_postype.data,
+                                        h_orientation.data,
+                                        h_diameter.data,
+                                        h_charge.data,
+                                        h_overlaps.data,
+                                        lnb);
+        lnboltzmann += lnb;
         } // end if local
 
 #ifdef ENABLE_MPI
@@ -2281,6 +2354,333 @@ bool UpdaterMuVT<Shape>::tryInsertParticle(uint64_t timestep,
     return nonzero;
     }
 
+template<class Shape>
+bool UpdaterMuVT<Shape>::computeInsertionLocal(unsigned int type,
+                                               const vec3<Scalar>& pos,
+                                               const quat<Scalar>& orientation,
+                                               unsigned int skip_tag,
+                                               const hoomd::detail::AABBTree* aabb_tree,
+                                               const std::vector<vec3<Scalar>>& image_list,
+                                               const unsigned int* h_tag,
+                                               const Scalar4* h_postype,
+                                               const Scalar4* h_orientation,
+                                               const Scalar* h_diameter,
+                                               const Scalar* h_charge,
+                                               const unsigned int* h_overlaps,
+                                               Scalar& lnboltzmann)
+    {
+    lnboltzmann = Scalar(0.0);
+
+    const unsigned int n_images = (unsigned int)image_list.size();
+    auto& params = m_mc->getParams();
+    const Index2D& overlap_idx = m_mc->getOverlapIndexer();
+
+    LongReal r_cut_patch(0.0);
+    if (m_mc->hasPairInteractions())
+        {
+        r_cut_patch = m_mc->getMaxPairEnergyRCutNonAdditive()
+                      + LongReal(0.5) * m_mc->getMaxPairInteractionAdditiveRCut(type);
+        }
+
+    unsigned int err_count = 0;
+
+    // read in the current position and orientation
+    Shape shape(orientation, params[type]);
+
+    for (unsigned int cur_image = 1; cur_image < n_images; cur_image++)
+        {
+        vec3<Scalar> pos_image = pos + image_list[cur_image];
+
+        // check for self-overlap with all images except the original
+        vec3<Scalar> r_ij = pos - pos_image;
+        if (h_overlaps[overlap_idx(type, type)] && check_circumsphere_overlap(r_ij, shape, shape)
+            && test_overlap(r_ij, shape, shape, err_count))
+            {
+            return true;
+            }
+
+        // self-energy
+        lnboltzmann -= m_mc->computeOnePairEnergy(dot(r_ij, r_ij),
+                                                  r_ij,
+                                                  type,
+                                                  orientation,
+                                                  1.0, // diameter i
+                                                  0.0, // charge i
+                                                  type,
+                                                  orientation,
+                                                  1.0, // diameter i
+                                                  0.0  // charge i
+        );
+        }
+
+    if (!aabb_tree)
+        {
+        return false;
+        }
+
+    // Check particle against AABB tree for neighbors
+    LongReal R_query = std::max(shape.getCircumsphereDiameter() / LongReal(2.0),
+                                r_cut_patch - m_mc->getMinCoreDiameter() / LongReal(2.0));
+    hoomd::detail::AABB aabb_local = hoomd::detail::AABB(vec3<Scalar>(0, 0, 0), R_query);
+
+    for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+        {
+        vec3<Scalar> pos_image = pos + image_list[cur_image];
+
+        hoomd::detail::AABB aabb = aabb_local;
+        aabb.translate(pos_image);
+
+        // stackless search
+        for (unsigned int cur_node_idx = 0; cur_node_idx < aabb_tree->getNumNodes(); cur_node_idx++)
+            {
+            if (aabb.overlaps(aabb_tree->getNodeAABB(cur_node_idx)))
+                {
+                if (aabb_tree->isNodeLeaf(cur_node_idx))
+                    {
+                    for (unsigned int cur_p = 0; cur_p < aabb_tree->getNodeNumParticles(cur_node_idx);
+                         cur_p++)
+                        {
+                        // read in its position and orientation
+                        unsigned int j = aabb_tree->getNodeParticle(cur_node_idx, cur_p);
+
+                        if (h_tag[j] == skip_tag)
+                            continue;
+
+                        Scalar4 postype_j = h_postype[j];
+                        quat<LongReal> orientation_j(h_orientation[j]);
+
+                        // put particles in coordinate system of particle i
+                        vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_image;
+
+                        unsigned int typ_j = __scalar_as_int(postype_j.w);
+                        Shape shape_j(orientation_j, params[typ_j]);
+
+                        if (h_overlaps[overlap_idx(type, typ_j)]
+                            && check_circumsphere_overlap(r_ij, shape, shape_j)
+                            && test_overlap(r_ij, shape, shape_j, err_count))
+                            {
+                            return true;
+                            }
+
+                        lnboltzmann -= m_mc->computeOnePairEnergy(dot(r_ij, r_ij),
+                                                                  r_ij,
+                                                                  type,
+                                                                  orientation,
+                                                                  1.0, // diameter i
+                                                                  0.0, // charge i
+                                                                  typ_j,
+                                                                  orientation_j,
+                                                                  h_diameter[j],
+                                                                  h_charge[j]);
+                        }
+                    }
+                }
+            else
+                {
+                // skip ahead
+                cur_node_idx += aabb_tree->getNodeSkip(cur_node_idx);
+                }
+            } // end loop over AABB nodes
+        } // end loop over images
+
+    return false;
+    }
+
+template<class Shape>
+void UpdaterMuVT<Shape>::tryInsertParticles(uint64_t timestep,
+                                            unsigned int type,
+                                            const std::vector<vec3<Scalar>>& pos,
+                                            const std::vector<quat<Scalar>>& orientation,
+                                            unsigned int skip_tag,
+                                            std::vector<Scalar>& lnboltzmann,
+                                            std::vector<unsigned int>& overlap)
+    {
+    const unsigned int n_trial = (unsigned int)pos.size();
+    lnboltzmann.assign(n_trial, Scalar(0.0));
+    overlap.assign(n_trial, 0);
+
+    // determine the trial positions that are local to this rank
+    std::vector<unsigned int> is_local(n_trial, 1);
+#ifdef ENABLE_MPI
+    if (this->m_pdata->getDomainDecomposition())
+        {
+        const BoxDim global_box = this->m_pdata->getGlobalBox();
+        ArrayHandle<unsigned int> h_cart_ranks(
+            this->m_pdata->getDomainDecomposition()->getCartRanks(),
+            access_location::host,
+            access_mode::read);
+        for (unsigned int l = 0; l < n_trial; ++l)
+            {
+            is_local[l]
+                = this->m_exec_conf->getRank()
+                  == this->m_pdata->getDomainDecomposition()->placeParticle(global_box,
+                                                                            vec_to_scalar3(pos[l]),
+                                                                            h_cart_ranks.data);
+            }
+        }
+#endif
+
+    // do we have to compute a wall contribution?
+    auto field = m_mc->getExternalField();
+    const BoxDim box = this->m_pdata->getGlobalBox();
+
+    // update the locality data structures before evaluating trials concurrently
+    const std::vector<vec3<Scalar>>& image_list = m_mc->updateImageList();
+    const hoomd::detail::AABBTree* aabb_tree = nullptr;
+    if (m_pdata->getN() + m_pdata->getNGhosts() > 0)
+        {
+        aabb_tree = &m_mc->buildAABBTree();
+        }
+
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                       access_location::host,
+                                       access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_overlaps(m_mc->getInteractionMatrix(),
+                                         access_location::host,
+                                         access_mode::read);
+
+    // evaluate the independent trials
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&]
+        {
+            tbb::parallel_for((unsigned int)0,
+                              n_trial,
+                              [&](unsigned int l)
+#else
+    for (unsigned int l = 0; l < n_trial; ++l)
+#endif
+                              {
+                                  if (is_local[l])
+                                      {
+                                      Scalar lnb(0.0);
+                                      if (field)
+                                          {
+                                          lnb -= field->energy(box,
+                                                               type,
+                                                               pos[l],
+                                                               quat<float>(orientation[l]),
+                                                               1.0, // diameter i
+                                                               0.0  // charge i
+                                          );
+                                          }
+
+                                      Scalar lnb_pair(0.0);
+                                      overlap[l] = computeInsertionLocal(type,
+                                                                         pos[l],
+                                                                         orientation[l],
+                                                                         skip_tag,
+                                                                         aabb_tree,
+                                                                         image_list,
+                                                                         h_tag.data,
+                                                                         h_postype.data,
+                                                                         h_orientation.data,
+                                                                         h_diameter.data,
+                                                                         h_charge.data,
+                                                                         h_overlaps.data,
+                                                                         lnb_pair);
+                                      lnboltzmann[l] = lnb + lnb_pair;
+                                      }
+                              }
+#ifdef ENABLE_TBB
+            );
+        });
+#endif
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &lnboltzmann.front(),
+                      n_trial,
+                      MPI_HOOMD_SCALAR,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &overlap.front(),
+                      n_trial,
+                      MPI_UNSIGNED,
+                      MPI_MAX,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+    }
+
+template<class Shape>
+void UpdaterMuVT<Shape>::generateInsertionTrials(hoomd::RandomGenerator& rng,
+                                                 unsigned int type,
+                                                 unsigned int n,
+                                                 std::vector<vec3<Scalar>>& pos,
+                                                 std::vector<quat<Scalar>>& orientation)
+    {
+    unsigned int ndim = this->m_sysdef->getNDimensions();
+    Shape shape_test(quat<Scalar>(), m_mc->getParams()[type]);
+    const BoxDim global_box = m_pdata->getGlobalBox();
+
+    for (unsigned int l = 0; l < n; ++l)
+        {
+        // Propose a random position uniformly in the box
+        Scalar3 f;
+        f.x = hoomd::detail::generate_canonical<Scalar>(rng);
+        f.y = hoomd::detail::generate_canonical<Scalar>(rng);
+        if (ndim == 2)
+            {
+            f.z = Scalar(0.5);
+            }
+        else
+            {
+            f.z = hoomd::detail::generate_canonical<Scalar>(rng);
+            }
+        pos.push_back(vec3<Scalar>(global_box.makeCoordinates(f)));
+
+        quat<Scalar> o;
+        if (shape_test.hasOrientation())
+            {
+            o = generateRandomOrientation(rng, ndim);
+            }
+        orientation.push_back(o);
+        }
+    }
+
+template<class Shape>
+bool UpdaterMuVT<Shape>::computeRosenbluthWeight(const std::vector<Scalar>& lnboltzmann,
+                                                 const std::vector<unsigned int>& overlap,
+                                                 Scalar& ln_W)
+    {
+    // factor out the largest weight to avoid overflow
+    bool nonzero = false;
+    Scalar ln_max(0.0);
+    for (unsigned int l = 0; l < lnboltzmann.size(); ++l)
+        {
+        if (overlap[l])
+            continue;
+        if (!nonzero || lnboltzmann[l] > ln_max)
+            ln_max = lnboltzmann[l];
+        nonzero = true;
+        }
+
+    if (!nonzero)
+        {
+        return false;
+        }
+
+    Scalar sum(0.0);
+    for (unsigned int l = 0; l < lnboltzmann.size(); ++l)
+        {
+        if (!overlap[l])
+            sum += exp(lnboltzmann[l] - ln_max);
+        }
+
+    ln_W = ln_max + log(sum / Scalar(lnboltzmann.size()));
+    return true;
+    }
+
 /*! \param mode 0 -> Absolute count, 1 -> relative to the start of the run, 2 -> relative to the
    last executed step \return The current state of the acceptance counters
 
@@ -3113,6 +3513,9 @@ template<class Shape> void export_UpdaterMuVT(pybind11::module& m, const std::st
                       &UpdaterMuVT<Shape>::getTransferTypes,
                       &UpdaterMuVT<Shape>::setTransferTypes)
         .def_property("ntrial", &UpdaterMuVT<Shape>::getNTrial, &UpdaterMuVT<Shape>::setNTrial)
+        .def_property("n_insertion_trials",
+                      &UpdaterMuVT<Shape>::getNInsertionTrials,
+                      &UpdaterMuVT<Shape>::setNInsertionTrials)
         .def_property_readonly("N", &UpdaterMuVT<Shape>::getN)
         .def("getCounters", &UpdaterMuVT<Shape>::getCounters);
     }
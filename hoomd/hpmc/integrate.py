@@ -437,7 +437,7 @@ class HPMCIntegrator(Integrator):
         self._simulation._warn_if_seed_unset()
         sys_def = self._simulation.state._cpp_sys_def
         if (isinstance(self._simulation.device, hoomd.device.GPU)
-                and (self._cpp_cls + 'GPU') in _hpmc.__dict__):
+                and (self._cpp_cls + 'GPU') in self._ext_module.__dict__):
             self._cpp_cell = _hoomd.CellListGPU(sys_def)
             self._cpp_obj = getattr(self._ext_module,
                                     self._cpp_cls + 'GPU')(sys_def,
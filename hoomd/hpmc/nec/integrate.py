@@ -18,6 +18,21 @@ class HPMCNECIntegrator(HPMCIntegrator):
     integrators. The attributes documented here are available to all HPMC
     integrators.
 
+    .. rubric:: Checkerboard chains
+
+    When ``checkerboard`` is `True`, the integrator divides the box into cells
+    at least one circumsphere diameter wide and runs the chains in
+    non-adjacent cells concurrently on the CPU threads of the device.
+    Particles outside the active cells do not move. Chains reflect off those
+    particles and off the cell walls. The cell grid is shifted randomly every
+    sweep. Each sweep performs about ``update_fraction * N`` chains, as in the
+    serial mode. When the box is less than two cells wide in any direction,
+    the sweep runs in serial. ``virial_pressure`` also counts the reflections
+    off frozen particles. Reflections at the cell walls add no virial.
+
+    Each chain stops after at most ``max_chain_events`` collisions and sweeps,
+    and the integrator reports an error when a chain reaches this limit.
+
     Warning:
         This class should not be instantiated by users. The class can be used
         for `isinstance` or `issubclass` checks.
@@ -30,7 +45,9 @@ class HPMCNECIntegrator(HPMCIntegrator):
                  chain_probability=0.5,
                  chain_time=0.5,
                  update_fraction=0.5,
-                 nselect=1):
+                 nselect=1,
+                 checkerboard=False,
+                 max_chain_events=100000):
         # initialize base class
         super().__init__(default_d, default_a, 0.5, nselect)
 
@@ -40,11 +57,15 @@ class HPMCNECIntegrator(HPMCIntegrator):
                 float, postprocess=self._process_chain_probability),
             chain_time=OnlyTypes(float, postprocess=self._process_chain_time),
             update_fraction=OnlyTypes(
-                float, postprocess=self._process_update_fraction))
+                float, postprocess=self._process_update_fraction),
+            checkerboard=bool(checkerboard),
+            max_chain_events=OnlyTypes(
+                int, postprocess=self._process_max_chain_events))
         self._param_dict.update(param_dict)
         self.chain_probability = chain_probability
         self.chain_time = chain_time
         self.update_fraction = update_fraction
+        self.max_chain_events = max_chain_events
 
     @staticmethod
     def _process_chain_probability(value):
@@ -72,6 +93,14 @@ class HPMCNECIntegrator(HPMCIntegrator):
                 "update_fraction has to be between 0 and 1. (got {})".format(
                     value))
 
+    @staticmethod
+    def _process_max_chain_events(value):
+        if value >= 1:
+            return value
+        else:
+            raise ValueError(
+                "max_chain_events has to be at least 1 (got {}).".format(value))
+
     @property
     def nec_counters(self):
         """Trial move counters.
@@ -141,6 +170,10 @@ class Sphere(HPMCNECIntegrator):
             fraction of N, defaults to 0.5.
         nselect (`int`, optional): The number of repeated updates to perform in
             each cell, defaults to 1.
+        checkerboard (`bool`, optional): Run chains concurrently in a
+            checkerboard of cells, defaults to `False`.
+        max_chain_events (`int`, optional): Maximum number of events in one
+            chain, defaults to 100000.
 
     Perform Newtonian event chain Monte Carlo integration of spheres.
 
@@ -168,6 +201,11 @@ class Sphere(HPMCNECIntegrator):
 
         update_fraction (float): Number of chains to be done as fraction of N.
 
+        checkerboard (bool): Run chains concurrently in a checkerboard of
+            cells.
+
+        max_chain_events (int): Maximum number of events in one chain.
+
         shape (`TypeParameter` [``particle type``, `dict`]):
             The shape parameters for each particle type. The dictionary has the
             following keys:
@@ -186,14 +224,18 @@ class Sphere(HPMCNECIntegrator):
                  default_d=0.1,
                  chain_time=0.5,
                  update_fraction=0.5,
-                 nselect=1):
+                 nselect=1,
+                 checkerboard=False,
+                 max_chain_events=100000):
         # initialize base class
         super().__init__(default_d=default_d,
                          default_a=0.1,
                          chain_probability=1.0,
                          chain_time=chain_time,
                          update_fraction=update_fraction,
-                         nselect=nselect)
+                         nselect=nselect,
+                         checkerboard=checkerboard,
+                         max_chain_events=max_chain_events)
 
         typeparam_shape = TypeParameter('shape',
                                         type_kind='particle_types',
@@ -234,6 +276,10 @@ class ConvexPolyhedron(HPMCNECIntegrator):
             fraction of N, defaults to 0.5.
         nselect (`int`, optional): Number of repeated updates for the
             cell/system, defaults to 1.
+        checkerboard (`bool`, optional): Run chains concurrently in a
+            checkerboard of cells, defaults to `False`.
+        max_chain_events (`int`, optional): Maximum number of events in one
+            chain, defaults to 100000.
 
     Perform Newtonian event chain Monte Carlo integration of convex polyhedra.
 
@@ -267,6 +313,11 @@ class ConvexPolyhedron(HPMCNECIntegrator):
 
         update_fraction (float): Number of chains to be done as fraction of N.
 
+        checkerboard (bool): Run chains concurrently in a checkerboard of
+            cells.
+
+        max_chain_events (int): Maximum number of events in one chain.
+
         shape (`TypeParameter` [``particle type``, `dict`]):
             The shape parameters for each particle type. The dictionary has the
             following keys.
@@ -297,14 +348,18 @@ class ConvexPolyhedron(HPMCNECIntegrator):
                  chain_probability=0.5,
                  chain_time=0.5,
                  update_fraction=0.5,
-                 nselect=1):
+                 nselect=1,
+                 checkerboard=False,
+                 max_chain_events=100000):
 
         super().__init__(default_d=default_d,
                          default_a=default_a,
                          chain_probability=chain_probability,
                          chain_time=chain_time,
                          update_fraction=update_fraction,
-                         nselect=nselect)
+                         nselect=nselect,
+                         checkerboard=checkerboard,
+                         max_chain_events=max_chain_events)
 
         typeparam_shape = TypeParameter('shape',
                                         type_kind='particle_types',
@@ -29,6 +29,7 @@ valid_attrs = [
     ("transfer_types", ["A"]),
     ("transfer_types", ["B"]),
     ("transfer_types", ["A", "B"]),
+    ("n_insertion_trials", 4),
 ]
 
 
@@ -133,8 +134,9 @@ def test_valid_setattr_attached(device, attr, value, simulation_factory,
     assert getattr(muvt, attr) == value
 
 
-def test_insertion_removal(device, simulation_factory,
-                           lattice_snapshot_factory):
+@pytest.mark.parametrize("n_insertion_trials", [1, 8])
+def test_insertion_removal(device, simulation_factory, lattice_snapshot_factory,
+                           n_insertion_trials):
     """Test that MuVT is able to insert and remove particles."""
     sim = simulation_factory(
         lattice_snapshot_factory(particle_types=["A", "B"],
@@ -149,7 +151,8 @@ def test_insertion_removal(device, simulation_factory,
     sim.operations.integrator = mc
 
     muvt = hoomd.hpmc.update.MuVT(trigger=hoomd.trigger.Periodic(5),
-                                  transfer_types=["B"])
+                                  transfer_types=["B"],
+                                  n_insertion_trials=n_insertion_trials)
     sim.operations.updaters.append(muvt)
 
     sim.run(0)
@@ -172,6 +175,52 @@ def test_insertion_removal(device, simulation_factory,
     assert muvt.N["B"] > 0
 
 
+@pytest.mark.validate
+def test_insertion_trials_equilibrium(device, simulation_factory,
+                                      lattice_snapshot_factory):
+    """Test that multiple insertion trials sample the same ensemble."""
+
+    def sample_n(n_insertion_trials):
+        sim = simulation_factory(
+            lattice_snapshot_factory(particle_types=["A"],
+                                     dimensions=2,
+                                     a=2,
+                                     n=4))
+
+        mc = hoomd.hpmc.integrate.Sphere(default_d=0.2, default_a=0)
+        mc.shape["A"] = dict(diameter=1.0)
+        sim.operations.integrator = mc
+
+        muvt = hoomd.hpmc.update.MuVT(trigger=hoomd.trigger.Periodic(1),
+                                      transfer_types=["A"],
+                                      n_insertion_trials=n_insertion_trials)
+        muvt.fugacity["A"] = 1.0
+        sim.operations.updaters.append(muvt)
+
+        sim.run(2000)
+
+        samples = []
+        for _ in range(400):
+            sim.run(10)
+            samples.append(muvt.N["A"])
+        return numpy.array(samples, dtype=float)
+
+    # estimate the error of the mean from block averages
+    def mean_and_error(samples, n_blocks=10):
+        blocks = numpy.mean(numpy.reshape(samples, (n_blocks, -1)), axis=1)
+        return numpy.mean(blocks), numpy.std(blocks,
+                                             ddof=1) / numpy.sqrt(n_blocks)
+
+    mean_single, error_single = mean_and_error(sample_n(1))
+    mean_multi, error_multi = mean_and_error(sample_n(4))
+
+    # the Rosenbluth weights must reproduce the single trial distribution
+    sigma = numpy.sqrt(error_single**2 + error_multi**2)
+    assert mean_single > 0
+    assert mean_multi == pytest.approx(mean_single,
+                                       abs=4 * sigma + 0.01 * mean_single)
+
+
 @pytest.mark.cpu
 @pytest.mark.skipif(not hoomd.version.llvm_enabled, reason="LLVM not enabled")
 def test_jit_remove_insert(device, simulation_factory,
@@ -0,0 +1,140 @@
+# Copyright (c) 2009-2024 The Regents of the University of Michigan.
+# Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+"""Test hoomd.hpmc.nec.integrate."""
+
+import hoomd
+import pytest
+import numpy
+
+cube_vertices = [
+    (-0.5, -0.5, -0.5),
+    (-0.5, -0.5, 0.5),
+    (-0.5, 0.5, -0.5),
+    (-0.5, 0.5, 0.5),
+    (0.5, -0.5, -0.5),
+    (0.5, -0.5, 0.5),
+    (0.5, 0.5, -0.5),
+    (0.5, 0.5, 0.5),
+]
+
+
+@pytest.fixture(scope="function")
+def nec_snapshot_factory(lattice_snapshot_factory):
+    """Make a lattice snapshot with random velocities."""
+
+    def make_snapshot(a, n):
+        snap = lattice_snapshot_factory(a=a, n=n)
+        if snap.communicator.rank == 0:
+            rng = numpy.random.default_rng(42)
+            snap.particles.velocity[:] = rng.normal(size=(snap.particles.N,
+                                                          3))
+        return snap
+
+    return make_snapshot
+
+
+def make_integrator(shape, checkerboard, chain_time):
+    if shape == "sphere":
+        mc = hoomd.hpmc.nec.integrate.Sphere(default_d=1.0,
+                                             chain_time=chain_time,
+                                             update_fraction=0.5,
+                                             checkerboard=checkerboard)
+        mc.shape["A"] = dict(diameter=1.0)
+    else:
+        mc = hoomd.hpmc.nec.integrate.ConvexPolyhedron(
+            default_d=1.0,
+            default_a=0.1,
+            chain_probability=0.5,
+            chain_time=chain_time,
+            update_fraction=0.5,
+            checkerboard=checkerboard)
+        mc.shape["A"] = dict(vertices=cube_vertices)
+    return mc
+
+
+@pytest.mark.serial
+@pytest.mark.cpu
+def test_max_chain_events(simulation_factory, nec_snapshot_factory):
+    """Test that max_chain_events is passed to the integrator."""
+    mc = hoomd.hpmc.nec.integrate.Sphere(max_chain_events=500)
+    assert mc.max_chain_events == 500
+
+    mc.shape["A"] = dict(diameter=1.0)
+    sim = simulation_factory(nec_snapshot_factory(a=1.5, n=6))
+    sim.operations.integrator = mc
+    sim.run(0)
+    assert mc.max_chain_events == 500
+
+    mc.max_chain_events = 1000
+    assert mc.max_chain_events == 1000
+
+    # a limit of 0 would leave the chains unbounded
+    with pytest.raises(ValueError):
+        mc.max_chain_events = 0
+    assert mc.max_chain_events == 1000
+
+
+@pytest.mark.serial
+@pytest.mark.cpu
+@pytest.mark.parametrize("checkerboard", [False, True])
+@pytest.mark.parametrize("shape", ["sphere", "cube"])
+def test_chains_no_overlaps(simulation_factory, nec_snapshot_factory, shape,
+                            checkerboard):
+    """Test that the culled sweeps in both modes never create overlaps."""
+    sim = simulation_factory(nec_snapshot_factory(a=1.8, n=6))
+    mc = make_integrator(shape, checkerboard, chain_time=2.0)
+    sim.operations.integrator = mc
+
+    initial_position = sim.state.get_snapshot().particles.position.copy()
+    sim.run(20)
+
+    assert mc.overlaps == 0
+    assert mc.nec_counters.chain_start_count > 0
+    assert mc.nec_counters.chain_at_collision_count > 0
+    assert mc.nec_counters.overlap_errors == 0
+
+    position = sim.state.get_snapshot().particles.position
+    assert numpy.any(position != initial_position)
+
+
+@pytest.mark.serial
+@pytest.mark.cpu
+def test_checkerboard_small_box(simulation_factory, nec_snapshot_factory):
+    """Test that boxes narrower than two cells fall back to serial chains."""
+    sim = simulation_factory(nec_snapshot_factory(a=1.1, n=1))
+    mc = make_integrator("sphere", checkerboard=True, chain_time=1.0)
+    sim.operations.integrator = mc
+
+    sim.run(10)
+    assert mc.overlaps == 0
+    assert mc.nec_counters.chain_start_count > 0
+
+
+@pytest.mark.validate
+@pytest.mark.serial
+@pytest.mark.cpu
+@pytest.mark.parametrize("checkerboard", [False, True])
+def test_virial_pressure(simulation_factory, nec_snapshot_factory,
+                         checkerboard):
+    """Test the hard sphere pressure against the Carnahan-Starling EOS."""
+    packing_fraction = 0.3
+    a = (numpy.pi / (6 * packing_fraction))**(1 / 3)
+    n = 8
+    density = 1 / a**3
+
+    sim = simulation_factory(nec_snapshot_factory(a=a, n=n))
+    mc = make_integrator("sphere", checkerboard, chain_time=1.0)
+    sim.operations.integrator = mc
+
+    sim.run(200)
+
+    pressure = []
+    for _ in range(500):
+        sim.run(1)
+        pressure.append(mc.virial_pressure)
+
+    eta = packing_fraction
+    compressibility = (1 + eta + eta**2 - eta**3) / (1 - eta)**3
+    assert numpy.mean(pressure) == pytest.approx(density * compressibility,
+                                                 rel=0.03)
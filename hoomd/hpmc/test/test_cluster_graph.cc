@@ -0,0 +1,109 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "hoomd/test/upp11_config.h"
+
+HOOMD_UP_MAIN();
+
+#include "hoomd/hpmc/UpdaterClusters.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include <pybind11/pybind11.h>
+
+using namespace hoomd;
+using namespace hoomd::hpmc;
+using namespace hoomd::hpmc::detail;
+
+//! Set up a graph for testing
+void initialize_graph(Graph& G, unsigned int V)
+    {
+#ifdef ENABLE_TBB
+    G.setTaskArena(std::make_shared<tbb::task_arena>());
+#endif
+    G.resize(V);
+    }
+
+UP_TEST(isolated_vertices)
+    {
+    Graph G;
+    initialize_graph(G, 4);
+
+    std::vector<std::vector<unsigned int>> cc;
+    G.connectedComponents(cc);
+
+    UP_ASSERT_EQUAL(cc.size(), 4);
+    for (unsigned int i = 0; i < 4; ++i)
+        {
+        UP_ASSERT_EQUAL(cc[i].size(), 1);
+        UP_ASSERT_EQUAL(cc[i][0], i);
+        }
+    }
+
+UP_TEST(components)
+    {
+    Graph G;
+    initialize_graph(G, 8);
+
+    // components {0, 3, 5, 7}, {1, 6}, {2}, {4}, duplicate and reversed edges are allowed
+    G.addEdge(7, 5);
+    G.addEdge(5, 3);
+    G.addEdge(0, 7);
+    G.addEdge(6, 1);
+    G.addEdge(1, 6);
+    G.addEdge(3, 5);
+
+    std::vector<std::vector<unsigned int>> cc;
+    G.connectedComponents(cc);
+
+    // components are ordered by their lowest vertex and list vertices in ascending order
+    UP_ASSERT_EQUAL(cc.size(), 4);
+    UP_ASSERT(cc[0] == std::vector<unsigned int>({0, 3, 5, 7}));
+    UP_ASSERT(cc[1] == std::vector<unsigned int>({1, 6}));
+    UP_ASSERT(cc[2] == std::vector<unsigned int>({2}));
+    UP_ASSERT(cc[3] == std::vector<unsigned int>({4}));
+    }
+
+UP_TEST(resize_clears_edges)
+    {
+    Graph G;
+    initialize_graph(G, 3);
+    G.addEdge(0, 1);
+    G.addEdge(1, 2);
+
+    std::vector<std::vector<unsigned int>> cc;
+    G.connectedComponents(cc);
+    UP_ASSERT_EQUAL(cc.size(), 1);
+
+    // grow the graph, all previous edges are removed
+    G.resize(5);
+    G.addEdge(3, 4);
+
+    cc.clear();
+    G.connectedComponents(cc);
+    UP_ASSERT_EQUAL(cc.size(), 4);
+    UP_ASSERT(cc[3] == std::vector<unsigned int>({3, 4}));
+    }
+
+UP_TEST(chain)
+    {
+    // a long chain added in scrambled order forms a single component
+    const unsigned int V = 1000;
+    Graph G;
+    initialize_graph(G, V);
+
+    for (unsigned int k = 0; k < V - 1; ++k)
+        {
+        unsigned int i = (k * 617) % (V - 1);
+        G.addEdge(i + 1, i);
+        }
+
+    std::vector<std::vector<unsigned int>> cc;
+    G.connectedComponents(cc);
+
+    UP_ASSERT_EQUAL(cc.size(), 1);
+    UP_ASSERT_EQUAL(cc[0].size(), V);
+    for (unsigned int i = 0; i < V; ++i)
+        UP_ASSERT_EQUAL(cc[0][i], i);
+    }
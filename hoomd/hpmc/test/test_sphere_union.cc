@@ -16,6 +16,7 @@ HOOMD_UP_MAIN();
 
 #include <memory>
 #include <pybind11/pybind11.h>
+#include <random>
 
 using namespace hoomd;
 using namespace hoomd::hpmc;
@@ -240,3 +241,62 @@ UP_TEST(overlapping_dumbbells)
     UP_ASSERT(test_overlap(r_b - r_a, a, b, err_count));
     UP_ASSERT(test_overlap(r_a - r_b, b, a, err_count));
     }
+
+UP_TEST(many_member_traversal)
+    {
+    // compare the tandem tree traversal against a brute force check of all member pairs for
+    // unions with deep trees
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<Scalar> uniform(-1.0, 1.0);
+
+    const unsigned int n_members = 50;
+    ShapeUnion<ShapeSphere>::param_type params(n_members);
+    params.diameter = ShortReal(2 * (sqrt(3.0) + 0.2));
+    params.ignore = 0;
+    for (unsigned int i = 0; i < n_members; ++i)
+        {
+        params.mpos[i] = vec3<Scalar>(uniform(rng), uniform(rng), uniform(rng));
+        params.morientation[i] = quat<Scalar>();
+        params.mparams[i].radius = ShortReal(0.1 + 0.05 * (uniform(rng) + 1.0));
+        params.mparams[i].ignore = 0;
+        params.moverlap[i] = 1;
+        }
+    build_tree<ShapeSphere>(params);
+
+    unsigned int n_overlap = 0;
+    for (unsigned int trial = 0; trial < 200; ++trial)
+        {
+        quat<Scalar> o_a(uniform(rng), vec3<Scalar>(uniform(rng), uniform(rng), uniform(rng)));
+        o_a = o_a * (Scalar)(Scalar(1.0) / sqrt(norm2(o_a)));
+        quat<Scalar> o_b(uniform(rng), vec3<Scalar>(uniform(rng), uniform(rng), uniform(rng)));
+        o_b = o_b * (Scalar)(Scalar(1.0) / sqrt(norm2(o_b)));
+
+        ShapeUnion<ShapeSphere> a(o_a, params);
+        ShapeUnion<ShapeSphere> b(o_b, params);
+        vec3<Scalar> r_ab = Scalar(2.5) * vec3<Scalar>(uniform(rng), uniform(rng), uniform(rng));
+
+        bool expected = false;
+        for (unsigned int i = 0; i < n_members && !expected; ++i)
+            {
+            vec3<Scalar> r_i = rotate(o_a, vec3<Scalar>(params.mpos[i]));
+            for (unsigned int j = 0; j < n_members; ++j)
+                {
+                vec3<Scalar> r_j = r_ab + rotate(o_b, vec3<Scalar>(params.mpos[j]));
+                Scalar d = params.mparams[i].radius + params.mparams[j].radius;
+                if (dot(r_j - r_i, r_j - r_i) <= d * d)
+                    {
+                    expected = true;
+                    break;
+                    }
+                }
+            }
+
+        n_overlap += expected;
+        UP_ASSERT_EQUAL(test_overlap(r_ab, a, b, err_count), expected);
+        UP_ASSERT_EQUAL(test_overlap(-r_ab, b, a, err_count), expected);
+        }
+
+    // the random configurations should sample both outcomes
+    UP_ASSERT(n_overlap > 0);
+    UP_ASSERT(n_overlap < 200);
+    }
@@ -379,6 +379,8 @@ class MuVT(Updater):
           ensemble)
         move_ratio (float): (if set) Set the ratio between volume and
           exchange/transfer moves (applies to Gibbs ensemble)
+        n_insertion_trials (int): Number of trial positions per insertion
+          and removal attempt (applies to grand canonical muVT)
 
     The muVT (or grand-canonical) ensemble simulates a system at constant
     fugacity.
@@ -389,6 +391,14 @@ class MuVT(Updater):
     ``ranks_per_partition`` argument of `hoomd.communicator.Communicator` to
     enable partitioned simulations.
 
+    When ``n_insertion_trials`` is larger than 1, `MuVT` evaluates that many
+    independent trial positions for each insertion and accepts the move with
+    the Rosenbluth weight :math:`W = \frac{1}{k} \sum_l e^{-\beta U_l}`,
+    inserting at one of the trials with probability proportional to its
+    Boltzmann factor. Removals use the weight of the reverse move. Multiple
+    trials improve the acceptance rate in dense systems. They are not
+    supported in Gibbs ensemble simulations or with depletants.
+
     .. rubric:: Mixed precision
 
     `MuVT` uses reduced precision floating point arithmetic when checking
@@ -409,6 +419,8 @@ class MuVT(Updater):
           (applies to Gibbs ensemble)
         ntrial (float): (**default**: 1) Number of configurational bias attempts
           to swap depletants
+        n_insertion_trials (int): (**default**: 1) Number of trial positions
+          per insertion and removal attempt
         fugacity (`TypeParameter` [ ``particle type``, `float`]):
             Particle fugacity
             :math:`[\mathrm{volume}^{-1}]` (**default:** 0).
@@ -419,7 +431,8 @@ class MuVT(Updater):
                  ngibbs=1,
                  max_volume_rescale=0.1,
                  volume_move_probability=0.5,
-                 trigger=1):
+                 trigger=1,
+                 n_insertion_trials=1):
         super().__init__(trigger)
 
         self.ngibbs = int(ngibbs)
@@ -429,6 +442,7 @@ class MuVT(Updater):
             transfer_types=list(transfer_types),
             max_volume_rescale=float(max_volume_rescale),
             volume_move_probability=float(volume_move_probability),
+            n_insertion_trials=int(n_insertion_trials),
             **_default_dict)
         self._param_dict.update(param_dict)
 
@@ -699,12 +713,16 @@ class Clusters(Updater):
 
         cpp_cls_name = "UpdaterClusters"
         cpp_cls_name += integrator.__class__.__name__
-        cpp_cls = getattr(_hpmc, cpp_cls_name)
+
+        # integrators from plugins may provide their own updater
+        ext_module = integrator._ext_module
+        if cpp_cls_name not in ext_module.__dict__:
+            ext_module = _hpmc
         use_gpu = (isinstance(self._simulation.device, hoomd.device.GPU)
-                   and (cpp_cls_name + 'GPU') in _hpmc.__dict__)
+                   and (cpp_cls_name + 'GPU') in ext_module.__dict__)
         if use_gpu:
             cpp_cls_name += "GPU"
-        cpp_cls = getattr(_hpmc, cpp_cls_name)
+        cpp_cls = getattr(ext_module, cpp_cls_name)
 
         if not integrator._attached:
             raise RuntimeError("Integrator is not attached yet.")
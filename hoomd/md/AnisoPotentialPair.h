@@ -472,6 +472,11 @@ Scalar AnisoPotentialPair<aniso_evaluator>::getRCut(pybind11::tuple types)
 template<class aniso_evaluator>
 void AnisoPotentialPair<aniso_evaluator>::computeForces(uint64_t timestep)
     {
+    if (m_nlist->getMidpoint())
+        {
+        throw std::runtime_error("Anisotropic pair forces do not support the midpoint method.");
+        }
+
     // start by updating the neighborlist
     m_nlist->compute(timestep);
 
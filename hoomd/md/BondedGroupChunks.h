@@ -0,0 +1,175 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "hoomd/ExecutionConfiguration.h"
+#include "hoomd/HOOMDMath.h"
+
+#include <algorithm>
+#include <vector>
+
+/*! \file BondedGroupChunks.h
+    \brief Declares BondedGroupChunks
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifdef ENABLE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
+#ifndef __BONDEDGROUPCHUNKS_H__
+#define __BONDEDGROUPCHUNKS_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace detail
+    {
+//! Evaluate the local index table of a bonded group on multiple threads
+/*! The local index table is sorted by the index of the first member. With TBB, run() splits the
+    table into contiguous chunks, one per thread, and moves each boundary to the next change of the
+    first member so that every chunk owns a contiguous range of particles exclusively. A chunk adds
+    the contributions to its own particles directly and spills the others into a buffer for the
+    owning chunk. The buffers are applied in chunk order, so results do not depend on thread
+    scheduling.
+
+    The buffers keep their capacity from step to step, so a force compute holds one
+    BondedGroupChunks for its lifetime.
+*/
+class BondedGroupChunks
+    {
+    public:
+    //! Evaluate the table
+    /*! \param exec_conf Execution configuration
+        \param table Local index table, sorted by the first member
+        \param n_particles Number of particles receiving contributions (local, or local + ghost)
+        \param compute compute(begin, end, add) evaluates the table entries [begin, end) and
+               calls add(idx, force_x, force_y, force_z, energy, virial) for every contribution
+        \param add_force add_force(idx, force_x, force_y, force_z, energy, virial) adds a
+               contribution to the force and virial arrays
+    */
+    template<class Table, class Compute, class AddForce>
+    void run(const ExecutionConfiguration& exec_conf,
+             const Table& table,
+             unsigned int n_particles,
+             Compute&& compute,
+             AddForce&& add_force)
+        {
+        const unsigned int size = (unsigned int)table.size();
+
+#ifdef ENABLE_TBB
+        const unsigned int n_chunks = std::min(exec_conf.getNumThreads(), size);
+#else
+        const unsigned int n_chunks = 1;
+#endif
+
+        if (n_chunks <= 1)
+            {
+            compute(0, size, add_force);
+            return;
+            }
+
+#ifdef ENABLE_TBB
+        m_chunk_begin.resize(n_chunks + 1);
+        m_chunk_owned.resize(n_chunks + 1);
+        m_chunk_begin[0] = 0;
+        m_chunk_owned[0] = 0;
+        for (unsigned int chunk = 1; chunk < n_chunks; chunk++)
+            {
+            unsigned int begin = (unsigned int)(size_t(size) * chunk / n_chunks);
+            begin = std::max(begin, m_chunk_begin[chunk - 1]);
+            while (begin > 0 && begin < size && table[begin].idx[0] == table[begin - 1].idx[0])
+                begin++;
+            m_chunk_begin[chunk] = begin;
+            m_chunk_owned[chunk]
+                = begin < size ? std::min(table[begin].idx[0], n_particles) : n_particles;
+            }
+        m_chunk_begin[n_chunks] = size;
+        m_chunk_owned[n_chunks] = n_particles;
+
+        m_spills.resize(size_t(n_chunks) * n_chunks);
+        for (auto& spill : m_spills)
+            spill.clear();
+
+        auto compute_chunk = [&](unsigned int chunk)
+        {
+            const unsigned int owned_begin = m_chunk_owned[chunk];
+            const unsigned int owned_end = m_chunk_owned[chunk + 1];
+            auto add = [&](unsigned int idx,
+                           Scalar force_x,
+                           Scalar force_y,
+                           Scalar force_z,
+                           Scalar energy,
+                           const Scalar* virial)
+            {
+                if (idx >= owned_begin && idx < owned_end)
+                    {
+                    add_force(idx, force_x, force_y, force_z, energy, virial);
+                    return;
+                    }
+
+                unsigned int owner
+                    = (unsigned int)(std::upper_bound(m_chunk_owned.begin() + 1,
+                                                      m_chunk_owned.end() - 1,
+                                                      idx)
+                                     - m_chunk_owned.begin() - 1);
+                Spill spill;
+                spill.idx = idx;
+                spill.force = make_scalar4(force_x, force_y, force_z, energy);
+                for (unsigned int k = 0; k < 6; k++)
+                    spill.virial[k] = virial[k];
+                m_spills[size_t(chunk) * n_chunks + owner].push_back(spill);
+            };
+            compute(m_chunk_begin[chunk], m_chunk_begin[chunk + 1], add);
+        };
+
+        auto apply_spills = [&](unsigned int owner)
+        {
+            for (unsigned int chunk = 0; chunk < n_chunks; chunk++)
+                {
+                for (const Spill& spill : m_spills[size_t(chunk) * n_chunks + owner])
+                    {
+                    add_force(spill.idx,
+                              spill.force.x,
+                              spill.force.y,
+                              spill.force.z,
+                              spill.force.w,
+                              spill.virial);
+                    }
+                }
+        };
+
+        exec_conf.getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for((unsigned int)0, n_chunks, compute_chunk);
+                tbb::parallel_for((unsigned int)0, n_chunks, apply_spills);
+            });
+#endif
+        }
+
+    private:
+#ifdef ENABLE_TBB
+    //! Contribution of a group to a particle owned by another chunk
+    struct Spill
+        {
+        unsigned int idx; //!< Particle index
+        Scalar4 force;    //!< Force and energy
+        Scalar virial[6]; //!< Virial
+        };
+
+    std::vector<unsigned int> m_chunk_begin; //!< First table entry of every chunk
+    std::vector<unsigned int> m_chunk_owned; //!< First particle owned by every chunk
+    std::vector<std::vector<Spill>>
+        m_spills; //!< Contributions from chunk c to chunk d, at c * n_chunks + d
+#endif
+    };
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __BONDEDGROUPCHUNKS_H__
@@ -13,6 +13,7 @@
 #include "hoomd/HOOMDMPI.h"
 #endif
 
+#include <algorithm>
 #include <iostream>
 using namespace std;
 
@@ -56,6 +57,13 @@ ComputeThermo::ComputeThermo(std::shared_ptr<SystemDefinition> sysdef,
 ComputeThermo::~ComputeThermo()
     {
     m_exec_conf->msg->notice(5) << "Destroying ComputeThermo" << endl;
+
+#ifdef ENABLE_MPI
+    if (m_reduction_pending)
+        {
+        MPI_Wait(&m_reduction_request, MPI_STATUS_IGNORE);
+        }
+#endif
     }
 
 /*! Calls computeProperties if the properties need updating
@@ -89,127 +97,131 @@ void ComputeThermo::computeProperties()
                                      access_location::host,
                                      access_mode::read);
     ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                       access_location::host,
+                                       access_mode::read);
+    ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(),
+                                  access_location::host,
+                                  access_mode::read);
+    ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
+                                   access_location::host,
+                                   access_mode::read);
 
     // access the net force, pe, and virial
     const GlobalArray<Scalar4>& net_force = m_pdata->getNetForce();
     const GlobalArray<Scalar>& net_virial = m_pdata->getNetVirial();
     ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, access_mode::read);
-
-    // total kinetic energy
-    double ke_trans_total = 0.0;
+    size_t virial_pitch = net_virial.getPitch();
 
     PDataFlags flags = m_pdata->getFlags();
+    bool compute_virial = flags[pdata_flag::pressure_tensor];
+    bool compute_rotational = flags[pdata_flag::rotational_kinetic_energy];
 
-    double pressure_kinetic_xx = 0.0;
-    double pressure_kinetic_xy = 0.0;
-    double pressure_kinetic_xz = 0.0;
-    double pressure_kinetic_yy = 0.0;
-    double pressure_kinetic_yz = 0.0;
-    double pressure_kinetic_zz = 0.0;
-
-    if (flags[pdata_flag::pressure_tensor])
+    // accumulate all sums in a single pass over the group
+    PartialSums sums;
+    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
         {
-        // Calculate kinetic part of pressure tensor
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        unsigned int j = m_group->getMemberIndex(group_idx);
+
+        // ignore rigid body constituent particles in the sum
+        if (!PartialSums::isCounted(h_body.data[j], h_tag.data[j]))
+            continue;
+
+        sums.addKinetic(make_scalar3(h_vel.data[j].x, h_vel.data[j].y, h_vel.data[j].z),
+                        h_vel.data[j].w);
+        if (compute_rotational)
             {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            // ignore rigid body constituent particles in the sum
-            if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
-                {
-                double mass = h_vel.data[j].w;
-                pressure_kinetic_xx += mass * ((double)h_vel.data[j].x * (double)h_vel.data[j].x);
-                pressure_kinetic_xy += mass * ((double)h_vel.data[j].x * (double)h_vel.data[j].y);
-                pressure_kinetic_xz += mass * ((double)h_vel.data[j].x * (double)h_vel.data[j].z);
-                pressure_kinetic_yy += mass * ((double)h_vel.data[j].y * (double)h_vel.data[j].y);
-                pressure_kinetic_yz += mass * ((double)h_vel.data[j].y * (double)h_vel.data[j].z);
-                pressure_kinetic_zz += mass * ((double)h_vel.data[j].z * (double)h_vel.data[j].z);
-                }
+            sums.addRotational(h_orientation.data[j], h_angmom.data[j], h_inertia.data[j]);
             }
-        // kinetic energy = 1/2 trace of kinetic part of pressure tensor
-        ke_trans_total
-            = Scalar(0.5) * (pressure_kinetic_xx + pressure_kinetic_yy + pressure_kinetic_zz);
+        sums.addPotential(h_net_force.data[j], h_net_virial.data, virial_pitch, j, compute_virial);
         }
-    else
+
+    storeProperties(sums, flags);
+
+#ifdef ENABLE_MPI
+    // in MPI, reduce extensive quantities only when they're needed
+    m_properties_reduced = !m_pdata->getDomainDecomposition();
+#endif // ENABLE_MPI
+    }
+
+/*! \param timestep Timestep at which the sums were evaluated
+    \param sums Sums over the local group members, computed with the current particle data flags
+
+    The properties are marked as computed at \a timestep, so that compute() does not repeat the
+    pass over the group.
+*/
+void ComputeThermo::setPartialSums(uint64_t timestep, const PartialSums& sums)
+    {
+    assert(!m_exec_conf->isCUDAEnabled());
+
+    m_first_compute = false;
+    m_last_computed = timestep;
+    m_computed_flags = m_pdata->getFlags();
+
+    if (m_group->getNumMembersGlobal() == 0)
+        return;
+
+    storeProperties(sums, m_computed_flags);
+
+#ifdef ENABLE_MPI
+    m_properties_reduced = !m_pdata->getDomainDecomposition();
+    if (!m_properties_reduced)
         {
-        // total kinetic energy
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        // start reducing all properties at once, reduceProperties() completes the reduction
+        m_reduction_buffer.resize(thermo_index::num_quantities);
             {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            // ignore rigid body constituent particles in the sum
-            if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
-                {
-                ke_trans_total += (double)h_vel.data[j].w
-                                  * ((double)h_vel.data[j].x * (double)h_vel.data[j].x
-                                     + (double)h_vel.data[j].y * (double)h_vel.data[j].y
-                                     + (double)h_vel.data[j].z * (double)h_vel.data[j].z);
-                }
+            ArrayHandle<Scalar> h_properties(m_properties,
+                                             access_location::host,
+                                             access_mode::read);
+            std::copy(h_properties.data,
+                      h_properties.data + thermo_index::num_quantities,
+                      m_reduction_buffer.begin());
             }
 
-        ke_trans_total *= Scalar(0.5);
+        MPI_Iallreduce(MPI_IN_PLACE,
+                       m_reduction_buffer.data(),
+                       thermo_index::num_quantities,
+                       MPI_HOOMD_SCALAR,
+                       MPI_SUM,
+                       m_exec_conf->getMPICommunicator(),
+                       &m_reduction_request);
+        m_reduction_pending = true;
         }
+#endif
+    }
+
+/*! \param sums Sums over the local group members
+    \param flags Particle data flags that determine which sums are valid
+*/
+void ComputeThermo::storeProperties(const PartialSums& sums, PDataFlags flags)
+    {
+#ifdef ENABLE_MPI
+    // the buffer of a pending reduction holds outdated properties
+    finishReduction();
+#endif
+
+    // kinetic part of the pressure tensor
+    double pressure_kinetic_xx = sums.ke_tensor[0];
+    double pressure_kinetic_xy = sums.ke_tensor[1];
+    double pressure_kinetic_xz = sums.ke_tensor[2];
+    double pressure_kinetic_yy = sums.ke_tensor[3];
+    double pressure_kinetic_yz = sums.ke_tensor[4];
+    double pressure_kinetic_zz = sums.ke_tensor[5];
+
+    // kinetic energy = 1/2 trace of kinetic part of pressure tensor
+    double ke_trans_total
+        = Scalar(0.5) * (pressure_kinetic_xx + pressure_kinetic_yy + pressure_kinetic_zz);
 
     // total rotational kinetic energy
     double ke_rot_total = 0.0;
-
     if (flags[pdata_flag::rotational_kinetic_energy])
         {
-        // Calculate rotational part of kinetic energy
-        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
-                                           access_location::host,
-                                           access_mode::read);
-        ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(),
-                                      access_location::host,
-                                      access_mode::read);
-        ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
-                                       access_location::host,
-                                       access_mode::read);
-
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-            {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            // ignore rigid body constituent particles in the sum
-            if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
-                {
-                Scalar3 I = h_inertia.data[j];
-                quat<Scalar> q(h_orientation.data[j]);
-                quat<Scalar> p(h_angmom.data[j]);
-                quat<Scalar> s(Scalar(0.5) * conj(q) * p);
-
-                // only if the moment of inertia along one principal axis is non-zero, that axis
-                // carries angular momentum
-                if (I.x > 0)
-                    {
-                    ke_rot_total += s.v.x * s.v.x / I.x;
-                    }
-                if (I.y > 0)
-                    {
-                    ke_rot_total += s.v.y * s.v.y / I.y;
-                    }
-                if (I.z > 0)
-                    {
-                    ke_rot_total += s.v.z * s.v.z / I.z;
-                    }
-                }
-            }
-
-        ke_rot_total /= Scalar(2.0);
+        ke_rot_total = sums.ke_rot / Scalar(2.0);
         }
 
     // total potential energy
-    double pe_total = 0.0;
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-        {
-        unsigned int j = m_group->getMemberIndex(group_idx);
-
-        // ignore rigid body constituent particles in the sum
-        if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
-            {
-            pe_total += (double)h_net_force.data[j].w;
-            }
-        }
-
-    pe_total += m_pdata->getExternalEnergy();
+    double pe_total = sums.pe + m_pdata->getExternalEnergy();
 
     double W = 0.0;
     double virial_xx = m_pdata->getExternalVirial(0);
@@ -221,26 +233,23 @@ void ComputeThermo::computeProperties()
 
     if (flags[pdata_flag::pressure_tensor])
         {
-        // Calculate upper triangular virial tensor
-        size_t virial_pitch = net_virial.getPitch();
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-            {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            // ignore rigid body constituent particles in the sum
-            if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
-                {
-                virial_xx += (double)h_net_virial.data[j + 0 * virial_pitch];
-                virial_xy += (double)h_net_virial.data[j + 1 * virial_pitch];
-                virial_xz += (double)h_net_virial.data[j + 2 * virial_pitch];
-                virial_yy += (double)h_net_virial.data[j + 3 * virial_pitch];
-                virial_yz += (double)h_net_virial.data[j + 4 * virial_pitch];
-                virial_zz += (double)h_net_virial.data[j + 5 * virial_pitch];
-                }
-            }
+        // upper triangular virial tensor
+        virial_xx += sums.virial[0];
+        virial_xy += sums.virial[1];
+        virial_xz += sums.virial[2];
+        virial_yy += sums.virial[3];
+        virial_yz += sums.virial[4];
+        virial_zz += sums.virial[5];
 
         // isotropic virial = 1/3 trace of virial tensor
         W = Scalar(1. / 3.) * (virial_xx + virial_yy + virial_zz);
         }
+    else
+        {
+        // the kinetic part of the pressure tensor is only valid together with the virial
+        pressure_kinetic_xx = pressure_kinetic_xy = pressure_kinetic_xz = 0.0;
+        pressure_kinetic_yy = pressure_kinetic_yz = pressure_kinetic_zz = 0.0;
+        }
 
     // compute the pressure
     // volume/area & other 2D stuff needed
@@ -284,11 +293,6 @@ void ComputeThermo::computeProperties()
     h_properties.data[thermo_index::pressure_yy] = pressure_yy;
     h_properties.data[thermo_index::pressure_yz] = pressure_yz;
     h_properties.data[thermo_index::pressure_zz] = pressure_zz;
-
-#ifdef ENABLE_MPI
-    // in MPI, reduce extensive quantities only when they're needed
-    m_properties_reduced = !m_pdata->getDomainDecomposition();
-#endif // ENABLE_MPI
     }
 
 #ifdef ENABLE_MPI
@@ -297,6 +301,12 @@ void ComputeThermo::reduceProperties()
     if (m_properties_reduced)
         return;
 
+    if (m_reduction_pending)
+        {
+        finishReduction();
+        return;
+        }
+
     // reduce properties
     ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::readwrite);
     MPI_Allreduce(MPI_IN_PLACE,
@@ -308,6 +318,19 @@ void ComputeThermo::reduceProperties()
 
     m_properties_reduced = true;
     }
+
+void ComputeThermo::finishReduction()
+    {
+    if (!m_reduction_pending)
+        return;
+
+    MPI_Wait(&m_reduction_request, MPI_STATUS_IGNORE);
+    m_reduction_pending = false;
+
+    ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::overwrite);
+    std::copy(m_reduction_buffer.begin(), m_reduction_buffer.end(), h_properties.data);
+    m_properties_reduced = true;
+    }
 #endif
 
 namespace detail
@@ -5,9 +5,11 @@
 #include "hoomd/Compute.h"
 #include "hoomd/GlobalArray.h"
 #include "hoomd/ParticleGroup.h"
+#include "hoomd/VectorMath.h"
 
 #include <limits>
 #include <memory>
+#include <vector>
 
 /*! \file ComputeThermo.h
     \brief Declares a class for computing thermodynamic quantities
@@ -51,6 +53,12 @@ namespace md
    the number of degrees of freedom from the integrators and sets that value for each ComputeThermo
    so that it is always correct.
 
+    computeProperties() accumulates all sums in a single pass over the group. Integration methods
+   that loop over the same group can accumulate the PartialSums themselves and hand them to
+   setPartialSums(), which replaces the pass entirely. In MPI simulations, setPartialSums() starts a
+   non-blocking reduction of all properties at once that completes when a property is first read,
+   so that the reduction overlaps with any work in between.
+
     \ingroup computes
 */
 class PYBIND11_EXPORT ComputeThermo : public Compute
@@ -65,6 +73,74 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
     //! Compute the temperature
     virtual void compute(uint64_t timestep);
 
+    //! Sums over the local group members that determine the thermodynamic properties
+    struct PartialSums
+        {
+        double ke_tensor[6] = {0, 0, 0, 0, 0, 0}; //!< Sum of m v_a v_b (xx, xy, xz, yy, yz, zz)
+        double ke_rot = 0.0;                      //!< Twice the rotational kinetic energy
+        double pe = 0.0;                          //!< Potential energy
+        double virial[6] = {0, 0, 0, 0, 0, 0};    //!< Virial tensor (xx, xy, xz, yy, yz, zz)
+
+        //! Test if a particle contributes to the sums (rigid body constituents do not)
+        static bool isCounted(unsigned int body, unsigned int tag)
+            {
+            return body >= MIN_FLOPPY || body == tag;
+            }
+
+        //! Add the translational kinetic energy tensor of a particle
+        void addKinetic(const Scalar3& v, Scalar mass)
+            {
+            double m = mass;
+            ke_tensor[0] += m * ((double)v.x * (double)v.x);
+            ke_tensor[1] += m * ((double)v.x * (double)v.y);
+            ke_tensor[2] += m * ((double)v.x * (double)v.z);
+            ke_tensor[3] += m * ((double)v.y * (double)v.y);
+            ke_tensor[4] += m * ((double)v.y * (double)v.z);
+            ke_tensor[5] += m * ((double)v.z * (double)v.z);
+            }
+
+        //! Add the rotational kinetic energy of a particle
+        void addRotational(const Scalar4& orientation, const Scalar4& angmom, const Scalar3& I)
+            {
+            quat<Scalar> q(orientation);
+            quat<Scalar> p(angmom);
+            quat<Scalar> s(Scalar(0.5) * conj(q) * p);
+
+            // only if the moment of inertia along one principal axis is non-zero, that axis
+            // carries angular momentum
+            if (I.x > 0)
+                ke_rot += s.v.x * s.v.x / I.x;
+            if (I.y > 0)
+                ke_rot += s.v.y * s.v.y / I.y;
+            if (I.z > 0)
+                ke_rot += s.v.z * s.v.z / I.z;
+            }
+
+        //! Add the potential energy and optionally the virial of particle \a j
+        void addPotential(const Scalar4& net_force,
+                          const Scalar* net_virial,
+                          size_t virial_pitch,
+                          unsigned int j,
+                          bool compute_virial)
+            {
+            pe += (double)net_force.w;
+            if (compute_virial)
+                {
+                for (unsigned int k = 0; k < 6; k++)
+                    virial[k] += (double)net_virial[j + k * virial_pitch];
+                }
+            }
+        };
+
+    //! Test if an integration method of \a group can provide the sums with setPartialSums()
+    bool acceptsPartialSums(const std::shared_ptr<ParticleGroup>& group) const
+        {
+        return group == m_group && !m_exec_conf->isCUDAEnabled();
+        }
+
+    //! Set the properties at the given timestep from sums accumulated by an integration method
+    void setPartialSums(uint64_t timestep, const PartialSums& sums);
+
     //! Returns the overall temperature last computed by compute()
     /*! \returns Instantaneous overall temperature of the system
      */
@@ -339,11 +415,21 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
     //! Does the actual computation
     virtual void computeProperties();
 
+    //! Compute the properties from the sums over the local group members
+    void storeProperties(const PartialSums& sums, PDataFlags flags);
+
 #ifdef ENABLE_MPI
     bool m_properties_reduced; //!< True if properties have been reduced across MPI
 
+    std::vector<Scalar> m_reduction_buffer; //!< Buffer of the non-blocking reduction
+    MPI_Request m_reduction_request;        //!< Request of the non-blocking reduction
+    bool m_reduction_pending = false;       //!< True if the non-blocking reduction is in flight
+
     //! Reduce properties over MPI
     virtual void reduceProperties();
+
+    //! Complete the non-blocking reduction, if any
+    void finishReduction();
 #endif
     };
 
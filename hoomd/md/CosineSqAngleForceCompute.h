@@ -1,6 +1,7 @@
 // Copyright (c) 2009-2024 The Regents of the University of Michigan.
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+#include "BondedGroupChunks.h"
 #include "hoomd/BondedGroupData.h"
 #include "hoomd/ForceCompute.h"
 
@@ -94,6 +95,8 @@ class PYBIND11_EXPORT CosineSqAngleForceCompute : public ForceCompute
 
     std::shared_ptr<AngleData> m_angle_data; //!< Angle data to use in computing angles
 
+    detail::BondedGroupChunks m_chunks; //!< Threaded evaluation of the angle table
+
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
     };
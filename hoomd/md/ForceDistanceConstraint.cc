@@ -3,6 +3,7 @@
 
 #include "ForceDistanceConstraint.h"
 
+#include <algorithm>
 #include <string.h>
 using namespace Eigen;
 
@@ -20,10 +21,14 @@ ForceDistanceConstraint::ForceDistanceConstraint(std::shared_ptr<SystemDefinitio
     : MolecularForceCompute(sysdef), m_cdata(m_sysdef->getConstraintData()), m_cmatrix(m_exec_conf),
       m_cvec(m_exec_conf), m_lagrange(m_exec_conf), m_rel_tol(1e-3),
       m_constraint_violated(m_exec_conf), m_condition(m_exec_conf), m_sparse_idxlookup(m_exec_conf),
-      m_constraint_reorder(true), m_constraints_added_removed(true), m_d_max(0.0)
+      m_constraint_reorder(true), m_constraints_added_removed(true), m_d_max(0.0),
+      m_solver("direct"), m_pattern_analyzed(false), m_iterative_pattern_analyzed(false)
     {
     m_constraint_violated.resetFlags(0);
 
+    // relative residual of the iterative solver
+    setSolverTolerance(1e-10);
+
     // connect to the ConstraintData to receive notifications when constraints change order in
     // memory
     m_cdata->getGroupReorderSignal()
@@ -116,9 +121,8 @@ void ForceDistanceConstraint::computeForces(uint64_t timestep)
         throw std::runtime_error("No constraints in the system.");
         }
 
-    // reallocate through amortized resizin
+    // reallocate through amortized resizing
     unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
-    m_cmatrix.resize(n_constraint * n_constraint);
     m_cvec.resize(n_constraint);
 
     // populate the terms in the matrix vector equation
@@ -136,28 +140,8 @@ void ForceDistanceConstraint::computeForces(uint64_t timestep)
 
 void ForceDistanceConstraint::fillMatrixVector(uint64_t timestep)
     {
-    // fill the matrix in column-major order
     unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
 
-    if (m_constraint_reorder)
-        {
-        // reset flag
-        m_constraint_reorder = false;
-
-        // resize lookup matrix
-        m_sparse_idxlookup.resize(n_constraint * n_constraint);
-
-        ArrayHandle<int> h_sparse_idxlookup(m_sparse_idxlookup,
-                                            access_location::host,
-                                            access_mode::overwrite);
-
-        // reset lookup matrix values to -1
-        for (unsigned int i = 0; i < n_constraint * n_constraint; ++i)
-            {
-            h_sparse_idxlookup.data[i] = -1;
-            }
-        }
-
     // access particle data
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
@@ -166,15 +150,17 @@ void ForceDistanceConstraint::fillMatrixVector(uint64_t timestep)
                                     access_location::host,
                                     access_mode::read);
 
-    // access matrix elements
-    ArrayHandle<double> h_cmatrix(m_cmatrix, access_location::host, access_mode::overwrite);
+    // access vector elements
     ArrayHandle<double> h_cvec(m_cvec, access_location::host, access_mode::overwrite);
 
-    // clear matrix
-    memset(h_cmatrix.data, 0, sizeof(double) * m_cmatrix.size());
-
     const BoxDim& box = m_pdata->getBox();
 
+    m_kinematics.resize(n_constraint);
+
+    // the sparsity pattern only depends on which constraints share particles
+    bool pattern_changed = m_constraint_reorder || m_pattern_tags.size() != n_constraint;
+    m_constraint_reorder = false;
+
     unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
     for (unsigned int n = 0; n < n_constraint; ++n)
         {
@@ -183,6 +169,13 @@ void ForceDistanceConstraint::fillMatrixVector(uint64_t timestep)
         assert(constraint.tag[0] <= m_pdata->getMaximumTag());
         assert(constraint.tag[1] <= m_pdata->getMaximumTag());
 
+        if (!pattern_changed
+            && (constraint.tag[0] != m_pattern_tags[n].tag[0]
+                || constraint.tag[1] != m_pattern_tags[n].tag[1]))
+            {
+            pattern_changed = true;
+            }
+
         // transform a and b into indices into the particle data arrays
         // (MEM TRANSFER: 4 integers)
         unsigned int idx_a = h_rtag.data[constraint.tag[0]];
@@ -212,88 +205,126 @@ void ForceDistanceConstraint::fillMatrixVector(uint64_t timestep)
         vec3<Scalar> rndot(va - vb);
         vec3<Scalar> qn(rn + rndot * m_deltaT);
 
-        // fill matrix row
-        for (unsigned int m = 0; m < n_constraint; ++m)
+        ConstraintKinematics& kinematics = m_kinematics[n];
+        kinematics.rn = rn;
+        kinematics.qn = qn;
+        kinematics.inv_ma = Scalar(1.0) / ma;
+        kinematics.inv_mb = Scalar(1.0) / mb;
+
+        // get constraint distance
+        Scalar d = m_cdata->getValueByIndex(n);
+
+        // check distance violation
+        if (fast::sqrt(dot(rn, rn)) - d >= m_rel_tol * d || std::isnan(dot(rn, rn)))
             {
-            // lookup the tag of each of the particles participating in the constraint
-            const ConstraintData::members_t constraint_m = m_cdata->getMembersByIndex(m);
-            assert(constraint_m.tag[0] <= m_pdata->getMaximumTag());
-            assert(constraint_m.tag[1] <= m_pdata->getMaximumTag());
-
-            // transform a and b into indices into the particle data arrays
-            // (MEM TRANSFER: 4 integers)
-            unsigned int idx_m_a = h_rtag.data[constraint_m.tag[0]];
-            unsigned int idx_m_b = h_rtag.data[constraint_m.tag[1]];
-            assert(idx_m_a <= m_pdata->getN() + m_pdata->getNGhosts());
-            assert(idx_m_b <= m_pdata->getN() + m_pdata->getNGhosts());
-
-            if (idx_m_a >= max_local || idx_m_b >= max_local)
-                {
-                this->m_exec_conf->msg->error()
-                    << "constrain.distance(): constraint " << constraint_m.tag[0] << " "
-                    << constraint_m.tag[1] << " incomplete." << std::endl
-                    << std::endl;
-                throw std::runtime_error("Error in constraint calculation");
-                }
+            m_constraint_violated.resetFlags(n + 1);
+            }
+
+        // fill vector component
+        h_cvec.data[n] = (dot(qn, qn) - d * d) / m_deltaT / m_deltaT;
+        h_cvec.data[n] += double(2.0)
+                          * dot(qn,
+                                vec3<Scalar>(h_netforce.data[idx_a]) / ma
+                                    - vec3<Scalar>(h_netforce.data[idx_b]) / mb);
+        }
 
-            vec3<Scalar> rm_a(h_pos.data[idx_m_a]);
-            vec3<Scalar> rm_b(h_pos.data[idx_m_b]);
-            vec3<Scalar> rm(rm_a - rm_b);
+    if (pattern_changed)
+        {
+        buildSparsityPattern();
+        }
 
-            // apply minimum image
-            rm = box.minImage(rm);
+    // fill the structurally non-zero matrix elements in column-major order
+    const int* outer = m_sparse.outerIndexPtr();
+    const int* inner = m_sparse.innerIndexPtr();
+    double* values = m_sparse.valuePtr();
+
+    for (unsigned int m = 0; m < n_constraint; ++m)
+        {
+        const ConstraintData::members_t& constraint_m = m_pattern_tags[m];
+        const vec3<Scalar>& rm = m_kinematics[m].rn;
+
+        for (int k = outer[m]; k < outer[m + 1]; ++k)
+            {
+            unsigned int n = inner[k];
+            const ConstraintData::members_t& constraint_n = m_pattern_tags[n];
+            const ConstraintKinematics& kinematics = m_kinematics[n];
+            double qr = double(4.0) * dot(kinematics.qn, rm);
 
             double delta(0.0);
-            if (idx_m_a == idx_a)
+            if (constraint_m.tag[0] == constraint_n.tag[0])
                 {
-                delta += double(4.0) * dot(qn, rm) / ma;
+                delta += qr * kinematics.inv_ma;
                 }
-            if (idx_m_b == idx_a)
+            if (constraint_m.tag[1] == constraint_n.tag[0])
                 {
-                delta -= double(4.0) * dot(qn, rm) / ma;
+                delta -= qr * kinematics.inv_ma;
                 }
-            if (idx_m_a == idx_b)
+            if (constraint_m.tag[0] == constraint_n.tag[1])
                 {
-                delta -= double(4.0) * dot(qn, rm) / mb;
+                delta -= qr * kinematics.inv_mb;
                 }
-            if (idx_m_b == idx_b)
+            if (constraint_m.tag[1] == constraint_n.tag[1])
                 {
-                delta += double(4.0) * dot(qn, rm) / mb;
+                delta += qr * kinematics.inv_mb;
                 }
 
-            h_cmatrix.data[m * n_constraint + n] += delta;
+            values[k] = delta;
+            }
+        }
+    }
 
-            // update sparse matrix
-            int k = m_sparse_idxlookup[m * n_constraint + n];
+/*! Two constraints couple in the constraint matrix if and only if they share a particle. The
+    pattern is assembled in compressed column storage from a list of (particle, constraint) pairs
+    sorted by particle tag, so the cost is linear in the number of constraints for bounded particle
+    valence.
+*/
+void ForceDistanceConstraint::buildSparsityPattern()
+    {
+    unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
 
-            if ((k == -1 && delta != double(0.0)) || (k != -1 && delta == double(0.0)))
-                {
-                m_condition.resetFlags(1);
-                }
+    m_pattern_tags.resize(n_constraint);
 
-            if (k != -1)
+    std::vector<std::pair<unsigned int, unsigned int>> ptl_constraint;
+    ptl_constraint.reserve(2 * n_constraint);
+    for (unsigned int n = 0; n < n_constraint; ++n)
+        {
+        const ConstraintData::members_t constraint = m_cdata->getMembersByIndex(n);
+        m_pattern_tags[n] = constraint;
+        ptl_constraint.push_back(std::make_pair(constraint.tag[0], n));
+        ptl_constraint.push_back(std::make_pair(constraint.tag[1], n));
+        }
+    std::sort(ptl_constraint.begin(), ptl_constraint.end());
+
+    // every pair of constraints acting on the same particle is a non-zero
+    std::vector<Triplet<double>> triplets;
+    for (unsigned int i = 0; i < ptl_constraint.size();)
+        {
+        unsigned int j = i;
+        while (j < ptl_constraint.size() && ptl_constraint[j].first == ptl_constraint[i].first)
+            {
+            ++j;
+            }
+
+        for (unsigned int row = i; row < j; ++row)
+            {
+            for (unsigned int col = i; col < j; ++col)
                 {
-                // update sparse matrix value directly
-                m_sparse.valuePtr()[k] = delta;
+                triplets.push_back(Triplet<double>(ptl_constraint[row].second,
+                                                   ptl_constraint[col].second,
+                                                   0.0));
                 }
             }
+        i = j;
+        }
 
-        // get constraint distance
-        Scalar d = m_cdata->getValueByIndex(n);
+    m_sparse.resize(n_constraint, n_constraint);
+    m_sparse.setFromTriplets(triplets.begin(), triplets.end());
+    m_sparse.makeCompressed();
 
-        // check distance violation
-        if (fast::sqrt(dot(rn, rn)) - d >= m_rel_tol * d || std::isnan(dot(rn, rn)))
-            {
-            m_constraint_violated.resetFlags(n + 1);
-            }
+    m_exec_conf->msg->notice(6) << "ForceDistanceConstraint: sparsity pattern changed, "
+                                << m_sparse.nonZeros() << " non-zeros" << std::endl;
 
-        // fill vector component
-        h_cvec.data[n] = (dot(qn, qn) - d * d) / m_deltaT / m_deltaT;
-        h_cvec.data[n] += double(2.0)
-                          * dot(qn,
-                                vec3<Scalar>(h_netforce.data[idx_a]) / ma
-                                    - vec3<Scalar>(h_netforce.data[idx_b]) / mb);
-        }
+    m_condition.resetFlags(1);
     }
 
 void ForceDistanceConstraint::checkConstraints(uint64_t timestep)
@@ -330,6 +361,83 @@ void ForceDistanceConstraint::checkConstraints(uint64_t timestep)
     }
 
 void ForceDistanceConstraint::solveConstraints(uint64_t timestep)
+    {
+    typedef Matrix<double, Dynamic, 1> vec_t;
+    typedef Map<vec_t> vec_map_t;
+
+    unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
+
+    // skip if zero constraints
+    if (n_constraint == 0)
+        return;
+
+    // reallocate array of constraint forces
+    m_lagrange.resize(n_constraint);
+
+    bool sparsity_pattern_changed = m_condition.readFlags();
+    m_condition.resetFlags(0);
+    if (sparsity_pattern_changed)
+        {
+        m_pattern_analyzed = false;
+        m_iterative_pattern_analyzed = false;
+        }
+
+    // access RHS and solution vector
+    ArrayHandle<double> h_cvec(m_cvec, access_location::host, access_mode::read);
+    ArrayHandle<double> h_lagrange(m_lagrange, access_location::host, access_mode::readwrite);
+    vec_map_t map_vec(h_cvec.data, n_constraint, 1);
+    vec_map_t map_lagrange(h_lagrange.data, n_constraint, 1);
+
+    if (m_solver == "iterative")
+        {
+        // start from the previous solution, unless the constraints changed
+        vec_t guess = vec_t::Zero(n_constraint);
+        if (!sparsity_pattern_changed)
+            {
+            guess = map_lagrange;
+            }
+
+        if (!m_iterative_pattern_analyzed)
+            {
+            m_iterative_solver.analyzePattern(m_sparse);
+            m_iterative_pattern_analyzed = true;
+            }
+
+        // refactorize the molecule blocks of the preconditioner with the new matrix values
+        m_iterative_solver.factorize(m_sparse);
+        map_lagrange = m_iterative_solver.solveWithGuess(map_vec, guess);
+
+        if (m_iterative_solver.info() != Success)
+            {
+            throw std::runtime_error("Could not solve linear system of constraint equations.");
+            }
+        }
+    else
+        {
+        if (!m_pattern_analyzed)
+            {
+            // Compute the ordering permutation vector from the structural pattern of A
+            m_sparse_solver.analyzePattern(m_sparse);
+            m_pattern_analyzed = true;
+            }
+
+        // Compute the numerical factorization
+        m_sparse_solver.factorize(m_sparse);
+
+        if (m_sparse_solver.info())
+            {
+            throw std::runtime_error("Could not solve linear system of constraint equations.");
+            }
+
+        // Use the factors to solve the linear system
+        map_lagrange = m_sparse_solver.solve(map_vec);
+        }
+    }
+
+/*! Used by the GPU implementation, which assembles the dense matrix m_cmatrix and detects changes
+    of the sparsity pattern by comparing against m_sparse_idxlookup.
+*/
+void ForceDistanceConstraint::solveConstraintsDense(uint64_t timestep)
     {
     // use Eigen dense matrix algebra (slow for large matrices)
     typedef Matrix<double, Dynamic, Dynamic, ColMajor> matrix_t;
@@ -529,7 +637,9 @@ Scalar ForceDistanceConstraint::dfs(unsigned int iconstraint,
                                     std::vector<int>& visited,
                                     unsigned int* label,
                                     std::vector<ConstraintData::members_t>& groups,
-                                    std::vector<Scalar>& length)
+                                    std::vector<Scalar>& length,
+                                    const std::vector<unsigned int>& ptl_constraint_ptr,
+                                    const std::vector<unsigned int>& ptl_constraints)
     {
     assert(iconstraint < groups.size());
 
@@ -550,22 +660,30 @@ Scalar ForceDistanceConstraint::dfs(unsigned int iconstraint,
     label[constraint.tag[0]] = molecule;
     label[constraint.tag[1]] = molecule;
 
-    // NOTE: this loop could be optimized with a reverse-lookup table ptl idx -> constraint
     assert(iconstraint < length.size());
     Scalar dmax = length[iconstraint];
 
-    for (unsigned int jconstraint = 0; jconstraint < groups.size(); ++jconstraint)
+    // visit the constraints sharing a particle, using the reverse lookup table ptl tag ->
+    // constraint
+    for (unsigned int i = 0; i < 2; ++i)
         {
-        ConstraintData::members_t tags_j = groups[jconstraint];
+        unsigned int tag = constraint.tag[i];
+        for (unsigned int k = ptl_constraint_ptr[tag]; k < ptl_constraint_ptr[tag + 1]; ++k)
+            {
+            unsigned int jconstraint = ptl_constraints[k];
 
-        if (iconstraint == jconstraint)
-            continue;
+            if (iconstraint == jconstraint)
+                continue;
 
-        if (tags_j.tag[0] == constraint.tag[0] || tags_j.tag[1] == constraint.tag[0]
-            || tags_j.tag[0] == constraint.tag[1] || tags_j.tag[1] == constraint.tag[1])
-            {
             // recursively mark connected constraint with current label
-            dmax += dfs(jconstraint, molecule, visited, label, groups, length);
+            dmax += dfs(jconstraint,
+                        molecule,
+                        visited,
+                        label,
+                        groups,
+                        length,
+                        ptl_constraint_ptr,
+                        ptl_constraints);
             }
         }
 
@@ -622,6 +740,27 @@ void ForceDistanceConstraint::assignMoleculeTags()
         h_molecule_tag.data[i] = NO_MOLECULE;
         }
 
+    // reverse lookup table from particle tag to the constraints it participates in
+    std::vector<unsigned int> ptl_constraint_ptr(nptl + 1, 0);
+    for (unsigned int iconstraint = 0; iconstraint < nconstraint_global; ++iconstraint)
+        {
+        ptl_constraint_ptr[groups[iconstraint].tag[0] + 1]++;
+        ptl_constraint_ptr[groups[iconstraint].tag[1] + 1]++;
+        }
+    for (unsigned int i = 0; i < nptl; ++i)
+        {
+        ptl_constraint_ptr[i + 1] += ptl_constraint_ptr[i];
+        }
+    std::vector<unsigned int> ptl_constraints(ptl_constraint_ptr[nptl]);
+        {
+        std::vector<unsigned int> fill(ptl_constraint_ptr.begin(), ptl_constraint_ptr.end() - 1);
+        for (unsigned int iconstraint = 0; iconstraint < nconstraint_global; ++iconstraint)
+            {
+            ptl_constraints[fill[groups[iconstraint].tag[0]]++] = iconstraint;
+            ptl_constraints[fill[groups[iconstraint].tag[1]]++] = iconstraint;
+            }
+        }
+
     int molecule = 0;
 
     // maximum molecule diameter
@@ -634,8 +773,14 @@ void ForceDistanceConstraint::assignMoleculeTags()
             if (!visited[iconstraint])
                 {
                 // depth first search
-                Scalar d
-                    = dfs(iconstraint, molecule++, visited, h_molecule_tag.data, groups, length);
+                Scalar d = dfs(iconstraint,
+                               molecule++,
+                               visited,
+                               h_molecule_tag.data,
+                               groups,
+                               length,
+                               ptl_constraint_ptr,
+                               ptl_constraints);
                 if (d > m_d_max)
                     {
                     m_d_max = d;
@@ -658,7 +803,13 @@ void export_ForceDistanceConstraint(pybind11::module& m)
         .def(pybind11::init<std::shared_ptr<SystemDefinition>>())
         .def_property("tolerance",
                       &ForceDistanceConstraint::getRelativeTolerance,
-                      &ForceDistanceConstraint::setRelativeTolerance);
+                      &ForceDistanceConstraint::setRelativeTolerance)
+        .def_property("solver",
+                      &ForceDistanceConstraint::getSolver,
+                      &ForceDistanceConstraint::setSolver)
+        .def_property("solver_tolerance",
+                      &ForceDistanceConstraint::getSolverTolerance,
+                      &ForceDistanceConstraint::setSolverTolerance);
     }
 
     } // end namespace detail
@@ -20,12 +20,174 @@
 #include "hoomd/GPUVector.h"
 
 #include <Eigen/Dense>
+#include <Eigen/IterativeLinearSolvers>
 #include <Eigen/SparseLU>
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 namespace hoomd
     {
 namespace md
     {
+namespace detail
+    {
+/*! Block-diagonal preconditioner of the constraint matrix with one block per molecule
+
+    Two constraints couple in the matrix only when they share a particle, so the connected
+    components of the sparsity pattern are the constrained molecules. analyzePattern() finds the
+    components and factorize() LU-decomposes the dense block of each. Components with more than
+    max_block_size constraints are split into consecutive blocks to bound the cost of the dense
+    factorizations.
+
+    The class implements the preconditioner interface of the Eigen iterative solvers.
+*/
+class MoleculeBlockPreconditioner
+    {
+    public:
+    typedef Eigen::Matrix<double, Eigen::Dynamic, 1> vec_t;
+
+    //! Largest block that is factorized as a whole
+    static const unsigned int max_block_size = 64;
+
+    MoleculeBlockPreconditioner() { }
+
+    template<typename MatrixType> explicit MoleculeBlockPreconditioner(const MatrixType& A)
+        {
+        compute(A);
+        }
+
+    //! Find the blocks from the sparsity pattern of \a A
+    template<typename MatrixType> MoleculeBlockPreconditioner& analyzePattern(const MatrixType& A)
+        {
+        const unsigned int n = (unsigned int)A.rows();
+
+        // union the constraints that share a matrix element
+        std::vector<unsigned int> root(n);
+        for (unsigned int i = 0; i < n; ++i)
+            root[i] = i;
+        auto find = [&](unsigned int i)
+        {
+            while (root[i] != i)
+                {
+                root[i] = root[root[i]];
+                i = root[i];
+                }
+            return i;
+        };
+        for (Eigen::Index k = 0; k < A.outerSize(); ++k)
+            {
+            for (typename MatrixType::InnerIterator it(A, k); it; ++it)
+                {
+                unsigned int a = find((unsigned int)it.row());
+                unsigned int b = find((unsigned int)it.col());
+                if (a != b)
+                    root[std::max(a, b)] = std::min(a, b);
+                }
+            }
+
+        // list the constraints of each molecule in index order
+        std::vector<unsigned int> count(n, 0);
+        for (unsigned int i = 0; i < n; ++i)
+            count[find(i)]++;
+        std::vector<unsigned int> offset(n + 1, 0);
+        for (unsigned int i = 0; i < n; ++i)
+            offset[i + 1] = offset[i] + count[i];
+        m_order.resize(n);
+        for (unsigned int i = 0; i < n; ++i)
+            m_order[offset[find(i)]++] = i;
+
+        // molecules are contiguous in m_order, split them into blocks
+        m_block_start.clear();
+        unsigned int start = 0;
+        for (unsigned int r = 0; r < n; ++r)
+            {
+            for (unsigned int first = 0; first < count[r]; first += max_block_size)
+                m_block_start.push_back(start + first);
+            start += count[r];
+            }
+        m_block_start.push_back(n);
+
+        const unsigned int n_blocks = (unsigned int)m_block_start.size() - 1;
+        m_block.resize(n);
+        m_local.resize(n);
+        m_blocks.resize(n_blocks);
+        m_lu.resize(n_blocks);
+        for (unsigned int blk = 0; blk < n_blocks; ++blk)
+            {
+            const unsigned int size = m_block_start[blk + 1] - m_block_start[blk];
+            m_blocks[blk].resize(size, size);
+            for (unsigned int l = 0; l < size; ++l)
+                {
+                m_block[m_order[m_block_start[blk] + l]] = blk;
+                m_local[m_order[m_block_start[blk] + l]] = l;
+                }
+            }
+        return *this;
+        }
+
+    //! LU-decompose the blocks of \a A
+    template<typename MatrixType> MoleculeBlockPreconditioner& factorize(const MatrixType& A)
+        {
+        for (auto& block : m_blocks)
+            block.setZero();
+        for (Eigen::Index k = 0; k < A.outerSize(); ++k)
+            {
+            for (typename MatrixType::InnerIterator it(A, k); it; ++it)
+                {
+                const unsigned int row = (unsigned int)it.row();
+                const unsigned int col = (unsigned int)it.col();
+                if (m_block[row] == m_block[col])
+                    m_blocks[m_block[row]](m_local[row], m_local[col]) = it.value();
+                }
+            }
+        for (unsigned int blk = 0; blk < m_blocks.size(); ++blk)
+            m_lu[blk].compute(m_blocks[blk]);
+        return *this;
+        }
+
+    template<typename MatrixType> MoleculeBlockPreconditioner& compute(const MatrixType& A)
+        {
+        analyzePattern(A);
+        return factorize(A);
+        }
+
+    //! Apply the inverse of the blocks to \a b
+    template<typename Rhs> vec_t solve(const Rhs& b) const
+        {
+        vec_t x(b.rows());
+        vec_t b_block;
+        for (unsigned int blk = 0; blk < m_lu.size(); ++blk)
+            {
+            const unsigned int first = m_block_start[blk];
+            const unsigned int size = m_block_start[blk + 1] - first;
+            b_block.resize(size);
+            for (unsigned int l = 0; l < size; ++l)
+                b_block[l] = b[m_order[first + l]];
+            b_block = m_lu[blk].solve(b_block);
+            for (unsigned int l = 0; l < size; ++l)
+                x[m_order[first + l]] = b_block[l];
+            }
+        return x;
+        }
+
+    Eigen::ComputationInfo info()
+        {
+        return Eigen::Success;
+        }
+
+    private:
+    std::vector<unsigned int> m_order;       //!< Constraint indices grouped by block
+    std::vector<unsigned int> m_block_start; //!< Start of each block in m_order
+    std::vector<unsigned int> m_block;       //!< Block of each constraint
+    std::vector<unsigned int> m_local;       //!< Index of each constraint within its block
+    std::vector<Eigen::MatrixXd> m_blocks;   //!< Dense matrix of each block
+    std::vector<Eigen::PartialPivLU<Eigen::MatrixXd>> m_lu; //!< Factorization of each block
+    };
+
+    } // end namespace detail
+
 /*! Implements a pairwise distance constraint using the algorithm of
 
     [1] M. Yoneya, H. J. C. Berendsen, and K. Hirasawa, “A Non-Iterative Matrix Method for
@@ -63,6 +225,39 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
         return m_rel_tol;
         }
 
+    /// Set the linear solver ("direct" or "iterative")
+    void setSolver(const std::string& solver)
+        {
+        if (solver != "direct" && solver != "iterative")
+            {
+            throw std::invalid_argument("Invalid constraint solver: " + solver);
+            }
+        m_solver = solver;
+        }
+
+    /// Get the linear solver
+    std::string getSolver()
+        {
+        return m_solver;
+        }
+
+    /// Set the relative residual at which the iterative solver stops
+    void setSolverTolerance(Scalar solver_tol)
+        {
+        if (solver_tol <= 0)
+            {
+            throw std::invalid_argument("solver_tolerance must be positive.");
+            }
+        m_solver_tol = solver_tol;
+        m_iterative_solver.setTolerance(solver_tol);
+        }
+
+    /// Get the relative residual at which the iterative solver stops
+    Scalar getSolverTolerance()
+        {
+        return m_solver_tol;
+        }
+
 #ifdef ENABLE_MPI
     //! Get ghost particle fields requested by this pair potential
     virtual CommFlags getRequestedCommFlags(uint64_t timestep);
@@ -74,7 +269,7 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
     protected:
     std::shared_ptr<ConstraintData> m_cdata; //! The constraint data
 
-    GPUVector<double> m_cmatrix;  //!< The matrix for the constraint force equation (column-major)
+    GPUVector<double> m_cmatrix;  //!< Dense constraint matrix, column-major (GPU only)
     GPUVector<double> m_cvec;     //!< The vector on the RHS of the constraint equation
     GPUVector<double> m_lagrange; //!< The solution for the lagrange multipliers
 
@@ -95,6 +290,29 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
 
     Scalar m_d_max; //!< Maximum constraint extension
 
+    std::string m_solver;    //!< Linear solver, "direct" (sparse LU) or "iterative" (BiCGSTAB)
+    bool m_pattern_analyzed; //!< True if the LU ordering matches the current sparsity pattern
+
+    bool m_iterative_pattern_analyzed; //!< True if the iterative solver saw the current pattern
+    Scalar m_solver_tol;               //!< Relative residual of the iterative solver
+
+    //! Persistent state of the iterative solver
+    Eigen::BiCGSTAB<Eigen::SparseMatrix<double, Eigen::ColMajor>,
+                    detail::MoleculeBlockPreconditioner>
+        m_iterative_solver;
+
+    std::vector<ConstraintData::members_t> m_pattern_tags; //!< Constraint tags of the pattern
+
+    //! Per-constraint quantities entering the matrix elements
+    struct ConstraintKinematics
+        {
+        vec3<Scalar> rn; //!< Minimum image bond vector
+        vec3<Scalar> qn; //!< Bond vector propagated by one time step
+        Scalar inv_ma;   //!< Inverse mass of the first particle
+        Scalar inv_mb;   //!< Inverse mass of the second particle
+        };
+    std::vector<ConstraintKinematics> m_kinematics; //!< Kinematics of the current step
+
     //! Compute the forces
     virtual void computeForces(uint64_t timestep);
 
@@ -107,6 +325,12 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
     //! Solve the constraint matrix equation
     virtual void solveConstraints(uint64_t timestep);
 
+    //! Solve the constraint matrix equation, detecting the sparsity pattern from m_cmatrix
+    void solveConstraintsDense(uint64_t timestep);
+
+    //! Build the sparsity pattern of the constraint matrix from the constraint topology
+    void buildSparsityPattern();
+
     //! Solve the linear matrix-vector equation
     virtual void computeConstraintForces(uint64_t timestep);
 
@@ -139,7 +363,9 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
                std::vector<int>& visited,
                unsigned int* label,
                std::vector<ConstraintData::members_t>& groups,
-               std::vector<Scalar>& length);
+               std::vector<Scalar>& length,
+               const std::vector<unsigned int>& ptl_constraint_ptr,
+               const std::vector<unsigned int>& ptl_constraints);
     };
 
     } // end namespace md
@@ -96,6 +96,9 @@ void ForceDistanceConstraintGPU::fillMatrixVector(uint64_t timestep)
     // fill the matrix in row-major order
     unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
 
+    // reallocate dense matrix through amortized resizing
+    m_cmatrix.resize(n_constraint * n_constraint);
+
     if (m_constraint_reorder)
         {
         // reset flag
@@ -214,7 +217,7 @@ void ForceDistanceConstraintGPU::solveConstraints(uint64_t timestep)
         }
 
     // solve on CPU
-    ForceDistanceConstraint::solveConstraints(timestep);
+    ForceDistanceConstraint::solveConstraintsDense(timestep);
 
     // a sparse matrix should have been constructed, resize values array
     m_sparse_val.resize(m_sparse.data().size());
@@ -1,6 +1,7 @@
 // Copyright (c) 2009-2024 The Regents of the University of Michigan.
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+#include "BondedGroupChunks.h"
 #include "hoomd/BondedGroupData.h"
 #include "hoomd/ForceCompute.h"
 
@@ -98,6 +99,8 @@ class PYBIND11_EXPORT HarmonicDihedralForceCompute : public ForceCompute
 
     std::shared_ptr<DihedralData> m_dihedral_data; //!< Dihedral data to use in computing dihedrals
 
+    detail::BondedGroupChunks m_chunks; //!< Threaded evaluation of the dihedral table
+
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
     };
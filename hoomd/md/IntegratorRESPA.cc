@@ -0,0 +1,247 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "IntegratorRESPA.h"
+
+#include <pybind11/stl_bind.h>
+PYBIND11_MAKE_OPAQUE(std::vector<std::shared_ptr<hoomd::ForceCompute>>);
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+IntegratorRESPA::IntegratorRESPA(std::shared_ptr<SystemDefinition> sysdef,
+                                 Scalar deltaT,
+                                 unsigned int period)
+    : IntegratorTwoStep(sysdef, deltaT), m_period(1)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing IntegratorRESPA" << endl;
+
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        throw std::runtime_error("Cannot create IntegratorRESPA on a GPU device.");
+        }
+
+    setPeriod(period);
+    }
+
+IntegratorRESPA::~IntegratorRESPA()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying IntegratorRESPA" << endl;
+    }
+
+/*! \param deltaT new deltaT to set
+    \post \a deltaT is also set on all slow forces
+*/
+void IntegratorRESPA::setDeltaT(Scalar deltaT)
+    {
+    IntegratorTwoStep::setDeltaT(deltaT);
+
+    for (auto& force : m_slow_forces)
+        {
+        force->setDeltaT(deltaT);
+        }
+    }
+
+/*! \param period Number of inner steps per outer step
+ */
+void IntegratorRESPA::setPeriod(unsigned int period)
+    {
+    if (period == 0)
+        {
+        throw std::domain_error("period must be positive");
+        }
+
+    m_period = period;
+    }
+
+/*! The accelerations are recomputed from the (scaled) net force so that the first step applies the
+    slow force impulse when the run starts on an outer step. A run that starts between outer steps
+    only receives the second impulse at the next outer step.
+*/
+void IntegratorRESPA::prepRun(uint64_t timestep)
+    {
+    for (auto& force : m_slow_forces)
+        {
+        force->setDeltaT(m_deltaT);
+        }
+
+    IntegratorTwoStep::prepRun(timestep);
+
+    computeAccelerations(timestep);
+    m_pdata->notifyAccelSet();
+    }
+
+/*! On outer steps, append the slow forces to m_forces with a force scale of m_period, so that the
+    base class computes them along with the fast forces and before the constraint forces.
+
+    On inner steps, the slow energy and virial from the last outer step are added to the external
+    energy and virial, so that the pressure seen by barostats includes the slow forces.
+*/
+void IntegratorRESPA::computeNetForce(uint64_t timestep)
+    {
+    if (m_slow_forces.size() == 0)
+        {
+        IntegratorTwoStep::computeNetForce(timestep);
+        return;
+        }
+
+    if (!isOuterStep(timestep))
+        {
+        IntegratorTwoStep::computeNetForce(timestep);
+
+        for (unsigned int k = 0; k < 6; k++)
+            {
+            m_pdata->setExternalVirial(k, m_pdata->getExternalVirial(k) + m_slow_virial[k]);
+            }
+        m_pdata->setExternalEnergy(m_pdata->getExternalEnergy() + m_slow_energy);
+        return;
+        }
+
+    size_t n_fast = m_forces.size();
+    m_force_scale.assign(n_fast, Scalar(1.0));
+    for (auto& force : m_slow_forces)
+        {
+        m_forces.push_back(force);
+        m_force_scale.push_back(Scalar(m_period));
+        }
+
+    try
+        {
+        IntegratorTwoStep::computeNetForce(timestep);
+        }
+    catch (...)
+        {
+        m_forces.resize(n_fast);
+        m_force_scale.clear();
+        throw;
+        }
+
+    m_forces.resize(n_fast);
+    m_force_scale.clear();
+
+    storeSlowVirial();
+    }
+
+/*! Sum the energy and virial of the slow forces over the local particles, including their external
+    contributions. The sums are this rank's contribution, like the external virial of other forces.
+*/
+void IntegratorRESPA::storeSlowVirial()
+    {
+    const unsigned int N = m_pdata->getN();
+    const bool compute_virial = m_pdata->getFlags()[pdata_flag::pressure_tensor];
+
+    m_slow_energy = Scalar(0.0);
+    for (unsigned int k = 0; k < 6; k++)
+        {
+        m_slow_virial[k] = Scalar(0.0);
+        }
+
+    for (auto& force : m_slow_forces)
+        {
+        ArrayHandle<Scalar4> h_force(force->getForceArray(),
+                                     access_location::host,
+                                     access_mode::read);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            m_slow_energy += h_force.data[i].w;
+            }
+        m_slow_energy += force->getExternalEnergy();
+
+        if (compute_virial)
+            {
+            ArrayHandle<Scalar> h_virial(force->getVirialArray(),
+                                         access_location::host,
+                                         access_mode::read);
+            const size_t pitch = force->getVirialArray().getPitch();
+            for (unsigned int k = 0; k < 6; k++)
+                {
+                for (unsigned int i = 0; i < N; i++)
+                    {
+                    m_slow_virial[k] += h_virial.data[k * pitch + i];
+                    }
+                m_slow_virial[k] += force->getExternalVirial(k);
+                }
+            }
+        }
+    }
+
+#ifdef ENABLE_MPI
+/// helper function to determine the ghost communication flags
+CommFlags IntegratorRESPA::determineFlags(uint64_t timestep)
+    {
+    auto flags = IntegratorTwoStep::determineFlags(timestep);
+
+    if (isOuterStep(timestep))
+        {
+        for (const auto& force : m_slow_forces)
+            {
+            flags |= force->getRequestedCommFlags(timestep);
+            }
+        }
+
+    return flags;
+    }
+#endif
+
+/// Check if any forces introduce anisotropic degrees of freedom
+bool IntegratorRESPA::areForcesAnisotropic()
+    {
+    auto is_anisotropic = IntegratorTwoStep::areForcesAnisotropic();
+
+    for (const auto& force : m_slow_forces)
+        {
+        is_anisotropic |= force->isAnisotropic();
+        }
+
+    return is_anisotropic;
+    }
+
+void IntegratorRESPA::resetStats()
+    {
+    IntegratorTwoStep::resetStats();
+
+    for (auto& force : m_slow_forces)
+        {
+        force->resetStats();
+        }
+    }
+
+void IntegratorRESPA::startAutotuning()
+    {
+    IntegratorTwoStep::startAutotuning();
+
+    for (auto& force : m_slow_forces)
+        {
+        force->startAutotuning();
+        }
+    }
+
+/// Check if autotuning is complete.
+bool IntegratorRESPA::isAutotuningComplete()
+    {
+    bool result = IntegratorTwoStep::isAutotuningComplete();
+    for (auto& force : m_slow_forces)
+        {
+        result = result && force->isAutotuningComplete();
+        }
+    return result;
+    }
+
+namespace detail
+    {
+void export_IntegratorRESPA(pybind11::module& m)
+    {
+    pybind11::class_<IntegratorRESPA, IntegratorTwoStep, std::shared_ptr<IntegratorRESPA>>(
+        m,
+        "IntegratorRESPA")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>, Scalar, unsigned int>())
+        .def_property_readonly("slow_forces", &IntegratorRESPA::getSlowForces)
+        .def_property("period", &IntegratorRESPA::getPeriod, &IntegratorRESPA::setPeriod);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
@@ -0,0 +1,108 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "IntegratorTwoStep.h"
+
+#pragma once
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+namespace hoomd
+    {
+namespace md
+    {
+/// Integrates the system with reversible multiple time stepping (r-RESPA)
+/** IntegratorRESPA splits the forces into fast forces (m_forces), evaluated every step, and slow
+    forces (m_slow_forces), evaluated only on outer steps where the timestep is a multiple of
+    m_period. Each timestep is one inner velocity Verlet step of the integration methods.
+
+    On outer steps, the slow forces enter the net force with their force and torque scaled by
+    m_period. The half step kick in integrateStepTwo and the following integrateStepOne then apply
+    the two slow impulses of the impulse (Verlet-I) r-RESPA scheme, so that any
+    IntegrationMethodTwoStep and its thermostat can be used unchanged.
+
+    The energy and virial of the slow forces are included in the net arrays (unscaled) only on
+    outer steps. On inner steps, their totals from the last outer step are added to the external
+    energy and virial so that the thermodynamic quantities (and barostats) include them.
+
+    \ingroup updaters
+*/
+class PYBIND11_EXPORT IntegratorRESPA : public IntegratorTwoStep
+    {
+    public:
+    /// Constructor
+    IntegratorRESPA(std::shared_ptr<SystemDefinition> sysdef, Scalar deltaT, unsigned int period);
+
+    /// Destructor
+    virtual ~IntegratorRESPA();
+
+    /// Change the timestep
+    virtual void setDeltaT(Scalar deltaT);
+
+    /// Get the list of slow forces
+    std::vector<std::shared_ptr<ForceCompute>>& getSlowForces()
+        {
+        return m_slow_forces;
+        }
+
+    /// Set the number of inner steps per outer step
+    void setPeriod(unsigned int period);
+
+    /// Get the number of inner steps per outer step
+    unsigned int getPeriod()
+        {
+        return m_period;
+        }
+
+    /// Prepare for the run
+    virtual void prepRun(uint64_t timestep);
+
+    /// helper function to compute net force/virial
+    virtual void computeNetForce(uint64_t timestep);
+
+#ifdef ENABLE_MPI
+    /// helper function to determine the ghost communication flags
+    virtual CommFlags determineFlags(uint64_t timestep);
+#endif
+
+    /// Check if any forces introduce anisotropic degrees of freedom
+    virtual bool areForcesAnisotropic();
+
+    /// Reset stats counters for children objects
+    virtual void resetStats();
+
+    /// Start autotuning kernel launch parameters
+    virtual void startAutotuning();
+
+    /// Check if autotuning is complete.
+    virtual bool isAutotuningComplete();
+
+    protected:
+    /// Forces evaluated on outer steps only
+    std::vector<std::shared_ptr<ForceCompute>> m_slow_forces;
+
+    /// Number of inner steps per outer step
+    unsigned int m_period;
+
+    /// Local virial of the slow forces at the last outer step
+    Scalar m_slow_virial[6] = {0, 0, 0, 0, 0, 0};
+
+    /// Local energy of the slow forces at the last outer step
+    Scalar m_slow_energy = 0;
+
+    /// Sum the energy and virial of the slow forces
+    void storeSlowVirial();
+
+    /// Test if the slow forces are evaluated at the given timestep
+    bool isOuterStep(uint64_t timestep) const
+        {
+        return timestep % m_period == 0;
+        }
+    };
+
+    } // end namespace md
+    } // end namespace hoomd
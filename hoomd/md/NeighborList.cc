@@ -31,7 +31,8 @@ namespace md
 */
 NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar r_buff)
     : Compute(sysdef), m_typpair_idx(m_pdata->getNTypes()), m_rcut_max_max(0.0), m_rcut_min(0.0),
-      m_r_buff(r_buff), m_filter_body(false), m_storage_mode(half), m_meshbond_data(NULL),
+      m_r_buff(r_buff), m_filter_body(false), m_storage_mode(half), m_r_buff_user(r_buff),
+      m_meshbond_data(NULL),
       m_rcut_changed(true), m_updates(0), m_forced_updates(0), m_dangerous_updates(0),
       m_force_update(true), m_dist_check(true), m_has_been_updated_once(false)
     {
@@ -48,8 +49,14 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar r_bu
     m_last_checked_tstep = 0;
     m_last_check_result = false;
     m_rebuild_check_delay = 0;
+    m_adaptive_check_delay = 0;
     m_exclusions_set = false;
 
+    m_last_build_end = 0;
+    m_last_build_time = 0;
+    m_avg_build_time = 0.0;
+    m_avg_interval_time = 0.0;
+
     m_n_particles_changed = false;
 
     // initialize box length at last update
@@ -225,6 +232,9 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar r_bu
     m_pdata->getMaxParticleNumberChangeSignal().connect<NeighborList, &NeighborList::reallocate>(
         this);
 
+    // connect to shrink to fit to release unused neighborlist memory
+    m_pdata->getShrinkToFitSignal().connect<NeighborList, &NeighborList::shrinkToFit>(this);
+
     m_pdata->getGlobalParticleNumberChangeSignal()
         .connect<NeighborList, &NeighborList::slotGlobalParticleNumberChange>(this);
 
@@ -316,6 +326,7 @@ NeighborList::~NeighborList()
     m_pdata->getParticleSortSignal().disconnect<NeighborList, &NeighborList::forceUpdate>(this);
     m_pdata->getMaxParticleNumberChangeSignal().disconnect<NeighborList, &NeighborList::reallocate>(
         this);
+    m_pdata->getShrinkToFitSignal().disconnect<NeighborList, &NeighborList::shrinkToFit>(this);
     m_pdata->getGlobalParticleNumberChangeSignal()
         .disconnect<NeighborList, &NeighborList::slotGlobalParticleNumberChange>(this);
 
@@ -408,6 +419,21 @@ void NeighborList::compute(uint64_t timestep)
         // check simulation box size is OK
         checkBoxSize();
 
+        if (m_midpoint)
+            {
+            if (m_storage_mode == full)
+                {
+                throw std::runtime_error("The midpoint method requires half neighbor lists.");
+                }
+
+            // ghost particles have rows in the list, and the ghosts change with every build
+            buildHeadList();
+            if (m_exclusions_set)
+                updateExListIdx();
+            }
+
+        int64_t build_start = m_clock.getTime();
+
         // rebuild the list until there is no overflow
         bool overflowed = false;
         do
@@ -429,8 +455,14 @@ void NeighborList::compute(uint64_t timestep)
         if (m_exclusions_set)
             filterNlist();
 
+        if (m_midpoint)
+            filterMidpoint();
+
         setLastUpdatedPos();
         m_has_been_updated_once = true;
+
+        m_last_build_end = m_clock.getTime();
+        m_last_build_time = m_last_build_end - build_start;
         }
     }
 
@@ -440,11 +472,16 @@ void NeighborList::compute(uint64_t timestep)
 */
 void NeighborList::setRBuff(Scalar r_buff)
     {
-    m_r_buff = r_buff;
-    if (m_r_buff < 0.0)
+    if (r_buff < 0.0)
         {
         throw runtime_error("Requested buffer radius is less than zero.");
         }
+    if (r_buff == Scalar(0.0) && m_adaptive_buffer)
+        {
+        throw invalid_argument("The adaptive buffer requires a nonzero buffer.");
+        }
+    m_r_buff = r_buff;
+    m_r_buff_user = r_buff;
     notifyRCutMatrixChange();
     forceUpdate();
     }
@@ -1312,7 +1349,7 @@ void NeighborList::setLastUpdatedPos()
 
 bool NeighborList::shouldCheckDistance(uint64_t timestep)
     {
-    return !m_force_update && !(timestep < (m_last_updated_tstep + m_rebuild_check_delay));
+    return !m_force_update && !(timestep < (m_last_updated_tstep + getCheckDelay()));
     }
 
 /*! \returns true If the neighbor list needs to be updated
@@ -1351,8 +1388,7 @@ bool NeighborList::needsUpdating(uint64_t timestep)
     // the last build
     bool dangerous = false;
     if (m_dist_check
-        && (m_rebuild_check_delay > 1
-            && timestep == (m_last_updated_tstep + m_rebuild_check_delay)))
+        && (getCheckDelay() > 1 && timestep == (m_last_updated_tstep + getCheckDelay())))
         dangerous = true;
 
     // if the update has been forced, the result defaults to true
@@ -1395,6 +1431,10 @@ bool NeighborList::needsUpdating(uint64_t timestep)
                 if (period >= m_update_periods.size())
                     period = m_update_periods.size() - 1;
                 m_update_periods[period]++;
+
+                // retune the buffer before the build and the ghost layer width request
+                if (m_adaptive_buffer)
+                    adaptBuffer(timestep - m_last_updated_tstep, dangerous);
                 }
 
             m_last_updated_tstep = timestep;
@@ -1421,10 +1461,126 @@ void NeighborList::resetStats()
     {
     m_updates = m_forced_updates = m_dangerous_updates = 0;
 
+    // the time between runs does not count towards the adaptive buffer
+    m_last_build_end = 0;
+
     for (unsigned int i = 0; i < m_update_periods.size(); i++)
         m_update_periods[i] = 0;
     }
 
+/*! \param period Number of steps since the last build
+    \param dangerous True if the rebuild was triggered by the first check after the last build
+
+    The cost model is described in the class documentation. All ranks use the build and interval
+    times of the slowest rank and the smallest local box so that they agree on the new buffer
+    width.
+*/
+void NeighborList::adaptBuffer(uint64_t period, bool dangerous)
+    {
+    // setAdaptiveBuffer() and setRBuff() reject a zero buffer
+    const Scalar r_buff = m_r_buff;
+    assert(r_buff > Scalar(0.0));
+
+    if (m_last_build_end > 0)
+        {
+        double times[2] = {double(m_last_build_time),
+                           double(m_clock.getTime() - m_last_build_end) / double(period)};
+#ifdef ENABLE_MPI
+        if (m_sysdef->isDomainDecomposed())
+            {
+            MPI_Allreduce(MPI_IN_PLACE,
+                          times,
+                          2,
+                          MPI_DOUBLE,
+                          MPI_MAX,
+                          m_exec_conf->getMPICommunicator());
+            }
+#endif
+
+        // running averages smooth out the timer noise
+        bool first = m_avg_interval_time == 0.0;
+        m_avg_build_time = first ? times[0] : 0.5 * (m_avg_build_time + times[0]);
+        m_avg_interval_time = first ? times[1] : 0.5 * (m_avg_interval_time + times[1]);
+        }
+
+    Scalar new_r_buff = r_buff;
+    if (m_avg_interval_time > 0.0)
+        {
+        const Scalar r_cut = getMaxRCut();
+
+        // bounds of the search, r_list must stay below half of the local box
+        Scalar3 L = m_pdata->getBox().getNearestPlaneDistance();
+        Scalar L_min = std::min(L.x, L.y);
+        if (m_sysdef->getNDimensions() == 3)
+            L_min = std::min(L_min, L.z);
+#ifdef ENABLE_MPI
+        // local boxes differ between ranks, all ranks must search the same range
+        if (m_sysdef->isDomainDecomposed())
+            {
+            MPI_Allreduce(MPI_IN_PLACE,
+                          &L_min,
+                          1,
+                          MPI_HOOMD_SCALAR,
+                          MPI_MIN,
+                          m_exec_conf->getMPICommunicator());
+            }
+#endif
+        Scalar r_max = std::min(Scalar(4.0) * m_r_buff_user,
+                                Scalar(0.49) * L_min - r_cut);
+        r_max = std::max(r_max, std::min(r_buff, m_r_buff_user));
+        Scalar r_min = std::min(Scalar(0.25) * m_r_buff_user, r_max);
+
+        // model of the cost per step relative to the current buffer
+        const double dimensions = m_sysdef->getNDimensions();
+        auto cost = [&](Scalar b)
+        {
+            double volume = pow((r_cut + b) / (r_cut + r_buff), dimensions);
+            return volume
+                   * (m_avg_build_time * r_buff / (double(period) * b) + m_avg_interval_time);
+        };
+
+        Scalar best = r_buff;
+        double best_cost = cost(r_buff);
+        const unsigned int n_samples = 32;
+        for (unsigned int i = 0; i < n_samples; i++)
+            {
+            Scalar b = r_min + (r_max - r_min) * Scalar(i) / Scalar(n_samples - 1);
+            double c = cost(b);
+            if (b > Scalar(0.0) && c < best_cost)
+                {
+                best = b;
+                best_cost = c;
+                }
+            }
+
+        new_r_buff = r_buff + Scalar(0.5) * (best - r_buff);
+        if (dangerous)
+            new_r_buff = std::max(new_r_buff, r_buff);
+        }
+
+    // lower the check delay to stay clear of dangerous builds with the new buffer
+    if (dangerous)
+        {
+        m_adaptive_check_delay = 1;
+        }
+    else
+        {
+        double ratio = std::min(new_r_buff / r_buff, Scalar(1.0));
+        uint64_t delay = uint64_t(double(period) * ratio * ratio / 2.0);
+        m_adaptive_check_delay = std::min(m_rebuild_check_delay, std::max(delay, uint64_t(1)));
+        }
+
+    // skip small changes, they would only resize the cell list
+    if (std::abs(new_r_buff - r_buff) > Scalar(0.02) * r_buff)
+        {
+        m_exec_conf->msg->notice(6) << "nlist: adaptive buffer " << r_buff << " -> " << new_r_buff
+                                    << endl;
+        m_r_buff = new_r_buff;
+        notifyRCutMatrixChange();
+        updateRList();
+        }
+    }
+
 unsigned int NeighborList::getSmallestRebuild()
     {
     for (unsigned int i = 0; i < m_update_periods.size(); i++)
@@ -1463,7 +1619,7 @@ void NeighborList::updateExListIdx()
                                             access_mode::overwrite);
 
     // translate the number and exclusions from one array to the other
-    for (unsigned int idx = 0; idx < m_pdata->getN(); idx++)
+    for (unsigned int idx = 0; idx < getNRows(); idx++)
         {
         // get the tag for this index
         unsigned int tag = h_tag.data[idx];
@@ -1498,7 +1654,7 @@ void NeighborList::filterNlist()
     ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::readwrite);
 
     // for each particle's neighbor list
-    for (unsigned int idx = 0; idx < m_pdata->getN(); idx++)
+    for (unsigned int idx = 0; idx < getNRows(); idx++)
         {
         size_t myHead = h_head_list.data[idx];
         unsigned int n_neigh = h_n_neigh.data[idx];
@@ -1535,6 +1691,55 @@ void NeighborList::filterNlist()
         }
     }
 
+/*! A pair is kept only on the rank whose domain contains the pair midpoint, so that each pair is
+    listed exactly once across all ranks. Ownership is tested only along the decomposed directions,
+    where the local box is not periodic.
+*/
+void NeighborList::filterMidpoint()
+    {
+#ifdef ENABLE_MPI
+    if (!m_sysdef->isDomainDecomposed())
+        return;
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<size_t> h_head_list(m_head_list, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::readwrite);
+
+    const BoxDim& box = m_pdata->getBox();
+    uchar3 periodic = box.getPeriodic();
+
+    for (unsigned int i = 0; i < getNRows(); i++)
+        {
+        const size_t head_i = h_head_list.data[i];
+        const unsigned int n_neigh = h_n_neigh.data[i];
+        const Scalar3 pos_i = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        unsigned int new_n_neigh = 0;
+
+        for (unsigned int k = 0; k < n_neigh; k++)
+            {
+            unsigned int j = h_nlist.data[head_i + k];
+            const Scalar3 pos_j = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+
+            Scalar3 midpoint = pos_i + Scalar(0.5) * box.minImage(pos_j - pos_i);
+            Scalar3 f = box.makeFraction(midpoint);
+
+            bool owned = (periodic.x || (f.x >= Scalar(0.0) && f.x < Scalar(1.0)))
+                         && (periodic.y || (f.y >= Scalar(0.0) && f.y < Scalar(1.0)))
+                         && (periodic.z || (f.z >= Scalar(0.0) && f.z < Scalar(1.0)));
+
+            if (owned)
+                {
+                h_nlist.data[head_i + new_n_neigh] = j;
+                new_n_neigh++;
+                }
+            }
+
+        h_n_neigh.data[i] = new_n_neigh;
+        }
+#endif
+    }
+
 /*!
  * Iterates through each particle, and calculates a running sum of the starting index for that
  * particle in the flat array of neighbors.
@@ -1551,7 +1756,7 @@ void NeighborList::buildHeadList()
                                    access_mode::read);
         ArrayHandle<unsigned int> h_Nmax(m_Nmax, access_location::host, access_mode::read);
 
-        for (unsigned int i = 0; i < m_pdata->getN(); ++i)
+        for (unsigned int i = 0; i < getNRows(); ++i)
             {
             h_head_list.data[i] = headAddress;
 
@@ -1568,10 +1773,24 @@ void NeighborList::buildHeadList()
  * \param size the requested number of elements in the neighbor list
  *
  * Increases the size of the neighbor list memory using amortized resizing (growth factor: 9/8)
- * only when needed.
+ * only when needed. After shrinkToFit(), the memory is reduced to \a size when it exceeds the
+ * requested ratio.
  */
 void NeighborList::resizeNlist(size_t size)
     {
+    if (m_shrink_nlist_ratio > Scalar(0)
+        && Scalar(m_nlist.getNumElements()) > m_shrink_nlist_ratio * Scalar(size))
+        {
+        // round up to nearest multiple of 4
+        size_t alloc_size = (size > 4) ? (size + 3) & ~3 : 4;
+
+        m_exec_conf->msg->notice(6)
+            << "nlist: Shrinking neighbor list, new size " << alloc_size << " uints " << endl;
+
+        m_nlist.resize(alloc_size);
+        }
+    m_shrink_nlist_ratio = 0;
+
     if (size > m_nlist.getNumElements())
         {
         m_exec_conf->msg->notice(6)
@@ -1591,6 +1810,52 @@ void NeighborList::resizeNlist(size_t size)
         }
     }
 
+/*!
+ * \param ratio Ratio of allocated to required memory above which buffers are shrunk
+ *
+ * The maximum number of neighbors per particle only grows when the list overflows, so after a
+ * compression it holds the high-water mark of the densest configuration. For each type where it
+ * exceeds \a ratio times the largest number of neighbors in the last build, it is reset to that
+ * number (rounded up to the nearest 4). The flat neighbor list is shrunk when the head list is
+ * rebuilt at the next update. If the estimate is too small, the next build overflows and the list
+ * grows again.
+ */
+void NeighborList::shrinkToFit(Scalar ratio)
+    {
+    if (m_has_been_updated_once)
+        {
+        ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<unsigned int> h_Nmax(m_Nmax, access_location::host, access_mode::readwrite);
+
+        std::vector<unsigned int> n_neigh_max(m_pdata->getNTypes(), 0);
+        for (unsigned int i = 0; i < getNRows(); ++i)
+            {
+            unsigned int type = __scalar_as_int(h_pos.data[i].w);
+            n_neigh_max[type] = std::max(n_neigh_max[type], h_n_neigh.data[i]);
+            }
+
+        for (unsigned int i = 0; i < m_pdata->getNTypes(); ++i)
+            {
+            unsigned int Nmax = (n_neigh_max[i] > 4) ? (n_neigh_max[i] + 3) & ~3 : 4;
+            if (Scalar(h_Nmax.data[i]) > ratio * Scalar(Nmax))
+                {
+                m_exec_conf->msg->notice(6) << "nlist: Shrinking Nmax for type " << i << " from "
+                                            << h_Nmax.data[i] << " to " << Nmax << endl;
+                h_Nmax.data[i] = Nmax;
+                }
+            }
+        }
+
+    resetConditions();
+
+    // the flat list is shrunk when the head list is rebuilt
+    m_shrink_nlist_ratio = ratio;
+    forceUpdate();
+    }
+
 /*!
  * \returns true if an overflow is detected for any particle type
  * \returns false if all particle types have enough memory for their neighbors
@@ -1743,7 +2008,7 @@ pybind11::array_t<uint32_t> NeighborList::getLocalPairListPython(uint64_t timest
     // We can get an upper bound for the number of pairs by accumulating n_neigh,
     // but without explicitly checking tags we cannot be sure of the number of duplicates
     size_t max_n_elem = 0;
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    for (unsigned int i = 0; i < getNRows(); i++)
         {
         max_n_elem += h_n_neigh.data[i];
         }
@@ -1758,7 +2023,7 @@ pybind11::array_t<uint32_t> NeighborList::getLocalPairListPython(uint64_t timest
                                            delete data;
                                        });
 
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    for (unsigned int i = 0; i < getNRows(); i++)
         {
         const size_t my_head = h_head_list.data[i];
         const unsigned int size = h_n_neigh.data[i];
@@ -1803,7 +2068,7 @@ pybind11::object NeighborList::getPairListPython(uint64_t timestep)
     // We can get an upper bound for the number of pairs by accumulating n_neigh,
     // but without explicitly checking tags we cannot be sure of the number of duplicates
     size_t max_n_elem = 0;
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    for (unsigned int i = 0; i < getNRows(); i++)
         {
         max_n_elem += h_n_neigh.data[i];
         }
@@ -1811,7 +2076,7 @@ pybind11::object NeighborList::getPairListPython(uint64_t timestep)
     auto* pair_list = new std::vector<vec2<uint32_t>>();
     pair_list->reserve(max_n_elem);
 
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    for (unsigned int i = 0; i < getNRows(); i++)
         {
         unsigned int tag_i = h_tags.data[i];
         const size_t my_head = h_head_list.data[i];
@@ -1820,7 +2085,8 @@ pybind11::object NeighborList::getPairListPython(uint64_t timestep)
             {
             const unsigned int j = h_nlist.data[my_head + k];
             const unsigned int tag_j = h_tags.data[j];
-            if ((!third_law || j >= m_pdata->getN()) && tag_i > tag_j)
+            // pairs with ghosts are listed on both ranks, except with the midpoint method
+            if (!m_midpoint && (!third_law || j >= m_pdata->getN()) && tag_i > tag_j)
                 continue;
 
             pair_list->push_back(vec2(tag_i, tag_j));
@@ -1997,6 +2263,10 @@ void export_NeighborList(pybind11::module& m)
                       &NeighborList::setRebuildCheckDelay)
         .def_property("check_dist", &NeighborList::getDistCheck, &NeighborList::setDistCheck)
         .def("setStorageMode", &NeighborList::setStorageMode)
+        .def_property("midpoint", &NeighborList::getMidpoint, &NeighborList::setMidpoint)
+        .def_property("adaptive_buffer",
+                      &NeighborList::getAdaptiveBuffer,
+                      &NeighborList::setAdaptiveBuffer)
         .def_property("exclusions", &NeighborList::getExclusions, &NeighborList::setExclusions)
         .def("addMesh", &NeighborList::AddMesh)
         .def("getMaxRCut", &NeighborList::getMaxRCut)
@@ -1,6 +1,7 @@
 // Copyright (c) 2009-2024 The Regents of the University of Michigan.
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+#include "hoomd/ClockSource.h"
 #include "hoomd/Compute.h"
 #include "hoomd/GPUFlags.h"
 #include "hoomd/GPUVector.h"
@@ -116,6 +117,32 @@ namespace md
     Condition flags are to be set during the buildNlist() call and will be checked by compute()
    which will then take the appropriate action.
 
+    <b>Midpoint method:</b>
+
+    By default, every rank lists all pairs of a local particle with local and ghost particles, so
+   pairs that cross a domain boundary are evaluated on both ranks and the ghost layer must be as
+   wide as r_list. When setMidpoint() is enabled with half storage in a domain decomposed
+   simulation, a pair is listed only on the rank whose domain contains the midpoint of the pair at
+   build time. Ghost particles then also have rows in the list (getNRows()), and the requested ghost
+   layer width is halved to r_list / 2. Consumers must apply the forces on ghost particles and add
+   them to their owners with Communicator::addGhostForces().
+
+    <b>Adaptive buffer:</b>
+
+    With setAdaptiveBuffer(), the buffer width is retuned at every rebuild triggered by the distance
+   check. The time spent in the build and the time spent between builds are measured and the cost
+   per step is modeled as the build time divided by the rebuild period plus the time between
+   builds, both scaled by the volume of the search sphere, with the rebuild period proportional to
+   the buffer width. The buffer moves half way towards the minimum of this model within
+   [r_buff / 4, 4 r_buff] of the value given to setRBuff(). The new buffer is applied just before
+   the list is built (and before the ghost layer width is requested), so a list is never checked
+   against a wider buffer than the one it was built with. The list memory is only reallocated
+   when a wider buffer overflows it.
+
+    To avoid dangerous builds, the check delay is lowered below the user set value to half of the
+   last rebuild period, scaled quadratically for a narrower buffer. After a dangerous build the
+   list is checked every step and the buffer is not narrowed until the next rebuild.
+
     \ingroup computes
 */
 class PYBIND11_EXPORT NeighborList : public Compute
@@ -203,6 +230,7 @@ class PYBIND11_EXPORT NeighborList : public Compute
     void setRebuildCheckDelay(uint64_t every)
         {
         m_rebuild_check_delay = every;
+        m_adaptive_check_delay = every;
         forceUpdate();
         }
 
@@ -213,6 +241,10 @@ class PYBIND11_EXPORT NeighborList : public Compute
 
     void setDistCheck(bool dist_check)
         {
+        if (!dist_check && m_adaptive_buffer)
+            {
+            throw std::invalid_argument("The adaptive buffer requires check_dist=True.");
+            }
         m_dist_check = dist_check;
         }
 
@@ -221,6 +253,53 @@ class PYBIND11_EXPORT NeighborList : public Compute
         return m_dist_check;
         }
 
+    //! Enable or disable online tuning of the buffer width
+    void setAdaptiveBuffer(bool adaptive)
+        {
+        if (adaptive && !m_dist_check)
+            {
+            throw std::invalid_argument("The adaptive buffer requires check_dist=True.");
+            }
+        if (adaptive && m_r_buff_user <= Scalar(0.0))
+            {
+            throw std::invalid_argument("The adaptive buffer requires a nonzero buffer.");
+            }
+        if (adaptive && m_exec_conf->isCUDAEnabled())
+            {
+            throw std::runtime_error("The adaptive buffer is not implemented on the GPU.");
+            }
+        m_adaptive_buffer = adaptive;
+        m_r_buff = m_r_buff_user;
+        m_adaptive_check_delay = m_rebuild_check_delay;
+        m_avg_build_time = 0.0;
+        m_avg_interval_time = 0.0;
+        notifyRCutMatrixChange();
+        forceUpdate();
+        }
+
+    //! Test if the buffer width is tuned online
+    bool getAdaptiveBuffer()
+        {
+        return m_adaptive_buffer;
+        }
+
+    //! Enable or disable the midpoint method
+    void setMidpoint(bool midpoint)
+        {
+        if (midpoint && m_exec_conf->isCUDAEnabled())
+            {
+            throw std::runtime_error("The midpoint method is not implemented on the GPU.");
+            }
+        m_midpoint = midpoint;
+        forceUpdate();
+        }
+
+    //! Test if the midpoint method is enabled
+    bool getMidpoint()
+        {
+        return m_midpoint;
+        }
+
     //! Set the storage mode
     /*! \param mode Storage mode to set
         - half only stores neighbors where i < j
@@ -388,7 +467,9 @@ class PYBIND11_EXPORT NeighborList : public Compute
 
         if (rcut_max_i > Scalar(0.0)) // ensure communication is required
             {
-            return rcut_max_i + m_r_buff;
+            // with the midpoint method, both particles of a pair are within r_list / 2 of the
+            // midpoint, which is in the local domain
+            return m_midpoint ? (rcut_max_i + m_r_buff) / Scalar(2.0) : rcut_max_i + m_r_buff;
             }
         else
             {
@@ -451,6 +532,15 @@ class PYBIND11_EXPORT NeighborList : public Compute
         return m_pdata->getNGhosts();
         }
 
+    //! Get the number of particles with a row in the neighbor list
+    /*! Only local particles have rows, except with the midpoint method, where ghost particles
+        have rows too.
+    */
+    unsigned int getNRows() const
+        {
+        return m_midpoint ? m_pdata->getN() + m_pdata->getNGhosts() : m_pdata->getN();
+        }
+
     /// Get the local pair list from Python
     pybind11::array_t<uint32_t> getLocalPairListPython(uint64_t timestep);
 
@@ -484,6 +574,10 @@ class PYBIND11_EXPORT NeighborList : public Compute
     Scalar m_r_buff;            //!< The buffer around the cutoff
     bool m_filter_body;         //!< Set to true if particles in the same body are to be filtered
     storageMode m_storage_mode; //!< The storage mode
+    bool m_midpoint = false;    //!< True if pairs are assigned to ranks by their midpoint
+
+    bool m_adaptive_buffer = false; //!< True if the buffer width is tuned online
+    Scalar m_r_buff_user;           //!< The buffer width set by the user
 
     GlobalArray<unsigned int> m_nlist;   //!< Neighbor list data
     GlobalArray<unsigned int> m_n_neigh; //!< Number of neighbors for each particle
@@ -513,6 +607,9 @@ class PYBIND11_EXPORT NeighborList : public Compute
     /// True if the number of bonds/angles/dihedrals/impropers/pairs has changed.
     bool m_topology_changed = false;
 
+    /// Shrink the neighbor list memory at the next head list build when over this ratio (0: never).
+    Scalar m_shrink_nlist_ratio = 0;
+
 #ifdef ENABLE_MPI
     /// The system's communicator.
     std::shared_ptr<Communicator> m_comm;
@@ -542,12 +639,18 @@ class PYBIND11_EXPORT NeighborList : public Compute
     //! Filter the neighbor list of excluded particles
     virtual void filterNlist();
 
+    //! Remove the pairs whose midpoint is outside of the local domain
+    void filterMidpoint();
+
     //! Build the head list to allocated memory
     virtual void buildHeadList();
 
     //! Amortized resizing of the neighborlist
     void resizeNlist(size_t size);
 
+    //! Release the neighbor list memory held beyond the last build
+    void shrinkToFit(Scalar ratio);
+
 #ifdef ENABLE_MPI
     CommFlags getRequestedCommFlags(uint64_t timestep)
         {
@@ -594,11 +697,27 @@ class PYBIND11_EXPORT NeighborList : public Compute
     uint64_t m_rebuild_check_delay;         //!< No update checks will be performed until
                                             //!< m_rebuild_check_delay steps after the last one
     std::vector<uint64_t> m_update_periods; //!< Steps between updates
+    uint64_t m_adaptive_check_delay;        //!< Check delay lowered by the adaptive buffer
+
+    ClockSource m_clock;        //!< Timer for the adaptive buffer
+    int64_t m_last_build_end;   //!< Time at the end of the last build (0 when unknown)
+    int64_t m_last_build_time;  //!< Duration of the last build
+    double m_avg_build_time;    //!< Running average of the build time
+    double m_avg_interval_time; //!< Running average of the time per step between builds
     std::set<std::string> m_exclusions;     //!< Exclusions that have been set
 
     //! Test if the list needs updating
     bool needsUpdating(uint64_t timestep);
 
+    //! Get the check delay in effect
+    uint64_t getCheckDelay() const
+        {
+        return m_adaptive_buffer ? m_adaptive_check_delay : m_rebuild_check_delay;
+        }
+
+    //! Retune the buffer width before a build triggered by the distance check
+    void adaptBuffer(uint64_t period, bool dangerous);
+
     //! Reallocate internal neighbor list data structures
     void reallocate();
 
@@ -89,8 +89,8 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
     // get periodic flags
     uchar3 periodic = box.getPeriodic();
 
-    // for each local particle
-    unsigned int nparticles = m_pdata->getN();
+    // for each local particle (and ghost particle with the midpoint method)
+    unsigned int nparticles = getNRows();
 
     for (int i = 0; i < (int)nparticles; i++)
         {
@@ -117,6 +117,14 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
         if (kb == (int)dim.z && periodic.z)
             kb = 0;
 
+        // ghost particles outside of the cell list cannot form a pair with a local midpoint
+        if (ib < 0 || ib >= (int)dim.x || jb < 0 || jb >= (int)dim.y || kb < 0
+            || kb >= (int)dim.z)
+            {
+            h_n_neigh.data[i] = 0;
+            continue;
+            }
+
         // identify the bin
         unsigned int my_cell = ci(ib, jb, kb);
 
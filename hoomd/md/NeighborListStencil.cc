@@ -152,8 +152,8 @@ void NeighborListStencil::buildNlist(uint64_t timestep)
     Index3D ci = m_cl->getCellIndexer();
     Index2D cli = m_cl->getCellListIndexer();
 
-    // for each local particle
-    unsigned int nparticles = m_pdata->getN();
+    // for each local particle (and ghost particle with the midpoint method)
+    unsigned int nparticles = getNRows();
 
     for (int i = 0; i < (int)nparticles; i++)
         {
@@ -180,6 +180,14 @@ void NeighborListStencil::buildNlist(uint64_t timestep)
         if (kb == (int)dim.z && periodic.z)
             kb = 0;
 
+        // ghost particles outside of the cell list cannot form a pair with a local midpoint
+        if (ib < 0 || ib >= (int)dim.x || jb < 0 || jb >= (int)dim.y || kb < 0
+            || kb >= (int)dim.z)
+            {
+            h_n_neigh.data[i] = 0;
+            continue;
+            }
+
         // loop through all neighboring bins
         unsigned int n_stencil = h_n_stencil.data[type_i];
         for (unsigned int cur_stencil = 0; cur_stencil < n_stencil; ++cur_stencil)
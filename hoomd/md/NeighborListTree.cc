@@ -293,8 +293,8 @@ void NeighborListTree::traverseTree()
     ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::overwrite);
 
-    // Loop over all particles
-    for (unsigned int i = 0; i < m_pdata->getN(); ++i)
+    // Loop over all particles with a row in the list
+    for (unsigned int i = 0; i < getNRows(); ++i)
         {
         // read in the current position and orientation
         const Scalar4 postype_i = h_postype.data[i];
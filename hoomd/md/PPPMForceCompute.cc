@@ -4,6 +4,10 @@
 #include "PPPMForceCompute.h"
 #include <map>
 
+#ifdef ENABLE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 namespace hoomd
     {
 namespace md
@@ -144,6 +148,9 @@ PPPMForceCompute::~PPPMForceCompute()
         kiss_fft_free(m_kiss_ifft);
         kiss_fft_cleanup();
         }
+#ifdef ENABLE_FFTW
+    destroyFFTWPlans();
+#endif
 #ifdef ENABLE_MPI
     if (m_dfft_initialized)
         {
@@ -525,7 +532,16 @@ void PPPMForceCompute::initializeFFT()
         }
 #endif // ENABLE_MPI
 
-    if (local_fft)
+    bool use_kiss_fft = local_fft;
+
+#ifdef ENABLE_FFTW
+    // FFTW replaces KISS FFT for local transforms, plans are created once the meshes are allocated
+    destroyFFTWPlans();
+    m_fftw_initialized = local_fft;
+    use_kiss_fft = false;
+#endif
+
+    if (use_kiss_fft)
         {
         int dims[3];
         dims[0] = m_mesh_points.z;
@@ -575,8 +591,73 @@ void PPPMForceCompute::initializeFFT()
 
     GlobalArray<kiss_fft_cpx> inv_fourier_mesh_z(m_n_cells + m_ghost_offset, m_exec_conf);
     m_inv_fourier_mesh_z.swap(inv_fourier_mesh_z);
+
+#ifdef ENABLE_FFTW
+    if (m_fftw_initialized)
+        {
+        static_assert(sizeof(kiss_fft_cpx) == sizeof(fftwf_complex),
+                      "FFTW requires single precision mesh storage");
+
+        // the meshes are row major with x varying fastest, as in the KISS FFT configuration
+        int nz = m_mesh_points.z;
+        int ny = m_mesh_points.y;
+        int nx = m_mesh_points.x;
+
+        ArrayHandle<kiss_fft_cpx> h_mesh(m_mesh, access_location::host, access_mode::overwrite);
+        ArrayHandle<kiss_fft_cpx> h_fourier_mesh(m_fourier_mesh,
+                                                 access_location::host,
+                                                 access_mode::overwrite);
+        m_fftw_forward = fftwf_plan_dft_3d(nz,
+                                           ny,
+                                           nx,
+                                           reinterpret_cast<fftwf_complex*>(h_mesh.data),
+                                           reinterpret_cast<fftwf_complex*>(h_fourier_mesh.data),
+                                           FFTW_FORWARD,
+                                           FFTW_ESTIMATE);
+
+        GlobalArray<kiss_fft_cpx>* fourier_mesh_G[3]
+            = {&m_fourier_mesh_G_x, &m_fourier_mesh_G_y, &m_fourier_mesh_G_z};
+        GlobalArray<kiss_fft_cpx>* inv_fourier_mesh[3]
+            = {&m_inv_fourier_mesh_x, &m_inv_fourier_mesh_y, &m_inv_fourier_mesh_z};
+        for (unsigned int i = 0; i < 3; ++i)
+            {
+            ArrayHandle<kiss_fft_cpx> h_in(*fourier_mesh_G[i],
+                                           access_location::host,
+                                           access_mode::overwrite);
+            ArrayHandle<kiss_fft_cpx> h_out(*inv_fourier_mesh[i],
+                                            access_location::host,
+                                            access_mode::overwrite);
+            m_fftw_inverse[i] = fftwf_plan_dft_3d(nz,
+                                                  ny,
+                                                  nx,
+                                                  reinterpret_cast<fftwf_complex*>(h_in.data),
+                                                  reinterpret_cast<fftwf_complex*>(h_out.data),
+                                                  FFTW_BACKWARD,
+                                                  FFTW_ESTIMATE);
+            }
+        }
+#endif
     }
 
+#ifdef ENABLE_FFTW
+void PPPMForceCompute::destroyFFTWPlans()
+    {
+    if (!m_fftw_initialized)
+        return;
+
+    if (m_fftw_forward)
+        fftwf_destroy_plan(m_fftw_forward);
+    for (unsigned int i = 0; i < 3; ++i)
+        {
+        if (m_fftw_inverse[i])
+            fftwf_destroy_plan(m_fftw_inverse[i]);
+        m_fftw_inverse[i] = NULL;
+        }
+    m_fftw_forward = NULL;
+    m_fftw_initialized = false;
+    }
+#endif
+
 //! CPU implementation of sinc(x)==sin(x)/x
 inline Scalar sinc(Scalar x)
     {
@@ -634,6 +715,9 @@ void PPPMForceCompute::computeInfluenceFunction()
 
 #ifdef ENABLE_MPI
     bool local_fft = m_kiss_fft_initialized;
+#ifdef ENABLE_FFTW
+    local_fft |= m_fftw_initialized;
+#endif
 
     uint3 pdim = make_uint3(0, 0, 0);
     uint3 pidx = make_uint3(0, 0, 0);
@@ -781,6 +865,9 @@ void PPPMForceCompute::assignParticles()
     ArrayHandle<kiss_fft_cpx> h_mesh(m_mesh, access_location::host, access_mode::overwrite);
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
 
+    ArrayHandle<unsigned int> h_index_array(m_group->getIndexArray(),
+                                            access_location::host,
+                                            access_mode::read);
     ArrayHandle<Scalar> h_rho_coeff(m_rho_coeff, access_location::host, access_mode::read);
 
     const BoxDim& box = m_pdata->getBox();
@@ -790,11 +877,13 @@ void PPPMForceCompute::assignParticles()
 
     Scalar V_cell = box.getVolume() / (Scalar)(m_mesh_points.x * m_mesh_points.y * m_mesh_points.z);
 
-    // loop over group
-    unsigned int group_size = m_group->getNumMembers();
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-        {
-        unsigned int idx = m_group->getMemberIndex(group_idx);
+    int nlower = -(m_order - 1) / 2;
+    int nupper = m_order / 2;
+
+    // find the mesh cell of one group member and the offset of the particle from that cell
+    auto locate_particle = [&](unsigned int group_idx, int3& cell, Scalar3& d) -> bool
+    {
+        unsigned int idx = h_index_array.data[group_idx];
 
         Scalar4 postype = h_postype.data[idx];
         Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
@@ -802,11 +891,9 @@ void PPPMForceCompute::assignParticles()
         // ignore if NaN
         if (std::isnan(pos.x) || std::isnan(pos.y) || std::isnan(pos.z))
             {
-            continue;
+            return false;
             }
 
-        Scalar qi = h_charge.data[idx];
-
         // compute coordinates in units of the mesh size
         Scalar3 f = box.makeFraction(pos);
         Scalar3 reduced_pos = make_scalar3(f.x * (Scalar)m_mesh_points.x,
@@ -835,9 +922,9 @@ void PPPMForceCompute::assignParticles()
         int iy = int(reduced_pos.y + shift);
         int iz = int(reduced_pos.z + shift);
 
-        Scalar dx = shiftone + (Scalar)ix - reduced_pos.x;
-        Scalar dy = shiftone + (Scalar)iy - reduced_pos.y;
-        Scalar dz = shiftone + (Scalar)iz - reduced_pos.z;
+        d.x = shiftone + (Scalar)ix - reduced_pos.x;
+        d.y = shiftone + (Scalar)iy - reduced_pos.y;
+        d.z = shiftone + (Scalar)iz - reduced_pos.z;
 
         // handle particles on the boundary
         if (ix == (int)m_grid_dim.x && !m_n_ghost_cells.x)
@@ -851,24 +938,37 @@ void PPPMForceCompute::assignParticles()
             || iz >= (int)m_grid_dim.z)
             {
             // ignore, error will be thrown elsewhere (in CellList)
-            continue;
+            return false;
+            }
+
+        cell = make_int3(ix, iy, iz);
+        return true;
+    };
+
+    // spread the charge of one group member, store(i, j, k, rho) adds rho to mesh cell (i, j, k)
+    auto spread_particle = [&](unsigned int group_idx, auto&& store)
+    {
+        int3 cell;
+        Scalar3 d;
+        if (!locate_particle(group_idx, cell, d))
+            {
+            return;
             }
 
+        Scalar qi = h_charge.data[h_index_array.data[group_idx]];
+
         int mult_fact = 2 * m_order + 1;
         Scalar Wx, Wy, Wz;
 
-        int nlower = -(m_order - 1) / 2;
-        int nupper = m_order / 2;
-
         for (int i = nlower; i <= nupper; ++i)
             {
             Wx = Scalar(0.0);
             for (int iorder = m_order - 1; iorder >= 0; iorder--)
                 {
-                Wx = h_rho_coeff.data[i - nlower + iorder * mult_fact] + Wx * dx;
+                Wx = h_rho_coeff.data[i - nlower + iorder * mult_fact] + Wx * d.x;
                 }
 
-            int neighi = (int)ix + i;
+            int neighi = cell.x + i;
 
             if (!m_n_ghost_cells.x)
                 {
@@ -883,10 +983,10 @@ void PPPMForceCompute::assignParticles()
                 Wy = Scalar(0.0);
                 for (int iorder = m_order - 1; iorder >= 0; iorder--)
                     {
-                    Wy = h_rho_coeff.data[j - nlower + iorder * mult_fact] + Wy * dy;
+                    Wy = h_rho_coeff.data[j - nlower + iorder * mult_fact] + Wy * d.y;
                     }
 
-                int neighj = (int)iy + j;
+                int neighj = cell.y + j;
 
                 if (!m_n_ghost_cells.y)
                     {
@@ -901,10 +1001,10 @@ void PPPMForceCompute::assignParticles()
                     Wz = Scalar(0.0);
                     for (int iorder = m_order - 1; iorder >= 0; iorder--)
                         {
-                        Wz = h_rho_coeff.data[k - nlower + iorder * mult_fact] + Wz * dz;
+                        Wz = h_rho_coeff.data[k - nlower + iorder * mult_fact] + Wz * d.z;
                         }
 
-                    int neighk = (int)iz + k;
+                    int neighk = cell.z + k;
                     if (!m_n_ghost_cells.z)
                         {
                         if (neighk >= (int)m_grid_dim.z)
@@ -915,15 +1015,180 @@ void PPPMForceCompute::assignParticles()
 
                     Scalar W = Wx * Wy * Wz;
 
-                    // store in row major order
-                    unsigned int neigh_idx
-                        = neighi + m_grid_dim.x * (neighj + m_grid_dim.y * neighk);
-
-                    h_mesh.data[neigh_idx].r += float(qi * W / V_cell);
+                    store(neighi, neighj, neighk, float(qi * W / V_cell));
                     }
                 }
             }
-        } // end loop over particles
+    };
+
+    unsigned int group_size = m_group->getNumMembers();
+
+#ifdef ENABLE_TBB
+    // each thread spreads a contiguous chunk of group members (which are spatially sorted) onto
+    // its own tile, which covers only the mesh cells that the chunk touches, the tiles are then
+    // summed in a fixed order
+    unsigned int n_chunks = std::min(m_exec_conf->getNumThreads(), group_size);
+    if (n_chunks > 1)
+        {
+        const int3 grid_dim = make_int3(m_grid_dim.x, m_grid_dim.y, m_grid_dim.z);
+        const bool periodic[3] = {!m_n_ghost_cells.x, !m_n_ghost_cells.y, !m_n_ghost_cells.z};
+
+        // coordinate of mesh cell n in a tile window starting at lo
+        auto tile_coord = [](int n, int lo, int dim, bool periodic) -> int
+        {
+            int t = n - lo;
+            if (periodic && t < 0)
+                t += dim;
+            return t;
+        };
+
+        // window of the cells touched by the base cells [min, max] along one direction
+        auto tile_window = [&](int min, int max, int dim, bool periodic, int& lo, int& size)
+        {
+            lo = min + nlower;
+            int hi = max + nupper;
+            if (!periodic)
+                {
+                lo = std::max(lo, 0);
+                hi = std::min(hi, dim - 1);
+                }
+            size = hi - lo + 1;
+            if (size >= dim)
+                {
+                lo = 0;
+                size = dim;
+                }
+            else if (lo < 0)
+                {
+                lo += dim;
+                }
+        };
+
+        m_thread_tiles.resize(n_chunks);
+
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for(
+                    (unsigned int)0,
+                    n_chunks,
+                    [&](unsigned int chunk)
+                    {
+                        unsigned int begin = (unsigned int)(size_t(chunk) * group_size / n_chunks);
+                        unsigned int end
+                            = (unsigned int)(size_t(chunk + 1) * group_size / n_chunks);
+
+                        // bounding box of the base cells in this chunk
+                        int3 cell_min = grid_dim;
+                        int3 cell_max = make_int3(-1, -1, -1);
+                        for (unsigned int group_idx = begin; group_idx < end; group_idx++)
+                            {
+                            int3 cell;
+                            Scalar3 d;
+                            if (!locate_particle(group_idx, cell, d))
+                                continue;
+                            cell_min = make_int3(std::min(cell_min.x, cell.x),
+                                                 std::min(cell_min.y, cell.y),
+                                                 std::min(cell_min.z, cell.z));
+                            cell_max = make_int3(std::max(cell_max.x, cell.x),
+                                                 std::max(cell_max.y, cell.y),
+                                                 std::max(cell_max.z, cell.z));
+                            }
+
+                        MeshTile& tile = m_thread_tiles[chunk];
+                        if (cell_max.x < 0)
+                            {
+                            tile.lo = make_int3(0, 0, 0);
+                            tile.size = make_int3(0, 0, 0);
+                            return;
+                            }
+
+                        tile_window(cell_min.x,
+                                    cell_max.x,
+                                    grid_dim.x,
+                                    periodic[0],
+                                    tile.lo.x,
+                                    tile.size.x);
+                        tile_window(cell_min.y,
+                                    cell_max.y,
+                                    grid_dim.y,
+                                    periodic[1],
+                                    tile.lo.y,
+                                    tile.size.y);
+                        tile_window(cell_min.z,
+                                    cell_max.z,
+                                    grid_dim.z,
+                                    periodic[2],
+                                    tile.lo.z,
+                                    tile.size.z);
+
+                        kiss_fft_cpx zero = {0, 0};
+                        tile.data.assign(size_t(tile.size.x) * tile.size.y * tile.size.z, zero);
+
+                        auto store = [&](int i, int j, int k, float rho)
+                        {
+                            int ti = tile_coord(i, tile.lo.x, grid_dim.x, periodic[0]);
+                            int tj = tile_coord(j, tile.lo.y, grid_dim.y, periodic[1]);
+                            int tk = tile_coord(k, tile.lo.z, grid_dim.z, periodic[2]);
+                            tile.data[ti + size_t(tile.size.x) * (tj + size_t(tile.size.y) * tk)]
+                                .r
+                                += rho;
+                        };
+
+                        for (unsigned int group_idx = begin; group_idx < end; group_idx++)
+                            spread_particle(group_idx, store);
+                    });
+
+                // sum the tiles plane by plane, in chunk order for every mesh cell
+                tbb::parallel_for(
+                    tbb::blocked_range<int>(0, grid_dim.z),
+                    [&](const tbb::blocked_range<int>& r)
+                    {
+                        for (int k = r.begin(); k != r.end(); ++k)
+                            {
+                            for (const MeshTile& tile : m_thread_tiles)
+                                {
+                                int tk = tile_coord(k, tile.lo.z, grid_dim.z, periodic[2]);
+                                if (tk < 0 || tk >= tile.size.z)
+                                    continue;
+
+                                for (int tj = 0; tj < tile.size.y; tj++)
+                                    {
+                                    int j = tile.lo.y + tj;
+                                    if (j >= grid_dim.y)
+                                        j -= grid_dim.y;
+
+                                    const kiss_fft_cpx* row
+                                        = tile.data.data()
+                                          + size_t(tile.size.x) * (tj + size_t(tile.size.y) * tk);
+                                    kiss_fft_cpx* mesh_row
+                                        = h_mesh.data + size_t(grid_dim.x) * (j + grid_dim.y * k);
+                                    for (int ti = 0; ti < tile.size.x; ti++)
+                                        {
+                                        int i = tile.lo.x + ti;
+                                        if (i >= grid_dim.x)
+                                            i -= grid_dim.x;
+                                        mesh_row[i].r += row[ti].r;
+                                        }
+                                    }
+                                }
+                            }
+                    });
+            });
+        return;
+        }
+#endif
+
+    // loop over group
+    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        {
+        spread_particle(group_idx,
+                        [&](int i, int j, int k, float rho)
+                        {
+                            // store in row major order
+                            h_mesh.data[i + m_grid_dim.x * (j + m_grid_dim.y * k)].r += rho;
+                        });
+        }
     }
 
 void PPPMForceCompute::updateMeshes()
@@ -939,6 +1204,21 @@ void PPPMForceCompute::updateMeshes()
         kiss_fftnd(m_kiss_fft, h_mesh.data, h_fourier_mesh.data);
         }
 
+#ifdef ENABLE_FFTW
+    if (m_fftw_initialized)
+        {
+        // transform the particle mesh locally (forward transform)
+        ArrayHandle<kiss_fft_cpx> h_mesh(m_mesh, access_location::host, access_mode::read);
+        ArrayHandle<kiss_fft_cpx> h_fourier_mesh(m_fourier_mesh,
+                                                 access_location::host,
+                                                 access_mode::overwrite);
+
+        fftwf_execute_dft(m_fftw_forward,
+                          reinterpret_cast<fftwf_complex*>(h_mesh.data),
+                          reinterpret_cast<fftwf_complex*>(h_fourier_mesh.data));
+        }
+#endif
+
 #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
         {
@@ -980,23 +1260,38 @@ void PPPMForceCompute::updateMeshes()
         unsigned int NNN = m_global_dim.x * m_global_dim.y * m_global_dim.z;
 
         // multiply with influence function and I*k
-        for (unsigned int k = 0; k < m_n_inner_cells; ++k)
-            {
-            kiss_fft_cpx f = h_fourier_mesh.data[k];
+        auto multiply_influence = [&](unsigned int begin, unsigned int end)
+        {
+            for (unsigned int k = begin; k < end; ++k)
+                {
+                kiss_fft_cpx f = h_fourier_mesh.data[k];
 
-            Scalar scaled_inf_f = h_inf_f.data[k] / ((Scalar)NNN);
+                Scalar scaled_inf_f = h_inf_f.data[k] / ((Scalar)NNN);
 
-            Scalar3 kvec = h_k.data[k];
+                Scalar3 kvec = h_k.data[k];
 
-            h_fourier_mesh_G_x.data[k].r = float(f.i * kvec.x * scaled_inf_f);
-            h_fourier_mesh_G_x.data[k].i = float(-f.r * kvec.x * scaled_inf_f);
+                h_fourier_mesh_G_x.data[k].r = float(f.i * kvec.x * scaled_inf_f);
+                h_fourier_mesh_G_x.data[k].i = float(-f.r * kvec.x * scaled_inf_f);
 
-            h_fourier_mesh_G_y.data[k].r = float(f.i * kvec.y * scaled_inf_f);
-            h_fourier_mesh_G_y.data[k].i = float(-f.r * kvec.y * scaled_inf_f);
+                h_fourier_mesh_G_y.data[k].r = float(f.i * kvec.y * scaled_inf_f);
+                h_fourier_mesh_G_y.data[k].i = float(-f.r * kvec.y * scaled_inf_f);
 
-            h_fourier_mesh_G_z.data[k].r = float(f.i * kvec.z * scaled_inf_f);
-            h_fourier_mesh_G_z.data[k].i = float(-f.r * kvec.z * scaled_inf_f);
-            }
+                h_fourier_mesh_G_z.data[k].r = float(f.i * kvec.z * scaled_inf_f);
+                h_fourier_mesh_G_z.data[k].i = float(-f.r * kvec.z * scaled_inf_f);
+                }
+        };
+
+#ifdef ENABLE_TBB
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, m_n_inner_cells),
+                                  [&](const tbb::blocked_range<unsigned int>& r)
+                                  { multiply_influence(r.begin(), r.end()); });
+            });
+#else
+        multiply_influence(0, m_n_inner_cells);
+#endif
         }
 
     if (m_kiss_fft_initialized)
@@ -1025,6 +1320,29 @@ void PPPMForceCompute::updateMeshes()
         kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_z.data, h_inv_fourier_mesh_z.data);
         }
 
+#ifdef ENABLE_FFTW
+    if (m_fftw_initialized)
+        {
+        // do a local inverse transform of the force mesh
+        GlobalArray<kiss_fft_cpx>* fourier_mesh_G[3]
+            = {&m_fourier_mesh_G_x, &m_fourier_mesh_G_y, &m_fourier_mesh_G_z};
+        GlobalArray<kiss_fft_cpx>* inv_fourier_mesh[3]
+            = {&m_inv_fourier_mesh_x, &m_inv_fourier_mesh_y, &m_inv_fourier_mesh_z};
+        for (unsigned int i = 0; i < 3; ++i)
+            {
+            ArrayHandle<kiss_fft_cpx> h_in(*fourier_mesh_G[i],
+                                           access_location::host,
+                                           access_mode::read);
+            ArrayHandle<kiss_fft_cpx> h_out(*inv_fourier_mesh[i],
+                                            access_location::host,
+                                            access_mode::overwrite);
+            fftwf_execute_dft(m_fftw_inverse[i],
+                              reinterpret_cast<fftwf_complex*>(h_in.data),
+                              reinterpret_cast<fftwf_complex*>(h_out.data));
+            }
+        }
+#endif
+
 #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
         {
@@ -1104,151 +1422,169 @@ void PPPMForceCompute::interpolateForces()
     // reset force for ALL particles
     memset(h_force.data, 0, sizeof(Scalar4) * m_pdata->getN());
 
+    ArrayHandle<unsigned int> h_index_array(m_group->getIndexArray(),
+                                            access_location::host,
+                                            access_mode::read);
     ArrayHandle<Scalar> h_rho_coeff(m_rho_coeff, access_location::host, access_mode::read);
 
     const BoxDim& box = m_pdata->getBox();
 
-    // loop over group
-    unsigned int group_size = m_group->getNumMembers();
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-        {
-        unsigned int idx = m_group->getMemberIndex(group_idx);
-        Scalar4 postype = h_postype.data[idx];
-
-        Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
-
-        // ignore if NaN
-        if (std::isnan(pos.x) || std::isnan(pos.y) || std::isnan(pos.z))
-            {
-            continue;
-            }
-
-        Scalar qi = h_charge.data[idx];
-
-        // compute coordinates in units of the mesh size
-        Scalar3 f = box.makeFraction(pos);
-        Scalar3 reduced_pos = make_scalar3(f.x * (Scalar)m_mesh_points.x,
-                                           f.y * (Scalar)m_mesh_points.y,
-                                           f.z * (Scalar)m_mesh_points.z);
-        reduced_pos.x += (Scalar)m_n_ghost_cells.x;
-        reduced_pos.y += (Scalar)m_n_ghost_cells.y;
-        reduced_pos.z += (Scalar)m_n_ghost_cells.z;
-
-        Scalar shift, shiftone;
-
-        if (m_order % 2)
-            {
-            shift = 0.5;
-            shiftone = 0.0;
-            }
-        else
+    // interpolate the force on a range of group members, each particle is written independently
+    auto interpolate_range = [&](unsigned int begin, unsigned int end)
+    {
+        for (unsigned int group_idx = begin; group_idx < end; group_idx++)
             {
-            shift = 0.0;
-            shiftone = 0.5;
-            }
-
-        // find cell of the force mesh the particle is in
-        int ix = int(reduced_pos.x + shift);
-        int iy = int(reduced_pos.y + shift);
-        int iz = int(reduced_pos.z + shift);
+            unsigned int idx = h_index_array.data[group_idx];
+            Scalar4 postype = h_postype.data[idx];
 
-        Scalar dx = shiftone + (Scalar)ix - reduced_pos.x;
-        Scalar dy = shiftone + (Scalar)iy - reduced_pos.y;
-        Scalar dz = shiftone + (Scalar)iz - reduced_pos.z;
+            Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
 
-        // handle particles on the boundary
-        if (ix == (int)m_grid_dim.x && !m_n_ghost_cells.x)
-            ix = 0;
-        if (iy == (int)m_grid_dim.y && !m_n_ghost_cells.y)
-            iy = 0;
-        if (iz == (int)m_grid_dim.z && !m_n_ghost_cells.z)
-            iz = 0;
-
-        if (ix < 0 || ix >= (int)m_grid_dim.x || iy < 0 || iy >= (int)m_grid_dim.y || iz < 0
-            || iz >= (int)m_grid_dim.z)
-            {
-            // ignore, error will be thrown elsewhere (in CellList)
-            continue;
-            }
+            // ignore if NaN
+            if (std::isnan(pos.x) || std::isnan(pos.y) || std::isnan(pos.z))
+                {
+                continue;
+                }
 
-        Scalar3 force = make_scalar3(0.0, 0.0, 0.0);
+            Scalar qi = h_charge.data[idx];
 
-        int mult_fact = 2 * m_order + 1;
-        Scalar Wx, Wy, Wz;
+            // compute coordinates in units of the mesh size
+            Scalar3 f = box.makeFraction(pos);
+            Scalar3 reduced_pos = make_scalar3(f.x * (Scalar)m_mesh_points.x,
+                                               f.y * (Scalar)m_mesh_points.y,
+                                               f.z * (Scalar)m_mesh_points.z);
+            reduced_pos.x += (Scalar)m_n_ghost_cells.x;
+            reduced_pos.y += (Scalar)m_n_ghost_cells.y;
+            reduced_pos.z += (Scalar)m_n_ghost_cells.z;
 
-        int nlower = -(m_order - 1) / 2;
-        int nupper = m_order / 2;
+            Scalar shift, shiftone;
 
-        for (int i = nlower; i <= nupper; ++i)
-            {
-            Wx = Scalar(0.0);
-            for (int iorder = m_order - 1; iorder >= 0; iorder--)
+            if (m_order % 2)
                 {
-                Wx = h_rho_coeff.data[i - nlower + iorder * mult_fact] + Wx * dx;
+                shift = 0.5;
+                shiftone = 0.0;
+                }
+            else
+                {
+                shift = 0.0;
+                shiftone = 0.5;
                 }
 
-            int neighi = (int)ix + i;
-
-            if (!m_n_ghost_cells.x)
+            // find cell of the force mesh the particle is in
+            int ix = int(reduced_pos.x + shift);
+            int iy = int(reduced_pos.y + shift);
+            int iz = int(reduced_pos.z + shift);
+
+            Scalar dx = shiftone + (Scalar)ix - reduced_pos.x;
+            Scalar dy = shiftone + (Scalar)iy - reduced_pos.y;
+            Scalar dz = shiftone + (Scalar)iz - reduced_pos.z;
+
+            // handle particles on the boundary
+            if (ix == (int)m_grid_dim.x && !m_n_ghost_cells.x)
+                ix = 0;
+            if (iy == (int)m_grid_dim.y && !m_n_ghost_cells.y)
+                iy = 0;
+            if (iz == (int)m_grid_dim.z && !m_n_ghost_cells.z)
+                iz = 0;
+
+            if (ix < 0 || ix >= (int)m_grid_dim.x || iy < 0 || iy >= (int)m_grid_dim.y || iz < 0
+                || iz >= (int)m_grid_dim.z)
                 {
-                if (neighi >= (int)m_grid_dim.x)
-                    neighi -= m_grid_dim.x;
-                else if (neighi < 0)
-                    neighi += m_grid_dim.x;
+                // ignore, error will be thrown elsewhere (in CellList)
+                continue;
                 }
 
-            for (int j = nlower; j <= nupper; ++j)
+            Scalar3 force = make_scalar3(0.0, 0.0, 0.0);
+
+            int mult_fact = 2 * m_order + 1;
+            Scalar Wx, Wy, Wz;
+
+            int nlower = -(m_order - 1) / 2;
+            int nupper = m_order / 2;
+
+            for (int i = nlower; i <= nupper; ++i)
                 {
-                Wy = Scalar(0.0);
+                Wx = Scalar(0.0);
                 for (int iorder = m_order - 1; iorder >= 0; iorder--)
                     {
-                    Wy = h_rho_coeff.data[j - nlower + iorder * mult_fact] + Wy * dy;
+                    Wx = h_rho_coeff.data[i - nlower + iorder * mult_fact] + Wx * dx;
                     }
 
-                int neighj = (int)iy + j;
+                int neighi = (int)ix + i;
 
-                if (!m_n_ghost_cells.y)
+                if (!m_n_ghost_cells.x)
                     {
-                    if (neighj >= (int)m_grid_dim.y)
-                        neighj -= m_grid_dim.y;
-                    else if (neighj < 0)
-                        neighj += m_grid_dim.y;
+                    if (neighi >= (int)m_grid_dim.x)
+                        neighi -= m_grid_dim.x;
+                    else if (neighi < 0)
+                        neighi += m_grid_dim.x;
                     }
 
-                for (int k = nlower; k <= nupper; ++k)
+                for (int j = nlower; j <= nupper; ++j)
                     {
-                    Wz = Scalar(0.0);
+                    Wy = Scalar(0.0);
                     for (int iorder = m_order - 1; iorder >= 0; iorder--)
                         {
-                        Wz = h_rho_coeff.data[k - nlower + iorder * mult_fact] + Wz * dz;
+                        Wy = h_rho_coeff.data[j - nlower + iorder * mult_fact] + Wy * dy;
                         }
 
-                    int neighk = (int)iz + k;
-                    if (!m_n_ghost_cells.z)
+                    int neighj = (int)iy + j;
+
+                    if (!m_n_ghost_cells.y)
                         {
-                        if (neighk >= (int)m_grid_dim.z)
-                            neighk -= m_grid_dim.z;
-                        else if (neighk < 0)
-                            neighk += m_grid_dim.z;
+                        if (neighj >= (int)m_grid_dim.y)
+                            neighj -= m_grid_dim.y;
+                        else if (neighj < 0)
+                            neighj += m_grid_dim.y;
                         }
 
-                    unsigned int neigh_idx
-                        = neighi + m_grid_dim.x * (neighj + m_grid_dim.y * neighk);
+                    for (int k = nlower; k <= nupper; ++k)
+                        {
+                        Wz = Scalar(0.0);
+                        for (int iorder = m_order - 1; iorder >= 0; iorder--)
+                            {
+                            Wz = h_rho_coeff.data[k - nlower + iorder * mult_fact] + Wz * dz;
+                            }
+
+                        int neighk = (int)iz + k;
+                        if (!m_n_ghost_cells.z)
+                            {
+                            if (neighk >= (int)m_grid_dim.z)
+                                neighk -= m_grid_dim.z;
+                            else if (neighk < 0)
+                                neighk += m_grid_dim.z;
+                            }
 
-                    kiss_fft_cpx E_x = h_inv_fourier_mesh_x.data[neigh_idx];
-                    kiss_fft_cpx E_y = h_inv_fourier_mesh_y.data[neigh_idx];
-                    kiss_fft_cpx E_z = h_inv_fourier_mesh_z.data[neigh_idx];
+                        unsigned int neigh_idx
+                            = neighi + m_grid_dim.x * (neighj + m_grid_dim.y * neighk);
 
-                    Scalar W = Wx * Wy * Wz;
-                    force.x += qi * W * E_x.r;
-                    force.y += qi * W * E_y.r;
-                    force.z += qi * W * E_z.r;
+                        kiss_fft_cpx E_x = h_inv_fourier_mesh_x.data[neigh_idx];
+                        kiss_fft_cpx E_y = h_inv_fourier_mesh_y.data[neigh_idx];
+                        kiss_fft_cpx E_z = h_inv_fourier_mesh_z.data[neigh_idx];
+
+                        Scalar W = Wx * Wy * Wz;
+                        force.x += qi * W * E_x.r;
+                        force.y += qi * W * E_y.r;
+                        force.z += qi * W * E_z.r;
+                        }
                     }
                 }
-            }
 
-        h_force.data[idx] = make_scalar4(force.x, force.y, force.z, 0.0);
-        } // end of loop over particles
+            h_force.data[idx] = make_scalar4(force.x, force.y, force.z, 0.0);
+            } // end of loop over particles
+    };
+
+    unsigned int group_size = m_group->getNumMembers();
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&]
+        {
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, group_size),
+                              [&](const tbb::blocked_range<unsigned int>& r)
+                              { interpolate_range(r.begin(), r.end()); });
+        });
+#else
+    interpolate_range(0, group_size);
+#endif
     }
 
 Scalar PPPMForceCompute::computePE()
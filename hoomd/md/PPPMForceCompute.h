@@ -15,6 +15,14 @@
 
 #include "hoomd/extern/kiss_fftnd.h"
 
+#ifdef ENABLE_FFTW
+#include <fftw3.h>
+#endif
+
+#ifdef ENABLE_TBB
+#include <vector>
+#endif
+
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 #include <memory>
 
@@ -212,6 +220,27 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
 
     bool m_kiss_fft_initialized; //!< True if a local KISS FFT has been set up
 
+#ifdef ENABLE_FFTW
+    fftwf_plan m_fftw_forward = NULL;  //!< FFTW plan for the forward transform of the mesh
+    fftwf_plan m_fftw_inverse[3] = {}; //!< FFTW plans for the inverse transforms of the force mesh
+    bool m_fftw_initialized = false;   //!< True if local FFTW plans have been set up
+
+    //! Destroy the FFTW plans
+    void destroyFFTWPlans();
+#endif
+
+#ifdef ENABLE_TBB
+    //! Part of the charge mesh that one thread assigns charges to
+    struct MeshTile
+        {
+        int3 lo;                        //!< First mesh cell covered by the tile
+        int3 size;                      //!< Number of cells covered along every axis
+        std::vector<kiss_fft_cpx> data; //!< Charges on the covered cells
+        };
+
+    std::vector<MeshTile> m_thread_tiles; //!< Per-thread charge assignment tiles
+#endif
+
     GlobalArray<kiss_fft_cpx> m_mesh;         //!< The particle density mesh
     GlobalArray<kiss_fft_cpx> m_fourier_mesh; //!< The fourier transformed mesh
     GlobalArray<kiss_fft_cpx>
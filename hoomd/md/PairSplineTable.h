@@ -0,0 +1,227 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#ifndef __PAIR_SPLINE_TABLE_H__
+#define __PAIR_SPLINE_TABLE_H__
+
+#include "hoomd/HOOMDMath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+/*! \file PairSplineTable.h
+    \brief Defines the cubic spline table used by the tabulated fast path of PotentialPair
+    \note This header cannot be compiled by nvcc
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace detail
+    {
+//! Cubic spline table of a pair force and energy as a function of r^2
+/*! The range [0, rcutsq) is divided into segments of equal width in r^2. Each segment stores the
+    cubic Hermite polynomials of force_divr and the pair energy in the local coordinate t in [0, 1).
+    The energy slope at the nodes is exact (dU/d(r^2) = -force_divr / 2), the slope of force_divr
+    is estimated by finite differences of the exact function with a step of 1/16 segment.
+
+    Every segment is compared to the exact function at three interior points. Segments with an error
+    above the tolerance (relative to the larger of the exact value and the median magnitude over
+    the table) are not tabulated and evaluate() returns false for them, so that the caller falls
+    back to the exact evaluator. This happens mostly in the steep repulsive core at small r. The
+    number of segments is doubled until all segments outside of the core r < r_cut / 4 are
+    tabulated, or the maximum table size is reached.
+*/
+class PairSplineTable
+    {
+    public:
+    //! Build the table
+    /*! \param rcutsq Squared cutoff radius, the table covers [0, rcutsq)
+        \param tolerance Relative error tolerance
+        \param eval Callable eval(rsq, force_divr, pair_eng) that computes the exact values and
+               sets them to zero when the pair is not evaluated
+    */
+    template<class Func> void build(Scalar rcutsq, Scalar tolerance, const Func& eval)
+        {
+        m_segments.clear();
+        m_inv_width = Scalar(0.0);
+
+        if (!(rcutsq > Scalar(0.0)))
+            return;
+
+        for (unsigned int n = min_segments; n <= max_segments; n *= 2)
+            {
+            unsigned int n_core = buildSegments(n, rcutsq, tolerance, eval);
+
+            bool complete = true;
+            for (unsigned int i = n_core; i < n; i++)
+                {
+                complete = complete && m_segments[i].tabulated;
+                }
+
+            if (complete)
+                break;
+            }
+        }
+
+    //! Interpolate force_divr and the pair energy
+    /*! \param rsq Squared distance between the particles
+        \param force_divr Output force divided by r
+        \param pair_eng Output pair energy
+        \returns false if \a rsq must be evaluated exactly
+    */
+    bool evaluate(Scalar rsq, Scalar& force_divr, Scalar& pair_eng) const
+        {
+        Scalar x = rsq * m_inv_width;
+        unsigned int i = (unsigned int)x;
+        if (i >= m_segments.size())
+            return false;
+
+        const Segment& s = m_segments[i];
+        if (!s.tabulated)
+            return false;
+
+        Scalar t = x - Scalar(i);
+        force_divr = s.f[0] + t * (s.f[1] + t * (s.f[2] + t * s.f[3]));
+        pair_eng = s.e[0] + t * (s.e[1] + t * (s.e[2] + t * s.e[3]));
+        return true;
+        }
+
+    //! Get the number of segments in the table
+    unsigned int getNumSegments() const
+        {
+        return (unsigned int)m_segments.size();
+        }
+
+    private:
+    static const unsigned int min_segments = 64;   //!< Size of the first table attempted
+    static const unsigned int max_segments = 4096; //!< Largest table size
+
+    //! Polynomial coefficients of one segment
+    struct Segment
+        {
+        Scalar f[4];    //!< Coefficients of force_divr in increasing order of t
+        Scalar e[4];    //!< Coefficients of the pair energy in increasing order of t
+        bool tabulated; //!< False when the segment must be evaluated exactly
+        };
+
+    Scalar m_inv_width = Scalar(0.0); //!< Inverse of the segment width in r^2
+    std::vector<Segment> m_segments;  //!< The table
+
+    //! Compute the Hermite coefficients from the end point values and slopes
+    static void hermite(Scalar p0, Scalar p1, Scalar m0, Scalar m1, Scalar* c)
+        {
+        c[0] = p0;
+        c[1] = m0;
+        c[2] = Scalar(3.0) * (p1 - p0) - Scalar(2.0) * m0 - m1;
+        c[3] = Scalar(2.0) * (p0 - p1) + m0 + m1;
+        }
+
+    //! Median magnitude of the given values
+    static Scalar medianMagnitude(std::vector<Scalar> values)
+        {
+        for (auto& v : values)
+            v = std::isfinite(v) ? std::abs(v) : Scalar(0.0);
+        if (values.size() == 0)
+            return Scalar(0.0);
+        auto mid = values.begin() + values.size() / 2;
+        std::nth_element(values.begin(), mid, values.end());
+        return *mid;
+        }
+
+    //! Fill and check a table with \a n segments
+    /*! \returns The index of the first segment outside of the core
+     */
+    template<class Func>
+    unsigned int buildSegments(unsigned int n, Scalar rcutsq, Scalar tolerance, const Func& eval)
+        {
+        Scalar width = rcutsq / Scalar(n);
+        m_inv_width = Scalar(1.0) / width;
+        m_segments.resize(n);
+
+        // force and energy at the nodes, the last node is evaluated just inside the cutoff
+        std::vector<Scalar> F(n + 1), U(n + 1);
+        for (unsigned int i = 0; i <= n; i++)
+            {
+            Scalar rsq = (i < n) ? Scalar(i) * width : std::nextafter(rcutsq, Scalar(0.0));
+            eval(rsq, F[i], U[i]);
+            }
+
+        // errors are measured relative to the typical magnitude outside of the core
+        unsigned int n_core = n / 16;
+        Scalar F_scale = medianMagnitude(std::vector<Scalar>(F.begin() + n_core, F.end()));
+        Scalar U_scale = medianMagnitude(std::vector<Scalar>(U.begin() + n_core, U.end()));
+
+        // slope of force_divr at the nodes in units of the segment width, from finite differences
+        // of the exact function with a step much smaller than the segment
+        std::vector<Scalar> dF(n + 1);
+        Scalar delta = width / Scalar(16.0);
+        for (unsigned int i = 0; i <= n; i++)
+            {
+            Scalar rsq = (i < n) ? Scalar(i) * width : std::nextafter(rcutsq, Scalar(0.0));
+            Scalar f[4], e;
+            if (i == 0 || i == n)
+                {
+                // one sided differences at the ends of the table
+                Scalar sign = (i == 0) ? Scalar(1.0) : Scalar(-1.0);
+                eval(rsq + sign * delta, f[0], e);
+                eval(rsq + sign * Scalar(2.0) * delta, f[1], e);
+                dF[i] = sign * (Scalar(-3.0) * F[i] + Scalar(4.0) * f[0] - f[1])
+                        / (Scalar(2.0) * delta);
+                }
+            else
+                {
+                eval(rsq - Scalar(2.0) * delta, f[0], e);
+                eval(rsq - delta, f[1], e);
+                eval(rsq + delta, f[2], e);
+                eval(rsq + Scalar(2.0) * delta, f[3], e);
+                dF[i] = (f[0] - Scalar(8.0) * f[1] + Scalar(8.0) * f[2] - f[3])
+                        / (Scalar(12.0) * delta);
+                }
+            dF[i] *= width;
+            }
+
+        auto within_tolerance = [&](Scalar approx, Scalar exact, Scalar scale)
+        {
+            return std::isfinite(approx) && std::isfinite(exact)
+                   && std::abs(approx - exact) <= tolerance * std::max(std::abs(exact), scale);
+        };
+
+        for (unsigned int i = 0; i < n; i++)
+            {
+            Segment& s = m_segments[i];
+            hermite(F[i], F[i + 1], dF[i], dF[i + 1], s.f);
+            hermite(U[i],
+                    U[i + 1],
+                    -F[i] * width * Scalar(0.5),
+                    -F[i + 1] * width * Scalar(0.5),
+                    s.e);
+
+            s.tabulated = true;
+            for (Scalar t : {Scalar(0.25), Scalar(0.5), Scalar(0.75)})
+                {
+                Scalar force_divr, pair_eng;
+                eval((Scalar(i) + t) * width, force_divr, pair_eng);
+
+                Scalar approx_force = s.f[0] + t * (s.f[1] + t * (s.f[2] + t * s.f[3]));
+                Scalar approx_eng = s.e[0] + t * (s.e[1] + t * (s.e[2] + t * s.e[3]));
+                s.tabulated = s.tabulated && within_tolerance(approx_force, force_divr, F_scale)
+                              && within_tolerance(approx_eng, pair_eng, U_scale);
+                }
+            }
+
+        return n_core;
+        }
+    };
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __PAIR_SPLINE_TABLE_H__
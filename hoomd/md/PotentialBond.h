@@ -1,10 +1,13 @@
 // Copyright (c) 2009-2024 The Regents of the University of Michigan.
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+#include "BondedGroupChunks.h"
 #include "hoomd/ForceCompute.h"
 #include "hoomd/GPUArray.h"
 #include "hoomd/MeshDefinition.h"
+#include <algorithm>
 #include <memory>
+#include <sstream>
 
 #include <vector>
 
@@ -64,6 +67,8 @@ template<class evaluator, class Bonds> class PotentialBond : public ForceCompute
     GPUArray<param_type> m_params;      //!< Bond parameters per type
     std::shared_ptr<Bonds> m_bond_data; //!< Bond data to use in computing bonds
 
+    detail::BondedGroupChunks m_chunks; //!< Threaded evaluation of the bond table
+
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
     };
@@ -162,15 +167,22 @@ pybind11::dict PotentialBond<evaluator, Bonds>::getParams(std::string type)
 
 /*! Actually perform the force computation
     \param timestep Current time step
+
+    Bonds are visited in the order of the local index table, sorted by the first member. With TBB,
+    the table is evaluated in chunks by detail::BondedGroupChunks, so results do not depend on
+    thread scheduling.
  */
 template<class evaluator, class Bonds>
 void PotentialBond<evaluator, Bonds>::computeForces(uint64_t timestep)
     {
     assert(m_pdata);
 
+    // bonds sorted by the local index of their first member, with member indices cached
+    const std::vector<typename Bonds::members_t>& bond_table = m_bond_data->getLocalIndexTable();
+    const std::vector<unsigned int>& bond_groups = m_bond_data->getLocalIndexTableGroups();
+
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
 
     ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::readwrite);
@@ -197,78 +209,81 @@ void PotentialBond<evaluator, Bonds>::computeForces(uint64_t timestep)
     PDataFlags flags = this->m_pdata->getFlags();
     bool compute_virial = flags[pdata_flag::pressure_tensor];
 
-    Scalar bond_virial[6];
-    for (unsigned int i = 0; i < 6; i++)
-        bond_virial[i] = Scalar(0.0);
-
-    ArrayHandle<typename Bonds::members_t> h_bonds(m_bond_data->getMembersArray(),
-                                                   access_location::host,
-                                                   access_mode::read);
     ArrayHandle<typeval_t> h_typeval(m_bond_data->getTypeValArray(),
                                      access_location::host,
                                      access_mode::read);
 
-    unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
+    const unsigned int N = m_pdata->getN();
 
-    // for each of the bonds
-    const unsigned int size = (unsigned int)m_bond_data->getN();
+    // evaluate the bonds [begin, end) of the table and hand the contribution to each particle to
+    // add(idx, force_x, force_y, force_z, energy, virial)
+    auto compute_bonds = [&](unsigned int begin, unsigned int end, auto&& add)
+    {
+        Scalar bond_virial[6];
+        for (unsigned int i = 0; i < 6; i++)
+            bond_virial[i] = Scalar(0.0);
 
-    for (unsigned int i = 0; i < size; i++)
-        {
-        // lookup the tag of each of the particles participating in the bond
-        const typename Bonds::members_t& bond = h_bonds.data[i];
-        assert(bond.tag[0] < m_pdata->getMaximumTag() + 1);
-        assert(bond.tag[1] < m_pdata->getMaximumTag() + 1);
-
-        // transform a and b into indices into the particle data arrays
-        // (MEM TRANSFER: 4 integers)
-        unsigned int idx_a = h_rtag.data[bond.tag[0]];
-        unsigned int idx_b = h_rtag.data[bond.tag[1]];
-
-        // throw an error if this bond is incomplete
-        if (idx_a >= max_local || idx_b >= max_local)
+        for (unsigned int i = begin; i < end; i++)
             {
-            std::ostringstream stream;
-            stream << "Error: bond " << bond.tag[0] << " " << bond.tag[1] << " is incomplete.";
-            throw std::runtime_error(stream.str());
-            }
+            // the particle indices of the bond members are cached in the table
+            const typename Bonds::members_t& bond = bond_table[i];
+            unsigned int idx_a = bond.idx[0];
+            unsigned int idx_b = bond.idx[1];
 
-        // calculate d\vec{r}
-        // (MEM TRANSFER: 6 Scalars / FLOPS: 3)
-        Scalar3 posa = make_scalar3(h_pos.data[idx_a].x, h_pos.data[idx_a].y, h_pos.data[idx_a].z);
-        Scalar3 posb = make_scalar3(h_pos.data[idx_b].x, h_pos.data[idx_b].y, h_pos.data[idx_b].z);
+            // throw an error if this bond is incomplete
+            if (idx_a == NOT_LOCAL || idx_b == NOT_LOCAL)
+                {
+                const typename Bonds::members_t tags
+                    = m_bond_data->getMembersByIndex(bond_groups[i]);
+                std::ostringstream stream;
+                stream << "Error: bond " << tags.tag[0] << " " << tags.tag[1] << " is incomplete.";
+                throw std::runtime_error(stream.str());
+                }
 
-        Scalar3 dx = posb - posa;
+            // calculate d\vec{r}
+            // (MEM TRANSFER: 6 Scalars / FLOPS: 3)
+            Scalar3 posa
+                = make_scalar3(h_pos.data[idx_a].x, h_pos.data[idx_a].y, h_pos.data[idx_a].z);
+            Scalar3 posb
+                = make_scalar3(h_pos.data[idx_b].x, h_pos.data[idx_b].y, h_pos.data[idx_b].z);
 
-        // access charge (if needed)
-        Scalar charge_a = Scalar(0.0);
-        Scalar charge_b = Scalar(0.0);
-        if (evaluator::needsCharge())
-            {
-            charge_a = h_charge.data[idx_a];
-            charge_b = h_charge.data[idx_b];
-            }
+            Scalar3 dx = posb - posa;
+
+            // access charge (if needed)
+            Scalar charge_a = Scalar(0.0);
+            Scalar charge_b = Scalar(0.0);
+            if (evaluator::needsCharge())
+                {
+                charge_a = h_charge.data[idx_a];
+                charge_b = h_charge.data[idx_b];
+                }
 
-        // if the vector crosses the box, pull it back
-        dx = box.minImage(dx);
+            // if the vector crosses the box, pull it back
+            dx = box.minImage(dx);
 
-        // calculate r_ab squared
-        Scalar rsq = dot(dx, dx);
+            // calculate r_ab squared
+            Scalar rsq = dot(dx, dx);
 
-        // compute the force and potential energy
-        Scalar force_divr = Scalar(0.0);
-        Scalar bond_eng = Scalar(0.0);
-        evaluator eval(rsq, h_params.data[h_typeval.data[i].type]);
-        if (evaluator::needsCharge())
-            eval.setCharge(charge_a, charge_b);
+            // compute the force and potential energy
+            Scalar force_divr = Scalar(0.0);
+            Scalar bond_eng = Scalar(0.0);
+            evaluator eval(rsq, h_params.data[h_typeval.data[bond_groups[i]].type]);
+            if (evaluator::needsCharge())
+                eval.setCharge(charge_a, charge_b);
 
-        bool evaluated = eval.evalForceAndEnergy(force_divr, bond_eng);
+            bool evaluated = eval.evalForceAndEnergy(force_divr, bond_eng);
 
-        // Bond energy must be halved
-        bond_eng *= Scalar(0.5);
+            // Bond energy must be halved
+            bond_eng *= Scalar(0.5);
+
+            if (!evaluated)
+                {
+                this->m_exec_conf->msg->error()
+                    << "bond." << evaluator::getName() << ": bond out of bounds" << std::endl
+                    << std::endl;
+                throw std::runtime_error("Error in bond calculation");
+                }
 
-        if (evaluated)
-            {
             // calculate virial
             if (compute_virial)
                 {
@@ -282,36 +297,46 @@ void PotentialBond<evaluator, Bonds>::computeForces(uint64_t timestep)
                 }
 
             // add the force to the particles (only for non-ghost particles)
-            if (idx_b < m_pdata->getN())
+            if (idx_b < N)
                 {
-                h_force.data[idx_b].x += force_divr * dx.x;
-                h_force.data[idx_b].y += force_divr * dx.y;
-                h_force.data[idx_b].z += force_divr * dx.z;
-                h_force.data[idx_b].w += bond_eng;
-                if (compute_virial)
-                    for (unsigned int i = 0; i < 6; i++)
-                        h_virial.data[i * m_virial_pitch + idx_b] += bond_virial[i];
+                add(idx_b,
+                    force_divr * dx.x,
+                    force_divr * dx.y,
+                    force_divr * dx.z,
+                    bond_eng,
+                    bond_virial);
                 }
 
-            if (idx_a < m_pdata->getN())
+            if (idx_a < N)
                 {
-                h_force.data[idx_a].x -= force_divr * dx.x;
-                h_force.data[idx_a].y -= force_divr * dx.y;
-                h_force.data[idx_a].z -= force_divr * dx.z;
-                h_force.data[idx_a].w += bond_eng;
-                if (compute_virial)
-                    for (unsigned int i = 0; i < 6; i++)
-                        h_virial.data[i * m_virial_pitch + idx_a] += bond_virial[i];
+                add(idx_a,
+                    -force_divr * dx.x,
+                    -force_divr * dx.y,
+                    -force_divr * dx.z,
+                    bond_eng,
+                    bond_virial);
                 }
             }
-        else
-            {
-            this->m_exec_conf->msg->error()
-                << "bond." << evaluator::getName() << ": bond out of bounds" << std::endl
-                << std::endl;
-            throw std::runtime_error("Error in bond calculation");
-            }
-        }
+    };
+
+    // add a contribution to the force and virial arrays
+    auto add_force = [&](unsigned int idx,
+                         Scalar force_x,
+                         Scalar force_y,
+                         Scalar force_z,
+                         Scalar energy,
+                         const Scalar* virial)
+    {
+        h_force.data[idx].x += force_x;
+        h_force.data[idx].y += force_y;
+        h_force.data[idx].z += force_z;
+        h_force.data[idx].w += energy;
+        if (compute_virial)
+            for (unsigned int k = 0; k < 6; k++)
+                h_virial.data[k * m_virial_pitch + idx] += virial[k];
+    };
+
+    m_chunks.run(*m_exec_conf, bond_table, N, compute_bonds, add_force);
     }
 
 #ifdef ENABLE_MPI
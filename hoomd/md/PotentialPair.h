@@ -17,6 +17,7 @@
 #include "hoomd/Index1D.h"
 #include "hoomd/managed_allocator.h"
 #include "hoomd/md/EvaluatorPairLJ.h"
+#include "hoomd/md/PairSplineTable.h"
 
 #ifdef ENABLE_HIP
 #include <hip/hip_runtime.h>
@@ -72,6 +73,15 @@ namespace md
    potentials are used. Thus, the combination of XPLOR switching + shifted potentials will not be
    supported to avoid slowing down the calculation for everyone.
 
+    <b>Tabulation</b>
+
+    When a positive tabulation tolerance is set, computeForces() interpolates the force and energy
+   (including the shift and XPLOR smoothing) from a cubic spline table in r^2 per type pair
+   (detail::PairSplineTable) instead of calling the evaluator. The tables are rebuilt lazily after
+   any change to the parameters, r_cut, r_on or the shift mode. Pairs in segments of the table that
+   do not meet the tolerance are computed with the evaluator. Tabulation is only available on the
+   CPU and for evaluators that do not depend on the particle charges.
+
     <b>Implementation details</b>
 
     rcutsq, ronsq, and the params are stored per particle type pair. It wastes a little bit of
@@ -92,6 +102,9 @@ template<class evaluator> class PotentialPair : public ForceCompute
     //! Destructor
     virtual ~PotentialPair();
 
+    //! Compute the forces and add the forces on ghost particles to their owners
+    virtual void compute(uint64_t timestep);
+
     //! Set and get the pair parameters for a single type pair
     virtual void setParams(unsigned int typ1, unsigned int typ2, const param_type& param);
     virtual void setParamsPython(pybind11::tuple typ, pybind11::dict params);
@@ -124,10 +137,12 @@ template<class evaluator> class PotentialPair : public ForceCompute
     void setShiftMode(energyShiftMode mode)
         {
         m_shift_mode = mode;
+        m_tables_dirty = true;
         }
 
     void setShiftModePython(std::string mode)
         {
+        m_tables_dirty = true;
         if (mode == "none")
             {
             m_shift_mode = no_shift;
@@ -182,6 +197,18 @@ template<class evaluator> class PotentialPair : public ForceCompute
         return m_tail_correction_enabled;
         }
 
+    /// Set the relative error tolerance of the tabulated fast path (0 disables tabulation)
+    void setTabulationTolerance(Scalar tolerance);
+
+    /// Get the relative error tolerance of the tabulated fast path
+    Scalar getTabulationTolerance()
+        {
+        return m_tabulation_tolerance;
+        }
+
+    /// Test whether the pair force at distance r is interpolated from the spline tables
+    bool isTabulated(pybind11::tuple types, Scalar r);
+
 #ifdef ENABLE_MPI
     //! Get ghost particle fields requested by this pair potential
     virtual CommFlags getRequestedCommFlags(uint64_t timestep);
@@ -242,6 +269,15 @@ template<class evaluator> class PotentialPair : public ForceCompute
     /// Keep track of number of each type of particle
     std::vector<unsigned int> m_num_particles_by_type;
 
+    /// Relative error tolerance of the tabulated fast path, 0 when tabulation is disabled
+    Scalar m_tabulation_tolerance = Scalar(0.0);
+
+    /// Set when the tables need to be rebuilt
+    bool m_tables_dirty = true;
+
+    /// Spline tables of the force and energy per type pair
+    std::vector<detail::PairSplineTable> m_tables;
+
 #ifdef ENABLE_MPI
     /// The system's communicator.
     std::shared_ptr<Communicator> m_comm;
@@ -250,6 +286,24 @@ template<class evaluator> class PotentialPair : public ForceCompute
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
 
+#ifdef ENABLE_MPI
+    /// Set by computeForces() when the forces on ghost particles must be sent to their owners
+    bool m_ghost_forces_pending = false;
+#endif
+
+    //! Compute the force and energy of one pair, including the energy shift and XPLOR smoothing
+    inline bool evaluatePair(Scalar rsq,
+                             Scalar rcutsq,
+                             Scalar ronsq,
+                             const param_type& param,
+                             Scalar qi,
+                             Scalar qj,
+                             Scalar& force_divr,
+                             Scalar& pair_eng) const;
+
+    //! Build the spline tables for all type pairs
+    void buildTables();
+
     //! Compute the long-range corrections to energy and pressure to account for truncating the pair
     //! potentials
     virtual void computeTailCorrection()
@@ -446,6 +500,26 @@ PotentialPair<evaluator>::PotentialPair(std::shared_ptr<SystemDefinition> sysdef
 #endif
     }
 
+/*! With the midpoint method, the forces, energies and virials of ghost particles are added to the
+    owning ranks once computeForces() has released its array handles.
+
+    \param timestep specifies the current time step of the simulation
+*/
+template<class evaluator> void PotentialPair<evaluator>::compute(uint64_t timestep)
+    {
+    ForceCompute::compute(timestep);
+
+#ifdef ENABLE_MPI
+    if (m_ghost_forces_pending)
+        {
+        m_comm->addGhostForces(m_force,
+                               m_virial,
+                               m_pdata->getFlags()[pdata_flag::pressure_tensor]);
+        m_ghost_forces_pending = false;
+        }
+#endif
+    }
+
 template<class evaluator> PotentialPair<evaluator>::~PotentialPair()
     {
     m_exec_conf->msg->notice(5) << "Destroying PotentialPair<" << evaluator::getName() << ">"
@@ -471,6 +545,7 @@ void PotentialPair<evaluator>::setParams(unsigned int typ1,
     validateTypes(typ1, typ2, "setting params");
     m_params[m_typpair_idx(typ1, typ2)] = param;
     m_params[m_typpair_idx(typ2, typ1)] = param;
+    m_tables_dirty = true;
     }
 
 template<class evaluator>
@@ -528,6 +603,7 @@ void PotentialPair<evaluator>::setRcut(unsigned int typ1, unsigned int typ2, Sca
 
     // notify the neighbor list that we have changed r_cut values
     m_nlist->notifyRCutMatrixChange();
+    m_tables_dirty = true;
     }
 
 template<class evaluator>
@@ -560,6 +636,7 @@ void PotentialPair<evaluator>::setRon(unsigned int typ1, unsigned int typ2, Scal
     ArrayHandle<Scalar> h_ronsq(m_ronsq, access_location::host, access_mode::readwrite);
     h_ronsq.data[m_typpair_idx(typ1, typ2)] = ron * ron;
     h_ronsq.data[m_typpair_idx(typ2, typ1)] = ron * ron;
+    m_tables_dirty = true;
     }
 
 template<class evaluator> Scalar PotentialPair<evaluator>::getROn(pybind11::tuple types)
@@ -579,6 +656,158 @@ void PotentialPair<evaluator>::setROnPython(pybind11::tuple types, Scalar r_on)
     setRon(typ1, typ2, r_on);
     }
 
+/*! \param tolerance Relative error tolerance of the interpolated force and energy
+ */
+template<class evaluator>
+void PotentialPair<evaluator>::setTabulationTolerance(Scalar tolerance)
+    {
+    if (tolerance < Scalar(0.0))
+        {
+        throw std::domain_error("tabulation_tolerance must be non-negative");
+        }
+    if (tolerance > Scalar(0.0) && evaluator::needsCharge())
+        {
+        throw std::runtime_error("Tabulation is not supported by pair potentials that depend on "
+                                 "the particle charges.");
+        }
+    if (tolerance > Scalar(0.0) && m_exec_conf->isCUDAEnabled())
+        {
+        throw std::runtime_error("Tabulation is not supported on the GPU.");
+        }
+
+    m_tabulation_tolerance = tolerance;
+    m_tables_dirty = true;
+    }
+
+/*! \param types Tuple of the two type names
+    \param r Distance between the particles
+    \returns True when the last computeForces() interpolated the pair at distance \a r
+*/
+template<class evaluator>
+bool PotentialPair<evaluator>::isTabulated(pybind11::tuple types, Scalar r)
+    {
+    auto typ1 = m_pdata->getTypeByName(types[0].cast<std::string>());
+    auto typ2 = m_pdata->getTypeByName(types[1].cast<std::string>());
+    validateTypes(typ1, typ2, "checking tabulation");
+
+    if (!(m_tabulation_tolerance > Scalar(0.0)) || m_tables_dirty)
+        return false;
+
+    Scalar force_divr = Scalar(0.0);
+    Scalar pair_eng = Scalar(0.0);
+    return m_tables[m_typpair_idx(typ1, typ2)].evaluate(r * r, force_divr, pair_eng);
+    }
+
+/*! \param rsq Squared distance between the particles
+    \param rcutsq Squared cutoff radius of the type pair
+    \param ronsq Squared XPLOR r_on of the type pair (only used in the xplor mode)
+    \param param Parameters of the type pair
+    \param qi Charge of particle i
+    \param qj Charge of particle j
+    \param force_divr Output force divided by r
+    \param pair_eng Output pair energy
+    \returns True if the pair was evaluated
+*/
+template<class evaluator>
+inline bool PotentialPair<evaluator>::evaluatePair(Scalar rsq,
+                                                   Scalar rcutsq,
+                                                   Scalar ronsq,
+                                                   const param_type& param,
+                                                   Scalar qi,
+                                                   Scalar qj,
+                                                   Scalar& force_divr,
+                                                   Scalar& pair_eng) const
+    {
+    // design specifies that energies are shifted if
+    // 1) shift mode is set to shift
+    // or 2) shift mode is explor and ron > rcut
+    bool energy_shift = false;
+    if (m_shift_mode == shift)
+        energy_shift = true;
+    else if (m_shift_mode == xplor)
+        {
+        if (ronsq > rcutsq)
+            energy_shift = true;
+        }
+
+    // compute the force and potential energy
+    evaluator eval(rsq, rcutsq, param);
+    if (evaluator::needsCharge())
+        eval.setCharge(qi, qj);
+
+    bool evaluated = eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+
+    // modify the potential for xplor shifting
+    if (evaluated && m_shift_mode == xplor)
+        {
+        if (rsq >= ronsq && rsq < rcutsq)
+            {
+            // Implement XPLOR smoothing (FLOPS: 16)
+            Scalar old_pair_eng = pair_eng;
+            Scalar old_force_divr = force_divr;
+
+            // calculate 1.0 / (xplor denominator)
+            Scalar xplor_denom_inv
+                = Scalar(1.0) / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
+
+            Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
+            Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq
+                       * (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq) * xplor_denom_inv;
+            Scalar ds_dr_divr = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
+
+            // make modifications to the old pair energy and force
+            pair_eng = old_pair_eng * s;
+            // note: I'm not sure why the minus sign needs to be there: my notes have a
+            // + But this is verified correct via plotting
+            force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
+            }
+        }
+
+    return evaluated;
+    }
+
+/*! \post m_tables holds a spline table for every type pair
+ */
+template<class evaluator> void PotentialPair<evaluator>::buildTables()
+    {
+    ArrayHandle<Scalar> h_ronsq(m_ronsq, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
+
+    m_tables.resize(m_typpair_idx.getNumElements());
+    for (unsigned int typ1 = 0; typ1 < m_pdata->getNTypes(); typ1++)
+        {
+        for (unsigned int typ2 = typ1; typ2 < m_pdata->getNTypes(); typ2++)
+            {
+            unsigned int typpair_idx = m_typpair_idx(typ1, typ2);
+            Scalar rcutsq = h_rcutsq.data[typpair_idx];
+            Scalar ronsq = h_ronsq.data[typpair_idx];
+            const param_type& param = m_params[typpair_idx];
+
+            m_tables[typpair_idx].build(
+                rcutsq,
+                m_tabulation_tolerance,
+                [&](Scalar rsq, Scalar& force_divr, Scalar& pair_eng)
+                {
+                    force_divr = Scalar(0.0);
+                    pair_eng = Scalar(0.0);
+                    if (!evaluatePair(rsq, rcutsq, ronsq, param, 0, 0, force_divr, pair_eng))
+                        {
+                        force_divr = Scalar(0.0);
+                        pair_eng = Scalar(0.0);
+                        }
+                });
+            m_tables[m_typpair_idx(typ2, typ1)] = m_tables[typpair_idx];
+
+            m_exec_conf->msg->notice(7)
+                << "PotentialPair<" << evaluator::getName() << ">: tabulated type pair " << typ1
+                << "," << typ2 << " with " << m_tables[typpair_idx].getNumSegments()
+                << " segments" << std::endl;
+            }
+        }
+
+    m_tables_dirty = false;
+    }
+
 /*! \post The pair forces are computed for the given timestep. The neighborlist's compute method is
    called to ensure that it is up to date before proceeding.
 
@@ -589,10 +818,24 @@ template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t
     // start by updating the neighborlist
     m_nlist->compute(timestep);
 
+    // interpolate from spline tables when tabulation is enabled
+    bool use_tables = m_tabulation_tolerance > Scalar(0.0);
+    if (use_tables && m_tables_dirty)
+        buildTables();
+
     // depending on the neighborlist settings, we can take advantage of newton's third law
     // to reduce computations at the cost of memory access complexity: set that flag now
     bool third_law = m_nlist->getStorageMode() == NeighborList::half;
 
+    // with the midpoint method, ghost particles have rows in the list and receive forces, which
+    // compute() sends back to their owners
+    const bool midpoint = m_nlist->getMidpoint();
+    const unsigned int n_rows = m_nlist->getNRows();
+    const unsigned int n_force = midpoint ? n_rows : m_pdata->getN();
+#ifdef ENABLE_MPI
+    m_ghost_forces_pending = midpoint && m_comm;
+#endif
+
     // access the neighbor list, particle data, and system box
     ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(),
                                         access_location::host,
@@ -624,7 +867,7 @@ template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t
     memset((void*)h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
 
     // for each particle
-    for (int i = 0; i < (int)m_pdata->getN(); i++)
+    for (int i = 0; i < (int)n_rows; i++)
         {
         // access the particle's position and type (MEM TRANSFER: 4 scalars)
         Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
@@ -684,58 +927,18 @@ template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t
             if (m_shift_mode == xplor)
                 ronsq = h_ronsq.data[typpair_idx];
 
-            // design specifies that energies are shifted if
-            // 1) shift mode is set to shift
-            // or 2) shift mode is explor and ron > rcut
-            bool energy_shift = false;
-            if (m_shift_mode == shift)
-                energy_shift = true;
-            else if (m_shift_mode == xplor)
-                {
-                if (ronsq > rcutsq)
-                    energy_shift = true;
-                }
-
             // compute the force and potential energy
             Scalar force_divr = Scalar(0.0);
             Scalar pair_eng = Scalar(0.0);
-            evaluator eval(rsq, rcutsq, param);
-            if (evaluator::needsCharge())
-                eval.setCharge(qi, qj);
-
-            bool evaluated = eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+            bool evaluated = false;
+            if (use_tables && rsq < rcutsq)
+                evaluated = m_tables[typpair_idx].evaluate(rsq, force_divr, pair_eng);
+            if (!evaluated)
+                evaluated
+                    = evaluatePair(rsq, rcutsq, ronsq, param, qi, qj, force_divr, pair_eng);
 
             if (evaluated)
                 {
-                // modify the potential for xplor shifting
-                if (m_shift_mode == xplor)
-                    {
-                    if (rsq >= ronsq && rsq < rcutsq)
-                        {
-                        // Implement XPLOR smoothing (FLOPS: 16)
-                        Scalar old_pair_eng = pair_eng;
-                        Scalar old_force_divr = force_divr;
-
-                        // calculate 1.0 / (xplor denominator)
-                        Scalar xplor_denom_inv
-                            = Scalar(1.0)
-                              / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
-
-                        Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
-                        Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq
-                                   * (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq)
-                                   * xplor_denom_inv;
-                        Scalar ds_dr_divr
-                            = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
-
-                        // make modifications to the old pair energy and force
-                        pair_eng = old_pair_eng * s;
-                        // note: I'm not sure why the minus sign needs to be there: my notes have a
-                        // + But this is verified correct via plotting
-                        force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
-                        }
-                    }
-
                 Scalar force_div2r = force_divr * Scalar(0.5);
                 // add the force, potential energy and virial to the particle i
                 // (FLOPS: 8)
@@ -752,8 +955,9 @@ template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t
                     }
 
                 // add the force to particle j if we are using the third law (MEM TRANSFER: 10
-                // scalars / FLOPS: 8) only add force to local particles
-                if (third_law && j < m_pdata->getN())
+                // scalars / FLOPS: 8) only add force to local particles, or also to ghost
+                // particles with the midpoint method
+                if (third_law && j < n_force)
                     {
                     unsigned int mem_idx = j;
                     h_force.data[mem_idx].x -= dx.x * force_divr;
@@ -804,6 +1008,13 @@ CommFlags PotentialPair<evaluator>::getRequestedCommFlags(uint64_t timestep)
     if (evaluator::needsCharge())
         flags[comm_flag::charge] = 1;
 
+    // forces on ghost particles are sent back with the midpoint method
+    if (m_nlist->getMidpoint())
+        {
+        flags[comm_flag::reverse_net_force] = 1;
+        flags[comm_flag::tag] = 1;
+        }
+
     flags |= ForceCompute::getRequestedCommFlags(timestep);
 
     return flags;
@@ -1032,6 +1243,10 @@ template<class T> void export_PotentialPair(pybind11::module& m, const std::stri
         .def_property("tail_correction",
                       &PotentialPair<T>::getTailCorrectionEnabled,
                       &PotentialPair<T>::setTailCorrectionEnabled)
+        .def_property("tabulation_tolerance",
+                      &PotentialPair<T>::getTabulationTolerance,
+                      &PotentialPair<T>::setTabulationTolerance)
+        .def("isTabulated", &PotentialPair<T>::isTabulated)
         .def("computeEnergyBetweenSets", &PotentialPair<T>::computeEnergyBetweenSetsPythonList);
     }
 
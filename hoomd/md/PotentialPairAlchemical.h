@@ -289,6 +289,11 @@ template<class evaluator, typename extra_pkg, typename alpha_particle_type>
 void PotentialPairAlchemical<evaluator, extra_pkg, alpha_particle_type>::computeForces(
     uint64_t timestep)
     {
+    if (m_nlist->getMidpoint())
+        {
+        throw std::runtime_error("Alchemical pair forces do not support the midpoint method.");
+        }
+
     // start by updating the neighborlist
     m_nlist->compute(timestep);
 
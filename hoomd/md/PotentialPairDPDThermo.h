@@ -101,6 +101,11 @@ template<class evaluator> std::shared_ptr<Variant> PotentialPairDPDThermo<evalua
 */
 template<class evaluator> void PotentialPairDPDThermo<evaluator>::computeForces(uint64_t timestep)
     {
+    if (this->m_nlist->getMidpoint())
+        {
+        throw std::runtime_error("DPD pair forces do not support the midpoint method.");
+        }
+
     // start by updating the neighborlist
     this->m_nlist->compute(timestep);
 
@@ -72,6 +72,18 @@ class Thermostat
     */
     virtual void advanceThermostat(uint64_t timestep, Scalar deltaT, bool aniso) { }
 
+    /** Get the thermodynamic properties that advanceThermostat() evaluates.
+
+        Integration methods may accumulate these properties in their first half step and call
+        advanceThermostat() later in the timestep (but before getRescalingFactorsTwo()).
+
+        @returns The compute, or null when advanceThermostat() does not evaluate any properties.
+    */
+    virtual std::shared_ptr<ComputeThermo> getAdvanceThermo()
+        {
+        return nullptr;
+        }
+
     /// Get the temperature variant.
     std::shared_ptr<Variant> getT()
         {
@@ -159,6 +171,11 @@ class MTTKThermostat : public Thermostat
         return {exp_thermo_fac, exp_thermo_fac_rot};
         }
 
+    std::shared_ptr<ComputeThermo> getAdvanceThermo() override
+        {
+        return m_thermo;
+        }
+
     void advanceThermostat(uint64_t timestep, Scalar deltaT, bool aniso = true) override
         {
         // compute the current thermodynamic properties
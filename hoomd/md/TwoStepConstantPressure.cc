@@ -231,6 +231,16 @@ void TwoStepConstantPressure::integrateStepOne(uint64_t timestep)
                                   : std::array<Scalar, 2> {1., 1.};
     const std::array<Scalar, 2> rescaleFactors = {rf[0] * mtk, rf[1] * mtk};
 
+    // accumulate the properties that the thermostat evaluates after this half step in the loops
+    // below when possible
+    std::shared_ptr<ComputeThermo> thermo
+        = m_thermostat ? m_thermostat->getAdvanceThermo() : nullptr;
+    PDataFlags flags = m_pdata->getFlags();
+    const bool accumulate = thermo && thermo->acceptsPartialSums(m_group)
+                            && (m_aniso || !flags[pdata_flag::rotational_kinetic_energy]);
+    const bool compute_virial = flags[pdata_flag::pressure_tensor];
+    ComputeThermo::PartialSums sums;
+
     //  update the propagator matrix using current barostat momenta
     updatePropagator();
 
@@ -300,6 +310,19 @@ void TwoStepConstantPressure::integrateStepOne(uint64_t timestep)
         ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
                                    access_location::host,
                                    access_mode::readwrite);
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                         access_location::host,
+                                         access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
+        ArrayHandle<Scalar4> h_net_force(m_pdata->getNetForce(),
+                                         access_location::host,
+                                         access_mode::read);
+        ArrayHandle<Scalar> h_net_virial(m_pdata->getNetVirial(),
+                                         access_location::host,
+                                         access_mode::read);
+        size_t virial_pitch = m_pdata->getNetVirial().getPitch();
 
         // precompute loop invariant quantity
         for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
@@ -341,6 +364,17 @@ void TwoStepConstantPressure::integrateStepOne(uint64_t timestep)
             h_pos.data[j].x = r.x;
             h_pos.data[j].y = r.y;
             h_pos.data[j].z = r.z;
+
+            if (accumulate
+                && ComputeThermo::PartialSums::isCounted(h_body.data[j], h_tag.data[j]))
+                {
+                sums.addKinetic(v, h_vel.data[j].w);
+                sums.addPotential(h_net_force.data[j],
+                                  h_net_virial.data,
+                                  virial_pitch,
+                                  j,
+                                  compute_virial);
+                }
             }
         } // end of GPUArray scope
 
@@ -376,6 +410,12 @@ void TwoStepConstantPressure::integrateStepOne(uint64_t timestep)
         ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
                                        access_location::host,
                                        access_mode::read);
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                         access_location::host,
+                                         access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
 
         for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
             {
@@ -480,13 +520,29 @@ void TwoStepConstantPressure::integrateStepOne(uint64_t timestep)
 
             h_orientation.data[j] = quat_to_scalar4(q);
             h_angmom.data[j] = quat_to_scalar4(p);
+
+            if (accumulate
+                && ComputeThermo::PartialSums::isCounted(h_body.data[j], h_tag.data[j]))
+                {
+                sums.addRotational(h_orientation.data[j], h_angmom.data[j], h_inertia.data[j]);
+                }
             }
         }
 
     // propagate thermostat variables forward
     if (m_thermostat)
         {
-        m_thermostat->advanceThermostat(timestep, m_deltaT, m_aniso);
+        if (accumulate)
+            {
+            // start the reduction of the sums now and advance the thermostat at the beginning of
+            // the second half step, so that the reduction overlaps with the force computation
+            thermo->setPartialSums(timestep, sums);
+            m_advance_thermostat_pending = true;
+            }
+        else
+            {
+            m_thermostat->advanceThermostat(timestep, m_deltaT, m_aniso);
+            }
         }
 
 #ifdef ENABLE_MPI
@@ -587,6 +643,20 @@ void TwoStepConstantPressure::thermalizeBarostatDOF(uint64_t timestep)
 void TwoStepConstantPressure::integrateStepTwo(uint64_t timestep)
     {
     unsigned int group_size = m_group->getNumMembers();
+
+    if (m_advance_thermostat_pending)
+        {
+        m_thermostat->advanceThermostat(timestep, m_deltaT, m_aniso);
+        m_advance_thermostat_pending = false;
+        }
+
+    // accumulate the properties at the full step, which advanceBarostat() evaluates, in the loops
+    // below when possible
+    PDataFlags flags = m_pdata->getFlags();
+    const bool accumulate = m_thermo_full_step->acceptsPartialSums(m_group)
+                            && (m_aniso || !flags[pdata_flag::rotational_kinetic_energy]);
+    const bool compute_virial = flags[pdata_flag::pressure_tensor];
+    ComputeThermo::PartialSums sums;
     // Rescaling factors, including Martyna-Tobias-Klein correction
     Scalar mtk = exp(-Scalar(1.0 / 2.0) * m_deltaT
                      * (m_barostat.nu_xx + m_barostat.nu_yy + m_barostat.nu_zz)
@@ -605,6 +675,16 @@ void TwoStepConstantPressure::integrateStepTwo(uint64_t timestep)
                                      access_location::host,
                                      access_mode::readwrite);
         ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                         access_location::host,
+                                         access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
+        ArrayHandle<Scalar> h_net_virial(m_pdata->getNetVirial(),
+                                         access_location::host,
+                                         access_mode::read);
+        size_t virial_pitch = m_pdata->getNetVirial().getPitch();
 
         // perform second half step of NPT integration
         for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
@@ -638,6 +718,17 @@ void TwoStepConstantPressure::integrateStepTwo(uint64_t timestep)
             h_vel.data[j].x = v.x;
             h_vel.data[j].y = v.y;
             h_vel.data[j].z = v.z;
+
+            if (accumulate
+                && ComputeThermo::PartialSums::isCounted(h_body.data[j], h_tag.data[j]))
+                {
+                sums.addKinetic(v, h_vel.data[j].w);
+                sums.addPotential(h_net_force.data[j],
+                                  h_net_virial.data,
+                                  virial_pitch,
+                                  j,
+                                  compute_virial);
+                }
             }
 
         if (m_aniso)
@@ -655,6 +746,12 @@ void TwoStepConstantPressure::integrateStepTwo(uint64_t timestep)
             ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
                                            access_location::host,
                                            access_mode::read);
+            ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                             access_location::host,
+                                             access_mode::read);
+            ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                            access_location::host,
+                                            access_mode::read);
 
             // precompute loop invariant quantity
 
@@ -692,10 +789,21 @@ void TwoStepConstantPressure::integrateStepTwo(uint64_t timestep)
                 p += m_deltaT * q * t;
 
                 h_angmom.data[j] = quat_to_scalar4(p);
+
+                if (accumulate
+                    && ComputeThermo::PartialSums::isCounted(h_body.data[j], h_tag.data[j]))
+                    {
+                    sums.addRotational(h_orientation.data[j], h_angmom.data[j], h_inertia.data[j]);
+                    }
                 }
             }
         } // end GPUArray scope
 
+    if (accumulate)
+        {
+        m_thermo_full_step->setPartialSums(timestep + 1, sums);
+        }
+
     // advance barostat (m_barostat.nu_xx, m_barostat.nu_yy, m_barostat.nu_zz) half a time step
     advanceBarostat(timestep + 1);
     }
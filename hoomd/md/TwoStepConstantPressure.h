@@ -219,6 +219,9 @@ class PYBIND11_EXPORT TwoStepConstantPressure : public IntegrationMethodTwoStep
     /// When true, rescale all particles in the system irrespective of group.
     bool m_rescale_all;
 
+    /// Set when integrateStepOne() defers advancing the thermostat to integrateStepTwo().
+    bool m_advance_thermostat_pending = false;
+
     /// Helper function to update the propagator elements.
     void updatePropagator();
 
@@ -16,6 +16,16 @@ void hoomd::md::TwoStepConstantVolume::integrateStepOne(uint64_t timestep)
 
     unsigned int group_size = m_group->getNumMembers();
 
+    // accumulate the properties that the thermostat evaluates after this half step in the loops
+    // below when possible
+    std::shared_ptr<ComputeThermo> thermo
+        = m_thermostat ? m_thermostat->getAdvanceThermo() : nullptr;
+    PDataFlags flags = m_pdata->getFlags();
+    const bool accumulate = thermo && thermo->acceptsPartialSums(m_group)
+                            && (m_aniso || !flags[pdata_flag::rotational_kinetic_energy]);
+    const bool compute_virial = flags[pdata_flag::pressure_tensor];
+    ComputeThermo::PartialSums sums;
+
         // scope array handles for proper releasing before calling the thermo compute
         {
         ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
@@ -27,6 +37,19 @@ void hoomd::md::TwoStepConstantVolume::integrateStepOne(uint64_t timestep)
         ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
                                    access_location::host,
                                    access_mode::readwrite);
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                         access_location::host,
+                                         access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
+        ArrayHandle<Scalar4> h_net_force(m_pdata->getNetForce(),
+                                         access_location::host,
+                                         access_mode::read);
+        ArrayHandle<Scalar> h_net_virial(m_pdata->getNetVirial(),
+                                         access_location::host,
+                                         access_mode::read);
+        size_t virial_pitch = m_pdata->getNetVirial().getPitch();
 
         for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
             {
@@ -61,6 +84,17 @@ void hoomd::md::TwoStepConstantVolume::integrateStepOne(uint64_t timestep)
             h_pos.data[j].x = pos.x;
             h_pos.data[j].y = pos.y;
             h_pos.data[j].z = pos.z;
+
+            if (accumulate
+                && ComputeThermo::PartialSums::isCounted(h_body.data[j], h_tag.data[j]))
+                {
+                sums.addKinetic(v, h_vel.data[j].w);
+                sums.addPotential(h_net_force.data[j],
+                                  h_net_virial.data,
+                                  virial_pitch,
+                                  j,
+                                  compute_virial);
+                }
             }
 
         // particles may have been moved slightly outside the box by the above steps, wrap them back
@@ -95,6 +129,12 @@ void hoomd::md::TwoStepConstantVolume::integrateStepOne(uint64_t timestep)
         ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
                                        access_location::host,
                                        access_mode::read);
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                         access_location::host,
+                                         access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
 
         for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
             {
@@ -200,13 +240,29 @@ void hoomd::md::TwoStepConstantVolume::integrateStepOne(uint64_t timestep)
 
             h_orientation.data[j] = quat_to_scalar4(q);
             h_angmom.data[j] = quat_to_scalar4(p);
+
+            if (accumulate
+                && ComputeThermo::PartialSums::isCounted(h_body.data[j], h_tag.data[j]))
+                {
+                sums.addRotational(h_orientation.data[j], h_angmom.data[j], h_inertia.data[j]);
+                }
             }
         }
 
     // get temperature and advance thermostat
     if (m_thermostat)
         {
-        m_thermostat->advanceThermostat(timestep, m_deltaT, m_aniso);
+        if (accumulate)
+            {
+            // start the reduction of the sums now and advance the thermostat at the beginning of
+            // the second half step, so that the reduction overlaps with the force computation
+            thermo->setPartialSums(timestep, sums);
+            m_advance_thermostat_pending = true;
+            }
+        else
+            {
+            m_thermostat->advanceThermostat(timestep, m_deltaT, m_aniso);
+            }
         }
     }
 
@@ -214,6 +270,12 @@ void hoomd::md::TwoStepConstantVolume::integrateStepTwo(uint64_t timestep)
     {
     unsigned int group_size = m_group->getNumMembers();
 
+    if (m_advance_thermostat_pending)
+        {
+        m_thermostat->advanceThermostat(timestep, m_deltaT, m_aniso);
+        m_advance_thermostat_pending = false;
+        }
+
     auto rescaling_factors = m_thermostat ? m_thermostat->getRescalingFactorsTwo(timestep, m_deltaT)
                                           : std::array<Scalar, 2> {1., 1.};
 
@@ -106,6 +106,9 @@ class PYBIND11_EXPORT TwoStepConstantVolume : public IntegrationMethodTwoStep
 
     /// The distance limit to apply (may be null).
     std::shared_ptr<Variant> m_limit;
+
+    /// Set when integrateStepOne() defers advancing the thermostat to integrateStepTwo().
+    bool m_advance_thermostat_pending = false;
     };
 
     } // namespace hoomd::md
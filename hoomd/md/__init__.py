@@ -29,7 +29,7 @@ from hoomd.md import dihedral
 from hoomd.md import external
 from hoomd.md import force
 from hoomd.md import improper
-from hoomd.md.integrate import Integrator
+from hoomd.md.integrate import Integrator, RESPA
 from hoomd.md import long_range
 from hoomd.md import manifold
 from hoomd.md import minimize
@@ -22,7 +22,7 @@ Warning:
 from hoomd.md import _md
 from hoomd.data.parameterdicts import ParameterDict, TypeParameterDict
 from hoomd.data.typeparam import TypeParameter
-from hoomd.data.typeconverter import OnlyIf, to_type_converter
+from hoomd.data.typeconverter import OnlyFrom, OnlyIf, to_type_converter
 from hoomd.md.force import Force
 import hoomd
 
@@ -52,6 +52,10 @@ class Distance(Constraint):
 
     Args:
         tolerance (float): Relative tolerance for constraint violation warnings.
+        solver (str): Linear solver for the constraint equations, ``'direct'``
+            or ``'iterative'``.
+        solver_tolerance (float): Relative residual at which the iterative
+            solver stops.
 
     `Distance` applies forces between particles that constrain the distances
     between particles to specific values. The algorithm implemented is described
@@ -96,14 +100,37 @@ class Distance(Constraint):
         issue a warning message. It does not influence the computation of the
         constraint force.
 
+    The constraint matrix is assembled in sparse form directly from the
+    constraint topology, so memory and time scale linearly with the number of
+    constraints. With ``solver='direct'``, `Distance` factorizes the matrix
+    with a sparse LU decomposition. The fill-reducing ordering is recomputed
+    only when the constraint topology changes. With ``solver='iterative'``,
+    `Distance` solves the system with the BiCGSTAB method, starting from the
+    Lagrange multipliers of the previous step, until the relative residual
+    drops below `solver_tolerance`. The preconditioner inverts the block of
+    each constrained molecule exactly (molecules with more than 64 constraints
+    are split into several blocks). This is typically faster for systems with
+    many small constrained molecules.
+
+    Note:
+        The GPU implementation always uses the direct solver.
+
     Attributes:
         tolerance (float): Relative tolerance for constraint violation warnings.
+        solver (str): Linear solver for the constraint equations, ``'direct'``
+            or ``'iterative'``.
+        solver_tolerance (float): Relative residual at which the iterative
+            solver stops.
     """
 
     _cpp_class_name = "ForceDistanceConstraint"
 
-    def __init__(self, tolerance=1e-3):
-        self._param_dict.update(ParameterDict(tolerance=float(tolerance)))
+    def __init__(self, tolerance=1e-3, solver='direct', solver_tolerance=1e-10):
+        self._param_dict.update(
+            ParameterDict(tolerance=float(tolerance),
+                          solver=OnlyFrom(['direct', 'iterative']),
+                          solver_tolerance=float(solver_tolerance)))
+        self.solver = solver
 
 
 class Rigid(Constraint):
@@ -310,3 +310,125 @@ class Integrator(_DynamicIntegrator):
         """
         v = self._cpp_obj.computeLinearMomentum()
         return (v.x, v.y, v.z)
+
+
+@hoomd.logging.modify_namespace(("md", "RESPA"))
+class RESPA(Integrator):
+    r"""Multiple time step molecular dynamics integration (r-RESPA).
+
+    Args:
+        dt (float): Inner integrator time step size :math:`[\mathrm{time}]`.
+
+        period (int): Number of inner steps per outer step.
+
+        slow_forces (Sequence[hoomd.md.force.Force]): Sequence of forces
+          evaluated only on outer steps. The default value of ``None``
+          initializes an empty list.
+
+        integrate_rotational_dof (bool): When True, integrate rotational degrees
+          of freedom.
+
+        forces (Sequence[hoomd.md.force.Force]): Sequence of fast forces
+          evaluated every step. The default value of ``None`` initializes an
+          empty list.
+
+        constraints (Sequence[hoomd.md.constrain.Constraint]): Sequence of
+          constraint forces applied to the particles in the system.
+
+        methods (Sequence[hoomd.md.methods.Method]): Sequence of integration
+          methods.
+
+        rigid (hoomd.md.constrain.Rigid): An object defining the rigid bodies in
+          the simulation.
+
+        half_step_hook (hoomd.md.HalfStepHook): Enables the user to perform
+            arbitrary computations during the half-step of the integration.
+
+    `RESPA` implements the impulse form of the reversible reference system
+    propagator algorithm. Every time step of the simulation is one inner step of
+    the integration `methods` with step size `dt` under the fast `forces`. The
+    `slow_forces` are evaluated only on outer steps, when the timestep is a
+    multiple of `period`, where they apply an impulse of
+    :math:`\frac{1}{2} \cdot \mathrm{period} \cdot dt \cdot \vec{F}` at the end
+    of the outer step and again at the start of the next:
+
+    .. math::
+
+        \vec{F}_{\mathrm{net},i} = \sum_{f \in \mathrm{forces}} \vec{F}_i^f
+        + \delta_{t \bmod \mathrm{period}, 0} \cdot \mathrm{period} \cdot
+        \sum_{f \in \mathrm{slow\_forces}} \vec{F}_i^f
+
+    Use `RESPA` to amortize the cost of expensive, slowly varying forces (such
+    as `hoomd.md.long_range.pppm.Coulomb` or long range pair potentials) over
+    several steps of stiff bonded forces. Any integration method, including
+    thermostatted ones, can be used. The thermostat acts on every inner step.
+
+    Note:
+        On inner steps, the energy and virial of the `slow_forces` are those
+        computed at the last outer step. Thermodynamic quantities, and the
+        pressure used by `hoomd.md.methods.ConstantPressure`, include the slow
+        forces on every step.
+
+    Note:
+        Start the simulation on a timestep that is a multiple of `period`.
+        Otherwise, the slow forces apply only the second impulse of the first
+        outer step.
+
+    Warning:
+        `RESPA` is only supported on the CPU.
+
+    Example::
+
+        respa = hoomd.md.RESPA(dt=0.001,
+                               period=4,
+                               methods=[nvt],
+                               forces=[harmonic, fene, lj],
+                               slow_forces=[coulomb_real, coulomb_reciprocal])
+        sim.operations.integrator = respa
+
+    Attributes:
+        period (int): Number of inner steps per outer step.
+
+        slow_forces (list[hoomd.md.force.Force]): List of forces evaluated only
+            on outer steps.
+    """
+
+    def __init__(self,
+                 dt,
+                 period,
+                 slow_forces=None,
+                 integrate_rotational_dof=False,
+                 forces=None,
+                 constraints=None,
+                 methods=None,
+                 rigid=None,
+                 half_step_hook=None):
+
+        super().__init__(dt, integrate_rotational_dof, forces, constraints,
+                         methods, rigid, half_step_hook)
+
+        slow_forces = [] if slow_forces is None else slow_forces
+        self._slow_forces = syncedlist.SyncedList(
+            Force,
+            syncedlist._PartialGetAttr('_cpp_obj'),
+            iterable=slow_forces)
+
+        self._param_dict.update(ParameterDict(period=int(period)))
+
+    def _attach_hook(self):
+        self._cpp_obj = _md.IntegratorRESPA(
+            self._simulation.state._cpp_sys_def, self.dt, self.period)
+        self._slow_forces._sync(self._simulation, self._cpp_obj.slow_forces)
+        _DynamicIntegrator._attach_hook(self)
+
+    def _detach_hook(self):
+        self._slow_forces._unsync()
+        super()._detach_hook()
+
+    @property
+    def slow_forces(self):
+        return self._slow_forces
+
+    @slow_forces.setter
+    def slow_forces(self, value):
+        _set_synced_list(self._slow_forces, value)
@@ -102,6 +102,7 @@ void export_PotentialPairDPDThermoDPD(pybind11::module& m);
 void export_PotentialPairDPDThermoLJ(pybind11::module& m);
 
 void export_IntegratorTwoStep(pybind11::module& m);
+void export_IntegratorRESPA(pybind11::module& m);
 void export_IntegrationMethodTwoStep(pybind11::module& m);
 void export_ZeroMomentumUpdater(pybind11::module& m);
 
@@ -481,6 +482,7 @@ PYBIND11_MODULE(_md, m)
     export_BerendsenThermostat(m);
 
     export_IntegratorTwoStep(m);
+    export_IntegratorRESPA(m);
     export_IntegrationMethodTwoStep(m);
     export_ZeroMomentumUpdater(m);
     export_TwoStepConstantVolume(m);
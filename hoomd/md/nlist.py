@@ -36,6 +36,26 @@ Note:
     `NeighborList.buffer` between the two extremes that provides the best
     performance.
 
+.. rubric:: Adaptive buffer
+
+The optimal buffer changes when the system compresses, heats, or phase
+separates during a run. Set `NeighborList.adaptive_buffer` to `True` to retune
+the buffer on the CPU at every neighbor list rebuild triggered by the distance
+check. The neighbor list measures the time spent building the list and the time
+spent between builds, and moves the buffer towards the value that minimizes
+the modeled cost per step within :math:`[r_\mathrm{buffer} / 4,
+4 r_\mathrm{buffer}]` of the value set by the user. Reading
+`NeighborList.buffer` returns the current buffer. To prevent dangerous builds,
+the neighbor list also checks more often than `rebuild_check_delay` when the
+rebuild period shrinks.
+
+Note:
+    Unlike `hoomd.md.tune.NeighborListBuffer`, which searches for the best
+    buffer with a series of short runs, the adaptive buffer tunes while the
+    simulation runs. The adaptive buffer requires ``check_dist=True`` and a
+    nonzero buffer, other settings raise a `ValueError`. Simulations that use it are not reproducible between runs
+    because the rebuilds depend on timing.
+
 .. rubric:: Base distance cutoff
 
 The `NeighborList.r_cut` attribute can be used to set the base cutoff distance
@@ -51,6 +71,25 @@ Attention:
     `pair_list`, `local_pair_list`, `cpu_local_nlist_arrays`, or
     `gpu_local_nlist_arrays`.
 
+.. rubric:: Midpoint method
+
+In MPI simulations, each rank normally lists every pair between one of its
+particles and a ghost particle, so pairs that cross a domain boundary are
+computed on both ranks and the ghost layer is
+:math:`r_\mathrm{cut} + r_\mathrm{buffer}` wide. Set `NeighborList.midpoint`
+to `True` to list each pair only on the rank whose domain contains the pair
+midpoint. This halves the ghost layer width, which reduces communication when
+the cutoff is long compared to the domain size. The forces on ghost particles
+are then sent back to the ranks that own them.
+
+Note:
+    The midpoint method is only available on the CPU, and only for the
+    isotropic `hoomd.md.pair.Pair` forces that do not override the pair loop.
+    `hoomd.md.pair.DPD`, `hoomd.md.pair.DPDLJ`, anisotropic pair forces,
+    alchemical pair forces, and many-body forces raise an error when they use a
+    neighbor list with ``midpoint=True``. The setting has no effect in
+    simulations without domain decomposition.
+
 .. rubric:: Exclusions
 
 Neighbor lists nominally include all particles within the chosen cutoff
@@ -103,6 +142,11 @@ class NeighborList(Compute):
         mesh (Mesh): mesh data structure (optional)
         default_r_cut (float): Default cutoff distance :math:`[\mathrm{length}]`
             (optional).
+        midpoint (bool): When `True`, assign each pair to the rank that
+            contains its midpoint and halve the ghost layer width (CPU only,
+            see above). Defaults to `False`.
+        adaptive_buffer (bool): When `True`, tune `buffer` online (CPU only,
+            see above). Defaults to `False`.
 
     .. py:attribute:: r_cut
 
@@ -134,7 +178,9 @@ class NeighborList(Compute):
         params = ParameterDict(exclusions=[validate_exclusions],
                                buffer=float(buffer),
                                rebuild_check_delay=int(rebuild_check_delay),
-                               check_dist=bool(check_dist))
+                               check_dist=bool(check_dist),
+                               midpoint=False,
+                               adaptive_buffer=False)
         params["exclusions"] = exclusions
         self._param_dict.update(params)
 
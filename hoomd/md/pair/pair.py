@@ -54,12 +54,33 @@ class Pair(force.Force):
         Neighbor list used to compute the pair force.
 
         Type: `hoomd.md.nlist.NeighborList`
+
+    .. py:attribute:: tabulation_tolerance
+
+        Relative error tolerance of the tabulated fast path. When positive,
+        the force and energy of each type pair (including the energy shift
+        and smoothing of `mode`) are tabulated in cubic splines in
+        :math:`r^2` and interpolated instead of evaluating the potential
+        directly. The tables are rebuilt when the parameters change. Pairs at
+        distances where the spline does not meet the tolerance, typically in
+        the steep repulsive core, are evaluated directly. Set to 0 to disable
+        tabulation. *Optional*: defaults to 0.
+
+        Tabulation is available only on the CPU. Pair forces that depend on
+        the particle charges or that compute additional terms (such as the
+        `DPD` thermostat) do not have this attribute.
+
+        Type: `float`
     """
 
     # The accepted modes for the potential. Should be reset by subclasses with
     # restricted modes.
     _accepted_modes = ("none", "shift", "xplor")
 
+    # Whether the potential can be tabulated. Should be reset by subclasses
+    # that do not use the generic pair loop or depend on particle charges.
+    _tabulation_supported = True
+
     # Module where the C++ class is defined. Reassign this when developing an
     # external plugin.
     _ext_module = _md
@@ -86,6 +107,10 @@ class Pair(force.Force):
                           nlist=hoomd.md.nlist.NeighborList))
         self.mode = mode
         self.nlist = nlist
+        if self._tabulation_supported:
+            self._param_dict.update(
+                ParameterDict(tabulation_tolerance=nonnegative_real))
+            self.tabulation_tolerance = 0.0
 
     def compute_energy(self, tags1, tags2):
         r"""Compute the energy between two sets of particles.
@@ -504,6 +529,7 @@ class Ewald(Pair):
     """
     _cpp_class_name = "PotentialPairEwald"
     _accepted_modes = ("none",)
+    _tabulation_supported = False
 
     def __init__(self, nlist, default_r_cut=None):
         super().__init__(nlist=nlist,
@@ -754,6 +780,7 @@ class DPD(Pair):
     """
     _cpp_class_name = "PotentialPairDPDThermoDPD"
     _accepted_modes = ("none",)
+    _tabulation_supported = False
 
     def __init__(
         self,
@@ -909,6 +936,7 @@ class DPDLJ(Pair):
     """
     _cpp_class_name = "PotentialPairDPDThermoLJ"
     _accepted_modes = ("none", "shift")
+    _tabulation_supported = False
 
     def __init__(self, nlist, kT, default_r_cut=None, mode='none'):
 
@@ -1359,6 +1387,7 @@ class ReactionField(Pair):
         Type: `str`
     """
     _cpp_class_name = "PotentialPairReactionField"
+    _tabulation_supported = False
 
     def __init__(self, nlist, default_r_cut=None, default_r_on=0., mode='none'):
         super().__init__(nlist, default_r_cut, default_r_on, mode)
@@ -220,3 +220,49 @@ def test_pickling(simulation_factory, triplet_snapshot_factory, angle_cls,
     sim.operations.integrator = integrator
     sim.run(0)
     pickling_check(potential)
+
+
+@pytest.mark.cpu
+@pytest.mark.skipif(not hoomd.version.tbb_enabled,
+                    reason="TBB is not enabled")
+@pytest.mark.parametrize('angle_cls, angle_args, params, force, energy',
+                         angle_test_parameters)
+def test_threads(lattice_snapshot_factory, simulation_factory, device,
+                 angle_cls, angle_args, params, force, energy):
+    """Threaded angle forces match the serial forces."""
+    n = 8
+    snap = lattice_snapshot_factory(n=n, a=1.0, r=0.1)
+    if snap.communicator.rank == 0:
+        # connect lattice neighbors that are far apart in the particle order so
+        # that many angles cross the chunks evaluated by different threads
+        N = snap.particles.N
+        tags = numpy.arange(N)
+        snap.angles.N = N
+        snap.angles.types = ['A-A-A']
+        snap.angles.typeid[:] = 0
+        snap.angles.group[:] = numpy.stack(
+            [tags, (tags + n * n) % N, (tags + n * n + 1) % N], axis=1)
+
+    num_cpu_threads = device.num_cpu_threads
+    results = []
+    try:
+        for threads in (1, 4):
+            device.num_cpu_threads = threads
+            potential = angle_cls(**angle_args)
+            potential.params['A-A-A'] = params
+            sim = simulation_factory(snap)
+            sim.always_compute_pressure = True
+            sim.operations.integrator = hoomd.md.Integrator(
+                dt=0.005, forces=[potential])
+            sim.run(0)
+            results.append(
+                (potential.forces, potential.energies, potential.virials))
+    finally:
+        device.num_cpu_threads = num_cpu_threads
+
+    if snap.communicator.rank == 0:
+        for serial, threaded in zip(results[0], results[1]):
+            numpy.testing.assert_allclose(threaded,
+                                          serial,
+                                          rtol=1e-5,
+                                          atol=1e-6)
@@ -197,3 +197,46 @@ def test_pickling(simulation_factory, snapshot_factory, bond_cls, bond_args,
     sim.operations.integrator = integrator
     sim.run(0)
     pickling_check(potential)
+
+
+@pytest.mark.cpu
+@pytest.mark.skipif(not hoomd.version.tbb_enabled,
+                    reason="TBB is not enabled")
+@pytest.mark.parametrize(
+    'bond_cls, bond_args, params, force, energy',
+    [p for p in bond_test_parameters if p[0] is hoomd.md.bond.Harmonic])
+def test_threads(lattice_snapshot_factory, simulation_factory, device,
+                 bond_cls, bond_args, params, force, energy):
+    """Threaded bond forces match the serial forces."""
+    n = 8
+    snap = lattice_snapshot_factory(n=n, a=1.0, r=0.1)
+    if snap.communicator.rank == 0:
+        # bond lattice neighbors that are far apart in the particle order so
+        # that many bonds cross the chunks evaluated by different threads
+        tags = np.arange(snap.particles.N)
+        snap.bonds.N = snap.particles.N
+        snap.bonds.types = ['A-A']
+        snap.bonds.typeid[:] = 0
+        snap.bonds.group[:] = np.stack(
+            [tags, (tags + n * n) % snap.particles.N], axis=1)
+
+    num_cpu_threads = device.num_cpu_threads
+    results = []
+    try:
+        for threads in (1, 4):
+            device.num_cpu_threads = threads
+            potential = bond_cls(**bond_args)
+            potential.params['A-A'] = params
+            sim = simulation_factory(snap)
+            sim.always_compute_pressure = True
+            sim.operations.integrator = hoomd.md.Integrator(
+                dt=0.005, forces=[potential])
+            sim.run(0)
+            results.append(
+                (potential.forces, potential.energies, potential.virials))
+    finally:
+        device.num_cpu_threads = num_cpu_threads
+
+    if snap.communicator.rank == 0:
+        for serial, threaded in zip(results[0], results[1]):
+            np.testing.assert_allclose(threaded, serial, rtol=1e-5, atol=1e-6)
@@ -77,6 +77,12 @@ def test_attach_detach(simulation_factory, polymer_snapshot_factory):
     assert d.tolerance == 1e-5
     d.tolerance = 1e-3
     assert d.tolerance == 1e-3
+    assert d.solver == 'direct'
+    d.solver = 'iterative'
+    assert d.solver == 'iterative'
+    assert d.solver_tolerance == 1e-10
+    d.solver_tolerance = 1e-8
+    assert d.solver_tolerance == 1e-8
 
     # attached
     sim = simulation_factory(polymer_snapshot_factory())
@@ -90,6 +96,12 @@ def test_attach_detach(simulation_factory, polymer_snapshot_factory):
     assert d.tolerance == 1e-3
     d.tolerance = 1e-5
     assert d.tolerance == 1e-5
+    assert d.solver == 'iterative'
+    d.solver = 'direct'
+    assert d.solver == 'direct'
+    assert d.solver_tolerance == 1e-8
+    d.solver_tolerance = 1e-12
+    assert d.solver_tolerance == 1e-12
 
 
 def test_pickling(simulation_factory, polymer_snapshot_factory):
@@ -109,9 +121,11 @@ def test_pickling(simulation_factory, polymer_snapshot_factory):
     pickling_check(d)
 
 
-def test_basic_simulation(simulation_factory, polymer_snapshot_factory):
+@pytest.mark.parametrize("solver", ['direct', 'iterative'])
+def test_basic_simulation(simulation_factory, polymer_snapshot_factory,
+                          solver):
     """Ensure that distances are constrained in a basic simulation."""
-    d = hoomd.md.constrain.Distance()
+    d = hoomd.md.constrain.Distance(solver=solver)
 
     sim = simulation_factory(polymer_snapshot_factory())
     integrator = hoomd.md.Integrator(dt=0.005)
@@ -146,3 +160,31 @@ def test_basic_simulation(simulation_factory, polymer_snapshot_factory):
                                       rtol=1e-5)
 
     autotuned_kernel_parameter_check(instance=d, activate=lambda: sim.run(1))
+
+
+@pytest.mark.cpu
+def test_iterative_matches_direct(simulation_factory, polymer_snapshot_factory):
+    """Check that both solvers give the same constraint forces."""
+
+    def constraint_forces(solver):
+        sim = simulation_factory(polymer_snapshot_factory())
+        sim.state.thermalize_particle_momenta(filter=hoomd.filter.All(),
+                                              kT=1.0)
+
+        d = hoomd.md.constrain.Distance(solver=solver, solver_tolerance=1e-12)
+        integrator = hoomd.md.Integrator(dt=0.005)
+        nve = hoomd.md.methods.ConstantVolume(filter=hoomd.filter.All())
+        integrator.methods.append(nve)
+        integrator.constraints.append(d)
+        sim.operations.integrator = integrator
+
+        # several steps reuse the analyzed sparsity pattern
+        sim.run(10)
+        return d.forces
+
+    direct = constraint_forces('direct')
+    iterative = constraint_forces('iterative')
+
+    if direct is not None:
+        assert numpy.any(direct != 0)
+        numpy.testing.assert_allclose(iterative, direct, rtol=1e-6, atol=1e-8)
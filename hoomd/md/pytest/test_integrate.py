@@ -164,3 +164,138 @@ def test_logging():
             "category": hoomd.logging.LoggerCategories.sequence
         }
     })
+
+
+def test_respa_attaching(make_simulation, integrator_elements):
+    sim = make_simulation()
+    if isinstance(sim.device, hoomd.device.GPU):
+        pytest.skip("RESPA is only supported on the CPU.")
+
+    slow_forces = integrator_elements.pop("forces")
+    respa = hoomd.md.RESPA(0.005,
+                           period=4,
+                           slow_forces=slow_forces,
+                           **integrator_elements)
+    sim.operations.integrator = respa
+    sim.run(0)
+    assert respa._attached
+    assert respa._slow_forces._synced
+    assert respa.period == 4
+
+    respa.period = 2
+    assert respa._cpp_obj.period == 2
+
+    sim.operations._unschedule()
+    assert not respa._attached
+    assert not respa._slow_forces._synced
+
+
+def test_respa_period_one(simulation_factory, lattice_snapshot_factory):
+    """RESPA with a period of 1 reproduces the single step integrator."""
+    positions = []
+    for use_respa in (False, True):
+        snapshot = lattice_snapshot_factory(n=6, a=1.2)
+        sim = simulation_factory(snapshot)
+        if isinstance(sim.device, hoomd.device.GPU):
+            pytest.skip("RESPA is only supported on the CPU.")
+        sim.state.thermalize_particle_momenta(hoomd.filter.All(), kT=1.0)
+
+        nlist = md.nlist.Cell(buffer=0.4)
+        lj = md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+        lj.params[("A", "A")] = {"epsilon": 1.0, "sigma": 1.0}
+        nve = md.methods.ConstantVolume(hoomd.filter.All())
+        if use_respa:
+            integrator = hoomd.md.RESPA(0.002,
+                                        period=1,
+                                        methods=[nve],
+                                        slow_forces=[lj])
+        else:
+            integrator = hoomd.md.Integrator(0.002, methods=[nve], forces=[lj])
+        sim.operations.integrator = integrator
+        sim.run(20)
+
+        snapshot = sim.state.get_snapshot()
+        if snapshot.communicator.rank == 0:
+            positions.append(snapshot.particles.position)
+
+    if len(positions) == 2:
+        numpy.testing.assert_allclose(positions[0], positions[1], rtol=1e-5)
+
+
+def test_respa_energy_conservation(simulation_factory,
+                                   lattice_snapshot_factory):
+    """Splitting soft forces into the slow level conserves energy."""
+    snapshot = lattice_snapshot_factory(n=6, a=1.2)
+    sim = simulation_factory(snapshot)
+    if isinstance(sim.device, hoomd.device.GPU):
+        pytest.skip("RESPA is only supported on the CPU.")
+    sim.state.thermalize_particle_momenta(hoomd.filter.All(), kT=1.0)
+
+    nlist = md.nlist.Cell(buffer=0.4)
+    lj = md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+    lj.params[("A", "A")] = {"epsilon": 1.0, "sigma": 1.0}
+    gauss = md.pair.Gaussian(nlist, default_r_cut=3.0)
+    gauss.params[("A", "A")] = {"epsilon": 0.1, "sigma": 1.0}
+    nve = md.methods.ConstantVolume(hoomd.filter.All())
+    respa = hoomd.md.RESPA(0.001,
+                           period=4,
+                           methods=[nve],
+                           forces=[lj],
+                           slow_forces=[gauss])
+    sim.operations.integrator = respa
+    thermo = md.compute.ThermodynamicQuantities(hoomd.filter.All())
+    sim.operations.computes.append(thermo)
+
+    sim.run(0)
+    energy_start = thermo.kinetic_energy + thermo.potential_energy
+    sim.run(400)
+    energy_end = thermo.kinetic_energy + thermo.potential_energy
+
+    assert energy_end == pytest.approx(energy_start, rel=1e-2)
+
+
+def test_respa_inner_step_pressure(simulation_factory,
+                                   lattice_snapshot_factory):
+    """The thermodynamic quantities include the slow forces on inner steps."""
+    snapshot = lattice_snapshot_factory(n=6, a=1.2)
+    sim = simulation_factory(snapshot)
+    if isinstance(sim.device, hoomd.device.GPU):
+        pytest.skip("RESPA is only supported on the CPU.")
+    sim.state.thermalize_particle_momenta(hoomd.filter.All(), kT=1.0)
+
+    nlist = md.nlist.Cell(buffer=0.4)
+    lj = md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+    lj.params[("A", "A")] = {"epsilon": 1.0, "sigma": 1.0}
+    gauss = md.pair.Gaussian(nlist, default_r_cut=3.0)
+    gauss.params[("A", "A")] = {"epsilon": 0.1, "sigma": 1.0}
+    nve = md.methods.ConstantVolume(hoomd.filter.All())
+    respa = hoomd.md.RESPA(0.001,
+                           period=4,
+                           methods=[nve],
+                           forces=[lj],
+                           slow_forces=[gauss])
+    sim.operations.integrator = respa
+    sim.always_compute_pressure = True
+    thermo = md.compute.ThermodynamicQuantities(hoomd.filter.All())
+    sim.operations.computes.append(thermo)
+
+    # the slow forces are computed on step 0 and held through step 1
+    sim.run(0)
+    gauss_energy = gauss.energy
+    gauss_virials = gauss.virials
+
+    sim.run(1)
+    assert sim.timestep % respa.period != 0
+    potential_energy = thermo.potential_energy
+    pressure = thermo.pressure
+    kinetic_energy = thermo.translational_kinetic_energy
+
+    assert potential_energy == pytest.approx(lj.energy + gauss_energy)
+
+    lj_virials = lj.virials
+    if sim.device.communicator.rank == 0:
+        virial = numpy.sum(lj_virials, axis=0) + numpy.sum(gauss_virials,
+                                                           axis=0)
+        W = (virial[0] + virial[3] + virial[5]) / 3
+        assert pressure == pytest.approx(
+            (2 * kinetic_energy / 3 + W) / sim.state.box.volume)
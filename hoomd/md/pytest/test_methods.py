@@ -199,6 +199,112 @@ class TestThermostats:
         assert xi_rot == 0.0
         assert eta_rot == 0.0
 
+    def test_mttk_update(self, simulation_factory, lattice_snapshot_factory):
+        """Tests the MTTK update from the kinetic energy after the first half
+        step."""
+        kT = 1.5
+        tau = 0.5
+        dt = 0.005
+        thermostat = hoomd.md.methods.thermostats.MTTK(kT, tau)
+        nvt = hoomd.md.methods.ConstantVolume(thermostat=thermostat,
+                                              filter=hoomd.filter.All())
+
+        snap = lattice_snapshot_factory(n=4, a=2.0)
+        if snap.communicator.rank == 0:
+            rng = np.random.default_rng(7)
+            snap.particles.velocity[:] = rng.normal(size=(snap.particles.N, 3))
+        sim = simulation_factory(snap)
+        thermo = hoomd.md.compute.ThermodynamicQuantities(hoomd.filter.All())
+        sim.operations.computes.append(thermo)
+        sim.operations.integrator = hoomd.md.Integrator(dt, methods=[nvt])
+        sim.run(0)
+
+        # without forces and with xi = 0, the velocities after the first half
+        # step equal the initial velocities
+        c = thermo.kinetic_temperature / kT - 1
+        sim.run(1)
+        xi, eta = thermostat.translational_dof
+        np.testing.assert_allclose(xi, dt / tau**2 * c, rtol=1e-4)
+        np.testing.assert_allclose(eta, dt**2 / tau**2 / 2 * c, rtol=1e-4)
+
+    def test_mttk_update_constant_pressure(self, simulation_factory,
+                                           lattice_snapshot_factory):
+        """Tests the deferred MTTK update with ConstantPressure."""
+        kT = 1.5
+        tau = 0.5
+        dt = 0.005
+        thermostat = hoomd.md.methods.thermostats.MTTK(kT, tau)
+        # the barostat barely rescales the velocities with a large tauS
+        npt = hoomd.md.methods.ConstantPressure(thermostat=thermostat,
+                                                filter=hoomd.filter.All(),
+                                                S=0.1,
+                                                tauS=1000,
+                                                couple="xyz")
+
+        snap = lattice_snapshot_factory(n=4, a=2.0)
+        if snap.communicator.rank == 0:
+            rng = np.random.default_rng(7)
+            snap.particles.velocity[:] = rng.normal(size=(snap.particles.N, 3))
+        sim = simulation_factory(snap)
+        thermo = hoomd.md.compute.ThermodynamicQuantities(hoomd.filter.All())
+        sim.operations.computes.append(thermo)
+        sim.operations.integrator = hoomd.md.Integrator(dt, methods=[npt])
+        sim.run(0)
+
+        c = thermo.kinetic_temperature / kT - 1
+        sim.run(1)
+        xi, eta = thermostat.translational_dof
+        np.testing.assert_allclose(xi, dt / tau**2 * c, rtol=1e-4)
+        np.testing.assert_allclose(eta, dt**2 / tau**2 / 2 * c, rtol=1e-4)
+
+    def test_mttk_barostat_update(self, simulation_factory,
+                                  lattice_snapshot_factory):
+        """Tests the barostat update from the full step sums."""
+        kT = 1.5
+        tau = 0.5
+        tauS = 1.0
+        S = 0.5
+        dt = 0.005
+        thermostat = hoomd.md.methods.thermostats.MTTK(kT, tau)
+        npt = hoomd.md.methods.ConstantPressure(thermostat=thermostat,
+                                                filter=hoomd.filter.All(),
+                                                S=S,
+                                                tauS=tauS,
+                                                couple="xyz")
+
+        snap = lattice_snapshot_factory(n=4, a=1.2, r=0.05)
+        if snap.communicator.rank == 0:
+            rng = np.random.default_rng(7)
+            snap.particles.velocity[:] = rng.normal(size=(snap.particles.N, 3))
+        sim = simulation_factory(snap)
+
+        lj = hoomd.md.pair.LJ(nlist=hoomd.md.nlist.Cell(buffer=0.4),
+                              default_r_cut=2.5)
+        lj.params[("A", "A")] = dict(epsilon=1.0, sigma=1.0)
+        thermo = hoomd.md.compute.ThermodynamicQuantities(hoomd.filter.All())
+        sim.operations.computes.append(thermo)
+        sim.operations.integrator = hoomd.md.Integrator(dt,
+                                                        methods=[npt],
+                                                        forces=[lj])
+        sim.run(0)
+
+        # the barostat advances half a step with the properties at the start
+        # and at the end of the step, the latter come from the sums that the
+        # method accumulates
+        ndof = thermo.translational_degrees_of_freedom
+        W = (ndof + 3) / 3 * kT * tauS**2
+
+        def half_step():
+            return (0.5 * dt * sim.state.box.volume / W * (thermo.pressure - S)
+                    + thermo.translational_kinetic_energy * dt / ndof / W)
+
+        nu = half_step()
+        sim.run(1)
+        nu += half_step()
+
+        barostat_dof = npt.barostat_dof
+        np.testing.assert_allclose(barostat_dof[:3], [nu] * 3, rtol=1e-4)
+
     def test_logging(self):
         logging_check(hoomd.md.methods.thermostats.MTTK,
                       ('md', 'methods', 'thermostats'), {
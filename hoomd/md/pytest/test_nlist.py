@@ -62,6 +62,8 @@ def test_common_params(nlist_params):
         "exclusions": ('bond',),
         "rebuild_check_delay": 1,
         "check_dist": True,
+        "midpoint": False,
+        "adaptive_buffer": False,
     }
     _assert_nlist_params(nlist, default_params_dict)
     new_params_dict = {
@@ -76,6 +78,10 @@ def test_common_params(nlist_params):
             np.random.randint(8),
         "check_dist":
             False,
+        "midpoint":
+            True,
+        "adaptive_buffer":
+            True,
     }
     for param in new_params_dict.keys():
         setattr(nlist, param, new_params_dict[param])
@@ -124,6 +130,121 @@ def test_simple_simulation(nlist_params, simulation_factory,
                                      activate=lambda: sim.run(1))
 
 
+def _run_midpoint(sim_factory, snapshot, nlist_cls, required_args, midpoint):
+    nlist = nlist_cls(**required_args, buffer=0.4)
+    nlist.midpoint = midpoint
+    lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    integrator = hoomd.md.Integrator(0.005, forces=[lj])
+    thermo = hoomd.md.compute.ThermodynamicQuantities(filter=hoomd.filter.All())
+
+    sim = sim_factory(snapshot)
+    sim.operations.integrator = integrator
+    sim.operations.computes.append(thermo)
+    sim.run(0)
+
+    return lj, thermo
+
+
+def test_midpoint(nlist_params, simulation_factory, lattice_snapshot_factory,
+                  device):
+    """The midpoint method evaluates the same forces, energies and virials."""
+    nlist_cls, required_args = nlist_params
+    snapshot = lattice_snapshot_factory(n=8, a=1.1, r=0.1)
+
+    if isinstance(device, hoomd.device.GPU):
+        with pytest.raises(RuntimeError):
+            _run_midpoint(simulation_factory, snapshot, nlist_cls,
+                          required_args, True)
+        return
+
+    lj_ref, thermo_ref = _run_midpoint(simulation_factory, snapshot,
+                                       nlist_cls, required_args, False)
+    lj, thermo = _run_midpoint(simulation_factory, snapshot, nlist_cls,
+                               required_args, True)
+
+    # per-particle arrays are gathered on rank 0
+    if device.communicator.rank == 0:
+        np.testing.assert_allclose(lj.forces, lj_ref.forces, atol=1e-5)
+        np.testing.assert_allclose(lj.energies, lj_ref.energies, atol=1e-5)
+    np.testing.assert_allclose(lj.energy, lj_ref.energy, rtol=1e-5)
+    np.testing.assert_allclose(thermo.pressure_tensor,
+                               thermo_ref.pressure_tensor,
+                               atol=1e-5)
+
+
+def _lj_simulation(sim_factory, snapshot, nlist):
+    lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    integrator = hoomd.md.Integrator(0.005, forces=[lj])
+    sim = sim_factory(snapshot)
+    sim.operations.integrator = integrator
+    return sim, lj
+
+
+def test_adaptive_buffer(nlist_params, simulation_factory,
+                         lattice_snapshot_factory, device):
+    """The adaptive buffer stays in range and the list stays complete."""
+    nlist_cls, required_args = nlist_params
+    snapshot = lattice_snapshot_factory(n=8, a=1.2, r=0.1)
+    nlist = nlist_cls(**required_args, buffer=0.4, rebuild_check_delay=10)
+    nlist.adaptive_buffer = True
+    sim, lj = _lj_simulation(simulation_factory, snapshot, nlist)
+    sim.operations.integrator.methods.append(
+        hoomd.md.methods.Langevin(hoomd.filter.All(), kT=1.5))
+
+    if isinstance(device, hoomd.device.GPU):
+        with pytest.raises(RuntimeError):
+            sim.run(0)
+        return
+
+    sim.run(500)
+    assert 0.1 <= nlist.buffer <= 1.6
+
+    # compare to a list that is rebuilt on the same step
+    sim_ref, lj_ref = _lj_simulation(simulation_factory,
+                                     sim.state.get_snapshot(),
+                                     nlist_cls(**required_args, buffer=0.4))
+    sim_ref.run(0)
+    np.testing.assert_allclose(lj.energy, lj_ref.energy, rtol=1e-5)
+    if device.communicator.rank == 0:
+        np.testing.assert_allclose(lj.forces, lj_ref.forces, atol=1e-4)
+
+
+def test_adaptive_buffer_invalid(nlist_params, simulation_factory,
+                                 lattice_snapshot_factory, device):
+    """The adaptive buffer rejects settings it cannot tune."""
+    nlist_cls, required_args = nlist_params
+    snapshot = lattice_snapshot_factory(n=8, a=1.2, r=0.1)
+
+    # without the distance check, there are no rebuilds to tune
+    nlist = nlist_cls(**required_args, buffer=0.4, check_dist=False)
+    nlist.adaptive_buffer = True
+    sim, lj = _lj_simulation(simulation_factory, snapshot, nlist)
+    with pytest.raises(ValueError):
+        sim.run(0)
+
+    # a zero buffer cannot be scaled
+    nlist = nlist_cls(**required_args, buffer=0)
+    nlist.adaptive_buffer = True
+    sim, lj = _lj_simulation(simulation_factory, snapshot, nlist)
+    with pytest.raises(ValueError):
+        sim.run(0)
+
+    if isinstance(device, hoomd.device.GPU):
+        return
+
+    # the settings cannot be changed to invalid values while tuning
+    nlist = nlist_cls(**required_args, buffer=0.4)
+    sim, lj = _lj_simulation(simulation_factory, snapshot, nlist)
+    sim.run(0)
+    nlist.adaptive_buffer = True
+    with pytest.raises(ValueError):
+        nlist.check_dist = False
+    with pytest.raises(ValueError):
+        nlist.buffer = 0
+
+
 def test_auto_detach_simulation(simulation_factory,
                                 two_particle_snapshot_factory):
     nlist = Cell(buffer=0.4)
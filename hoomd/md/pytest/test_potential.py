@@ -762,6 +762,52 @@ def test_run(simulation_factory, lattice_snapshot_factory, valid_params):
     autotuned_kernel_parameter_check(instance=pot, activate=lambda: sim.run(1))
 
 
+@pytest.mark.cpu
+@pytest.mark.skipif(not hoomd.version.tbb_enabled,
+                    reason="TBB is not enabled")
+@pytest.mark.parametrize(
+    "valid_params",
+    [
+        p for p in _valid_params()
+        if issubclass(p.pair_potential, md.many_body.Triplet)
+    ],
+    ids=lambda x: x.pair_potential.__name__)
+def test_many_body_threads(simulation_factory, lattice_snapshot_factory,
+                           device, valid_params):
+    """Threaded many body forces match the serial forces."""
+    pair_keys = valid_params.pair_potential_params.keys()
+    particle_types = list(set(itertools.chain.from_iterable(pair_keys)))
+    snap = lattice_snapshot_factory(particle_types=particle_types,
+                                    n=8,
+                                    a=1.7,
+                                    r=0.1)
+    if snap.communicator.rank == 0:
+        rng = np.random.default_rng(1)
+        snap.particles.typeid[:] = rng.integers(0, len(snap.particles.types),
+                                                snap.particles.N)
+
+    num_cpu_threads = device.num_cpu_threads
+    results = []
+    try:
+        for threads in (1, 4):
+            device.num_cpu_threads = threads
+            pot = valid_params.pair_potential(**valid_params.extra_args,
+                                              nlist=md.nlist.Cell(buffer=0.4),
+                                              default_r_cut=2.5)
+            pot.params = deepcopy(valid_params.pair_potential_params)
+            sim = simulation_factory(snap)
+            sim.always_compute_pressure = True
+            sim.operations.integrator = md.Integrator(dt=0.005, forces=[pot])
+            sim.run(0)
+            results.append((pot.forces, pot.energies, pot.virials))
+    finally:
+        device.num_cpu_threads = num_cpu_threads
+
+    if snap.communicator.rank == 0:
+        for serial, threaded in zip(results[0], results[1]):
+            np.testing.assert_allclose(threaded, serial, rtol=1e-5, atol=1e-6)
+
+
 def set_distance(simulation, distance):
     snap = simulation.state.get_snapshot()
     if snap.communicator.rank == 0:
@@ -1377,3 +1423,70 @@ def test_shift(simulation_factory, two_particle_snapshot_factory,
     # is much closer to 0 than V.
     tolerance = max(math.fabs(V / 1e4), 1e-8)
     assert V_shifted == pytest.approx(expected=0, abs=tolerance)
+
+
+@pytest.mark.parametrize("forces_and_energies",
+                         _forces_and_energies(),
+                         ids=lambda x: x.pair_potential.__name__)
+@pytest.mark.parametrize("mode", ['none', 'shift', 'xplor'])
+def test_tabulation(device, simulation_factory, two_particle_snapshot_factory,
+                    forces_and_energies, mode):
+    """Test that tabulated pair forces match the direct evaluation."""
+    pair_cls = forces_and_energies.pair_potential
+    if not pair_cls._tabulation_supported:
+        pytest.skip(f"{pair_cls.__name__} does not support tabulation.")
+    if mode not in pair_cls._accepted_modes:
+        pytest.skip(f"{pair_cls.__name__} does not support the {mode} mode.")
+
+    potentials = []
+    for tolerance in (0, 1e-7):
+        potential = pair_cls(**forces_and_energies.extra_args,
+                             nlist=md.nlist.Cell(buffer=0.4),
+                             default_r_cut=2.5)
+        potential.params[('A', 'A')] = forces_and_energies.pair_potential_params
+        potential.mode = mode
+        if mode == 'xplor':
+            potential.r_on[('A', 'A')] = 2.0
+        potential.tabulation_tolerance = tolerance
+        potentials.append(potential)
+
+    assert potentials[1].tabulation_tolerance == 1e-7
+
+    snap = two_particle_snapshot_factory(particle_types=['A'], d=0.75)
+    _update_snap(pair_cls, snap)
+    sim = simulation_factory(snap)
+    sim.operations.computes.extend(potentials)
+
+    if isinstance(device, hoomd.device.GPU):
+        with pytest.raises(RuntimeError):
+            sim.run(0)
+        return
+
+    sim.run(0)
+    tabulated_distances = []
+    for d in (0.75, 1.0, 1.2345, 1.5, 2.2, 2.4999):
+        snap = sim.state.get_snapshot()
+        if snap.communicator.rank == 0:
+            snap.particles.position[0] = [0, 0, .1]
+            snap.particles.position[1] = [0, 0, d + .1]
+        sim.state.set_snapshot(snap)
+
+        direct, tabulated = potentials
+        if direct.energies is not None:
+            np.testing.assert_allclose(tabulated.energies,
+                                       direct.energies,
+                                       rtol=1e-5,
+                                       atol=1e-6)
+            np.testing.assert_allclose(tabulated.forces,
+                                       direct.forces,
+                                       rtol=1e-5,
+                                       atol=1e-6)
+
+        # the direct potential never interpolates, the tabulated one must
+        # interpolate at least some of the distances instead of falling back to
+        # the evaluator
+        assert not direct._cpp_obj.isTabulated(('A', 'A'), d)
+        tabulated_distances.append(tabulated._cpp_obj.isTabulated(('A', 'A'),
+                                                                  d))
+
+    assert any(tabulated_distances)
@@ -163,3 +163,81 @@ def test_pppm_energy(simulation_factory, two_charged_particle_snapshot_factory):
     # The reference energy is from a LAMMPS simulation. The tolerance is large
     # as the PPPM parameters do not directly map between the two codes
     numpy.testing.assert_allclose(energy, -1.0021254, rtol=1e-2)
+
+
+def _pppm_forces(simulation_factory, snapshot, resolution):
+    """Compute the PPPM reciprocal space forces and energy of a snapshot."""
+    nlist = hoomd.md.nlist.Cell(buffer=0.4)
+    ewald, coulomb = hoomd.md.long_range.pppm.make_pppm_coulomb_forces(
+        nlist=nlist, resolution=resolution, order=5, r_cut=2.5, alpha=0)
+
+    sim = simulation_factory(snapshot)
+    integrator = hoomd.md.Integrator(dt=0.005)
+    integrator.forces.extend([ewald, coulomb])
+    sim.operations.integrator = integrator
+    sim.run(0)
+
+    return coulomb.forces, coulomb.energy
+
+
+@pytest.fixture(scope='function')
+def charged_lattice_snapshot(lattice_snapshot_factory):
+    """Make a neutral lattice of displaced charges."""
+    s = lattice_snapshot_factory(n=8, a=1.5, r=0.3)
+    if s.communicator.rank == 0:
+        s.particles.charge[:] = numpy.resize([1, -1], s.particles.N)
+    return s
+
+
+@pytest.mark.cpu
+@pytest.mark.skipif(not hoomd.version.tbb_enabled,
+                    reason="TBB is not enabled")
+def test_pppm_threads(simulation_factory, charged_lattice_snapshot, device):
+    """Threaded charge assignment matches the serial charge assignment."""
+    num_cpu_threads = device.num_cpu_threads
+
+    try:
+        device.num_cpu_threads = 1
+        forces_serial, energy_serial = _pppm_forces(simulation_factory,
+                                                    charged_lattice_snapshot,
+                                                    (32, 32, 32))
+
+        device.num_cpu_threads = 4
+        forces_threaded, energy_threaded = _pppm_forces(
+            simulation_factory, charged_lattice_snapshot, (32, 32, 32))
+    finally:
+        device.num_cpu_threads = num_cpu_threads
+
+    assert energy_threaded == pytest.approx(energy_serial, rel=1e-5)
+    if device.communicator.rank == 0:
+        numpy.testing.assert_allclose(forces_threaded,
+                                      forces_serial,
+                                      rtol=1e-4,
+                                      atol=1e-5)
+
+
+@pytest.mark.cpu
+@pytest.mark.serial
+@pytest.mark.skipif(not hoomd.version.fftw_enabled,
+                    reason="FFTW is not enabled")
+@pytest.mark.parametrize("resolution", [(64, 64, 64), (48, 60, 54)])
+def test_pppm_fftw(simulation_factory, two_charged_particle_snapshot_factory,
+                   resolution):
+    """The FFTW transforms reproduce the reference two particle energy."""
+    nlist = hoomd.md.nlist.Cell(buffer=0.4)
+    ewald, coulomb = hoomd.md.long_range.pppm.make_pppm_coulomb_forces(
+        nlist=nlist, resolution=resolution, order=6, r_cut=3.0, alpha=0)
+
+    sim = simulation_factory(two_charged_particle_snapshot_factory())
+    integrator = hoomd.md.Integrator(dt=0.005)
+    integrator.forces.extend([ewald, coulomb])
+    sim.operations.integrator = integrator
+    sim.run(0)
+
+    numpy.testing.assert_allclose(ewald.energy + coulomb.energy,
+                                  -1.0021254,
+                                  rtol=1e-2)
+
+    # the two reciprocal space forces are equal and opposite
+    forces = coulomb.forces
+    numpy.testing.assert_allclose(forces[0], -forces[1], atol=1e-6)
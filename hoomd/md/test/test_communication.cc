@@ -3629,6 +3629,119 @@ void test_communicator_ghosts_per_type(communicator_creator comm_creator,
         }
     }
 
+//! Check that the structure-of-arrays positions match the positions of local and ghost particles
+void check_position_components(std::shared_ptr<ParticleData> pdata)
+    {
+    UP_ASSERT(pdata->getPositionComponentsEnabled());
+
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_pos_x(pdata->getPositionsX(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_pos_y(pdata->getPositionsY(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_pos_z(pdata->getPositionsZ(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_type_idx(pdata->getTypeIndices(),
+                                         access_location::host,
+                                         access_mode::read);
+
+    for (unsigned int i = 0; i < pdata->getN() + pdata->getNGhosts(); ++i)
+        {
+        UP_ASSERT_EQUAL(h_pos_x.data[i], h_pos.data[i].x);
+        UP_ASSERT_EQUAL(h_pos_y.data[i], h_pos.data[i].y);
+        UP_ASSERT_EQUAL(h_pos_z.data[i], h_pos.data[i].z);
+        UP_ASSERT_EQUAL(h_type_idx.data[i], (unsigned int)__scalar_as_int(h_pos.data[i].w));
+        }
+    }
+
+//! Test that migration and ghost exchange keep the structure-of-arrays positions in sync
+void test_communicator_position_components(communicator_creator comm_creator,
+                                           std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // this test needs to be run on eight processors
+    int size;
+    MPI_Comm_size(exec_conf->getHOOMDWorldMPICommunicator(), &size);
+    UP_ASSERT_EQUAL(size, 8);
+
+    // create a system with sixteen particles
+    BoxDim box(2.0);
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(16,  // number of particles
+                                                                  box, // box dimensions
+                                                                  2, // number of particle types
+                                                                  0, // number of bond types
+                                                                  0, // number of angle types
+                                                                  0, // number of dihedral types
+                                                                  0, // number of dihedral types
+                                                                  exec_conf));
+
+    std::shared_ptr<ParticleData> pdata(sysdef->getParticleData());
+
+    // place one particle in the middle of every domain and one close to its +x boundary
+    for (unsigned int i = 0; i < 8; ++i)
+        {
+        Scalar3 center = make_scalar3((i & 1) ? 0.5 : -0.5,
+                                      (i & 2) ? 0.5 : -0.5,
+                                      (i & 4) ? 0.5 : -0.5);
+        pdata->setPosition(i, center, false);
+        pdata->setType(i, i % 2);
+        pdata->setPosition(8 + i,
+                           make_scalar3((i & 1) ? 0.98 : -0.02, center.y, center.z),
+                           false);
+        pdata->setType(8 + i, (i + 1) % 2);
+        }
+
+    SnapshotParticleData<Scalar> snap(16);
+    pdata->takeSnapshot(snap);
+
+    // initialize a 2x2x2 domain decomposition on processor with rank 0
+    std::shared_ptr<DomainDecomposition> decomposition(
+        new DomainDecomposition(exec_conf, pdata->getBox().getL(), 2, 2, 2));
+
+    std::shared_ptr<hoomd::Communicator> comm = comm_creator(sysdef, decomposition);
+
+    pdata->setDomainDecomposition(decomposition);
+
+    pdata->initializeFromSnapshot(snap);
+
+    pdata->setPositionComponentsEnabled(true);
+    UP_ASSERT_EQUAL(pdata->getN(), 2);
+    check_position_components(pdata);
+
+    // move the particles close to the boundary into the +x neighbor and migrate them
+    for (unsigned int i = 0; i < 8; ++i)
+        {
+        Scalar3 center = make_scalar3((i & 1) ? 0.5 : -0.5,
+                                      (i & 2) ? 0.5 : -0.5,
+                                      (i & 4) ? 0.5 : -0.5);
+        pdata->setPosition(8 + i,
+                           make_scalar3((i & 1) ? 1.02 : 0.02, center.y, center.z),
+                           false);
+        }
+    comm->migrateParticles();
+    UP_ASSERT_EQUAL(pdata->getN(), 2);
+    check_position_components(pdata);
+
+    // the migrated particles are in the ghost layer of their -x neighbor
+    ghost_layer_width g(Scalar(0.1));
+    comm->getGhostLayerWidthRequestSignal().connect<ghost_layer_width, &ghost_layer_width::get>(g);
+
+    CommFlags flags(0);
+    flags[comm_flag::position] = 1;
+    flags[comm_flag::tag] = 1;
+    comm->setFlags(flags);
+
+    comm->exchangeGhosts();
+    UP_ASSERT(pdata->getNGhosts() > 0);
+    check_position_components(pdata);
+
+    // move all particles without leaving their domain and update the ghosts
+    for (unsigned int tag = 0; tag < 16; ++tag)
+        {
+        Scalar3 pos = pdata->getPosition(tag);
+        pdata->setPosition(tag, pos + make_scalar3(0, 0, 0.01), false);
+        }
+    comm->beginUpdateGhosts(0);
+    comm->finishUpdateGhosts(0);
+    check_position_components(pdata);
+    }
+
 //! Communicator creator for unit tests
 std::shared_ptr<hoomd::Communicator>
 base_class_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
@@ -3896,6 +4009,16 @@ UP_TEST(communicator_ghost_layer_per_type_test)
     test_communicator_ghosts_per_type(communicator_creator_base, exec_conf_cpu, BoxDim(2.0));
     }
 
+UP_TEST(communicator_position_components_test)
+    {
+    if (!exec_conf_cpu)
+        exec_conf_cpu = std::shared_ptr<ExecutionConfiguration>(
+            new ExecutionConfiguration(ExecutionConfiguration::CPU));
+
+    communicator_creator communicator_creator_base = bind(base_class_communicator_creator, _1, _2);
+    test_communicator_position_components(communicator_creator_base, exec_conf_cpu);
+    }
+
 UP_SUITE_END();
 
 #ifdef ENABLE_HIP
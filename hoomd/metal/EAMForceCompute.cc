@@ -3,8 +3,14 @@
 
 #include "EAMForceCompute.h"
 
+#include <algorithm>
+#include <type_traits>
 #include <vector>
 
+#ifdef ENABLE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 using namespace std;
 
 #include <stdexcept>
@@ -327,13 +333,6 @@ void EAMForceCompute::computeForces(uint64_t timestep)
     ArrayHandle<Scalar4> h_rphi(m_rphi, access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_drphi(m_drphi, access_location::host, access_mode::read);
 
-    // index and remainder
-    Scalar position;           // look up position, scalar
-    unsigned int int_position; // look up index for position, integer
-    unsigned int idxs;         // look up index in F, rho, rphi array, considering shift, integer
-    Scalar remainder;          // look up remainder in array, integer
-    Scalar4 v, dv;             // value, d(value)
-
     // there are enough other checks on the input data: but it doesn't hurt to be safe
     assert(h_force.data);
     assert(h_virial.data);
@@ -356,201 +355,325 @@ void EAMForceCompute::computeForces(uint64_t timestep)
     Scalar r_cut_sq = m_r_cut * m_r_cut;
 
     // parameters for each particle
-    vector<Scalar> atomElectronDensity;
-    atomElectronDensity.resize(m_pdata->getN());
-    vector<Scalar> atomDerivativeEmbeddingFunction;
-    atomDerivativeEmbeddingFunction.resize(m_pdata->getN());
-    vector<Scalar> atomEmbeddingFunction;
-    atomEmbeddingFunction.resize(m_pdata->getN());
+    const unsigned int N = m_pdata->getN();
+    vector<Scalar> atomElectronDensity(N, Scalar(0.0));
+    vector<Scalar> atomDerivativeEmbeddingFunction(N);
     unsigned int ntypes = m_pdata->getNTypes();
 
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    // Run compute_range(begin, end, out, scatter) over all particles. Particle i adds to out[i]
+    // directly. With a half neighbor list, the contributions to neighbor k go through
+    // scatter(k, value). In parallel, each chunk of particles owns the entries out[begin, end) and
+    // adds to them directly. Contributions to particles of other chunks are spilled into a buffer
+    // for the owning chunk and applied after all chunks finish, in chunk order. With
+    // locality-sorted particles, only pairs across chunk boundaries spill.
+    auto for_all_particles = [&](const auto& compute_range, auto* out, auto& spills)
+    {
+        using T = std::remove_pointer_t<decltype(out)>;
+
+        auto add = [](T& a, const T& v)
         {
-        // access the particle's position and type
-        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-        const size_t head_i = h_head_list.data[i];
+            if constexpr (std::is_same<T, Scalar>::value)
+                {
+                a += v;
+                }
+            else
+                {
+                a.x += v.x;
+                a.y += v.y;
+                a.z += v.z;
+                a.w += v.w;
+                }
+        };
 
-        // sanity check
-        assert(typei < m_pdata->getNTypes());
+#ifdef ENABLE_TBB
+        const unsigned int n_chunks = std::min(m_exec_conf->getNumThreads(), N);
 
-        // loop over all of the neighbors of this particle
-        const unsigned int size = (unsigned int)h_n_neigh.data[i];
+        if (n_chunks > 1 && !third_law)
+            {
+            auto no_scatter = [](unsigned int, const T&) { };
+            m_exec_conf->getTaskArena()->execute(
+                [&]
+                {
+                    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+                                      [&](const tbb::blocked_range<unsigned int>& r)
+                                      { compute_range(r.begin(), r.end(), out, no_scatter); });
+                });
+            return;
+            }
 
-        for (unsigned int j = 0; j < size; j++)
+        if (n_chunks > 1)
             {
-            // access the index of this neighbor
-            unsigned int k = h_nlist.data[head_i + j];
-            // sanity check
-            assert(k < m_pdata->getN());
+            m_chunk_begin.resize(n_chunks + 1);
+            for (unsigned int chunk = 0; chunk <= n_chunks; chunk++)
+                m_chunk_begin[chunk] = (unsigned int)(size_t(N) * chunk / n_chunks);
 
-            // calculate dr
-            Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
-            Scalar3 dx = pi - pk;
+            // the spill buffers keep their capacity from step to step
+            spills.resize(size_t(n_chunks) * n_chunks);
+            for (auto& spill : spills)
+                spill.clear();
+
+            auto compute_chunk = [&](unsigned int chunk)
+            {
+                const unsigned int begin = m_chunk_begin[chunk];
+                const unsigned int end = m_chunk_begin[chunk + 1];
+                auto scatter = [&](unsigned int k, const T& v)
+                {
+                    if (k >= begin && k < end)
+                        {
+                        add(out[k], v);
+                        return;
+                        }
+
+                    unsigned int owner
+                        = (unsigned int)(std::upper_bound(m_chunk_begin.begin() + 1,
+                                                          m_chunk_begin.end(),
+                                                          k)
+                                         - m_chunk_begin.begin() - 1);
+                    spills[size_t(chunk) * n_chunks + owner].push_back(std::make_pair(k, v));
+                };
+                compute_range(begin, end, out, scatter);
+            };
+
+            auto apply_spills = [&](unsigned int owner)
+            {
+                for (unsigned int chunk = 0; chunk < n_chunks; chunk++)
+                    for (const auto& spill : spills[size_t(chunk) * n_chunks + owner])
+                        add(out[spill.first], spill.second);
+            };
+
+            m_exec_conf->getTaskArena()->execute(
+                [&]
+                {
+                    tbb::parallel_for((unsigned int)0, n_chunks, compute_chunk);
+                    tbb::parallel_for((unsigned int)0, n_chunks, apply_spills);
+                });
+            return;
+            }
+#endif
+        compute_range(0, N, out, [&](unsigned int k, const T& v) { add(out[k], v); });
+    };
+
+    // accumulate the electron density P = sum{rho} of each particle
+    auto compute_density
+        = [&](unsigned int begin, unsigned int end, Scalar* density, const auto& scatter)
+    {
+        for (unsigned int i = begin; i < end; i++)
+            {
+            // access the particle's position and type
+            Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+            const size_t head_i = h_head_list.data[i];
 
-            // access the type of the neighbor particle
-            unsigned int typej = __scalar_as_int(h_pos.data[k].w);
             // sanity check
-            assert(typej < m_pdata->getNTypes());
+            assert(typei < ntypes);
 
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
+            // loop over all of the neighbors of this particle
+            const unsigned int size = (unsigned int)h_n_neigh.data[i];
 
-            // start computing the force
-            // calculate r squared
-            Scalar rsq = dot(dx, dx);
-            ;
-            // only compute the force if the particles are closer than the cut-off
-            if (rsq < r_cut_sq)
+            for (unsigned int j = 0; j < size; j++)
                 {
-                // calculate position r for rho(r)
-                position = sqrt(rsq) * rdr;
-                int_position = (unsigned int)position;
-                int_position = min(int_position, nr - 1);
-                remainder = position - int_position;
-                // calculate P = sum{rho}
-                idxs = int_position + nr * (typej * ntypes + typei);
-                v = h_rho.data[idxs];
-                atomElectronDensity[i] += v.w + v.z * remainder + v.y * remainder * remainder
-                                          + v.x * remainder * remainder * remainder;
-                // if third_law, pair it
-                if (third_law)
+                // access the index of this neighbor
+                unsigned int k = h_nlist.data[head_i + j];
+                // sanity check
+                assert(k < N);
+
+                // calculate dr
+                Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
+                Scalar3 dx = pi - pk;
+
+                // access the type of the neighbor particle
+                unsigned int typej = __scalar_as_int(h_pos.data[k].w);
+                // sanity check
+                assert(typej < ntypes);
+
+                // apply periodic boundary conditions
+                dx = box.minImage(dx);
+
+                // calculate r squared
+                Scalar rsq = dot(dx, dx);
+
+                // only compute the density if the particles are closer than the cut-off
+                if (rsq < r_cut_sq)
                     {
-                    idxs = int_position + nr * (typei * ntypes + typej);
-                    v = h_rho.data[idxs];
-                    atomElectronDensity[k] += v.w + v.z * remainder + v.y * remainder * remainder
-                                              + v.x * remainder * remainder * remainder;
+                    // calculate position r for rho(r)
+                    Scalar position = sqrt(rsq) * rdr;
+                    unsigned int int_position = (unsigned int)position;
+                    int_position = min(int_position, nr - 1);
+                    Scalar remainder = position - int_position;
+                    // calculate P = sum{rho}
+                    unsigned int idxs = int_position + nr * (typej * ntypes + typei);
+                    Scalar4 v = h_rho.data[idxs];
+                    density[i] += v.w + v.z * remainder + v.y * remainder * remainder
+                                  + v.x * remainder * remainder * remainder;
+                    // if third_law, pair it
+                    if (third_law)
+                        {
+                        idxs = int_position + nr * (typei * ntypes + typej);
+                        v = h_rho.data[idxs];
+                        scatter(k,
+                                v.w + v.z * remainder + v.y * remainder * remainder
+                                    + v.x * remainder * remainder * remainder);
+                        }
                     }
                 }
             }
-        }
+    };
 
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        {
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-        // calculate position rho for F(rho)
-        position = atomElectronDensity[i] * rdrho;
-        int_position = (unsigned int)position;
-        int_position = min(int_position, nrho - 1);
-        remainder = position - int_position;
-
-        idxs = int_position + typei * nrho;
-        v = h_F.data[idxs];
-        dv = h_dF.data[idxs];
-        // compute dF / dP
-        atomDerivativeEmbeddingFunction[i] = dv.z + dv.y * remainder + dv.x * remainder * remainder;
-        // compute embedded energy F(P), sum up each particle
-        h_force.data[i].w += v.w + v.z * remainder + v.y * remainder * remainder
-                             + v.x * remainder * remainder * remainder;
-        }
-
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        {
-        // access the particle's position and type
-        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-        const size_t head_i = h_head_list.data[i];
-        // sanity check
-        assert(typei < m_pdata->getNTypes());
-
-        // initialize current particle force, potential energy, and virial to 0
-        Scalar fxi = 0.0;
-        Scalar fyi = 0.0;
-        Scalar fzi = 0.0;
-        Scalar pei = 0.0;
-        Scalar viriali[6];
-        for (int k = 0; k < 6; k++)
-            viriali[k] = 0.0;
-
-        // loop over all of the neighbors of this particle
-        const unsigned int size = (unsigned int)h_n_neigh.data[i];
-        for (unsigned int j = 0; j < size; j++)
+    // compute the embedding energy F(P) and dF / dP of each particle
+    auto compute_embedding = [&](unsigned int begin, unsigned int end, Scalar4* force)
+    {
+        for (unsigned int i = begin; i < end; i++)
             {
-            // access the index of this neighbor
-            unsigned int k = h_nlist.data[head_i + j];
-            // sanity check
-            assert(k < m_pdata->getN());
-
-            // calculate \Delta r
-            Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
-            Scalar3 dx = pi - pk;
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+            // calculate position rho for F(rho)
+            Scalar position = atomElectronDensity[i] * rdrho;
+            unsigned int int_position = (unsigned int)position;
+            int_position = min(int_position, nrho - 1);
+            Scalar remainder = position - int_position;
+
+            unsigned int idxs = int_position + typei * nrho;
+            Scalar4 v = h_F.data[idxs];
+            Scalar4 dv = h_dF.data[idxs];
+            // compute dF / dP
+            atomDerivativeEmbeddingFunction[i]
+                = dv.z + dv.y * remainder + dv.x * remainder * remainder;
+            // compute embedded energy F(P), sum up each particle
+            force[i].w += v.w + v.z * remainder + v.y * remainder * remainder
+                          + v.x * remainder * remainder * remainder;
+            }
+    };
 
-            // access the type of the neighbor particle
-            unsigned int typej = __scalar_as_int(h_pos.data[k].w);
+    // compute the pair forces, the virial is only accumulated on particle i
+    auto compute_forces
+        = [&](unsigned int begin, unsigned int end, Scalar4* force, const auto& scatter)
+    {
+        for (unsigned int i = begin; i < end; i++)
+            {
+            // access the particle's position and type
+            Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+            const size_t head_i = h_head_list.data[i];
             // sanity check
-            assert(typej < m_pdata->getNTypes());
-
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
-
-            // start computing the force
-            // calculate r squared
-            Scalar rsq = dot(dx, dx);
-
-            // calculate position r for phi(r)
-            if (rsq >= r_cut_sq)
-                continue;
-            Scalar r = sqrt(rsq);
-            Scalar inverseR = 1.0 / r;
-            position = r * rdr;
-            int_position = (unsigned int)position;
-            int_position = min(int_position, nr - 1);
-            remainder = position - int_position;
-            // calculate the shift position for type ij
-            int shift = (typei >= typej)
-                            ? (int)(0.5 * (2 * ntypes - typej - 1) * typej + typei) * nr
-                            : (int)(0.5 * (2 * ntypes - typei - 1) * typei + typej) * nr;
-
-            idxs = int_position + shift;
-            v = h_rphi.data[idxs];
-            dv = h_drphi.data[idxs];
-            // pair_eng = phi
-            Scalar pair_eng = (v.w + v.z * remainder + v.y * remainder * remainder
-                               + v.x * remainder * remainder * remainder)
-                              * inverseR;
-            // derivativePhi = (phi + r * dphi/dr - phi) * 1/r = dphi / dr
-            Scalar derivativePhi
-                = (dv.z + dv.y * remainder + dv.x * remainder * remainder - pair_eng) * inverseR;
-            // derivativeRhoI = drho / dr of i
-            idxs = int_position + typei * ntypes * nr + typej * nr;
-            dv = h_drho.data[idxs];
-            Scalar derivativeRhoI = dv.z + dv.y * remainder + dv.x * remainder * remainder;
-            // derivativeRhoJ = drho / dr of j
-            idxs = int_position + typej * ntypes * nr + typei * nr;
-            dv = h_drho.data[idxs];
-            Scalar derivativeRhoJ = dv.z + dv.y * remainder + dv.x * remainder * remainder;
-            // fullDerivativePhi = dF/dP * drho / dr for j + dF/dP * drho / dr for j + phi
-            Scalar fullDerivativePhi = atomDerivativeEmbeddingFunction[i] * derivativeRhoJ
-                                       + atomDerivativeEmbeddingFunction[k] * derivativeRhoI
-                                       + derivativePhi;
-            // compute forces
-            Scalar pairForce = -fullDerivativePhi * inverseR;
-            viriali[0] += dx.x * dx.x * pairForce;
-            viriali[1] += dx.x * dx.y * pairForce;
-            viriali[2] += dx.x * dx.z * pairForce;
-            viriali[3] += dx.y * dx.y * pairForce;
-            viriali[4] += dx.y * dx.z * pairForce;
-            viriali[5] += dx.z * dx.z * pairForce;
-            fxi += dx.x * pairForce;
-            fyi += dx.y * pairForce;
-            fzi += dx.z * pairForce;
-            pei += pair_eng * 0.5;
-
-            if (third_law)
+            assert(typei < ntypes);
+
+            // initialize current particle force, potential energy, and virial to 0
+            Scalar fxi = 0.0;
+            Scalar fyi = 0.0;
+            Scalar fzi = 0.0;
+            Scalar pei = 0.0;
+            Scalar viriali[6];
+            for (int k = 0; k < 6; k++)
+                viriali[k] = 0.0;
+
+            // loop over all of the neighbors of this particle
+            const unsigned int size = (unsigned int)h_n_neigh.data[i];
+            for (unsigned int j = 0; j < size; j++)
                 {
-                h_force.data[k].x -= dx.x * pairForce;
-                h_force.data[k].y -= dx.y * pairForce;
-                h_force.data[k].z -= dx.z * pairForce;
-                h_force.data[k].w += pair_eng * 0.5;
+                // access the index of this neighbor
+                unsigned int k = h_nlist.data[head_i + j];
+                // sanity check
+                assert(k < N);
+
+                // calculate \Delta r
+                Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
+                Scalar3 dx = pi - pk;
+
+                // access the type of the neighbor particle
+                unsigned int typej = __scalar_as_int(h_pos.data[k].w);
+                // sanity check
+                assert(typej < ntypes);
+
+                // apply periodic boundary conditions
+                dx = box.minImage(dx);
+
+                // start computing the force
+                // calculate r squared
+                Scalar rsq = dot(dx, dx);
+
+                // calculate position r for phi(r)
+                if (rsq >= r_cut_sq)
+                    continue;
+                Scalar r = sqrt(rsq);
+                Scalar inverseR = 1.0 / r;
+                Scalar position = r * rdr;
+                unsigned int int_position = (unsigned int)position;
+                int_position = min(int_position, nr - 1);
+                Scalar remainder = position - int_position;
+                // calculate the shift position for type ij
+                int shift = (typei >= typej)
+                                ? (int)(0.5 * (2 * ntypes - typej - 1) * typej + typei) * nr
+                                : (int)(0.5 * (2 * ntypes - typei - 1) * typei + typej) * nr;
+
+                unsigned int idxs = int_position + shift;
+                Scalar4 v = h_rphi.data[idxs];
+                Scalar4 dv = h_drphi.data[idxs];
+                // pair_eng = phi
+                Scalar pair_eng = (v.w + v.z * remainder + v.y * remainder * remainder
+                                   + v.x * remainder * remainder * remainder)
+                                  * inverseR;
+                // derivativePhi = (phi + r * dphi/dr - phi) * 1/r = dphi / dr
+                Scalar derivativePhi
+                    = (dv.z + dv.y * remainder + dv.x * remainder * remainder - pair_eng)
+                      * inverseR;
+                // derivativeRhoI = drho / dr of i
+                idxs = int_position + typei * ntypes * nr + typej * nr;
+                dv = h_drho.data[idxs];
+                Scalar derivativeRhoI = dv.z + dv.y * remainder + dv.x * remainder * remainder;
+                // derivativeRhoJ = drho / dr of j
+                idxs = int_position + typej * ntypes * nr + typei * nr;
+                dv = h_drho.data[idxs];
+                Scalar derivativeRhoJ = dv.z + dv.y * remainder + dv.x * remainder * remainder;
+                // fullDerivativePhi = dF/dP * drho / dr for j + dF/dP * drho / dr for j + phi
+                Scalar fullDerivativePhi = atomDerivativeEmbeddingFunction[i] * derivativeRhoJ
+                                           + atomDerivativeEmbeddingFunction[k] * derivativeRhoI
+                                           + derivativePhi;
+                // compute forces
+                Scalar pairForce = -fullDerivativePhi * inverseR;
+                viriali[0] += dx.x * dx.x * pairForce;
+                viriali[1] += dx.x * dx.y * pairForce;
+                viriali[2] += dx.x * dx.z * pairForce;
+                viriali[3] += dx.y * dx.y * pairForce;
+                viriali[4] += dx.y * dx.z * pairForce;
+                viriali[5] += dx.z * dx.z * pairForce;
+                fxi += dx.x * pairForce;
+                fyi += dx.y * pairForce;
+                fzi += dx.z * pairForce;
+                pei += pair_eng * 0.5;
+
+                if (third_law)
+                    {
+                    scatter(k,
+                            make_scalar4(-dx.x * pairForce,
+                                         -dx.y * pairForce,
+                                         -dx.z * pairForce,
+                                         pair_eng * 0.5));
+                    }
                 }
+            force[i].x += fxi;
+            force[i].y += fyi;
+            force[i].z += fzi;
+            force[i].w += pei;
+            for (int k = 0; k < 6; k++)
+                h_virial.data[k * virial_pitch + i] += viriali[k];
             }
-        h_force.data[i].x += fxi;
-        h_force.data[i].y += fyi;
-        h_force.data[i].z += fzi;
-        h_force.data[i].w += pei;
-        for (int k = 0; k < 6; k++)
-            h_virial.data[k * virial_pitch + i] += viriali[k];
-        }
+    };
+
+    for_all_particles(compute_density, atomElectronDensity.data(), m_density_spills);
+
+    // the embedding pass only writes to particle i
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&]
+        {
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+                              [&](const tbb::blocked_range<unsigned int>& r)
+                              { compute_embedding(r.begin(), r.end(), h_force.data); });
+        });
+#else
+    compute_embedding(0, N, h_force.data);
+#endif
+
+    for_all_particles(compute_forces, h_force.data, m_force_spills);
     }
 
 void EAMForceCompute::set_neighbor_list(std::shared_ptr<md::NeighborList> nlist)
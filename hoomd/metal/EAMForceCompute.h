@@ -5,6 +5,8 @@
 #include "hoomd/md/NeighborList.h"
 
 #include <memory>
+#include <utility>
+#include <vector>
 
 /*! \file EAMForceCompute.h
  \brief Declares the EAMForceCompute class
@@ -43,6 +45,10 @@ namespace metal
  h_dF.data[100].z, h_dF.data[100].y, h_dF.data[100].x, are for interpolating derivative embedded
  function.
 
+ \b Threading
+ With TBB, the density and force passes run in parallel over the particles. With a half neighbor
+ list, each thread scatters into its own buffer and the buffers are summed in a fixed order.
+
  \ingroup computes
  */
 class EAMForceCompute : public ForceCompute
@@ -88,6 +94,12 @@ class EAMForceCompute : public ForceCompute
     GPUArray<Scalar4> m_drphi; //!< derivative pair wise function and its coefficients
     GPUArray<Scalar> m_dFdP;   //!< derivative F / derivative P
 
+    std::vector<unsigned int> m_chunk_begin; //!< First particle of every thread chunk
+    std::vector<std::vector<std::pair<unsigned int, Scalar>>>
+        m_density_spills; //!< Densities from chunk c to chunk d, at c * n_chunks + d
+    std::vector<std::vector<std::pair<unsigned int, Scalar4>>>
+        m_force_spills; //!< Forces from chunk c to chunk d, at c * n_chunks + d
+
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
 
@@ -10,6 +10,10 @@
 #include "hoomd/RNGIdentifiers.h"
 #include "hoomd/RandomNumbers.h"
 
+#ifdef ENABLE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 namespace hoomd
     {
 mpcd::ATCollisionMethod::ATCollisionMethod(std::shared_ptr<SystemDefinition> sysdef,
@@ -87,8 +91,8 @@ void mpcd::ATCollisionMethod::drawVelocities(uint64_t timestep)
 
     // random velocities are drawn for each particle and stored into the "alternate" arrays
     const Scalar T = (*m_T)(timestep);
-    for (unsigned int idx = 0; idx < N_tot; ++idx)
-        {
+    auto draw_particle = [&](unsigned int idx)
+    {
         unsigned int pidx;
         unsigned int tag;
         Scalar mass;
@@ -124,7 +128,15 @@ void mpcd::ATCollisionMethod::drawVelocities(uint64_t timestep)
             {
             h_alt_vel_embed->data[pidx] = make_scalar4(vel.x, vel.y, vel.z, mass);
             }
-        }
+    };
+
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&] { tbb::parallel_for((unsigned int)0, N_tot, draw_particle); });
+#else
+    for (unsigned int idx = 0; idx < N_tot; ++idx)
+        draw_particle(idx);
+#endif
     }
 
 void mpcd::ATCollisionMethod::applyVelocities()
@@ -168,8 +180,8 @@ void mpcd::ATCollisionMethod::applyVelocities()
                                     access_location::host,
                                     access_mode::read);
 
-    for (unsigned int idx = 0; idx < N_tot; ++idx)
-        {
+    auto apply_particle = [&](unsigned int idx)
+    {
         unsigned int cell, pidx;
         Scalar4 vel_rand;
         if (idx < N_mpcd)
@@ -203,7 +215,15 @@ void mpcd::ATCollisionMethod::applyVelocities()
             {
             h_vel_embed->data[pidx] = make_scalar4(vnew.x, vnew.y, vnew.z, vel_rand.w);
             }
-        }
+    };
+
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&] { tbb::parallel_for((unsigned int)0, N_tot, apply_particle); });
+#else
+    for (unsigned int idx = 0; idx < N_tot; ++idx)
+        apply_particle(idx);
+#endif
     }
 
 void mpcd::ATCollisionMethod::setCellList(std::shared_ptr<mpcd::CellList> cl)
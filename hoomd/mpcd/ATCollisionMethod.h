@@ -37,6 +37,12 @@ class PYBIND11_EXPORT ATCollisionMethod : public mpcd::CollisionMethod
 
     void setCellList(std::shared_ptr<mpcd::CellList> cl);
 
+    //! Get the cell properties used by the collision rule
+    virtual std::shared_ptr<mpcd::CellThermoCompute> getCellThermo() const
+        {
+        return m_thermo;
+        }
+
     //! Set the temperature and enable the thermostat
     void setTemperature(std::shared_ptr<Variant> T)
         {
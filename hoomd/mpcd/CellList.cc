@@ -8,6 +8,11 @@
 #include "hoomd/Communicator.h"
 #endif // ENABLE_MPI
 
+#ifdef ENABLE_TBB
+#include <algorithm>
+#include <tbb/parallel_for.h>
+#endif
+
 /*!
  * \file mpcd/CellList.cc
  * \brief Definition of mpcd::CellList
@@ -18,8 +23,8 @@ namespace hoomd
 mpcd::CellList::CellList(std::shared_ptr<SystemDefinition> sysdef)
     : Compute(sysdef), m_mpcd_pdata(m_sysdef->getMPCDParticleData()), m_cell_size(1.0),
       m_cell_np_max(4), m_cell_np(m_exec_conf), m_cell_list(m_exec_conf),
-      m_embed_cell_ids(m_exec_conf), m_conditions(m_exec_conf), m_needs_compute_dim(true),
-      m_particles_sorted(false), m_virtual_change(false)
+      m_embed_cell_ids(m_exec_conf), m_conditions(m_exec_conf), m_num_builds(0), m_swept(false),
+      m_needs_compute_dim(true), m_particles_sorted(false), m_virtual_change(false)
     {
     assert(m_mpcd_pdata);
     m_exec_conf->msg->notice(5) << "Constructing MPCD CellList" << std::endl;
@@ -79,6 +84,12 @@ void mpcd::CellList::compute(uint64_t timestep)
         m_force_compute = true;
         }
 
+    // a cell list built during streaming is only valid as long as the particles have not changed
+    if (m_swept && !m_mpcd_pdata->checkCellCache())
+        {
+        m_force_compute = true;
+        }
+
     if (peekCompute(timestep))
         {
 #ifdef ENABLE_MPI
@@ -119,12 +130,119 @@ void mpcd::CellList::compute(uint64_t timestep)
         m_first_compute = false;
         m_force_compute = false;
         m_last_computed = timestep;
+        ++m_num_builds;
+        m_swept = false;
 
         // signal to the ParticleData that the cell list cache is now valid
         m_mpcd_pdata->validateCellCache();
         }
     }
 
+/*!
+ * The dimensions of the cell list are computed first if needed.
+ *
+ * \returns Binning for the current cell dimensions and grid shift
+ */
+mpcd::detail::CellBinner mpcd::CellList::getBinner()
+    {
+    computeDimensions();
+
+    mpcd::detail::CellBinner binner;
+    binner.grid_shift = m_grid_shift;
+    binner.global_lo = m_pdata->getGlobalBox().getLo();
+    binner.cell_size = m_cell_size;
+    binner.periodic = m_pdata->getBox().getPeriodic();
+    binner.origin_idx = m_origin_idx;
+    binner.cell_dim = m_cell_dim;
+    binner.cell_indexer = m_cell_indexer;
+
+    // total effective number of cells in the global box, optionally padded by
+    // extra cells in MPI simulations
+    binner.n_global_cells = m_global_cell_dim;
+#ifdef ENABLE_MPI
+    if (isCommunicating(mpcd::detail::face::east))
+        binner.n_global_cells.x += 2 * m_num_extra;
+    if (isCommunicating(mpcd::detail::face::north))
+        binner.n_global_cells.y += 2 * m_num_extra;
+    if (isCommunicating(mpcd::detail::face::up))
+        binner.n_global_cells.z += 2 * m_num_extra;
+#endif // ENABLE_MPI
+
+    return binner;
+    }
+
+/*!
+ * \param timestep Timestep the cell list is built for
+ * \param runs Runs of MPCD particles in each chunk of the streaming sweep
+ *
+ * The runs must cover the MPCD particles in order, and the cell of each particle must already be
+ * cached in its velocity. There can be no virtual or embedded particles. The cell list is then
+ * identical to the one built by compute() and is marked as computed at \a timestep.
+ */
+void mpcd::CellList::buildFromRuns(uint64_t timestep,
+                                   const std::vector<std::vector<mpcd::detail::CellRun>>& runs)
+    {
+    assert(!m_embed_group && m_mpcd_pdata->getNVirtual() == 0);
+    computeDimensions();
+
+        {
+        // count the particles in each cell first so that the cell list can be sized
+        ArrayHandle<unsigned int> h_cell_np(m_cell_np,
+                                            access_location::host,
+                                            access_mode::overwrite);
+        memset(h_cell_np.data, 0, sizeof(unsigned int) * m_cell_indexer.getNumElements());
+        for (const auto& chunk : runs)
+            {
+            for (const auto& run : chunk)
+                {
+                h_cell_np.data[run.cell] += run.count;
+                }
+            }
+
+        unsigned int np_max = 0;
+        for (unsigned int cur_cell = 0; cur_cell < m_cell_indexer.getNumElements(); ++cur_cell)
+            {
+            np_max = std::max(np_max, h_cell_np.data[cur_cell]);
+            }
+        if (np_max > m_cell_np_max)
+            {
+            m_cell_np_max = np_max;
+            reallocate();
+            }
+        }
+
+    // fill the cell list in particle order
+    ArrayHandle<unsigned int> h_cell_list(m_cell_list,
+                                          access_location::host,
+                                          access_mode::overwrite);
+    ArrayHandle<unsigned int> h_cell_np(m_cell_np, access_location::host, access_mode::overwrite);
+    memset(h_cell_np.data, 0, sizeof(unsigned int) * m_cell_indexer.getNumElements());
+    for (const auto& chunk : runs)
+        {
+        for (const auto& run : chunk)
+            {
+            unsigned int offset = h_cell_np.data[run.cell];
+            for (unsigned int cur_p = run.first; cur_p < run.first + run.count; ++cur_p)
+                {
+                h_cell_list.data[m_cell_list_indexer(offset++, run.cell)] = cur_p;
+                }
+            h_cell_np.data[run.cell] = offset;
+            }
+        }
+
+    // this build accounts for any changes flagged so far
+    m_virtual_change = false;
+    m_particles_sorted = false;
+
+    m_first_compute = false;
+    m_force_compute = false;
+    m_last_computed = timestep;
+    ++m_num_builds;
+    m_swept = true;
+
+    m_mpcd_pdata->validateCellCache();
+    }
+
 void mpcd::CellList::reallocate()
     {
     m_exec_conf->msg->notice(6) << "Allocating MPCD cell list, " << m_cell_np_max
@@ -519,12 +637,16 @@ bool mpcd::CellList::isCommunicating(mpcd::detail::face dir)
 
 /*!
  * \param timestep Current simulation timestep
+ *
+ * With multiple threads, the particles are split into contiguous chunks. Each chunk counts how
+ * many of its particles fall into each cell, a prefix sum over the chunks gives the offset of each
+ * chunk within each cell, and each chunk then writes its particles into the cell list. The
+ * particles in a cell are stored in index order, so the result is the same as a serial build.
+ * The number of chunks is at most 4 N / n_cells, so the counts and their scan take O(N) memory and
+ * work. Sparse systems with less than half a particle per cell are built serially.
  */
 void mpcd::CellList::buildCellList()
     {
-    const BoxDim& box = m_pdata->getBox();
-    const uchar3 periodic = box.getPeriodic();
-
     ArrayHandle<unsigned int> h_cell_list(m_cell_list,
                                           access_location::host,
                                           access_mode::overwrite);
@@ -561,22 +683,11 @@ void mpcd::CellList::buildCellList()
         N_tot += m_embed_group->getNumMembers();
         }
 
-    // total effective number of cells in the global box, optionally padded by
-    // extra cells in MPI simulations
-    uint3 n_global_cells = m_global_cell_dim;
-#ifdef ENABLE_MPI
-    if (isCommunicating(mpcd::detail::face::east))
-        n_global_cells.x += 2 * m_num_extra;
-    if (isCommunicating(mpcd::detail::face::north))
-        n_global_cells.y += 2 * m_num_extra;
-    if (isCommunicating(mpcd::detail::face::up))
-        n_global_cells.z += 2 * m_num_extra;
-#endif // ENABLE_MPI
+    const mpcd::detail::CellBinner binner = getBinner();
 
-    const Scalar3 global_lo = m_pdata->getGlobalBox().getLo();
-
-    for (unsigned int cur_p = 0; cur_p < N_tot; ++cur_p)
-        {
+    // bin a particle, and stash its bin into the velocity array if it could be binned
+    auto bin_particle = [&](unsigned int cur_p, unsigned int& bin_idx)
+    {
         Scalar4 postype_i;
         if (cur_p < N_mpcd)
             {
@@ -588,57 +699,153 @@ void mpcd::CellList::buildCellList()
             }
         Scalar3 pos_i = make_scalar3(postype_i.x, postype_i.y, postype_i.z);
 
-        if (std::isnan(pos_i.x) || std::isnan(pos_i.y) || std::isnan(pos_i.z))
+        const unsigned int status = binner(pos_i, bin_idx);
+        if (status == 0)
             {
-            conditions.y = cur_p + 1;
-            continue;
+            if (cur_p < N_mpcd)
+                {
+                h_vel.data[cur_p].w = __int_as_scalar(bin_idx);
+                }
+            else
+                {
+                h_embed_cell_ids->data[cur_p - N_mpcd] = bin_idx;
+                }
             }
+        return status;
+    };
+
+#ifdef ENABLE_TBB
+    // the per-chunk counts hold n_chunks * n_cells entries and the scan visits all of them, so the
+    // number of chunks is limited to keep both proportional to the number of particles
+    const unsigned int n_cells = m_cell_indexer.getNumElements();
+    const unsigned int max_chunks
+        = (unsigned int)std::max(size_t(1), size_t(4) * N_tot / std::max(n_cells, 1u));
+    const unsigned int n_chunks = std::min({m_exec_conf->getNumThreads(), N_tot, max_chunks});
+    if (n_chunks > 1)
+        {
+        m_chunk_bins.resize(N_tot);
+
+        // the counts are all zero between calls, so only new entries need to be cleared
+        if (m_chunk_counts.size() < size_t(n_chunks) * n_cells)
+            m_chunk_counts.resize(size_t(n_chunks) * n_cells, 0);
+        std::vector<uint3> chunk_conditions(n_chunks, make_uint3(0, 0, 0));
+        auto chunk_begin = [&](unsigned int chunk)
+        { return (unsigned int)(size_t(N_tot) * chunk / n_chunks); };
+
+        // count the particles in each cell for one chunk
+        auto count_chunk = [&](unsigned int chunk)
+        {
+            unsigned int* counts = m_chunk_counts.data() + size_t(chunk) * n_cells;
+            uint3& chunk_cond = chunk_conditions[chunk];
+            const unsigned int last = chunk_begin(chunk + 1);
+            for (unsigned int cur_p = chunk_begin(chunk); cur_p < last; ++cur_p)
+                {
+                unsigned int bin_idx = 0;
+                const unsigned int status = bin_particle(cur_p, bin_idx);
+                if (status == 1)
+                    {
+                    chunk_cond.y = cur_p + 1;
+                    bin_idx = mpcd::detail::NO_CELL;
+                    }
+                else if (status == 2)
+                    {
+                    chunk_cond.z = cur_p + 1;
+                    bin_idx = mpcd::detail::NO_CELL;
+                    }
+                else
+                    {
+                    ++counts[bin_idx];
+                    }
+                m_chunk_bins[cur_p] = bin_idx;
+                }
+        };
+
+        // turn the counts for one cell into the offset of each chunk, leaving the entries of
+        // chunks without particles in the cell zero
+        auto scan_cell = [&](unsigned int cell)
+        {
+            unsigned int np = 0;
+            for (unsigned int chunk = 0; chunk < n_chunks; ++chunk)
+                {
+                unsigned int& count = m_chunk_counts[size_t(chunk) * n_cells + cell];
+                const unsigned int chunk_np = count;
+                if (chunk_np != 0)
+                    {
+                    count = np;
+                    np += chunk_np;
+                    }
+                }
+            h_cell_np.data[cell] = np;
+        };
+
+        // write the particles of one chunk into the cell list
+        auto fill_chunk = [&](unsigned int chunk)
+        {
+            unsigned int* offsets = m_chunk_counts.data() + size_t(chunk) * n_cells;
+            uint3& chunk_cond = chunk_conditions[chunk];
+            const unsigned int last = chunk_begin(chunk + 1);
+            for (unsigned int cur_p = chunk_begin(chunk); cur_p < last; ++cur_p)
+                {
+                const unsigned int bin_idx = m_chunk_bins[cur_p];
+                if (bin_idx == mpcd::detail::NO_CELL)
+                    continue;
 
-        // bin particle assuming orthorhombic box (already validated)
-        const Scalar3 delta = (pos_i - m_grid_shift) - global_lo;
-        int3 global_bin = make_int3((int)std::floor(delta.x / m_cell_size),
-                                    (int)std::floor(delta.y / m_cell_size),
-                                    (int)std::floor(delta.z / m_cell_size));
+                const unsigned int offset = offsets[bin_idx]++;
+                if (offset < m_cell_np_max)
+                    {
+                    h_cell_list.data[m_cell_list_indexer(offset, bin_idx)] = cur_p;
+                    }
+                else
+                    {
+                    // overflow
+                    chunk_cond.x = std::max(chunk_cond.x, offset + 1);
+                    }
+                }
+
+            // clear the entries this chunk used for the next call
+            for (unsigned int cur_p = chunk_begin(chunk); cur_p < last; ++cur_p)
+                {
+                const unsigned int bin_idx = m_chunk_bins[cur_p];
+                if (bin_idx != mpcd::detail::NO_CELL)
+                    offsets[bin_idx] = 0;
+                }
+        };
 
-        // wrap cell back through the boundaries (grid shifting may send +/- 1 outside of range)
-        // this is done using periodic from the "local" box, since this will be periodic
-        // only when there is one rank along the dimension
-        if (periodic.x)
+        m_exec_conf->getTaskArena()->execute(
+            [&]
             {
-            if (global_bin.x == (int)n_global_cells.x)
-                global_bin.x = 0;
-            else if (global_bin.x == -1)
-                global_bin.x = n_global_cells.x - 1;
-            }
-        if (periodic.y)
+                tbb::parallel_for((unsigned int)0, n_chunks, count_chunk);
+                tbb::parallel_for((unsigned int)0, n_cells, scan_cell);
+                tbb::parallel_for((unsigned int)0, n_chunks, fill_chunk);
+            });
+
+        // the last particle to fail is reported, like in the serial build
+        for (const uint3& chunk_cond : chunk_conditions)
             {
-            if (global_bin.y == (int)n_global_cells.y)
-                global_bin.y = 0;
-            else if (global_bin.y == -1)
-                global_bin.y = n_global_cells.y - 1;
+            conditions.x = std::max(conditions.x, chunk_cond.x);
+            conditions.y = std::max(conditions.y, chunk_cond.y);
+            conditions.z = std::max(conditions.z, chunk_cond.z);
             }
-        if (periodic.z)
+        m_conditions.resetFlags(conditions);
+        return;
+        }
+#endif // ENABLE_TBB
+
+    for (unsigned int cur_p = 0; cur_p < N_tot; ++cur_p)
+        {
+        unsigned int bin_idx = 0;
+        const unsigned int status = bin_particle(cur_p, bin_idx);
+        if (status == 1)
             {
-            if (global_bin.z == (int)n_global_cells.z)
-                global_bin.z = 0;
-            else if (global_bin.z == -1)
-                global_bin.z = n_global_cells.z - 1;
+            conditions.y = cur_p + 1;
+            continue;
             }
-
-        // compute the local cell
-        int3 bin = make_int3(global_bin.x - m_origin_idx.x,
-                             global_bin.y - m_origin_idx.y,
-                             global_bin.z - m_origin_idx.z);
-
-        // validate and make sure no particles blew out of the box
-        if ((bin.x < 0 || bin.x >= (int)m_cell_dim.x) || (bin.y < 0 || bin.y >= (int)m_cell_dim.y)
-            || (bin.z < 0 || bin.z >= (int)m_cell_dim.z))
+        else if (status == 2)
             {
             conditions.z = cur_p + 1;
             continue;
             }
 
-        unsigned int bin_idx = m_cell_indexer(bin.x, bin.y, bin.z);
         unsigned int offset = h_cell_np.data[bin_idx];
         if (offset < m_cell_np_max)
             {
@@ -650,16 +857,6 @@ void mpcd::CellList::buildCellList()
             conditions.x = std::max(conditions.x, offset + 1);
             }
 
-        // stash the current particle bin into the velocity array
-        if (cur_p < N_mpcd)
-            {
-            h_vel.data[cur_p].w = __int_as_scalar(bin_idx);
-            }
-        else
-            {
-            h_embed_cell_ids->data[cur_p - N_mpcd] = bin_idx;
-            }
-
         // increment the counter always
         ++h_cell_np.data[bin_idx];
         }
@@ -698,8 +895,8 @@ void mpcd::CellList::sort(uint64_t timestep,
                                           access_mode::readwrite);
     const unsigned int N_mpcd = m_mpcd_pdata->getN();
 
-    for (unsigned int idx = 0; idx < getNCells(); ++idx)
-        {
+    auto sort_cell = [&](unsigned int idx)
+    {
         const unsigned int np = h_cell_np.data[idx];
         for (unsigned int offset = 0; offset < np; ++offset)
             {
@@ -711,7 +908,15 @@ void mpcd::CellList::sort(uint64_t timestep,
                 h_cell_list.data[cl_idx] = h_rorder.data[pid];
                 }
             }
-        }
+    };
+
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&] { tbb::parallel_for((unsigned int)0, getNCells(), sort_cell); });
+#else
+    for (unsigned int idx = 0; idx < getNCells(); ++idx)
+        sort_cell(idx);
+#endif
     }
 
 #ifdef ENABLE_MPI
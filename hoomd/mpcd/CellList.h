@@ -24,11 +24,100 @@
 #include <pybind11/pybind11.h>
 
 #include <array>
+#include <vector>
 
 namespace hoomd
     {
 namespace mpcd
     {
+namespace detail
+    {
+//! Consecutive MPCD particles that lie in the same cell
+/*!
+ * Runs are accumulated while streaming when the cell list is built in the same sweep as the
+ * streaming step (see mpcd::CellList::buildFromRuns). Runs store the sums needed for the cell
+ * properties so that the particle data does not need to be read again.
+ */
+struct CellRun
+    {
+    unsigned int cell;  //!< Local cell index
+    unsigned int first; //!< Index of the first particle
+    unsigned int count; //!< Number of particles
+    double4 momentum;   //!< Momentum (x,y,z) and mass (w) of the particles
+    double ke;          //!< Kinetic energy of the particles
+    };
+
+//! Bins positions into the local cells of a mpcd::CellList
+struct CellBinner
+    {
+    //! Find the local cell of a position
+    /*!
+     * \param pos Particle position
+     * \param cell Local cell index (output)
+     * \returns 0 if the particle was binned, 1 if the position is NaN, and 2 if the particle
+     *          lies outside of the cells
+     */
+    inline unsigned int operator()(const Scalar3& pos, unsigned int& cell) const
+        {
+        if (std::isnan(pos.x) || std::isnan(pos.y) || std::isnan(pos.z))
+            return 1;
+
+        // bin particle assuming orthorhombic box (already validated)
+        const Scalar3 delta = (pos - grid_shift) - global_lo;
+        int3 global_bin = make_int3((int)std::floor(delta.x / cell_size),
+                                    (int)std::floor(delta.y / cell_size),
+                                    (int)std::floor(delta.z / cell_size));
+
+        // wrap cell back through the boundaries (grid shifting may send +/- 1 outside of range)
+        // this is done using periodic from the "local" box, since this will be periodic
+        // only when there is one rank along the dimension
+        if (periodic.x)
+            {
+            if (global_bin.x == (int)n_global_cells.x)
+                global_bin.x = 0;
+            else if (global_bin.x == -1)
+                global_bin.x = n_global_cells.x - 1;
+            }
+        if (periodic.y)
+            {
+            if (global_bin.y == (int)n_global_cells.y)
+                global_bin.y = 0;
+            else if (global_bin.y == -1)
+                global_bin.y = n_global_cells.y - 1;
+            }
+        if (periodic.z)
+            {
+            if (global_bin.z == (int)n_global_cells.z)
+                global_bin.z = 0;
+            else if (global_bin.z == -1)
+                global_bin.z = n_global_cells.z - 1;
+            }
+
+        // compute the local cell
+        int3 bin = make_int3(global_bin.x - origin_idx.x,
+                             global_bin.y - origin_idx.y,
+                             global_bin.z - origin_idx.z);
+
+        // validate and make sure no particles blew out of the box
+        if ((bin.x < 0 || bin.x >= (int)cell_dim.x) || (bin.y < 0 || bin.y >= (int)cell_dim.y)
+            || (bin.z < 0 || bin.z >= (int)cell_dim.z))
+            return 2;
+
+        cell = cell_indexer(bin.x, bin.y, bin.z);
+        return 0;
+        }
+
+    Scalar3 grid_shift;   //!< Grid shift
+    Scalar3 global_lo;    //!< Lower corner of the global box
+    Scalar cell_size;     //!< Cell width
+    uint3 n_global_cells; //!< Number of global cells, padded in MPI simulations
+    uchar3 periodic;      //!< Periodicity of the local box
+    int3 origin_idx;      //!< Origin as a global index
+    uint3 cell_dim;       //!< Number of local cells in each direction
+    Index3D cell_indexer; //!< Indexer of the local cells
+    };
+    } // end namespace detail
+
 //! Computes the MPCD cell list on the CPU
 class PYBIND11_EXPORT CellList : public Compute
     {
@@ -45,6 +134,19 @@ class PYBIND11_EXPORT CellList : public Compute
     //! Sizes the cell list based on the box
     void computeDimensions();
 
+    //! Get the binning of the cell list with the current dimensions and grid shift
+    mpcd::detail::CellBinner getBinner();
+
+    //! Build the cell list from the runs accumulated during a streaming sweep
+    void buildFromRuns(uint64_t timestep,
+                       const std::vector<std::vector<mpcd::detail::CellRun>>& runs);
+
+    //! Get the number of times the cell list has been built
+    uint64_t getNumBuilds() const
+        {
+        return m_num_builds;
+        }
+
     //! Get the cell list data
     const GPUArray<unsigned int>& getCellList() const
         {
@@ -263,6 +365,14 @@ class PYBIND11_EXPORT CellList : public Compute
 
     int3 m_origin_idx; //!< Origin as a global index
 
+    uint64_t m_num_builds; //!< Number of times the cell list has been built
+    bool m_swept;          //!< True if the cell list was last built from a streaming sweep
+
+#ifdef ENABLE_TBB
+    std::vector<unsigned int> m_chunk_bins;   //!< Cell of each particle in a threaded build
+    std::vector<unsigned int> m_chunk_counts; //!< Per-chunk cell counts, zero between builds
+#endif // ENABLE_TBB
+
 #ifdef ENABLE_MPI
     unsigned int m_num_extra;               //!< Number of extra cells to communicate over
     std::array<unsigned int, 6> m_num_comm; //!< Number of cells to communicate on each face
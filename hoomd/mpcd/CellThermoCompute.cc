@@ -9,6 +9,10 @@
 #include "CellThermoCompute.h"
 #include "ReductionOperators.h"
 
+#ifdef ENABLE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 namespace hoomd
     {
 /*!
@@ -18,7 +22,7 @@ mpcd::CellThermoCompute::CellThermoCompute(std::shared_ptr<SystemDefinition> sys
                                            std::shared_ptr<mpcd::CellList> cl)
     : Compute(sysdef), m_mpcd_pdata(m_sysdef->getMPCDParticleData()), m_cl(cl),
       m_needs_net_reduce(true), m_cell_vel(m_exec_conf), m_cell_energy(m_exec_conf),
-      m_ncells_alloc(0)
+      m_ncells_alloc(0), m_swept(false), m_swept_builds(0), m_callbacks_deferred(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing MPCD CellThermoCompute" << std::endl;
 
@@ -53,11 +57,33 @@ mpcd::CellThermoCompute::~CellThermoCompute()
 void mpcd::CellThermoCompute::compute(uint64_t timestep)
     {
     Compute::compute(timestep);
+
+    // properties from a streaming sweep are only valid if the cell list has not been rebuilt since
+    if (m_swept)
+        {
+        m_cl->compute(timestep);
+        if (m_cl->getNumBuilds() != m_swept_builds)
+            {
+            m_force_compute = true;
+            }
+        }
+
     // check if computation should proceed, and always mark the calculation as occurring at this
     // timestep, even if forced
     if (!shouldCompute(timestep))
+        {
+        // callbacks are made now so that they see the particle data at this timestep
+        if (m_callbacks_deferred)
+            {
+            m_callbacks_deferred = false;
+            if (!m_callbacks.empty())
+                m_callbacks.emit(timestep);
+            }
         return;
+        }
     m_last_computed = timestep;
+    m_swept = false;
+    m_callbacks_deferred = false;
 
     // cell list needs to be up to date first
     m_cl->compute(timestep);
@@ -75,6 +101,101 @@ void mpcd::CellThermoCompute::compute(uint64_t timestep)
     m_needs_net_reduce = true;
     }
 
+/*!
+ * \param timestep Timestep the properties are computed for
+ * \param runs Runs of MPCD particles in each chunk of the streaming sweep
+ *
+ * The cell list must have been built from the same \a runs. The sums of the runs are added to
+ * their cells in order, so the properties are the same as from compute() up to round off when a
+ * cell is split between runs. The properties are marked as computed at \a timestep, but the
+ * callbacks are deferred to the call to compute() at \a timestep so that they see the particle
+ * data at that time.
+ */
+void mpcd::CellThermoCompute::computeFromRuns(
+    uint64_t timestep,
+    const std::vector<std::vector<mpcd::detail::CellRun>>& runs)
+    {
+#ifdef ENABLE_MPI
+    assert(!m_use_mpi);
+#endif // ENABLE_MPI
+    updateFlags();
+
+    const unsigned int ncells = m_cl->getNCells();
+    if (ncells != m_ncells_alloc)
+        {
+        reallocate(ncells);
+        }
+
+    ArrayHandle<unsigned int> h_cell_np(m_cl->getCellSizeArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<double4> h_cell_vel(m_cell_vel, access_location::host, access_mode::overwrite);
+    ArrayHandle<double3> h_cell_energy(m_cell_energy,
+                                       access_location::host,
+                                       access_mode::overwrite);
+    const bool need_energy = m_flags[mpcd::detail::thermo_options::energy];
+
+    // sum the momentum and kinetic energy into the cells
+    memset(h_cell_vel.data, 0, sizeof(double4) * ncells);
+    if (need_energy)
+        {
+        memset(h_cell_energy.data, 0, sizeof(double3) * ncells);
+        }
+    for (const auto& chunk : runs)
+        {
+        for (const auto& run : chunk)
+            {
+            double4& momentum = h_cell_vel.data[run.cell];
+            momentum.x += run.momentum.x;
+            momentum.y += run.momentum.y;
+            momentum.z += run.momentum.z;
+            momentum.w += run.momentum.w;
+
+            if (need_energy)
+                h_cell_energy.data[run.cell].x += run.ke;
+            }
+        }
+
+    // normalize the sums into the cell properties
+    for (unsigned int cur_cell = 0; cur_cell < ncells; ++cur_cell)
+        {
+        const double4 momentum = h_cell_vel.data[cur_cell];
+        const double mass = momentum.w;
+        double3 vel_cm = make_double3(0.0, 0.0, 0.0);
+        if (mass > 0.)
+            {
+            vel_cm.x = momentum.x / mass;
+            vel_cm.y = momentum.y / mass;
+            vel_cm.z = momentum.z / mass;
+            }
+
+        h_cell_vel.data[cur_cell] = make_double4(vel_cm.x, vel_cm.y, vel_cm.z, mass);
+        if (need_energy)
+            {
+            const unsigned int np = h_cell_np.data[cur_cell];
+            const double ke = h_cell_energy.data[cur_cell].x;
+            double temp(0.0);
+            if (np > 1)
+                {
+                const double ke_cm
+                    = 0.5 * mass
+                      * (vel_cm.x * vel_cm.x + vel_cm.y * vel_cm.y + vel_cm.z * vel_cm.z);
+                temp = 2. * (ke - ke_cm) / (m_sysdef->getNDimensions() * (np - 1));
+                }
+            h_cell_energy.data[cur_cell] = make_double3(ke, temp, __int_as_double(np));
+            }
+        }
+
+    m_needs_net_reduce = true;
+
+    m_first_compute = false;
+    m_force_compute = false;
+    m_last_computed = timestep;
+    m_swept = true;
+    m_swept_builds = m_cl->getNumBuilds();
+    m_callbacks_deferred = true;
+    }
+
 void mpcd::CellThermoCompute::computeCellProperties(uint64_t timestep)
     {
 /*
@@ -169,7 +290,7 @@ struct CellPropertySum
                         double& ke,
                         unsigned int& np,
                         const unsigned int cell,
-                        const bool energy)
+                        const bool energy) const
         {
         momentum = make_double4(0.0, 0.0, 0.0, 0.0);
         ke = 0.0;
@@ -272,8 +393,8 @@ void mpcd::CellThermoCompute::beginOuterCellProperties()
 
     // Loop over all outer cells and compute total momentum, mass, energy
     const bool need_energy = m_flags[mpcd::detail::thermo_options::energy];
-    for (unsigned int idx = 0; idx < m_vel_comm->getNCells(); ++idx)
-        {
+    auto sum_cell = [&](unsigned int idx)
+    {
         const unsigned int cur_cell = h_cells.data[idx];
 
         // compute the cell properties
@@ -285,7 +406,15 @@ void mpcd::CellThermoCompute::beginOuterCellProperties()
         h_cell_vel.data[cur_cell] = make_double4(momentum.x, momentum.y, momentum.z, momentum.w);
         if (need_energy)
             h_cell_energy.data[cur_cell] = make_double3(ke, 0.0, __int_as_double(np));
-        }
+    };
+
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&] { tbb::parallel_for((unsigned int)0, m_vel_comm->getNCells(), sum_cell); });
+#else
+    for (unsigned int idx = 0; idx < m_vel_comm->getNCells(); ++idx)
+        sum_cell(idx);
+#endif
     }
 
 void mpcd::CellThermoCompute::finishOuterCellProperties()
@@ -300,8 +429,8 @@ void mpcd::CellThermoCompute::finishOuterCellProperties()
 
     // Loop over all outer cells and normalize the summed quantities
     const bool need_energy = m_flags[mpcd::detail::thermo_options::energy];
-    for (unsigned int idx = 0; idx < m_vel_comm->getNCells(); ++idx)
-        {
+    auto normalize_cell = [&](unsigned int idx)
+    {
         const unsigned int cur_cell = h_cells.data[idx];
 
         // average cell properties if the cell has mass
@@ -334,7 +463,15 @@ void mpcd::CellThermoCompute::finishOuterCellProperties()
                 }
             h_cell_energy.data[cur_cell] = make_double3(ke, temp, __int_as_double(np));
             }
-        }
+    };
+
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&] { tbb::parallel_for((unsigned int)0, m_vel_comm->getNCells(), normalize_cell); });
+#else
+    for (unsigned int idx = 0; idx < m_vel_comm->getNCells(); ++idx)
+        normalize_cell(idx);
+#endif
     }
 #endif // ENABLE_MPI
 
@@ -409,45 +546,55 @@ void mpcd::CellThermoCompute::calcInnerCellProperties()
 
     // iterate over all of the inner cells and compute average velocity, energy, temperature
     const bool need_energy = m_flags[mpcd::detail::thermo_options::energy];
-    for (unsigned int k = lo.z; k < hi.z; ++k)
-        {
-        for (unsigned int j = lo.y; j < hi.y; ++j)
+    const uint3 n_inner = make_uint3(hi.x - lo.x, hi.y - lo.y, hi.z - lo.z);
+    auto compute_row = [&](unsigned int row)
+    {
+        const unsigned int j = lo.y + row % n_inner.y;
+        const unsigned int k = lo.z + row / n_inner.y;
+        for (unsigned int i = lo.x; i < hi.x; ++i)
             {
-            for (unsigned int i = lo.x; i < hi.x; ++i)
-                {
-                const unsigned int cur_cell = ci(i, j, k);
+            const unsigned int cur_cell = ci(i, j, k);
 
-                // compute the cell properties
-                double4 momentum;
-                double ke(0.0);
-                unsigned int np(0);
-                summer.compute(momentum, ke, np, cur_cell, need_energy);
+            // compute the cell properties
+            double4 momentum;
+            double ke(0.0);
+            unsigned int np(0);
+            summer.compute(momentum, ke, np, cur_cell, need_energy);
 
-                const double mass = momentum.w;
-                double3 vel_cm = make_double3(0.0, 0.0, 0.0);
-                if (mass > 0.)
-                    {
-                    vel_cm.x = momentum.x / mass;
-                    vel_cm.y = momentum.y / mass;
-                    vel_cm.z = momentum.z / mass;
-                    }
+            const double mass = momentum.w;
+            double3 vel_cm = make_double3(0.0, 0.0, 0.0);
+            if (mass > 0.)
+                {
+                vel_cm.x = momentum.x / mass;
+                vel_cm.y = momentum.y / mass;
+                vel_cm.z = momentum.z / mass;
+                }
 
-                h_cell_vel.data[cur_cell] = make_double4(vel_cm.x, vel_cm.y, vel_cm.z, mass);
-                if (need_energy)
+            h_cell_vel.data[cur_cell] = make_double4(vel_cm.x, vel_cm.y, vel_cm.z, mass);
+            if (need_energy)
+                {
+                double temp(0.0);
+                if (np > 1)
                     {
-                    double temp(0.0);
-                    if (np > 1)
-                        {
-                        const double ke_cm
-                            = 0.5 * mass
-                              * (vel_cm.x * vel_cm.x + vel_cm.y * vel_cm.y + vel_cm.z * vel_cm.z);
-                        temp = 2. * (ke - ke_cm) / (m_sysdef->getNDimensions() * (np - 1));
-                        }
-                    h_cell_energy.data[cur_cell] = make_double3(ke, temp, __int_as_double(np));
+                    const double ke_cm
+                        = 0.5 * mass
+                          * (vel_cm.x * vel_cm.x + vel_cm.y * vel_cm.y + vel_cm.z * vel_cm.z);
+                    temp = 2. * (ke - ke_cm) / (m_sysdef->getNDimensions() * (np - 1));
                     }
-                } // i
-            } // j
-        } // k
+                h_cell_energy.data[cur_cell] = make_double3(ke, temp, __int_as_double(np));
+                }
+            }
+    };
+
+    // each row of cells along x is independent, so the rows are threaded
+    const unsigned int n_rows = n_inner.y * n_inner.z;
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&] { tbb::parallel_for((unsigned int)0, n_rows, compute_row); });
+#else
+    for (unsigned int row = 0; row < n_rows; ++row)
+        compute_row(row);
+#endif
     }
 
 void mpcd::CellThermoCompute::computeNetProperties()
@@ -473,12 +620,20 @@ void mpcd::CellThermoCompute::computeNetProperties()
 
         const bool need_energy = m_flags[mpcd::detail::thermo_options::energy];
 
-        double3 net_momentum = make_double3(0, 0, 0);
-        double energy(0.0), temp(0.0);
-        for (unsigned int k = 0; k < upper.z; ++k)
+        // partial sums over a contiguous range of rows of cells along x
+        struct NetSum
             {
-            for (unsigned int j = 0; j < upper.y; ++j)
+            double3 momentum = make_double3(0, 0, 0);
+            double energy = 0.0;
+            double temp = 0.0;
+            unsigned int n_temp_cells = 0;
+            };
+        auto sum_rows = [&](NetSum& sum, unsigned int first_row, unsigned int last_row)
+        {
+            for (unsigned int row = first_row; row < last_row; ++row)
                 {
+                const unsigned int j = row % upper.y;
+                const unsigned int k = row / upper.y;
                 for (unsigned int i = 0; i < upper.x; ++i)
                     {
                     const unsigned int idx = ci(i, j, k);
@@ -488,34 +643,72 @@ void mpcd::CellThermoCompute::computeNetProperties()
                         = make_double3(cell_vel_mass.x, cell_vel_mass.y, cell_vel_mass.z);
                     const double cell_mass = cell_vel_mass.w;
 
-                    net_momentum.x += cell_mass * cell_vel.x;
-                    net_momentum.y += cell_mass * cell_vel.y;
-                    net_momentum.z += cell_mass * cell_vel.z;
+                    sum.momentum.x += cell_mass * cell_vel.x;
+                    sum.momentum.y += cell_mass * cell_vel.y;
+                    sum.momentum.z += cell_mass * cell_vel.z;
 
                     if (need_energy)
                         {
                         const double3 cell_energy = h_cell_energy.data[idx];
-                        energy += cell_energy.x;
+                        sum.energy += cell_energy.x;
 
                         if (__double_as_int(cell_energy.z) > 1)
                             {
-                            temp += cell_energy.y;
-                            ++n_temp_cells;
+                            sum.temp += cell_energy.y;
+                            ++sum.n_temp_cells;
                             }
                         }
                     }
                 }
+        };
+
+        const unsigned int n_rows = upper.y * upper.z;
+        NetSum net;
+#ifdef ENABLE_TBB
+        // each thread sums a fixed block of rows, and the blocks are merged in order so that the
+        // result does not depend on the scheduling
+        const unsigned int n_chunks = std::min(m_exec_conf->getNumThreads(), n_rows);
+        if (n_chunks > 1)
+            {
+            std::vector<NetSum> chunk_sums(n_chunks);
+            m_exec_conf->getTaskArena()->execute(
+                [&]
+                {
+                    tbb::parallel_for((unsigned int)0,
+                                      n_chunks,
+                                      [&](unsigned int chunk)
+                                      {
+                                          sum_rows(chunk_sums[chunk],
+                                                   (chunk * n_rows) / n_chunks,
+                                                   ((chunk + 1) * n_rows) / n_chunks);
+                                      });
+                });
+            for (const NetSum& sum : chunk_sums)
+                {
+                net.momentum.x += sum.momentum.x;
+                net.momentum.y += sum.momentum.y;
+                net.momentum.z += sum.momentum.z;
+                net.energy += sum.energy;
+                net.temp += sum.temp;
+                net.n_temp_cells += sum.n_temp_cells;
+                }
+            }
+        else
+#endif // ENABLE_TBB
+            {
+            sum_rows(net, 0, n_rows);
             }
+        n_temp_cells = net.n_temp_cells;
 
         ArrayHandle<double> h_net_properties(m_net_properties,
                                              access_location::host,
                                              access_mode::overwrite);
-        h_net_properties.data[mpcd::detail::thermo_index::momentum_x] = net_momentum.x;
-        h_net_properties.data[mpcd::detail::thermo_index::momentum_y] = net_momentum.y;
-        h_net_properties.data[mpcd::detail::thermo_index::momentum_z] = net_momentum.z;
+        h_net_properties.data[mpcd::detail::thermo_index::momentum_x] = net.momentum.x;
+        h_net_properties.data[mpcd::detail::thermo_index::momentum_y] = net.momentum.y;
+        h_net_properties.data[mpcd::detail::thermo_index::momentum_z] = net.momentum.z;
 
-        h_net_properties.data[mpcd::detail::thermo_index::energy] = energy;
-        h_net_properties.data[mpcd::detail::thermo_index::temperature] = temp;
+        h_net_properties.data[mpcd::detail::thermo_index::energy] = net.energy;
+        h_net_properties.data[mpcd::detail::thermo_index::temperature] = net.temp;
         }
 
 #ifdef ENABLE_MPI
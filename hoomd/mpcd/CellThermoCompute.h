@@ -41,6 +41,10 @@ class PYBIND11_EXPORT CellThermoCompute : public Compute
     //! Compute the cell thermodynamic properties
     void compute(uint64_t timestep);
 
+    //! Compute the cell properties from the runs accumulated during a streaming sweep
+    void computeFromRuns(uint64_t timestep,
+                         const std::vector<std::vector<mpcd::detail::CellRun>>& runs);
+
     //! Get the cell indexer for the attached cell list
     const Index3D& getCellIndexer() const
         {
@@ -177,6 +181,10 @@ class PYBIND11_EXPORT CellThermoCompute : public Compute
     Nano::Signal<void(uint64_t timestep)> m_callbacks; //!< Signal for callback functions
 
     private:
+    bool m_swept;              //!< True if the properties were last computed from a streaming sweep
+    uint64_t m_swept_builds;   //!< Number of cell list builds at the time of the sweep
+    bool m_callbacks_deferred; //!< True if the callbacks have not been called for the sweep
+
     //! Allocate memory per cell
     void reallocate(unsigned int ncells);
 
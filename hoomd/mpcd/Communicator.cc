@@ -30,7 +30,8 @@ mpcd::Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef)
       m_mpcd_pdata(m_sysdef->getMPCDParticleData()), m_mpi_comm(m_exec_conf->getMPICommunicator()),
       m_decomposition(m_pdata->getDomainDecomposition()), m_is_communicating(false),
       m_check_decomposition(true), m_nneigh(0), m_n_unique_neigh(0), m_sendbuf(m_exec_conf),
-      m_recvbuf(m_exec_conf), m_force_migrate(false)
+      m_recvbuf(m_exec_conf), m_migrate_pending(false), m_migrate_timestep(0),
+      m_has_migrated(false), m_migrated_timestep(0), m_force_migrate(false)
     {
     // initialize array of neighbor processor ids
     assert(m_mpi_comm);
@@ -66,6 +67,10 @@ mpcd::Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef)
     MPI_Type_commit(&m_pdata_element);
     MPI_Type_free(&tmp);
 
+    // the migration messages stay in flight while other work communicates, so they get their own
+    // communicator to keep them from matching receives posted on the shared one
+    MPI_Comm_dup(m_mpi_comm, &m_migrate_comm);
+
     initializeNeighborArrays();
     }
 
@@ -74,6 +79,7 @@ mpcd::Communicator::~Communicator()
     m_exec_conf->msg->notice(5) << "Destroying MPCD Communicator" << std::endl;
     detachCallbacks();
     MPI_Type_free(&m_pdata_element);
+    MPI_Comm_free(&m_migrate_comm);
     }
 
 void mpcd::Communicator::initializeNeighborArrays()
@@ -199,6 +205,9 @@ void mpcd::Communicator::communicate(uint64_t timestep)
     // Guard to prevent recursive triggering of migration
     m_is_communicating = true;
 
+    // complete any migration that was started in advance
+    finishCommunicate();
+
     // force the cell list to adopt the correct dimensions before proceeding,
     // which will trigger any size change signals
     m_cl->computeDimensions();
@@ -217,9 +226,14 @@ void mpcd::Communicator::communicate(uint64_t timestep)
         }
     if (migrate)
         {
-        migrateParticles(timestep);
+        // a migration that was done in advance for this timestep is still valid
+        if (m_force_migrate || !m_has_migrated || m_migrated_timestep != timestep)
+            {
+            migrateParticles(timestep);
+            }
         m_force_migrate = false;
         }
+    m_has_migrated = false;
 
     m_is_communicating = false;
     }
@@ -254,7 +268,62 @@ class MigratePartitionOp
     } // namespace detail
     } // namespace mpcd
 
+/*!
+ * \param timestep Timestep of the migration
+ *
+ * The migration is split into beginMigrate(), which posts the first stage, and finishMigrate().
+ */
 void mpcd::Communicator::migrateParticles(uint64_t timestep)
+    {
+    beginMigrate(timestep);
+    finishMigrate();
+    }
+
+/*!
+ * \param timestep Current timestep
+ *
+ * This starts a migration that would otherwise happen in communicate() at \a timestep, so that it
+ * can overlap with other work (e.g., the MD force computation). The particles must not be moved
+ * until finishCommunicate() is called. The migration is skipped in communicate() at \a timestep if
+ * nothing changed in between.
+ */
+void mpcd::Communicator::beginCommunicate(uint64_t timestep)
+    {
+    if (!m_cl)
+        {
+        throw std::runtime_error("Cell list has not been set");
+        }
+
+    finishCommunicate();
+
+    m_cl->computeDimensions();
+    if (m_check_decomposition)
+        {
+        checkDecomposition();
+        m_check_decomposition = false;
+        }
+
+    beginMigrate(timestep);
+    }
+
+void mpcd::Communicator::finishCommunicate()
+    {
+    if (!m_migrate_pending)
+        return;
+
+    const uint64_t timestep = m_migrate_timestep;
+    finishMigrate();
+    m_has_migrated = true;
+    m_migrated_timestep = timestep;
+    }
+
+/*!
+ * \param timestep Timestep of the migration
+ *
+ * The particles that leave the local domain are removed from the particle data, and the first
+ * communication stage is posted.
+ */
+void mpcd::Communicator::beginMigrate(uint64_t timestep)
     {
     if (m_mpcd_pdata->getNVirtual() > 0)
         {
@@ -271,164 +340,53 @@ void mpcd::Communicator::migrateParticles(uint64_t timestep)
     // fill send buffer once
     m_mpcd_pdata->removeParticles(m_sendbuf, 0xffffffff, timestep);
 
-    // fill the buffers and send in each direction
-    unsigned int n_recv = 0;
-    for (unsigned int dim = 0; dim < m_sysdef->getNDimensions(); ++dim)
+    m_migrate_pending = true;
+    m_migrate_timestep = timestep;
+    m_recvbuf.resize(0);
+    m_stage.dim = 0;
+    while (m_stage.dim < m_sysdef->getNDimensions()
+           && !isCommunicating(static_cast<mpcd::detail::face>(2 * m_stage.dim)))
         {
-        if (!isCommunicating(static_cast<mpcd::detail::face>(2 * dim)))
-            continue;
-
-        const unsigned int right_mask = 1 << (2 * dim);
-        const unsigned int left_mask = 1 << (2 * dim + 1);
-        const unsigned int stage_mask = right_mask | left_mask;
-
-        // neighbor ranks
-        const unsigned int right_neigh = m_decomposition->getNeighborRank(2 * dim);
-        const unsigned int left_neigh = m_decomposition->getNeighborRank(2 * dim + 1);
+        ++m_stage.dim;
+        }
+    if (m_stage.dim < m_sysdef->getNDimensions())
+        {
+        postMigrateStage();
+        }
+    }
 
-        // partition the send buffer by destination, leaving unsent particles at the front
-        unsigned int n_keep, n_send_left, n_send_right;
-            {
-            ArrayHandle<mpcd::detail::pdata_element> h_sendbuf(m_sendbuf,
-                                                               access_location::host,
-                                                               access_mode::readwrite);
-
-            // first, partition off particles that may be sent in either direction
-            mpcd::detail::MigratePartitionOp part_op(stage_mask);
-            auto bound = std::partition(h_sendbuf.data, h_sendbuf.data + m_sendbuf.size(), part_op);
-            n_keep = (unsigned int)(&(*bound) - h_sendbuf.data);
-
-            // then, partition the sent particles into the left and right ranks so that particles
-            // getting sent right come first
-            if (left_neigh != right_neigh)
-                {
-                // partition the remaining particles left and right
-                mpcd::detail::MigratePartitionOp sort_op(left_mask);
-                bound = std::partition(h_sendbuf.data + n_keep,
-                                       h_sendbuf.data + m_sendbuf.size(),
-                                       sort_op);
-                n_send_right = (unsigned int)(&(*bound) - (h_sendbuf.data + n_keep));
-                n_send_left = (unsigned int)(m_sendbuf.size() - n_keep - n_send_right);
-                }
-            else
-                {
-                n_send_right = (unsigned int)(m_sendbuf.size() - n_keep);
-                n_send_left = 0;
-                }
-            }
+/*!
+ * The remaining stages are completed in order, and the received particles are added to the
+ * particle data.
+ */
+void mpcd::Communicator::finishMigrate()
+    {
+    if (!m_migrate_pending)
+        return;
 
-        // communicate size of the message that will contain the particle data
-        unsigned int n_recv_left, n_recv_right;
-        if (left_neigh != right_neigh)
-            {
-            m_reqs.resize(4);
-            MPI_Isend(&n_send_right, 1, MPI_UNSIGNED, right_neigh, 0, m_mpi_comm, &m_reqs[0]);
-            MPI_Irecv(&n_recv_right, 1, MPI_UNSIGNED, right_neigh, 0, m_mpi_comm, &m_reqs[1]);
-            MPI_Isend(&n_send_left, 1, MPI_UNSIGNED, left_neigh, 0, m_mpi_comm, &m_reqs[2]);
-            MPI_Irecv(&n_recv_left, 1, MPI_UNSIGNED, left_neigh, 0, m_mpi_comm, &m_reqs[3]);
-            MPI_Waitall(4, m_reqs.data(), MPI_STATUSES_IGNORE);
-            }
-        else
-            {
-            // send right, receive left (same thing, really) only if neighbors match
-            n_recv_right = 0;
-            m_reqs.resize(2);
-            MPI_Isend(&n_send_right, 1, MPI_UNSIGNED, right_neigh, 0, m_mpi_comm, &m_reqs[0]);
-            MPI_Irecv(&n_recv_left, 1, MPI_UNSIGNED, left_neigh, 0, m_mpi_comm, &m_reqs[1]);
-            MPI_Waitall(2, m_reqs.data(), MPI_STATUSES_IGNORE);
-            }
+    while (m_stage.dim < m_sysdef->getNDimensions())
+        {
+        completeMigrateStage();
 
-        // exchange particle data
-        m_recvbuf.resize(n_recv + n_recv_left + n_recv_right);
+        ++m_stage.dim;
+        while (m_stage.dim < m_sysdef->getNDimensions()
+               && !isCommunicating(static_cast<mpcd::detail::face>(2 * m_stage.dim)))
             {
-            ArrayHandle<mpcd::detail::pdata_element> h_sendbuf(m_sendbuf,
-                                                               access_location::host,
-                                                               access_mode::read);
-            ArrayHandle<mpcd::detail::pdata_element> h_recvbuf(m_recvbuf,
-                                                               access_location::host,
-                                                               access_mode::overwrite);
-            m_reqs.resize(4);
-            int nreq = 0;
-            if (n_send_right != 0)
-                {
-                MPI_Isend(h_sendbuf.data + n_keep,
-                          n_send_right,
-                          m_pdata_element,
-                          right_neigh,
-                          1,
-                          m_mpi_comm,
-                          &m_reqs[nreq++]);
-                }
-            if (n_send_left != 0)
-                {
-                MPI_Isend(h_sendbuf.data + n_keep + n_send_right,
-                          n_send_left,
-                          m_pdata_element,
-                          left_neigh,
-                          1,
-                          m_mpi_comm,
-                          &m_reqs[nreq++]);
-                }
-            if (n_recv_right != 0)
-                {
-                MPI_Irecv(h_recvbuf.data + n_recv,
-                          n_recv_right,
-                          m_pdata_element,
-                          right_neigh,
-                          1,
-                          m_mpi_comm,
-                          &m_reqs[nreq++]);
-                }
-            if (n_recv_left != 0)
-                {
-                MPI_Irecv(h_recvbuf.data + n_recv + n_recv_right,
-                          n_recv_left,
-                          m_pdata_element,
-                          left_neigh,
-                          1,
-                          m_mpi_comm,
-                          &m_reqs[nreq++]);
-                }
-            MPI_Waitall(nreq, m_reqs.data(), MPI_STATUSES_IGNORE);
+            ++m_stage.dim;
             }
-
-            // now we pass through and unpack the particles, either by holding onto them in the
-            // receive buffer or by passing them back into the send buffer for the next stage
+        if (m_stage.dim < m_sysdef->getNDimensions())
             {
-            // partition the receive buffer so that particles that need to be sent are at the end
-            ArrayHandle<mpcd::detail::pdata_element> h_recvbuf(m_recvbuf,
-                                                               access_location::host,
-                                                               access_mode::readwrite);
-            mpcd::detail::MigratePartitionOp part_op(~stage_mask);
-            auto bound = std::partition(h_recvbuf.data + n_recv,
-                                        h_recvbuf.data + m_recvbuf.size(),
-                                        part_op);
-            n_recv = (unsigned int)(&(*bound) - h_recvbuf.data);
-
-            // move particles to resend over to the send buffer and unset the bits from this stage
-            const unsigned int n_resend = (unsigned int)(m_recvbuf.size() - n_recv);
-            m_sendbuf.resize(n_keep + n_resend);
-            ArrayHandle<mpcd::detail::pdata_element> h_sendbuf(m_sendbuf,
-                                                               access_location::host,
-                                                               access_mode::readwrite);
-            std::copy(h_recvbuf.data + n_recv,
-                      h_recvbuf.data + m_recvbuf.size(),
-                      h_sendbuf.data + n_keep);
-            for (unsigned int idx = n_keep; idx < m_sendbuf.size(); ++idx)
-                {
-                h_sendbuf.data[idx].comm_flag &= ~stage_mask;
-                }
+            postMigrateStage();
             }
-        m_recvbuf.resize(n_recv); // free up memory from the end of the receive buffer
-        } // end dir loop
+        }
 
         // fill particle data with wrapped, received particles
         {
         ArrayHandle<mpcd::detail::pdata_element> h_recvbuf(m_recvbuf,
                                                            access_location::host,
                                                            access_mode::readwrite);
-        const BoxDim wrap_box = getWrapBox(box);
-        for (unsigned int idx = 0; idx < n_recv; ++idx)
+        const BoxDim wrap_box = getWrapBox(m_cl->getCoverageBox());
+        for (unsigned int idx = 0; idx < m_recvbuf.size(); ++idx)
             {
             mpcd::detail::pdata_element& p = h_recvbuf.data[idx];
             Scalar4& postype = p.pos;
@@ -439,7 +397,190 @@ void mpcd::Communicator::migrateParticles(uint64_t timestep)
         }
 
     // this mask will totally unset any bits that could still be set (there should be none)
-    m_mpcd_pdata->addParticles(m_recvbuf, 0xffffffff, timestep);
+    m_mpcd_pdata->addParticles(m_recvbuf, 0xffffffff, m_migrate_timestep);
+    m_migrate_pending = false;
+    }
+
+/*!
+ * The send buffer is partitioned by destination, and the message sizes and the particles are
+ * sent. The particles can be sent before the size of the incoming messages is known because the
+ * send buffer is not modified until the stage is completed.
+ */
+void mpcd::Communicator::postMigrateStage()
+    {
+    const unsigned int dim = m_stage.dim;
+    const unsigned int right_mask = 1 << (2 * dim);
+    const unsigned int left_mask = 1 << (2 * dim + 1);
+    const unsigned int stage_mask = right_mask | left_mask;
+
+    // neighbor ranks
+    const unsigned int right_neigh = m_decomposition->getNeighborRank(2 * dim);
+    const unsigned int left_neigh = m_decomposition->getNeighborRank(2 * dim + 1);
+
+    // partition the send buffer by destination, leaving unsent particles at the front
+    ArrayHandle<mpcd::detail::pdata_element> h_sendbuf(m_sendbuf,
+                                                       access_location::host,
+                                                       access_mode::readwrite);
+
+    // first, partition off particles that may be sent in either direction
+    mpcd::detail::MigratePartitionOp part_op(stage_mask);
+    auto bound = std::partition(h_sendbuf.data, h_sendbuf.data + m_sendbuf.size(), part_op);
+    m_stage.n_keep = (unsigned int)(&(*bound) - h_sendbuf.data);
+
+    // then, partition the sent particles into the left and right ranks so that particles
+    // getting sent right come first
+    if (left_neigh != right_neigh)
+        {
+        // partition the remaining particles left and right
+        mpcd::detail::MigratePartitionOp sort_op(left_mask);
+        bound = std::partition(h_sendbuf.data + m_stage.n_keep,
+                               h_sendbuf.data + m_sendbuf.size(),
+                               sort_op);
+        m_stage.n_send_right = (unsigned int)(&(*bound) - (h_sendbuf.data + m_stage.n_keep));
+        m_stage.n_send_left
+            = (unsigned int)(m_sendbuf.size() - m_stage.n_keep - m_stage.n_send_right);
+        }
+    else
+        {
+        m_stage.n_send_right = (unsigned int)(m_sendbuf.size() - m_stage.n_keep);
+        m_stage.n_send_left = 0;
+        }
+
+    // communicate size of the message that will contain the particle data
+    m_reqs.resize(8);
+    m_stage.n_size_reqs = 0;
+    if (left_neigh != right_neigh)
+        {
+        MPI_Isend(&m_stage.n_send_right,
+                  1,
+                  MPI_UNSIGNED,
+                  right_neigh,
+                  0,
+                  m_migrate_comm,
+                  &m_reqs[0]);
+        MPI_Irecv(&m_stage.n_recv_right,
+                  1,
+                  MPI_UNSIGNED,
+                  right_neigh,
+                  0,
+                  m_migrate_comm,
+                  &m_reqs[1]);
+        MPI_Isend(&m_stage.n_send_left, 1, MPI_UNSIGNED, left_neigh, 0, m_migrate_comm, &m_reqs[2]);
+        MPI_Irecv(&m_stage.n_recv_left, 1, MPI_UNSIGNED, left_neigh, 0, m_migrate_comm, &m_reqs[3]);
+        m_stage.n_size_reqs = 4;
+        }
+    else
+        {
+        // send right, receive left (same thing, really) only if neighbors match
+        m_stage.n_recv_right = 0;
+        MPI_Isend(&m_stage.n_send_right,
+                  1,
+                  MPI_UNSIGNED,
+                  right_neigh,
+                  0,
+                  m_migrate_comm,
+                  &m_reqs[0]);
+        MPI_Irecv(&m_stage.n_recv_left, 1, MPI_UNSIGNED, left_neigh, 0, m_migrate_comm, &m_reqs[1]);
+        m_stage.n_size_reqs = 2;
+        }
+
+    // send the particle data, which is received once the sizes are known
+    m_stage.n_data_reqs = 0;
+    if (m_stage.n_send_right != 0)
+        {
+        MPI_Isend(h_sendbuf.data + m_stage.n_keep,
+                  m_stage.n_send_right,
+                  m_pdata_element,
+                  right_neigh,
+                  1,
+                  m_migrate_comm,
+                  &m_reqs[m_stage.n_size_reqs + m_stage.n_data_reqs++]);
+        }
+    if (m_stage.n_send_left != 0)
+        {
+        MPI_Isend(h_sendbuf.data + m_stage.n_keep + m_stage.n_send_right,
+                  m_stage.n_send_left,
+                  m_pdata_element,
+                  left_neigh,
+                  1,
+                  m_migrate_comm,
+                  &m_reqs[m_stage.n_size_reqs + m_stage.n_data_reqs++]);
+        }
+    }
+
+/*!
+ * The particle data is received from the neighbors, and the particles that still need to be
+ * forwarded are moved back into the send buffer for the next stage.
+ */
+void mpcd::Communicator::completeMigrateStage()
+    {
+    const unsigned int dim = m_stage.dim;
+    const unsigned int stage_mask = (1 << (2 * dim)) | (1 << (2 * dim + 1));
+    const unsigned int right_neigh = m_decomposition->getNeighborRank(2 * dim);
+    const unsigned int left_neigh = m_decomposition->getNeighborRank(2 * dim + 1);
+
+    MPI_Waitall(m_stage.n_size_reqs, m_reqs.data(), MPI_STATUSES_IGNORE);
+
+    // exchange particle data
+    const unsigned int n_recv = (unsigned int)m_recvbuf.size();
+    m_recvbuf.resize(n_recv + m_stage.n_recv_left + m_stage.n_recv_right);
+        {
+        ArrayHandle<mpcd::detail::pdata_element> h_recvbuf(m_recvbuf,
+                                                           access_location::host,
+                                                           access_mode::readwrite);
+        int nreq = m_stage.n_data_reqs;
+        MPI_Request* data_reqs = m_reqs.data() + m_stage.n_size_reqs;
+        if (m_stage.n_recv_right != 0)
+            {
+            MPI_Irecv(h_recvbuf.data + n_recv,
+                      m_stage.n_recv_right,
+                      m_pdata_element,
+                      right_neigh,
+                      1,
+                      m_migrate_comm,
+                      &data_reqs[nreq++]);
+            }
+        if (m_stage.n_recv_left != 0)
+            {
+            MPI_Irecv(h_recvbuf.data + n_recv + m_stage.n_recv_right,
+                      m_stage.n_recv_left,
+                      m_pdata_element,
+                      left_neigh,
+                      1,
+                      m_migrate_comm,
+                      &data_reqs[nreq++]);
+            }
+        MPI_Waitall(nreq, data_reqs, MPI_STATUSES_IGNORE);
+        }
+
+    // now we pass through and unpack the particles, either by holding onto them in the
+    // receive buffer or by passing them back into the send buffer for the next stage
+    unsigned int n_keep_recv;
+        {
+        // partition the receive buffer so that particles that need to be sent are at the end
+        ArrayHandle<mpcd::detail::pdata_element> h_recvbuf(m_recvbuf,
+                                                           access_location::host,
+                                                           access_mode::readwrite);
+        mpcd::detail::MigratePartitionOp part_op(~stage_mask);
+        auto bound
+            = std::partition(h_recvbuf.data + n_recv, h_recvbuf.data + m_recvbuf.size(), part_op);
+        n_keep_recv = (unsigned int)(&(*bound) - h_recvbuf.data);
+
+        // move particles to resend over to the send buffer and unset the bits from this stage
+        const unsigned int n_resend = (unsigned int)(m_recvbuf.size() - n_keep_recv);
+        m_sendbuf.resize(m_stage.n_keep + n_resend);
+        ArrayHandle<mpcd::detail::pdata_element> h_sendbuf(m_sendbuf,
+                                                           access_location::host,
+                                                           access_mode::readwrite);
+        std::copy(h_recvbuf.data + n_keep_recv,
+                  h_recvbuf.data + m_recvbuf.size(),
+                  h_sendbuf.data + m_stage.n_keep);
+        for (unsigned int idx = m_stage.n_keep; idx < m_sendbuf.size(); ++idx)
+            {
+            h_sendbuf.data[idx].comm_flag &= ~stage_mask;
+            }
+        }
+    m_recvbuf.resize(n_keep_recv); // free up memory from the end of the receive buffer
     }
 
 /*!
@@ -124,6 +124,12 @@ class PYBIND11_EXPORT Communicator : public Autotuned
         {
         m_force_migrate = true;
         }
+
+    //! Start migrating particles in advance of communicate()
+    void beginCommunicate(uint64_t timestep);
+
+    //! Finish the migration started by beginCommunicate()
+    void finishCommunicate();
     //@}
 
     //! Get the cell list used for determining when communication is needed
@@ -202,6 +208,37 @@ class PYBIND11_EXPORT Communicator : public Autotuned
     GPUVector<mpcd::detail::pdata_element> m_sendbuf; //!< Buffer for particles that are sent
     GPUVector<mpcd::detail::pdata_element> m_recvbuf; //!< Buffer for particles that are received
     std::vector<MPI_Request> m_reqs;                  //!< MPI requests
+    MPI_Comm m_migrate_comm; //!< Private communicator for messages left in flight by migration
+
+    //! State of the migration stage that is in flight
+    struct MigrateStage
+        {
+        unsigned int dim;          //!< Dimension being communicated
+        unsigned int n_keep;       //!< Number of particles in the send buffer not sent
+        unsigned int n_send_right; //!< Number of particles sent right
+        unsigned int n_send_left;  //!< Number of particles sent left
+        unsigned int n_recv_right; //!< Number of particles received from the right
+        unsigned int n_recv_left;  //!< Number of particles received from the left
+        int n_size_reqs;           //!< Number of requests for the message sizes
+        int n_data_reqs;           //!< Number of requests for sending particles
+        };
+    MigrateStage m_stage;         //!< Current migration stage
+    bool m_migrate_pending;       //!< True if a migration has been started but not finished
+    uint64_t m_migrate_timestep;  //!< Timestep of the pending migration
+    bool m_has_migrated;          //!< True if particles were migrated in advance
+    uint64_t m_migrated_timestep; //!< Timestep the particles were migrated in advance for
+
+    //! Fill the send buffer and post the first migration stage
+    void beginMigrate(uint64_t timestep);
+
+    //! Complete all migration stages and add the received particles
+    void finishMigrate();
+
+    //! Send the particles for the current stage
+    void postMigrateStage();
+
+    //! Receive the particles for the current stage
+    void completeMigrateStage();
 
     //! Attach callback signals
     void attachCallbacks();
@@ -214,6 +251,7 @@ class PYBIND11_EXPORT Communicator : public Autotuned
     void slotBoxChanged()
         {
         m_check_decomposition = true;
+        m_has_migrated = false;
         }
 
     MigrateSignal m_migrate_requests; //!< Signal to request migration
@@ -16,6 +16,10 @@
 #include "StreamingMethod.h"
 #include <pybind11/pybind11.h>
 
+#ifdef ENABLE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 namespace hoomd
     {
 namespace mpcd
@@ -39,6 +43,12 @@ namespace mpcd
  *  3. validateBox(): Checks whether the global simulation box is consistent with the streaming
  * geometry.
  *
+ * When a sweep is requested with setSweep(), the particles are also binned into the cell list and
+ * their momentum and kinetic energy are summed into runs of consecutive particles in the same cell
+ * while they are streamed. The particles are processed in chunks of a fixed size (in parallel
+ * with TBB), so the runs do not depend on the number of threads. The cell list and cell
+ * properties are then built from the runs without another pass over the particle data. The runs
+ * are short if the particles are not sorted, so a Sorter should be used with sweeps.
  */
 template<class Geometry>
 class PYBIND11_EXPORT ConfinedStreamingMethod : public mpcd::StreamingMethod
@@ -87,6 +97,9 @@ class PYBIND11_EXPORT ConfinedStreamingMethod : public mpcd::StreamingMethod
 
     //! Check that particles lie inside the geometry
     virtual bool validateParticles();
+
+    static const unsigned int sweep_chunk_size = 8192; //!< Number of particles per sweep chunk
+    std::vector<std::vector<mpcd::detail::CellRun>> m_sweep_runs; //!< Runs in each sweep chunk
     };
 
 /*!
@@ -94,6 +107,10 @@ class PYBIND11_EXPORT ConfinedStreamingMethod : public mpcd::StreamingMethod
  */
 template<class Geometry> void ConfinedStreamingMethod<Geometry>::stream(uint64_t timestep)
     {
+    // a sweep request only applies to the next streaming step
+    std::shared_ptr<mpcd::CellThermoCompute> sweep_thermo;
+    sweep_thermo.swap(m_sweep_thermo);
+
     if (!shouldStream(timestep))
         return;
 
@@ -121,14 +138,14 @@ template<class Geometry> void ConfinedStreamingMethod<Geometry>::stream(uint64_t
     // acquire polymorphic pointer to the external field
     const mpcd::ExternalField* field = (m_field) ? m_field->get(access_location::host) : nullptr;
 
-    for (unsigned int cur_p = 0; cur_p < m_mpcd_pdata->getN(); ++cur_p)
-        {
+    auto stream_particle = [&](unsigned int cur_p, Scalar3& pos, Scalar3& vel)
+    {
         const Scalar4 postype = h_pos.data[cur_p];
-        Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
+        pos = make_scalar3(postype.x, postype.y, postype.z);
         const unsigned int type = __scalar_as_int(postype.w);
 
         const Scalar4 vel_cell = h_vel.data[cur_p];
-        Scalar3 vel = make_scalar3(vel_cell.x, vel_cell.y, vel_cell.z);
+        vel = make_scalar3(vel_cell.x, vel_cell.y, vel_cell.z);
         // estimate next velocity based on current acceleration
         if (field)
             {
@@ -154,6 +171,80 @@ template<class Geometry> void ConfinedStreamingMethod<Geometry>::stream(uint64_t
         box.wrap(pos, image);
 
         h_pos.data[cur_p] = make_scalar4(pos.x, pos.y, pos.z, __int_as_scalar(type));
+    };
+
+    if (sweep_thermo)
+        {
+        const mpcd::detail::CellBinner binner = m_cl->getBinner();
+        const unsigned int N = m_mpcd_pdata->getN();
+        const unsigned int n_chunks = (N + sweep_chunk_size - 1) / sweep_chunk_size;
+        const double mass_d = mass;
+        m_sweep_runs.resize(n_chunks);
+        std::vector<unsigned char> failed(n_chunks, 0);
+
+        auto sweep_chunk = [&](unsigned int chunk)
+        {
+            std::vector<mpcd::detail::CellRun>& runs = m_sweep_runs[chunk];
+            runs.clear();
+
+            const unsigned int last = std::min(N, (chunk + 1) * sweep_chunk_size);
+            for (unsigned int cur_p = chunk * sweep_chunk_size; cur_p < last; ++cur_p)
+                {
+                Scalar3 pos, vel;
+                stream_particle(cur_p, pos, vel);
+
+                // particles that cannot be binned are reported by the regular cell list build
+                unsigned int cell = mpcd::detail::NO_CELL;
+                if (binner(pos, cell) != 0)
+                    {
+                    failed[chunk] = 1;
+                    cell = mpcd::detail::NO_CELL;
+                    }
+                else
+                    {
+                    if (runs.empty() || runs.back().cell != cell)
+                        {
+                        runs.push_back({cell, cur_p, 0, make_double4(0.0, 0.0, 0.0, 0.0), 0.0});
+                        }
+                    mpcd::detail::CellRun& run = runs.back();
+                    const double3 vel_i = make_double3(vel.x, vel.y, vel.z);
+                    ++run.count;
+                    run.momentum.x += mass_d * vel_i.x;
+                    run.momentum.y += mass_d * vel_i.y;
+                    run.momentum.z += mass_d * vel_i.z;
+                    run.momentum.w += mass_d;
+                    run.ke += 0.5 * mass_d
+                              * (vel_i.x * vel_i.x + vel_i.y * vel_i.y + vel_i.z * vel_i.z);
+                    }
+
+                h_vel.data[cur_p] = make_scalar4(vel.x, vel.y, vel.z, __int_as_scalar(cell));
+                }
+        };
+
+#ifdef ENABLE_TBB
+        m_exec_conf->getTaskArena()->execute(
+            [&] { tbb::parallel_for((unsigned int)0, n_chunks, sweep_chunk); });
+#else
+        for (unsigned int chunk = 0; chunk < n_chunks; ++chunk)
+            sweep_chunk(chunk);
+#endif
+
+        if (std::find(failed.begin(), failed.end(), 1) == failed.end())
+            {
+            m_cl->buildFromRuns(m_sweep_timestep, m_sweep_runs);
+            sweep_thermo->computeFromRuns(m_sweep_timestep, m_sweep_runs);
+            }
+        else
+            {
+            m_mpcd_pdata->invalidateCellCache();
+            }
+        return;
+        }
+
+    for (unsigned int cur_p = 0; cur_p < m_mpcd_pdata->getN(); ++cur_p)
+        {
+        Scalar3 pos, vel;
+        stream_particle(cur_p, pos, vel);
         h_vel.data[cur_p]
             = make_scalar4(vel.x, vel.y, vel.z, __int_as_scalar(mpcd::detail::NO_CELL));
         }
@@ -103,9 +103,23 @@ void mpcd::Integrator::update(uint64_t timestep)
     // domains
     if (m_stream)
         {
+        if (m_fuse_collision)
+            setupFusedCollision(timestep);
         m_stream->stream(timestep);
         }
 
+#ifdef ENABLE_MPI
+    // the MPCD particles do not move again before the next collision, so start migrating them
+    // while the MD forces are computed
+    const bool migrate_async
+        = m_mpcd_comm && !m_exec_conf->isCUDAEnabled() && checkCollide(timestep + 1);
+    if (migrate_async)
+        {
+        m_sysdef->getMPCDParticleData()->removeVirtualParticles();
+        m_mpcd_comm->beginCommunicate(timestep + 1);
+        }
+#endif // ENABLE_MPI
+
     // compute the net force on the MD particles
 #ifdef ENABLE_HIP
     if (m_exec_conf->isCUDAEnabled())
@@ -117,6 +131,11 @@ void mpcd::Integrator::update(uint64_t timestep)
     // perform the second step of the MD integration
     for (auto method = m_methods.begin(); method != m_methods.end(); ++method)
         (*method)->integrateStepTwo(timestep);
+
+#ifdef ENABLE_MPI
+    if (migrate_async)
+        m_mpcd_comm->finishCommunicate();
+#endif // ENABLE_MPI
     }
 
 /*!
@@ -146,12 +165,51 @@ void mpcd::Integrator::prepRun(uint64_t timestep)
         }
 
 #ifdef ENABLE_MPI
-    // force a communication step if present
+    // force a communication step if present, since the particles may have been changed between
+    // runs (virtual particles are not communicated, and are filled again before they are used)
     if (m_mpcd_comm)
         {
+        m_sysdef->getMPCDParticleData()->removeVirtualParticles();
+        m_mpcd_comm->forceMigrate();
         m_mpcd_comm->communicate(timestep);
         }
 #endif // ENABLE_MPI
+
+    // the particles may have been changed between runs, so do not use a cell list from streaming
+    m_sysdef->getMPCDParticleData()->invalidateCellCache();
+    }
+
+/*!
+ * \param timestep Current timestep
+ *
+ * If the next streaming step is followed directly by a collision, the streaming method bins the
+ * particles and sums the cell properties for that collision while it streams. This is only done
+ * on the CPU in simulations without domain decomposition, virtual particles, or embedded
+ * particles. Otherwise, the cell list and properties are computed by the collision method.
+ *
+ * The random grid shift of the collision is drawn now. It is the same shift that the collision
+ * method draws again at the collision timestep.
+ */
+void mpcd::Integrator::setupFusedCollision(uint64_t timestep)
+    {
+    if (m_exec_conf->isCUDAEnabled() || !m_collide || !m_fillers.empty()
+        || !m_stream->peekStream(timestep))
+        return;
+
+#ifdef ENABLE_MPI
+    if (m_mpcd_comm || m_sysdef->isDomainDecomposed())
+        return;
+#endif // ENABLE_MPI
+
+    const uint64_t collide_timestep = timestep + m_stream->getPeriod();
+    auto cl = m_collide->getCellList();
+    auto thermo = m_collide->getCellThermo();
+    if (!m_collide->peekCollide(collide_timestep) || !thermo || !cl || cl->getEmbeddedGroup()
+        || cl != m_stream->getCellList())
+        return;
+
+    m_collide->drawGridShift(collide_timestep);
+    m_stream->setSweep(thermo, collide_timestep);
     }
 
 /*!
@@ -191,6 +249,9 @@ void mpcd::detail::export_Integrator(pybind11::module& m)
         .def("removeSorter", &mpcd::Integrator::removeSorter)
         .def("addFiller", &mpcd::Integrator::addFiller)
         .def("removeAllFillers", &mpcd::Integrator::removeAllFillers)
+        .def_property("fuse_collision",
+                      &mpcd::Integrator::getFuseCollision,
+                      &mpcd::Integrator::setFuseCollision)
 #ifdef ENABLE_MPI
         .def("setMPCDCommunicator", &mpcd::Integrator::setMPCDCommunicator)
 #endif // ENABLE_MPI
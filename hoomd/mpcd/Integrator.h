@@ -146,6 +146,18 @@ class PYBIND11_EXPORT Integrator : public hoomd::md::IntegratorTwoStep
         m_fillers.clear();
         }
 
+    //! Set if the cell list and cell properties are computed while streaming
+    void setFuseCollision(bool fuse_collision)
+        {
+        m_fuse_collision = fuse_collision;
+        }
+
+    //! Get if the cell list and cell properties are computed while streaming
+    bool getFuseCollision() const
+        {
+        return m_fuse_collision;
+        }
+
     protected:
     std::shared_ptr<mpcd::CollisionMethod> m_collide; //!< MPCD collision rule
     std::shared_ptr<mpcd::StreamingMethod> m_stream;  //!< MPCD streaming rule
@@ -157,6 +169,12 @@ class PYBIND11_EXPORT Integrator : public hoomd::md::IntegratorTwoStep
 
     std::vector<std::shared_ptr<mpcd::VirtualParticleFiller>>
         m_fillers; //!< MPCD virtual particle fillers
+
+    bool m_fuse_collision = false; //!< If true, fuse the streaming and the next collision
+
+    //! Request the cell properties of the next collision during streaming, if possible
+    void setupFusedCollision(uint64_t timestep);
+
     private:
     //! Check if a collision will occur at the current timestep
     bool checkCollide(uint64_t timestep)
@@ -0,0 +1,397 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*!
+ * \file mpcd/MeshGeometry.h
+ * \brief Definition of the MPCD triangle mesh geometry
+ */
+
+#ifndef MPCD_MESH_GEOMETRY_H_
+#define MPCD_MESH_GEOMETRY_H_
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "BoundaryCondition.h"
+
+#include "hoomd/AABBTree.h"
+#include "hoomd/BoxDim.h"
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/VectorMath.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace hoomd
+    {
+namespace mpcd
+    {
+namespace detail
+    {
+//! Triangle of a MeshGeometry
+struct MeshTriangle
+    {
+    vec3<Scalar> v0; //!< First vertex
+    vec3<Scalar> e1; //!< Edge from the first to the second vertex
+    vec3<Scalar> e2; //!< Edge from the first to the third vertex
+    vec3<Scalar> n;  //!< Unit normal pointing into the fluid
+    };
+
+//! Geometry bounded by a triangle mesh
+/*!
+ * This class defines a geometry whose solid boundaries are given by a triangle mesh, so that
+ * complex channels and obstacles can be used without writing a new geometry class. The vertices
+ * of each triangle are ordered counterclockwise when viewed from the fluid, so that the normal
+ * \f$(\mathbf{v}_1-\mathbf{v}_0)\times(\mathbf{v}_2-\mathbf{v}_0)\f$ points into the fluid.
+ *
+ * The triangles are stored in a bounding volume hierarchy (hoomd::detail::AABBTree). A collision
+ * is detected by intersecting the segment traveled by the particle during the streaming step with
+ * the triangles, and the particle is reflected at the first triangle that it crosses from the fluid
+ * side. A position is outside the geometry if it lies behind the closest triangle. At an edge or a
+ * vertex, the triangle whose normal is best aligned with the separation is used.
+ *
+ * The mesh is not periodic. Surfaces that cross a periodic boundary of the simulation box must be
+ * continued past the boundary by at least the distance that a particle travels in one streaming
+ * step, and the continued surface must match the periodic image inside the box.
+ *
+ * The geometry enforces boundary conditions \b only on the MPCD solvent particles. Additional
+ * interactions are required with any embedded particles using appropriate wall potentials.
+ */
+class __attribute__((visibility("default"))) MeshGeometry
+    {
+    public:
+    //! Constructor
+    /*!
+     * \param vertices Vertices of the mesh
+     * \param triangles Indexes of the three vertices of each triangle
+     * \param bc Boundary condition at the wall (slip or no-slip)
+     */
+    MeshGeometry(const std::vector<Scalar3>& vertices,
+                 const std::vector<uint3>& triangles,
+                 boundary bc)
+        : m_bc(bc)
+        {
+        if (triangles.empty())
+            {
+            throw std::runtime_error("Mesh geometry must have at least one triangle");
+            }
+
+        m_triangles.resize(triangles.size());
+        std::vector<hoomd::detail::AABB> aabbs(triangles.size());
+        for (unsigned int i = 0; i < triangles.size(); ++i)
+            {
+            const uint3 tri = triangles[i];
+            if (tri.x >= vertices.size() || tri.y >= vertices.size() || tri.z >= vertices.size())
+                {
+                throw std::runtime_error("Mesh geometry triangle has an invalid vertex index");
+                }
+            const vec3<Scalar> v0(vertices[tri.x]);
+            const vec3<Scalar> v1(vertices[tri.y]);
+            const vec3<Scalar> v2(vertices[tri.z]);
+
+            MeshTriangle& t = m_triangles[i];
+            t.v0 = v0;
+            t.e1 = v1 - v0;
+            t.e2 = v2 - v0;
+            const vec3<Scalar> n = cross(t.e1, t.e2);
+            const Scalar nn = dot(n, n);
+            if (!(nn > Scalar(0)))
+                {
+                throw std::runtime_error("Mesh geometry triangle has zero area");
+                }
+            t.n = n / fast::sqrt(nn);
+
+            const vec3<Scalar> lo(std::min({v0.x, v1.x, v2.x}),
+                                  std::min({v0.y, v1.y, v2.y}),
+                                  std::min({v0.z, v1.z, v2.z}));
+            const vec3<Scalar> hi(std::max({v0.x, v1.x, v2.x}),
+                                  std::max({v0.y, v1.y, v2.y}),
+                                  std::max({v0.z, v1.z, v2.z}));
+            aabbs[i] = hoomd::detail::AABB(lo, hi);
+            aabbs[i].tag = i;
+            }
+        m_tree.buildTree(aabbs.data(), (unsigned int)aabbs.size());
+        }
+
+    //! Detect collision between the particle and the boundary
+    /*!
+     * \param pos Proposed particle position
+     * \param vel Proposed particle velocity
+     * \param dt Integration time remaining (inout).
+     *
+     * \returns True if a collision occurred, and false otherwise
+     *
+     * \post The particle position \a pos is moved to the point of reflection, the velocity \a vel
+     * is updated according to the appropriate bounce back rule, and the integration time \a dt is
+     * decreased to the amount of time remaining.
+     *
+     * The passed value of \a dt must be the time taken to arrive at pos. Only triangles that are
+     * crossed from the fluid side are considered, so a particle that was just reflected from a
+     * triangle does not collide with it again.
+     */
+    bool detectCollision(Scalar3& pos, Scalar3& vel, Scalar& dt) const
+        {
+        const vec3<Scalar> v(vel);
+        const vec3<Scalar> d = v * dt;
+        const vec3<Scalar> start = vec3<Scalar>(pos) - d;
+        if (dt <= Scalar(0) || dot(d, d) == Scalar(0))
+            {
+            dt = Scalar(0);
+            return false;
+            }
+
+        // bounding box of the segment for culling nodes of the tree
+        const vec3<Scalar> end(pos);
+        const vec3<Scalar> seg_lo(std::min(start.x, end.x),
+                                  std::min(start.y, end.y),
+                                  std::min(start.z, end.z));
+        const vec3<Scalar> seg_hi(std::max(start.x, end.x),
+                                  std::max(start.y, end.y),
+                                  std::max(start.z, end.z));
+        const hoomd::detail::AABB seg(seg_lo, seg_hi);
+
+        // find the first triangle crossed from the fluid side, as a fraction s of the segment
+        Scalar s_hit = Scalar(2);
+        unsigned int hit = 0;
+        for (unsigned int node = 0; node < m_tree.getNumNodes(); ++node)
+            {
+            if (!seg.overlaps(m_tree.getNodeAABB(node)))
+                {
+                node += m_tree.getNodeSkip(node);
+                continue;
+                }
+            if (!m_tree.isNodeLeaf(node))
+                continue;
+
+            for (unsigned int j = 0; j < m_tree.getNodeNumParticles(node); ++j)
+                {
+                const unsigned int idx = m_tree.getNodeParticle(node, j);
+                Scalar s;
+                if (intersectSegment(m_triangles[idx], start, d, s) && s < s_hit)
+                    {
+                    s_hit = s;
+                    hit = idx;
+                    }
+                }
+            }
+
+        if (s_hit > Scalar(1))
+            {
+            dt = Scalar(0);
+            return false;
+            }
+
+        // move the particle to the point of contact and keep the time not yet integrated
+        pos = vec_to_scalar3(start + s_hit * d);
+        dt = (Scalar(1) - s_hit) * dt;
+
+        // update velocity according to boundary conditions
+        const vec3<Scalar>& n = m_triangles[hit].n;
+        const vec3<Scalar> vn = dot(n, v) * n;
+        vec3<Scalar> new_vel = v;
+        // no-slip requires reflection of the tangential components
+        if (m_bc == boundary::no_slip)
+            {
+            new_vel -= Scalar(2) * (v - vn);
+            }
+        // always reflect normal component for no-penetration
+        new_vel -= Scalar(2) * vn;
+        vel = vec_to_scalar3(new_vel);
+
+        return true;
+        }
+
+    //! Check if a particle is out of bounds
+    /*!
+     * \param pos Current particle position
+     * \returns True if particle is out of bounds, and false otherwise
+     */
+    bool isOutside(const Scalar3& pos) const
+        {
+        const vec3<Scalar> p(pos);
+
+        Scalar best_dsq = std::numeric_limits<Scalar>::max();
+        Scalar best_align = Scalar(0);
+        Scalar best_side = Scalar(1);
+        for (unsigned int node = 0; node < m_tree.getNumNodes(); ++node)
+            {
+            // skip nodes that are farther away than the closest triangle found so far
+            const hoomd::detail::AABB& aabb = m_tree.getNodeAABB(node);
+            const vec3<Scalar> lo = aabb.getLower();
+            const vec3<Scalar> hi = aabb.getUpper();
+            const vec3<Scalar> dr(p.x - std::max(lo.x, std::min(p.x, hi.x)),
+                                  p.y - std::max(lo.y, std::min(p.y, hi.y)),
+                                  p.z - std::max(lo.z, std::min(p.z, hi.z)));
+            if (dot(dr, dr) > best_dsq * (Scalar(1) + tie_tolerance))
+                {
+                node += m_tree.getNodeSkip(node);
+                continue;
+                }
+            if (!m_tree.isNodeLeaf(node))
+                continue;
+
+            for (unsigned int j = 0; j < m_tree.getNodeNumParticles(node); ++j)
+                {
+                const MeshTriangle& t = m_triangles[m_tree.getNodeParticle(node, j)];
+                const vec3<Scalar> sep = p - closestPoint(t, p);
+                const Scalar dsq = dot(sep, sep);
+                const Scalar side = dot(sep, t.n);
+                // squared cosine between the separation and the normal, to break ties at edges
+                const Scalar align = (dsq > Scalar(0)) ? side * side / dsq : Scalar(1);
+                const bool tie = std::abs(dsq - best_dsq) <= tie_tolerance * best_dsq;
+                if ((!tie && dsq < best_dsq) || (tie && align > best_align))
+                    {
+                    best_dsq = std::min(dsq, best_dsq);
+                    best_align = align;
+                    best_side = side;
+                    }
+                }
+            }
+
+        return (best_side < Scalar(0));
+        }
+
+    //! Validate that the simulation box is large enough for the geometry
+    /*!
+     * \param box Global simulation box
+     * \param cell_size Size of MPCD cell
+     *
+     * The mesh can have any shape, so there is no general condition on the box. It is the
+     * responsibility of the user to continue the surface consistently through the periodic
+     * boundaries.
+     */
+    bool validateBox(const BoxDim& box, Scalar cell_size) const
+        {
+        return true;
+        }
+
+    //! Get the number of triangles
+    unsigned int getNumTriangles() const
+        {
+        return (unsigned int)m_triangles.size();
+        }
+
+    //! Get a triangle of the mesh
+    /*!
+     * \param idx Index of the triangle
+     */
+    const MeshTriangle& getTriangle(unsigned int idx) const
+        {
+        return m_triangles[idx];
+        }
+
+    //! Get the wall boundary condition
+    /*!
+     * \returns Boundary condition at wall
+     */
+    boundary getBoundaryCondition() const
+        {
+        return m_bc;
+        }
+
+    //! Get the unique name of this geometry
+    static std::string getName()
+        {
+        return std::string("Mesh");
+        }
+
+    private:
+    std::vector<MeshTriangle> m_triangles; //!< Triangles of the mesh
+    hoomd::detail::AABBTree m_tree;        //!< Bounding volume hierarchy of the triangles
+    const boundary m_bc;                   //!< Boundary condition
+
+    static constexpr Scalar barycentric_tolerance = Scalar(1e-6); //!< Padding of triangle edges
+    static constexpr Scalar tie_tolerance = Scalar(1e-5); //!< Relative tolerance of equal distances
+
+    //! Intersect a segment with a triangle
+    /*!
+     * \param t Triangle
+     * \param start Start of the segment
+     * \param d Displacement along the segment
+     * \param s Fraction of the segment at the intersection (output)
+     * \returns True if the segment crosses the triangle from the fluid side
+     *
+     * This is the Moller-Trumbore algorithm. The triangle is padded slightly so that a particle
+     * cannot pass between two triangles sharing an edge because of round off.
+     */
+    static bool intersectSegment(const MeshTriangle& t,
+                                 const vec3<Scalar>& start,
+                                 const vec3<Scalar>& d,
+                                 Scalar& s)
+        {
+        // only motion into the solid is a collision
+        if (!(dot(d, t.n) < Scalar(0)))
+            return false;
+
+        const vec3<Scalar> h = cross(d, t.e2);
+        const Scalar det = dot(t.e1, h);
+        const Scalar inv_det = Scalar(1) / det;
+        const vec3<Scalar> r = start - t.v0;
+        const Scalar u = dot(r, h) * inv_det;
+        if (u < -barycentric_tolerance || u > Scalar(1) + barycentric_tolerance)
+            return false;
+        const vec3<Scalar> q = cross(r, t.e1);
+        const Scalar v = dot(d, q) * inv_det;
+        if (v < -barycentric_tolerance || u + v > Scalar(1) + barycentric_tolerance)
+            return false;
+        s = dot(t.e2, q) * inv_det;
+        return (s >= Scalar(0) && s <= Scalar(1));
+        }
+
+    //! Find the closest point on a triangle
+    /*!
+     * \param t Triangle
+     * \param p Point
+     * \returns The point on \a t closest to \a p
+     *
+     * The Voronoi regions of the vertices, edges, and face are tested in turn.
+     */
+    static vec3<Scalar> closestPoint(const MeshTriangle& t, const vec3<Scalar>& p)
+        {
+        const vec3<Scalar> ap = p - t.v0;
+        const Scalar d1 = dot(t.e1, ap);
+        const Scalar d2 = dot(t.e2, ap);
+        if (d1 <= Scalar(0) && d2 <= Scalar(0))
+            return t.v0;
+
+        const vec3<Scalar> bp = ap - t.e1;
+        const Scalar d3 = dot(t.e1, bp);
+        const Scalar d4 = dot(t.e2, bp);
+        if (d3 >= Scalar(0) && d4 <= d3)
+            return t.v0 + t.e1;
+
+        const Scalar vc = d1 * d4 - d3 * d2;
+        if (vc <= Scalar(0) && d1 >= Scalar(0) && d3 <= Scalar(0))
+            return t.v0 + (d1 / (d1 - d3)) * t.e1;
+
+        const vec3<Scalar> cp = ap - t.e2;
+        const Scalar d5 = dot(t.e1, cp);
+        const Scalar d6 = dot(t.e2, cp);
+        if (d6 >= Scalar(0) && d5 <= d6)
+            return t.v0 + t.e2;
+
+        const Scalar vb = d5 * d2 - d1 * d6;
+        if (vb <= Scalar(0) && d2 >= Scalar(0) && d6 <= Scalar(0))
+            return t.v0 + (d2 / (d2 - d6)) * t.e2;
+
+        const Scalar va = d3 * d6 - d5 * d4;
+        if (va <= Scalar(0) && (d4 - d3) >= Scalar(0) && (d5 - d6) >= Scalar(0))
+            {
+            const Scalar w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+            return t.v0 + t.e1 + w * (t.e2 - t.e1);
+            }
+
+        const Scalar denom = Scalar(1) / (va + vb + vc);
+        return t.v0 + (vb * denom) * t.e1 + (vc * denom) * t.e2;
+        }
+    };
+
+    } // end namespace detail
+    } // end namespace mpcd
+    } // end namespace hoomd
+
+#endif // MPCD_MESH_GEOMETRY_H_
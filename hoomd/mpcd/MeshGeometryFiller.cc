@@ -0,0 +1,236 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*!
+ * \file mpcd/MeshGeometryFiller.cc
+ * \brief Definition of mpcd::MeshGeometryFiller
+ */
+
+#include "MeshGeometryFiller.h"
+#include "hoomd/RNGIdentifiers.h"
+#include "hoomd/RandomNumbers.h"
+
+namespace hoomd
+    {
+mpcd::MeshGeometryFiller::MeshGeometryFiller(std::shared_ptr<SystemDefinition> sysdef,
+                                             Scalar density,
+                                             unsigned int type,
+                                             std::shared_ptr<Variant> T,
+                                             std::shared_ptr<const mpcd::detail::MeshGeometry> geom)
+    : mpcd::VirtualParticleFiller(sysdef, density, type, T), m_geom(geom)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing MPCD MeshGeometryFiller" << std::endl;
+    }
+
+mpcd::MeshGeometryFiller::~MeshGeometryFiller()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying MPCD MeshGeometryFiller" << std::endl;
+    }
+
+/*!
+ * \param grid_shift Shift of the cell grid
+ * \param margin Distance to grow each cell by in every direction
+ *
+ * The cells are searched in the unwrapped coordinates of each triangle, and then wrapped back into
+ * the global cell grid. A cell is cut by the triangle if the plane of the triangle passes through
+ * it, which is conservative at the edges of the triangle.
+ */
+void mpcd::MeshGeometryFiller::findBoundaryCells(const Scalar3& grid_shift, Scalar margin)
+    {
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    const Scalar cell_size = m_cl->getCellSize();
+    const vec3<Scalar> origin(global_box.getLo() + grid_shift);
+    const uint3 n_cells = m_cl->getGlobalDim();
+    const Index3D& cell_indexer = m_cl->getGlobalCellIndexer();
+
+    auto bin = [&](Scalar x, Scalar lo) { return (int)std::floor((x - lo) / cell_size); };
+    auto wrap = [](int i, unsigned int n)
+    { return (unsigned int)(((i % (int)n) + (int)n) % (int)n); };
+
+    m_boundary_cells.clear();
+    for (unsigned int i = 0; i < m_geom->getNumTriangles(); ++i)
+        {
+        const mpcd::detail::MeshTriangle& t = m_geom->getTriangle(i);
+        const vec3<Scalar> v1 = t.v0 + t.e1;
+        const vec3<Scalar> v2 = t.v0 + t.e2;
+        const int3 lo = make_int3(bin(std::min({t.v0.x, v1.x, v2.x}) - margin, origin.x),
+                                  bin(std::min({t.v0.y, v1.y, v2.y}) - margin, origin.y),
+                                  bin(std::min({t.v0.z, v1.z, v2.z}) - margin, origin.z));
+        const int3 hi = make_int3(bin(std::max({t.v0.x, v1.x, v2.x}) + margin, origin.x),
+                                  bin(std::max({t.v0.y, v1.y, v2.y}) + margin, origin.y),
+                                  bin(std::max({t.v0.z, v1.z, v2.z}) + margin, origin.z));
+
+        // projected half width of a (grown) cell onto the triangle normal
+        const Scalar r = (Scalar(0.5) * cell_size + margin)
+                         * (std::abs(t.n.x) + std::abs(t.n.y) + std::abs(t.n.z));
+        for (int k = lo.z; k <= hi.z; ++k)
+            {
+            for (int j = lo.y; j <= hi.y; ++j)
+                {
+                for (int ii = lo.x; ii <= hi.x; ++ii)
+                    {
+                    const vec3<Scalar> center
+                        = origin
+                          + cell_size
+                                * vec3<Scalar>(Scalar(ii) + Scalar(0.5),
+                                               Scalar(j) + Scalar(0.5),
+                                               Scalar(k) + Scalar(0.5));
+                    if (std::abs(dot(t.n, center - t.v0)) > r)
+                        continue;
+
+                    m_boundary_cells.push_back(cell_indexer(wrap(ii, n_cells.x),
+                                                            wrap(j, n_cells.y),
+                                                            wrap(k, n_cells.z)));
+                    }
+                }
+            }
+        }
+
+    std::sort(m_boundary_cells.begin(), m_boundary_cells.end());
+    m_boundary_cells.erase(std::unique(m_boundary_cells.begin(), m_boundary_cells.end()),
+                           m_boundary_cells.end());
+    }
+
+/*!
+ * \param timestep Current timestep to draw particles
+ *
+ * Each boundary cell draws the same number of candidates from its own random stream, so the
+ * positions do not depend on the domain decomposition. Each rank keeps only the particles inside
+ * its local box.
+ *
+ * In persistent mode, the positions must cover every grid shift. A cell cut by the mesh for some
+ * grid shift lies within one cell size of the mesh, so the unshifted cells within one cell size of
+ * the mesh are filled instead.
+ */
+void mpcd::MeshGeometryFiller::computeNumFill(uint64_t timestep)
+    {
+    m_cl->computeDimensions();
+    const Scalar cell_size = m_cl->getCellSize();
+    Scalar3 grid_shift = m_cl->getGridShift();
+    Scalar margin = 0;
+    if (m_persistent)
+        {
+        grid_shift = make_scalar3(0, 0, 0);
+        if (m_cl->getMaxGridShift() > Scalar(0))
+            margin = cell_size;
+        }
+    findBoundaryCells(grid_shift, margin);
+
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    const BoxDim& box = m_pdata->getBox();
+    const Scalar3 lo = box.getLo();
+    const Scalar3 hi = box.getHi();
+    const Scalar3 origin = global_box.getLo() + grid_shift;
+    const Index3D& cell_indexer = m_cl->getGlobalCellIndexer();
+    const unsigned int N_draw
+        = (unsigned int)std::round(m_density * cell_size * cell_size * cell_size);
+
+    uint16_t seed = m_sysdef->getSeed();
+
+    m_fill_pos.clear();
+    for (const unsigned int cell : m_boundary_cells)
+        {
+        const uint3 cell_idx = cell_indexer.getTriple(cell);
+        const Scalar3 cell_lo = origin
+                                + cell_size
+                                      * make_scalar3(Scalar(cell_idx.x),
+                                                     Scalar(cell_idx.y),
+                                                     Scalar(cell_idx.z));
+        hoomd::RandomGenerator rng(
+            hoomd::Seed(hoomd::RNGIdentifier::MeshGeometryFiller, timestep, seed),
+            hoomd::Counter(cell, 1));
+        hoomd::UniformDistribution<Scalar> uniform(Scalar(0), cell_size);
+        for (unsigned int i = 0; i < N_draw; ++i)
+            {
+            Scalar3 pos = cell_lo + make_scalar3(uniform(rng), uniform(rng), uniform(rng));
+            int3 image = make_int3(0, 0, 0);
+            global_box.wrap(pos, image);
+
+            if (pos.x < lo.x || pos.x >= hi.x || pos.y < lo.y || pos.y >= hi.y || pos.z < lo.z
+                || pos.z >= hi.z)
+                continue;
+
+            if (m_geom->isOutside(pos))
+                m_fill_pos.push_back(pos);
+            }
+        }
+
+    m_N_fill = (unsigned int)m_fill_pos.size();
+    }
+
+/*!
+ * \param timestep Current timestep to draw particles
+ */
+void mpcd::MeshGeometryFiller::drawParticles(uint64_t timestep)
+    {
+        {
+        ArrayHandle<Scalar4> h_pos(m_mpcd_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        ArrayHandle<unsigned int> h_tag(m_mpcd_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::readwrite);
+
+        // index to start filling from
+        const unsigned int first_idx
+            = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual() - m_N_fill;
+        for (unsigned int i = 0; i < m_N_fill; ++i)
+            {
+            const unsigned int pidx = first_idx + i;
+            const Scalar3 pos = m_fill_pos[i];
+            h_pos.data[pidx] = make_scalar4(pos.x, pos.y, pos.z, __int_as_scalar(m_type));
+            h_tag.data[pidx] = m_first_tag + i;
+            }
+        }
+
+    drawVelocities(timestep);
+    }
+
+/*!
+ * \param timestep Current timestep to draw velocities
+ */
+void mpcd::MeshGeometryFiller::drawVelocities(uint64_t timestep)
+    {
+    ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(),
+                               access_location::host,
+                               access_mode::readwrite);
+
+    const Scalar vel_factor = fast::sqrt((*m_T)(timestep) / m_mpcd_pdata->getMass());
+
+    uint16_t seed = m_sysdef->getSeed();
+
+    // index to start filling from
+    const unsigned int first_idx = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual() - m_N_fill;
+    for (unsigned int i = 0; i < m_N_fill; ++i)
+        {
+        const unsigned int tag = m_first_tag + i;
+        hoomd::RandomGenerator rng(
+            hoomd::Seed(hoomd::RNGIdentifier::MeshGeometryFiller, timestep, seed),
+            hoomd::Counter(tag));
+
+        hoomd::NormalDistribution<Scalar> gen(vel_factor, 0.0);
+        Scalar3 vel;
+        gen(vel.x, vel.y, rng);
+        vel.z = gen(rng);
+        h_vel.data[first_idx + i]
+            = make_scalar4(vel.x, vel.y, vel.z, __int_as_scalar(mpcd::detail::NO_CELL));
+        }
+    }
+
+/*!
+ * \param m Python module to export to
+ */
+void mpcd::detail::export_MeshGeometryFiller(pybind11::module& m)
+    {
+    pybind11::class_<mpcd::MeshGeometryFiller,
+                     mpcd::VirtualParticleFiller,
+                     std::shared_ptr<mpcd::MeshGeometryFiller>>(m, "MeshGeometryFiller")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            Scalar,
+                            unsigned int,
+                            std::shared_ptr<Variant>,
+                            std::shared_ptr<const mpcd::detail::MeshGeometry>>())
+        .def("setGeometry", &mpcd::MeshGeometryFiller::setGeometry);
+    }
+
+    } // end namespace hoomd
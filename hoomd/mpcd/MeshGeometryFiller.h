@@ -0,0 +1,86 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*!
+ * \file mpcd/MeshGeometryFiller.h
+ * \brief Definition of virtual particle filler for mpcd::detail::MeshGeometry.
+ */
+
+#ifndef MPCD_MESH_GEOMETRY_FILLER_H_
+#define MPCD_MESH_GEOMETRY_FILLER_H_
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "MeshGeometry.h"
+#include "VirtualParticleFiller.h"
+
+#include <pybind11/pybind11.h>
+
+namespace hoomd
+    {
+namespace mpcd
+    {
+//! Adds virtual particles to the MPCD particle data for MeshGeometry
+/*!
+ * Only the cells that are cut by the mesh are filled. These boundary cells are found from the
+ * bounding box of each triangle and a test of the triangle plane against the cell, subject to the
+ * grid shift. Each boundary cell is sampled uniformly at the fill density, and the samples that
+ * lie outside the geometry (in the solid) are kept. The positions are drawn in computeNumFill() so
+ * that the number of virtual particles is known before they are added.
+ *
+ * The walls of a MeshGeometry are stationary, so the virtual particles have zero mean velocity.
+ *
+ * In persistent mode, the boundary cells are found on the unshifted grid with a margin of one cell
+ * so that the stored positions fill the cells cut by the mesh for any grid shift.
+ */
+class PYBIND11_EXPORT MeshGeometryFiller : public mpcd::VirtualParticleFiller
+    {
+    public:
+    MeshGeometryFiller(std::shared_ptr<SystemDefinition> sysdef,
+                       Scalar density,
+                       unsigned int type,
+                       std::shared_ptr<Variant> T,
+                       std::shared_ptr<const mpcd::detail::MeshGeometry> geom);
+
+    virtual ~MeshGeometryFiller();
+
+    void setGeometry(std::shared_ptr<const mpcd::detail::MeshGeometry> geom)
+        {
+        m_geom = geom;
+        notifyRefill();
+        }
+
+    //! Get the number of boundary cells found by the last fill
+    unsigned int getNumBoundaryCells() const
+        {
+        return (unsigned int)m_boundary_cells.size();
+        }
+
+    protected:
+    std::shared_ptr<const mpcd::detail::MeshGeometry> m_geom;
+    std::vector<unsigned int> m_boundary_cells; //!< Global indexes of the cells cut by the mesh
+    std::vector<Scalar3> m_fill_pos;            //!< Positions of the particles to fill
+
+    //! Compute the total number of particles to fill
+    virtual void computeNumFill(uint64_t timestep);
+
+    //! Draw particles within the fill volume
+    virtual void drawParticles(uint64_t timestep);
+
+    //! Draw the velocities of particles reused from the last fill
+    virtual void drawVelocities(uint64_t timestep);
+
+    //! Find the cells that are cut by the mesh
+    void findBoundaryCells(const Scalar3& grid_shift, Scalar margin);
+    };
+
+namespace detail
+    {
+//! Export MeshGeometryFiller to python
+void export_MeshGeometryFiller(pybind11::module& m);
+    } // end namespace detail
+    } // end namespace mpcd
+    } // end namespace hoomd
+#endif // MPCD_MESH_GEOMETRY_FILLER_H_
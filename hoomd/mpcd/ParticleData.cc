@@ -651,21 +651,15 @@ void mpcd::ParticleData::allocate(unsigned int N_max)
         }
 #endif // ENABLE_MPI
 
-    // Allocate the alternate data
-    GPUArray<Scalar4> pos_alt(N_max, m_exec_conf);
-    m_pos_alt.swap(pos_alt);
-
-    GPUArray<Scalar4> vel_alt(N_max, m_exec_conf);
-    m_vel_alt.swap(vel_alt);
-
-    GPUArray<unsigned int> tag_alt(N_max, m_exec_conf);
-    m_tag_alt.swap(tag_alt);
+    // The alternate data is allocated when it is first used
+    m_pos_alt = GPUArray<Scalar4>();
+    m_vel_alt = GPUArray<Scalar4>();
+    m_tag_alt = GPUArray<unsigned int>();
 
 #ifdef ENABLE_MPI
     if (m_decomposition)
         {
-        GPUArray<unsigned int> comm_flags_alt(N_max, m_exec_conf);
-        m_comm_flags_alt.swap(comm_flags_alt);
+        m_comm_flags_alt = GPUArray<unsigned int>();
 
         GPUArray<unsigned int> remove_ids(N_max, m_exec_conf);
         m_remove_ids.swap(remove_ids);
@@ -704,14 +698,18 @@ void mpcd::ParticleData::reallocate(unsigned int N_max)
         }
 #endif // ENABLE_MPI
 
-    // Reallocate the alternate data
-    m_pos_alt.resize(N_max);
-    m_vel_alt.resize(N_max);
-    m_tag_alt.resize(N_max);
+    // Reallocate the alternate data that has been used, the rest is allocated on first use
+    if (!m_pos_alt.isNull())
+        m_pos_alt.resize(N_max);
+    if (!m_vel_alt.isNull())
+        m_vel_alt.resize(N_max);
+    if (!m_tag_alt.isNull())
+        m_tag_alt.resize(N_max);
 #ifdef ENABLE_MPI
     if (m_decomposition)
         {
-        m_comm_flags_alt.resize(N_max);
+        if (!m_comm_flags_alt.isNull())
+            m_comm_flags_alt.resize(N_max);
         m_remove_ids.resize(N_max);
 
 #ifdef ENABLE_HIP
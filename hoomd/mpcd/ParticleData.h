@@ -48,6 +48,10 @@ namespace mpcd
  * - velocity + cell index in array of Scalar4
  * - tag in array of unsigned int
  *
+ * The alternate arrays used for swapping are only allocated when they are first requested. The
+ * CPU Sorter reorders the particles in place, so only the AT collision rule (velocities) and the
+ * GPU Sorter need them. This roughly halves the memory per MPCD particle in other simulations.
+ *
  * Unlike the standard ParticleData, a reverse tag mapping is not currently maintained
  * in order to save local memory. (That is, it is possible to read the tag of a local particle,
  * but it is not possible to efficiently find the local particle that has a given
@@ -216,38 +220,62 @@ class PYBIND11_EXPORT ParticleData : public Autotuned
     //! Get alternate array of MPCD particle positions
     const GPUArray<Scalar4>& getAltPositions() const
         {
+        allocateAlt(m_pos_alt);
         return m_pos_alt;
         }
 
     //! Swap out alternate MPCD particle position array
     void swapPositions()
         {
+        allocateAlt(m_pos_alt);
         m_pos.swap(m_pos_alt);
         }
 
     //! Get alternate array of MPCD particle velocities
     const GPUArray<Scalar4>& getAltVelocities() const
         {
+        allocateAlt(m_vel_alt);
         return m_vel_alt;
         }
 
     //! Swap out alternate MPCD particle velocity array
     void swapVelocities()
         {
+        allocateAlt(m_vel_alt);
         m_vel.swap(m_vel_alt);
         }
 
     //! Get alternate array of MPCD particle tags
     const GPUArray<unsigned int>& getAltTags() const
         {
+        allocateAlt(m_tag_alt);
         return m_tag_alt;
         }
 
     //! Swap out alternate MPCD particle tags
     void swapTags()
         {
+        allocateAlt(m_tag_alt);
         m_tag.swap(m_tag_alt);
         }
+
+    //! Check if the alternate MPCD particle positions have been allocated
+    bool hasAltPositions() const
+        {
+        return !m_pos_alt.isNull();
+        }
+
+    //! Check if the alternate MPCD particle velocities have been allocated
+    bool hasAltVelocities() const
+        {
+        return !m_vel_alt.isNull();
+        }
+
+    //! Check if the alternate MPCD particle tags have been allocated
+    bool hasAltTags() const
+        {
+        return !m_tag_alt.isNull();
+        }
     //@}
 
     //! \name signal methods
@@ -391,12 +419,14 @@ class PYBIND11_EXPORT ParticleData : public Autotuned
     //! Get the alternate MPCD particle communication flags
     const GPUArray<unsigned int>& getAltCommFlags() const
         {
+        allocateAlt(m_comm_flags_alt);
         return m_comm_flags_alt;
         }
 
     //! Swap out alternate MPCD communication flags
     void swapCommFlags()
         {
+        allocateAlt(m_comm_flags_alt);
         m_comm_flags.swap(m_comm_flags_alt);
         }
 
@@ -421,12 +451,12 @@ class PYBIND11_EXPORT ParticleData : public Autotuned
     GPUArray<unsigned int> m_comm_flags; //!< MPCD particle communication flags
 #endif                                   // ENABLE_MPI
 
-    GPUArray<Scalar4> m_pos_alt;      //!< Alternate position array
-    GPUArray<Scalar4> m_vel_alt;      //!< Alternate velocity array
-    GPUArray<unsigned int> m_tag_alt; //!< Alternate tag array
+    mutable GPUArray<Scalar4> m_pos_alt;      //!< Alternate position array
+    mutable GPUArray<Scalar4> m_vel_alt;      //!< Alternate velocity array
+    mutable GPUArray<unsigned int> m_tag_alt; //!< Alternate tag array
 #ifdef ENABLE_MPI
-    GPUArray<unsigned int> m_comm_flags_alt; //!< Alternate communication flags
-    GPUArray<unsigned int> m_remove_ids;     //!< Partitioned indexes of particles to keep
+    mutable GPUArray<unsigned int> m_comm_flags_alt; //!< Alternate communication flags
+    GPUArray<unsigned int> m_remove_ids;             //!< Partitioned indexes of particles to keep
 #ifdef ENABLE_HIP
     GPUArray<unsigned char> m_remove_flags; //!< Temporary flag to mark keeping particle
     GPUFlags<unsigned int> m_num_remove;    //!< Number of particles to remove
@@ -456,6 +486,22 @@ class PYBIND11_EXPORT ParticleData : public Autotuned
     //! Reallocate data arrays
     void reallocate(unsigned int N_max);
 
+    //! Allocate an alternate array on first use
+    /*!
+     * \param alt Alternate array
+     *
+     * The contents of an alternate array are not meaningful until it is written, so the array
+     * is simply replaced if it does not have the current size.
+     */
+    template<class T> void allocateAlt(GPUArray<T>& alt) const
+        {
+        if (alt.getNumElements() != m_N_max)
+            {
+            GPUArray<T> new_alt(m_N_max, m_exec_conf);
+            alt.swap(new_alt);
+            }
+        }
+
     const static float resize_factor; //!< Amortized growth factor the data arrays
     //! Resize the data
     void resize(unsigned int N);
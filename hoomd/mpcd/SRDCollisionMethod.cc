@@ -10,6 +10,10 @@
 #include "hoomd/RNGIdentifiers.h"
 #include "hoomd/RandomNumbers.h"
 
+#ifdef ENABLE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 namespace hoomd
     {
 mpcd::SRDCollisionMethod::SRDCollisionMethod(std::shared_ptr<SystemDefinition> sysdef,
@@ -71,53 +75,61 @@ void mpcd::SRDCollisionMethod::drawRotationVectors(uint64_t timestep)
 
     uint16_t seed = m_sysdef->getSeed();
 
-    for (unsigned int k = 0; k < ci.getD(); ++k)
-        {
-        for (unsigned int j = 0; j < ci.getH(); ++j)
+    // each row of cells along x is drawn independently, so the rows are threaded
+    const unsigned int n_rows = ci.getH() * ci.getD();
+    auto draw_row = [&](unsigned int row)
+    {
+        const unsigned int j = row % ci.getH();
+        const unsigned int k = row / ci.getH();
+        for (unsigned int i = 0; i < ci.getW(); ++i)
             {
-            for (unsigned int i = 0; i < ci.getW(); ++i)
+            const int3 global_cell = m_cl->getGlobalCell(make_int3(i, j, k));
+            const unsigned int global_idx = global_ci(global_cell.x, global_cell.y, global_cell.z);
+            const unsigned int idx = ci(i, j, k);
+
+            // Initialize the PRNG using the current cell index, timestep, and seed for the hash
+            hoomd::RandomGenerator rng(
+                hoomd::Seed(hoomd::RNGIdentifier::SRDCollisionMethod, timestep, seed),
+                hoomd::Counter(global_idx));
+
+            // draw rotation vector off the surface of the sphere
+            double3 rotvec;
+            hoomd::SpherePointGenerator<double> sphgen;
+            sphgen(rng, rotvec);
+            h_rotvec.data[idx] = rotvec;
+
+            if (use_thermostat)
                 {
-                const int3 global_cell = m_cl->getGlobalCell(make_int3(i, j, k));
-                const unsigned int global_idx
-                    = global_ci(global_cell.x, global_cell.y, global_cell.z);
-                const unsigned int idx = ci(i, j, k);
-
-                // Initialize the PRNG using the current cell index, timestep, and seed for the hash
-                hoomd::RandomGenerator rng(
-                    hoomd::Seed(hoomd::RNGIdentifier::SRDCollisionMethod, timestep, seed),
-                    hoomd::Counter(global_idx));
-
-                // draw rotation vector off the surface of the sphere
-                double3 rotvec;
-                hoomd::SpherePointGenerator<double> sphgen;
-                sphgen(rng, rotvec);
-                h_rotvec.data[idx] = rotvec;
-
-                if (use_thermostat)
+                const double3 cell_energy = h_cell_energy->data[idx];
+                const unsigned int np = __double_as_int(cell_energy.z);
+                double factor = 1.0;
+                if (np > 1)
                     {
-                    const double3 cell_energy = h_cell_energy->data[idx];
-                    const unsigned int np = __double_as_int(cell_energy.z);
-                    double factor = 1.0;
-                    if (np > 1)
-                        {
-                        // the total number of degrees of freedom in the cell divided by 2
-                        const double alpha = m_sysdef->getNDimensions() * (np - 1) / (double)2.;
-
-                        // draw a random kinetic energy for the cell at the set temperature
-                        hoomd::GammaDistribution<double> gamma_gen(alpha, T_set);
-                        const double rand_ke = gamma_gen(rng);
-
-                        // generate the scale factor from the current temperature
-                        // (don't use the kinetic energy of this cell, since this
-                        // is total not relative to COM)
-                        const double cur_ke = alpha * cell_energy.y;
-                        factor = (cur_ke > 0.) ? fast::sqrt(rand_ke / cur_ke) : 1.;
-                        }
-                    h_factors->data[idx] = factor;
+                    // the total number of degrees of freedom in the cell divided by 2
+                    const double alpha = m_sysdef->getNDimensions() * (np - 1) / (double)2.;
+
+                    // draw a random kinetic energy for the cell at the set temperature
+                    hoomd::GammaDistribution<double> gamma_gen(alpha, T_set);
+                    const double rand_ke = gamma_gen(rng);
+
+                    // generate the scale factor from the current temperature
+                    // (don't use the kinetic energy of this cell, since this
+                    // is total not relative to COM)
+                    const double cur_ke = alpha * cell_energy.y;
+                    factor = (cur_ke > 0.) ? fast::sqrt(rand_ke / cur_ke) : 1.;
                     }
+                h_factors->data[idx] = factor;
                 }
             }
-        }
+    };
+
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&] { tbb::parallel_for((unsigned int)0, n_rows, draw_row); });
+#else
+    for (unsigned int row = 0; row < n_rows; ++row)
+        draw_row(row);
+#endif
     }
 
 void mpcd::SRDCollisionMethod::rotate(uint64_t timestep)
@@ -166,8 +178,8 @@ void mpcd::SRDCollisionMethod::rotate(uint64_t timestep)
             new ArrayHandle<double>(m_factors, access_location::host, access_mode::read));
         }
 
-    for (unsigned int cur_p = 0; cur_p < N_tot; ++cur_p)
-        {
+    auto rotate_particle = [&](unsigned int cur_p)
+    {
         double3 vel;
         unsigned int cell;
         // these properties are needed for the embedded particles only
@@ -237,7 +249,15 @@ void mpcd::SRDCollisionMethod::rotate(uint64_t timestep)
             {
             h_vel_embed->data[idx] = make_scalar4(new_vel.x, new_vel.y, new_vel.z, mass);
             }
-        }
+    };
+
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&] { tbb::parallel_for((unsigned int)0, N_tot, rotate_particle); });
+#else
+    for (unsigned int cur_p = 0; cur_p < N_tot; ++cur_p)
+        rotate_particle(cur_p);
+#endif
     }
 
 void mpcd::SRDCollisionMethod::setCellList(std::shared_ptr<mpcd::CellList> cl)
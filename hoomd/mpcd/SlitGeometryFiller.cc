@@ -27,7 +27,7 @@ mpcd::SlitGeometryFiller::~SlitGeometryFiller()
     m_exec_conf->msg->notice(5) << "Destroying MPCD SlitGeometryFiller" << std::endl;
     }
 
-void mpcd::SlitGeometryFiller::computeNumFill()
+void mpcd::SlitGeometryFiller::computeNumFill(uint64_t timestep)
     {
     // as a precaution, validate the global box with the current cell list
     const BoxDim& global_box = m_pdata->getGlobalBox();
@@ -81,9 +81,6 @@ void mpcd::SlitGeometryFiller::drawParticles(uint64_t timestep)
     ArrayHandle<Scalar4> h_pos(m_mpcd_pdata->getPositions(),
                                access_location::host,
                                access_mode::readwrite);
-    ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(),
-                               access_location::host,
-                               access_mode::readwrite);
     ArrayHandle<unsigned int> h_tag(m_mpcd_pdata->getTags(),
                                     access_location::host,
                                     access_mode::readwrite);
@@ -92,8 +89,6 @@ void mpcd::SlitGeometryFiller::drawParticles(uint64_t timestep)
     Scalar3 lo = box.getLo();
     Scalar3 hi = box.getHi();
 
-    const Scalar vel_factor = fast::sqrt((*m_T)(timestep) / m_mpcd_pdata->getMass());
-
     uint16_t seed = m_sysdef->getSeed();
 
     // index to start filling from
@@ -122,17 +117,46 @@ void mpcd::SlitGeometryFiller::drawParticles(uint64_t timestep)
                                         hoomd::UniformDistribution<Scalar>(lo.z, hi.z)(rng),
                                         __int_as_scalar(m_type));
 
+        h_tag.data[pidx] = tag;
+        }
+
+    drawVelocities(timestep);
+    }
+
+/*!
+ * \param timestep Current timestep to draw velocities
+ *
+ * The particles are in the same order as when they were drawn, so the first \a m_N_lo belong to
+ * the lower wall.
+ */
+void mpcd::SlitGeometryFiller::drawVelocities(uint64_t timestep)
+    {
+    ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(),
+                               access_location::host,
+                               access_mode::readwrite);
+
+    const Scalar vel_factor = fast::sqrt((*m_T)(timestep) / m_mpcd_pdata->getMass());
+
+    uint16_t seed = m_sysdef->getSeed();
+
+    // index to start filling from
+    const unsigned int first_idx = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual() - m_N_fill;
+    for (unsigned int i = 0; i < m_N_fill; ++i)
+        {
+        const unsigned int tag = m_first_tag + i;
+        hoomd::RandomGenerator rng(
+            hoomd::Seed(hoomd::RNGIdentifier::SlitGeometryFiller, timestep, seed),
+            hoomd::Counter(tag));
+        signed char sign = (char)((i >= m_N_lo) - (i < m_N_lo));
+
         hoomd::NormalDistribution<Scalar> gen(vel_factor, 0.0);
         Scalar3 vel;
         gen(vel.x, vel.y, rng);
         vel.z = gen(rng);
-        // TODO: should these be given zero net-momentum contribution (relative to the frame of
-        // reference?)
-        h_vel.data[pidx] = make_scalar4(vel.x + sign * m_geom->getVelocity(),
-                                        vel.y,
-                                        vel.z,
-                                        __int_as_scalar(mpcd::detail::NO_CELL));
-        h_tag.data[pidx] = tag;
+        h_vel.data[first_idx + i] = make_scalar4(vel.x + sign * m_geom->getVelocity(),
+                                                 vel.y,
+                                                 vel.z,
+                                                 __int_as_scalar(mpcd::detail::NO_CELL));
         }
     }
 
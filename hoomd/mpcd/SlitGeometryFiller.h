@@ -41,6 +41,7 @@ class PYBIND11_EXPORT SlitGeometryFiller : public mpcd::VirtualParticleFiller
     void setGeometry(std::shared_ptr<const mpcd::detail::SlitGeometry> geom)
         {
         m_geom = geom;
+        notifyRefill();
         }
 
     protected:
@@ -51,10 +52,13 @@ class PYBIND11_EXPORT SlitGeometryFiller : public mpcd::VirtualParticleFiller
     unsigned int m_N_hi; //!< number of particles to fill above channel
 
     //! Compute the total number of particles to fill
-    virtual void computeNumFill();
+    virtual void computeNumFill(uint64_t timestep);
 
     //! Draw particles within the fill volume
     virtual void drawParticles(uint64_t timestep);
+
+    //! Draw the velocities of particles reused from the last fill
+    virtual void drawVelocities(uint64_t timestep);
     };
 
 namespace detail
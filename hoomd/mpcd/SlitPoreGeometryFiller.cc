@@ -44,7 +44,7 @@ mpcd::SlitPoreGeometryFiller::~SlitPoreGeometryFiller()
             this);
     }
 
-void mpcd::SlitPoreGeometryFiller::computeNumFill()
+void mpcd::SlitPoreGeometryFiller::computeNumFill(uint64_t timestep)
     {
     const Scalar cell_size = m_cl->getCellSize();
     const Scalar max_shift = m_cl->getMaxGridShift();
@@ -153,13 +153,9 @@ void mpcd::SlitPoreGeometryFiller::drawParticles(uint64_t timestep)
     ArrayHandle<Scalar4> h_pos(m_mpcd_pdata->getPositions(),
                                access_location::host,
                                access_mode::readwrite);
-    ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(),
-                               access_location::host,
-                               access_mode::readwrite);
     ArrayHandle<unsigned int> h_tag(m_mpcd_pdata->getTags(),
                                     access_location::host,
                                     access_mode::readwrite);
-    const Scalar vel_factor = fast::sqrt((*m_T)(timestep) / m_mpcd_pdata->getMass());
 
     const BoxDim& box = m_pdata->getBox();
     Scalar3 lo = box.getLo();
@@ -201,15 +197,39 @@ void mpcd::SlitPoreGeometryFiller::drawParticles(uint64_t timestep)
                                         hoomd::UniformDistribution<Scalar>(lo.z, hi.z)(rng),
                                         __int_as_scalar(m_type));
 
+        h_tag.data[pidx] = tag;
+        }
+
+    drawVelocities(timestep);
+    }
+
+/*!
+ * \param timestep Current timestep to draw velocities
+ */
+void mpcd::SlitPoreGeometryFiller::drawVelocities(uint64_t timestep)
+    {
+    ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(),
+                               access_location::host,
+                               access_mode::readwrite);
+    const Scalar vel_factor = fast::sqrt((*m_T)(timestep) / m_mpcd_pdata->getMass());
+
+    uint16_t seed = m_sysdef->getSeed();
+
+    // index to start filling from
+    const unsigned int first_idx = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual() - m_N_fill;
+    for (unsigned int i = 0; i < m_N_fill; ++i)
+        {
+        const unsigned int tag = m_first_tag + i;
+        hoomd::RandomGenerator rng(
+            hoomd::Seed(hoomd::RNGIdentifier::SlitPoreGeometryFiller, timestep, seed),
+            hoomd::Counter(tag));
+
         hoomd::NormalDistribution<Scalar> gen(vel_factor, 0.0);
         Scalar3 vel;
         gen(vel.x, vel.y, rng);
         vel.z = gen(rng);
-        // TODO: should these be given zero net-momentum contribution (relative to the frame of
-        // reference?)
-        h_vel.data[pidx]
+        h_vel.data[first_idx + i]
             = make_scalar4(vel.x, vel.y, vel.z, __int_as_scalar(mpcd::detail::NO_CELL));
-        h_tag.data[pidx] = tag;
         }
     }
 
@@ -43,6 +43,7 @@ class PYBIND11_EXPORT SlitPoreGeometryFiller : public mpcd::VirtualParticleFille
         {
         m_geom = geom;
         notifyRecompute();
+        notifyRefill();
         }
 
     protected:
@@ -54,11 +55,14 @@ class PYBIND11_EXPORT SlitPoreGeometryFiller : public mpcd::VirtualParticleFille
     GPUArray<uint2> m_ranges;                //!< Particle tag ranges for filling
 
     //! Compute the total number of particles to fill
-    virtual void computeNumFill();
+    virtual void computeNumFill(uint64_t timestep);
 
     //! Draw particles within the fill volume
     virtual void drawParticles(uint64_t timestep);
 
+    //! Draw the velocities of particles reused from the last fill
+    virtual void drawVelocities(uint64_t timestep);
+
     private:
     bool m_needs_recompute;
     Scalar3 m_recompute_cache;
@@ -8,6 +8,12 @@
 
 #include "Sorter.h"
 
+#include <numeric>
+
+#ifdef ENABLE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 namespace hoomd
     {
 /*!
@@ -63,6 +69,10 @@ void mpcd::Sorter::update(uint64_t timestep)
  * Loop through the computed cell list and generate a compacted list of the order
  * particles appear. This will put the particles into a cell-list order, which
  * should be more friendly for other MPCD cell-based operations.
+ *
+ * The cell list is already a counting sort of the particles by cell, so only the compaction is
+ * needed. With multiple threads, the cells are split into contiguous chunks. Each chunk counts its
+ * MPCD particles, and a prefix sum over the chunks gives where each chunk starts writing.
  */
 void mpcd::Sorter::computeOrder(uint64_t timestep)
     {
@@ -81,22 +91,65 @@ void mpcd::Sorter::computeOrder(uint64_t timestep)
     ArrayHandle<unsigned int> h_order(m_order, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_rorder(m_rorder, access_location::host, access_mode::overwrite);
     const unsigned int N_mpcd = m_mpcd_pdata->getN();
-    unsigned int cur_p = 0;
-    for (unsigned int idx = 0; idx < m_cl->getNCells(); ++idx)
-        {
-        const unsigned int np = h_cell_np.data[idx];
-        for (unsigned int offset = 0; offset < np; ++offset)
+    const unsigned int n_cells = m_cl->getNCells();
+
+    // write the order of the MPCD particles in cells [first, last), starting from cur_p
+    auto order_cells = [&](unsigned int first, unsigned int last, unsigned int cur_p)
+    {
+        for (unsigned int idx = first; idx < last; ++idx)
             {
-            const unsigned int pid = h_cell_list.data[cli(offset, idx)];
-            // only count MPCD particles, and skip embedded particles
-            if (pid < N_mpcd)
+            const unsigned int np = h_cell_np.data[idx];
+            for (unsigned int offset = 0; offset < np; ++offset)
                 {
-                h_order.data[cur_p] = pid;
-                h_rorder.data[pid] = cur_p;
-                ++cur_p;
+                const unsigned int pid = h_cell_list.data[cli(offset, idx)];
+                // only count MPCD particles, and skip embedded particles
+                if (pid < N_mpcd)
+                    {
+                    h_order.data[cur_p] = pid;
+                    h_rorder.data[pid] = cur_p;
+                    ++cur_p;
+                    }
                 }
             }
+    };
+
+#ifdef ENABLE_TBB
+    const unsigned int n_chunks = std::min(m_exec_conf->getNumThreads(), n_cells);
+    if (n_chunks > 1)
+        {
+        auto chunk_begin = [&](unsigned int chunk)
+        { return (unsigned int)(size_t(n_cells) * chunk / n_chunks); };
+
+        // count the MPCD particles in each chunk of cells
+        std::vector<unsigned int> chunk_start(n_chunks + 1, 0);
+        auto count_chunk = [&](unsigned int chunk)
+        {
+            unsigned int n = 0;
+            const unsigned int last = chunk_begin(chunk + 1);
+            for (unsigned int idx = chunk_begin(chunk); idx < last; ++idx)
+                {
+                const unsigned int np = h_cell_np.data[idx];
+                for (unsigned int offset = 0; offset < np; ++offset)
+                    {
+                    if (h_cell_list.data[cli(offset, idx)] < N_mpcd)
+                        ++n;
+                    }
+                }
+            chunk_start[chunk + 1] = n;
+        };
+        auto order_chunk = [&](unsigned int chunk)
+        { order_cells(chunk_begin(chunk), chunk_begin(chunk + 1), chunk_start[chunk]); };
+
+        m_exec_conf->getTaskArena()->execute(
+            [&] { tbb::parallel_for((unsigned int)0, n_chunks, count_chunk); });
+        std::partial_sum(chunk_start.begin(), chunk_start.end(), chunk_start.begin());
+        m_exec_conf->getTaskArena()->execute(
+            [&] { tbb::parallel_for((unsigned int)0, n_chunks, order_chunk); });
+        return;
         }
+#endif // ENABLE_TBB
+
+    order_cells(0, n_cells, 0);
     }
 
 /*!
@@ -105,7 +158,7 @@ void mpcd::Sorter::computeOrder(uint64_t timestep)
  * be implemented without having to duplicate the application of the sort.
  *
  * The sorted order is applied by swapping out the alternate per-particle data
- * arrays. The communication flags are \b not sorted in MPI because by design,
+ * arrays, which are allocated by the first sort. The communication flags are \b not sorted in MPI because by design,
  * the caller is responsible for clearing out any old flags before using them.
  */
 void mpcd::Sorter::applyOrder() const
@@ -134,13 +187,21 @@ void mpcd::Sorter::applyOrder() const
                                             access_location::host,
                                             access_mode::overwrite);
 
-        for (unsigned int idx = 0; idx < m_mpcd_pdata->getN(); ++idx)
-            {
+        auto apply_particle = [&](unsigned int idx)
+        {
             const unsigned int old_idx = h_order.data[idx];
             h_pos_alt.data[idx] = h_pos.data[old_idx];
             h_vel_alt.data[idx] = h_vel.data[old_idx];
             h_tag_alt.data[idx] = h_tag.data[old_idx];
-            }
+        };
+
+#ifdef ENABLE_TBB
+        m_exec_conf->getTaskArena()->execute(
+            [&] { tbb::parallel_for((unsigned int)0, m_mpcd_pdata->getN(), apply_particle); });
+#else
+        for (unsigned int idx = 0; idx < m_mpcd_pdata->getN(); ++idx)
+            apply_particle(idx);
+#endif
 
         // copy virtual particle data if it exists
         if (m_mpcd_pdata->getNVirtual() > 0)
@@ -8,6 +8,8 @@
 
 #include "StreamingGeometry.h"
 
+#include <pybind11/numpy.h>
+
 namespace hoomd
     {
 namespace mpcd
@@ -45,6 +47,43 @@ void export_SlitPoreGeometry(pybind11::module& m)
         .def("getBoundaryCondition", &SlitPoreGeometry::getBoundaryCondition);
     }
 
+/*!
+ * The mesh is constructed from an (N,3) array of vertices and an (M,3) array of the vertex
+ * indexes of each triangle.
+ */
+void export_MeshGeometry(pybind11::module& m)
+    {
+    pybind11::class_<MeshGeometry, std::shared_ptr<MeshGeometry>>(m, "MeshGeometry")
+        .def(pybind11::init(
+            [](pybind11::array_t<Scalar, pybind11::array::c_style | pybind11::array::forcecast>
+                   vertices,
+               pybind11::array_t<unsigned int,
+                                 pybind11::array::c_style | pybind11::array::forcecast> triangles,
+               boundary bc)
+            {
+                if (vertices.ndim() != 2 || vertices.shape(1) != 3 || triangles.ndim() != 2
+                    || triangles.shape(1) != 3)
+                    {
+                    throw std::runtime_error("Mesh vertices and triangles must have shape (N,3)");
+                    }
+                const Scalar* v = vertices.data();
+                std::vector<Scalar3> verts(vertices.shape(0));
+                for (size_t i = 0; i < verts.size(); ++i)
+                    {
+                    verts[i] = make_scalar3(v[3 * i], v[3 * i + 1], v[3 * i + 2]);
+                    }
+                const unsigned int* t = triangles.data();
+                std::vector<uint3> tris(triangles.shape(0));
+                for (size_t i = 0; i < tris.size(); ++i)
+                    {
+                    tris[i] = make_uint3(t[3 * i], t[3 * i + 1], t[3 * i + 2]);
+                    }
+                return std::make_shared<MeshGeometry>(verts, tris, bc);
+            }))
+        .def("getNumTriangles", &MeshGeometry::getNumTriangles)
+        .def("getBoundaryCondition", &MeshGeometry::getBoundaryCondition);
+    }
+
     } // end namespace detail
     } // end namespace mpcd
     } // end namespace hoomd
@@ -15,6 +15,7 @@
 #include "SlitPoreGeometry.h"
 
 #ifndef __HIPCC__
+#include "MeshGeometry.h"
 #include <pybind11/pybind11.h>
 
 namespace hoomd
@@ -35,6 +36,9 @@ void export_SlitGeometry(pybind11::module& m);
 //! Export SlitPoreGeometry to python
 void export_SlitPoreGeometry(pybind11::module& m);
 
+//! Export MeshGeometry to python
+void export_MeshGeometry(pybind11::module& m);
+
     } // end namespace detail
     } // end namespace mpcd
     } // end namespace hoomd
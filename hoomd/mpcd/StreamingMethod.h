@@ -14,6 +14,7 @@
 #endif
 
 #include "CellList.h"
+#include "CellThermoCompute.h"
 #include "ExternalField.h"
 #include "hoomd/Autotuned.h"
 #include "hoomd/GPUPolymorph.h"
@@ -81,12 +82,39 @@ class PYBIND11_EXPORT StreamingMethod : public Autotuned
     //! Set the period of the streaming method
     void setPeriod(unsigned int cur_timestep, unsigned int period);
 
+    //! Get the period of the streaming method
+    unsigned int getPeriod() const
+        {
+        return m_period;
+        }
+
+    //! Get the cell list used for collisions
+    std::shared_ptr<mpcd::CellList> getCellList() const
+        {
+        return m_cl;
+        }
+
     //! Set the cell list used for collisions
     virtual void setCellList(std::shared_ptr<mpcd::CellList> cl)
         {
         m_cl = cl;
         }
 
+    //! Build the cell list and cell properties for a collision during the next streaming step
+    /*!
+     * \param thermo Cell properties to compute, using the cell list of the streaming method
+     * \param timestep Timestep of the collision
+     *
+     * Streaming methods that support it bin the particles and sum the cell properties in the
+     * same sweep over the particles as the streaming. Otherwise, the request is ignored and the
+     * cell list and properties are computed as usual by the collision method.
+     */
+    void setSweep(std::shared_ptr<mpcd::CellThermoCompute> thermo, uint64_t timestep)
+        {
+        m_sweep_thermo = thermo;
+        m_sweep_timestep = timestep;
+        }
+
     protected:
     std::shared_ptr<SystemDefinition> m_sysdef;                //!< HOOMD system definition
     std::shared_ptr<hoomd::ParticleData> m_pdata;              //!< HOOMD particle data
@@ -100,6 +128,9 @@ class PYBIND11_EXPORT StreamingMethod : public Autotuned
 
     std::shared_ptr<hoomd::GPUPolymorph<mpcd::ExternalField>> m_field; //!< External field
 
+    std::shared_ptr<mpcd::CellThermoCompute> m_sweep_thermo; //!< Cell properties to sweep
+    uint64_t m_sweep_timestep = 0;                           //!< Timestep of the sweep collision
+
     //! Check if streaming should occur
     virtual bool shouldStream(uint64_t timestep);
     };
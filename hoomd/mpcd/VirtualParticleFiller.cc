@@ -16,10 +16,26 @@ mpcd::VirtualParticleFiller::VirtualParticleFiller(std::shared_ptr<SystemDefinit
                                                    std::shared_ptr<Variant> T)
     : m_sysdef(sysdef), m_pdata(m_sysdef->getParticleData()), m_exec_conf(m_pdata->getExecConf()),
       m_mpcd_pdata(m_sysdef->getMPCDParticleData()), m_density(density), m_type(type), m_T(T),
-      m_N_fill(0), m_first_tag(0)
+      m_N_fill(0), m_first_tag(0), m_persistent(false), m_needs_refill(true),
+      m_refill_cache(make_scalar3(-1, -1, -1))
     {
+    m_pdata->getBoxChangeSignal()
+        .connect<mpcd::VirtualParticleFiller, &mpcd::VirtualParticleFiller::notifyRefill>(this);
     }
 
+mpcd::VirtualParticleFiller::~VirtualParticleFiller()
+    {
+    m_pdata->getBoxChangeSignal()
+        .disconnect<mpcd::VirtualParticleFiller, &mpcd::VirtualParticleFiller::notifyRefill>(this);
+    }
+
+/*!
+ * \param timestep Current timestep
+ *
+ * In persistent mode, the positions of the last fill are copied back in if they are still valid,
+ * and only the velocities are drawn. The tags are always assigned again because the number of
+ * MPCD particles may have changed.
+ */
 void mpcd::VirtualParticleFiller::fill(uint64_t timestep)
     {
     if (!m_cl)
@@ -27,8 +43,17 @@ void mpcd::VirtualParticleFiller::fill(uint64_t timestep)
         throw std::runtime_error("Cell list has not been set");
         }
 
+    // check if fill-relevant variables have changed (can't use signal because cell list build may
+    // not have triggered yet)
+    const Scalar3 refill_cache
+        = make_scalar3(m_cl->getCellSize(), m_cl->getMaxGridShift(), m_density);
+    m_needs_refill |= (m_refill_cache.x != refill_cache.x || m_refill_cache.y != refill_cache.y
+                       || m_refill_cache.z != refill_cache.z);
+    const bool reuse = m_persistent && !m_needs_refill;
+
     // update the fill volume
-    computeNumFill();
+    if (!reuse)
+        computeNumFill(timestep);
 
     // in mpi, do a prefix scan on the tag offset in this range
     // then shift the first tag by the current number of particles, which ensures a compact tag
@@ -51,12 +76,67 @@ void mpcd::VirtualParticleFiller::fill(uint64_t timestep)
     // add the new virtual particles locally
     m_mpcd_pdata->addVirtualParticles(m_N_fill);
 
-    // draw the particles consistent with those tags
-    drawParticles(timestep);
+    const unsigned int first_idx = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual() - m_N_fill;
+    if (reuse)
+        {
+            // copy in the stored positions with the new tags
+            {
+            ArrayHandle<Scalar4> h_pos(m_mpcd_pdata->getPositions(),
+                                       access_location::host,
+                                       access_mode::readwrite);
+            ArrayHandle<unsigned int> h_tag(m_mpcd_pdata->getTags(),
+                                            access_location::host,
+                                            access_mode::readwrite);
+            std::copy(m_persistent_pos.begin(), m_persistent_pos.end(), h_pos.data + first_idx);
+            for (unsigned int i = 0; i < m_N_fill; ++i)
+                h_tag.data[first_idx + i] = m_first_tag + i;
+            }
+
+        drawVelocities(timestep);
+        }
+    else
+        {
+        // draw the particles consistent with those tags
+        drawParticles(timestep);
+
+        // store the positions for the next fill
+        if (m_persistent)
+            {
+            ArrayHandle<Scalar4> h_pos(m_mpcd_pdata->getPositions(),
+                                       access_location::host,
+                                       access_mode::read);
+            m_persistent_pos.assign(h_pos.data + first_idx, h_pos.data + first_idx + m_N_fill);
+            m_needs_refill = false;
+            m_refill_cache = refill_cache;
+            }
+        }
 
     m_mpcd_pdata->invalidateCellCache();
     }
 
+/*!
+ * \param persistent If true, reuse the positions of the virtual particles between fills
+ */
+void mpcd::VirtualParticleFiller::setPersistent(bool persistent)
+    {
+    if (persistent && m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->error()
+            << "Persistent MPCD virtual particle filling is only supported on the CPU" << std::endl;
+        throw std::runtime_error("Persistent virtual particle filling not supported on the GPU");
+        }
+    m_persistent = persistent;
+    notifyRefill();
+    }
+
+/*!
+ * \param timestep Current timestep
+ */
+void mpcd::VirtualParticleFiller::drawVelocities(uint64_t timestep)
+    {
+    throw std::runtime_error("Virtual particle filler does not support persistent filling");
+    }
+
 void mpcd::VirtualParticleFiller::setDensity(Scalar density)
     {
     if (density <= Scalar(0.0))
@@ -65,6 +145,7 @@ void mpcd::VirtualParticleFiller::setDensity(Scalar density)
         throw std::runtime_error("Invalid virtual particle density");
         }
     m_density = density;
+    notifyRefill();
     }
 
 void mpcd::VirtualParticleFiller::setType(unsigned int type)
@@ -76,6 +157,7 @@ void mpcd::VirtualParticleFiller::setType(unsigned int type)
         throw std::runtime_error("Invalid type id");
         }
     m_type = type;
+    notifyRefill();
     }
 
 /*!
@@ -92,7 +174,9 @@ void mpcd::detail::export_VirtualParticleFiller(pybind11::module& m)
                             std::shared_ptr<Variant>>())
         .def("setDensity", &mpcd::VirtualParticleFiller::setDensity)
         .def("setType", &mpcd::VirtualParticleFiller::setType)
-        .def("setTemperature", &mpcd::VirtualParticleFiller::setTemperature);
+        .def("setTemperature", &mpcd::VirtualParticleFiller::setTemperature)
+        .def("setPersistent", &mpcd::VirtualParticleFiller::setPersistent)
+        .def("getPersistent", &mpcd::VirtualParticleFiller::getPersistent);
     }
 
     } // end namespace hoomd
@@ -20,6 +20,8 @@
 #include "hoomd/Variant.h"
 #include <pybind11/pybind11.h>
 
+#include <vector>
+
 namespace hoomd
     {
 namespace mpcd
@@ -33,6 +35,12 @@ namespace mpcd
  * class must then implement two methods:
  *  1. computeNumFill(), which is the number of virtual particles to add.
  *  2. drawParticles(), which is the rule to determine where to put the particles.
+ *
+ * In persistent mode, the positions of the virtual particles are stored after they are drawn and
+ * reused by later fills. Only the velocities are redrawn using drawVelocities(), which a deriving
+ * class must implement to support this mode. The stored positions are drawn again if the box, cell
+ * size, maximum grid shift, density, type, or geometry changes, so the fill volume must not depend
+ * on the current grid shift.
  */
 class PYBIND11_EXPORT VirtualParticleFiller : public Autotuned
     {
@@ -42,7 +50,7 @@ class PYBIND11_EXPORT VirtualParticleFiller : public Autotuned
                           unsigned int type,
                           std::shared_ptr<Variant> T);
 
-    virtual ~VirtualParticleFiller() { }
+    virtual ~VirtualParticleFiller();
 
     //! Fill up virtual particles
     void fill(uint64_t timestep);
@@ -53,6 +61,15 @@ class PYBIND11_EXPORT VirtualParticleFiller : public Autotuned
     //! Set the fill particle type
     void setType(unsigned int type);
 
+    //! Set whether the virtual particle positions are reused between fills
+    void setPersistent(bool persistent);
+
+    //! Get whether the virtual particle positions are reused between fills
+    bool getPersistent() const
+        {
+        return m_persistent;
+        }
+
     //! Set the fill particle temperature
     void setTemperature(std::shared_ptr<Variant> T)
         {
@@ -63,6 +80,7 @@ class PYBIND11_EXPORT VirtualParticleFiller : public Autotuned
     virtual void setCellList(std::shared_ptr<mpcd::CellList> cl)
         {
         m_cl = cl;
+        notifyRefill();
         }
 
     protected:
@@ -79,11 +97,25 @@ class PYBIND11_EXPORT VirtualParticleFiller : public Autotuned
     unsigned int m_N_fill;    //!< Number of particles to fill locally
     unsigned int m_first_tag; //!< First tag of locally held particles
 
+    bool m_persistent;                     //!< If true, reuse the positions of the last fill
+    bool m_needs_refill;                   //!< If true, the stored positions must be drawn again
+    Scalar3 m_refill_cache;                //!< Cell size, max grid shift, and density of the fill
+    std::vector<Scalar4> m_persistent_pos; //!< Stored positions and types of the last fill
+
+    //! Mark the stored positions as out of date
+    void notifyRefill()
+        {
+        m_needs_refill = true;
+        }
+
     //! Compute the total number of particles to fill
-    virtual void computeNumFill() { }
+    virtual void computeNumFill(uint64_t timestep) { }
 
     //! Draw particles within the fill volume
     virtual void drawParticles(uint64_t timestep) { }
+
+    //! Draw the velocities of particles reused from the last fill
+    virtual void drawVelocities(uint64_t timestep);
     };
 
 namespace detail
@@ -111,6 +111,8 @@ class integrator():
                     advance the real time of the system forward by *dt* (in time units).
         aniso (bool): Whether to integrate rotational degrees of freedom (bool),
                       default None (autodetect).
+        fuse_collision (bool): Whether to compute the cell list and cell
+                               properties for a collision while streaming.
 
     The MPCD integrator enables the MPCD algorithm concurrently with standard
     MD :py:mod:`~hoomd.md.methods` methods. An integrator must be created
@@ -135,14 +137,24 @@ class integrator():
     The MD particles can be read at any time step because their positions
     are updated every step.
 
+    When *fuse_collision* is True, a streaming step that is directly followed
+    by a collision also bins the MPCD particles into cells and sums the cell
+    momentum and energy in the same pass over the particles, in parallel with
+    TBB. This saves a pass over the MPCD particle data in memory bound
+    simulations. Fusing is only done on the CPU in simulations without domain
+    decomposition, virtual particles, or embedded particles, and it works best
+    when the particles are sorted with :py:class:`~hoomd.mpcd.update.sort`.
+    The cell properties may differ from the unfused calculation by round off.
+
     Examples::
 
         mpcd.integrator(dt=0.1)
         mpcd.integrator(dt=0.01, aniso=True)
+        mpcd.integrator(dt=0.1, fuse_collision=True)
 
     """
 
-    def __init__(self, dt, aniso=None):
+    def __init__(self, dt, aniso=None, fuse_collision=False):
         # check system is initialized
         if hoomd.context.current.mpcd is None:
             hoomd.context.current.device.cpp_msg.error(
@@ -155,7 +167,8 @@ class integrator():
         self.supports_methods = True
         self.dt = dt
         self.aniso = aniso
-        self.metadata_fields = ['dt', 'aniso']
+        self.fuse_collision = fuse_collision
+        self.metadata_fields = ['dt', 'aniso', 'fuse_collision']
 
         # configure C++ integrator
         self.cpp_integrator = _mpcd.Integrator(hoomd.context.current.mpcd.data,
@@ -164,23 +177,27 @@ class integrator():
             self.cpp_integrator.setMPCDCommunicator(
                 hoomd.context.current.mpcd.comm)
         hoomd.context.current.system.setIntegrator(self.cpp_integrator)
+        self.cpp_integrator.fuse_collision = self.fuse_collision
 
         if self.aniso is not None:
             self.set_params(aniso=aniso)
 
     _aniso_modes = {}
 
-    def set_params(self, dt=None, aniso=None):
+    def set_params(self, dt=None, aniso=None, fuse_collision=None):
         """ Changes parameters of an existing integration mode.
 
         Args:
             dt (float): New time step delta (if set) (in time units).
             aniso (bool): Anisotropic integration mode (bool), default None (autodetect).
+            fuse_collision (bool): Whether to compute the collision cell
+                                   properties while streaming (if set).
 
         Examples::
 
             integrator.set_params(dt=0.007)
             integrator.set_params(dt=0.005, aniso=False)
+            integrator.set_params(fuse_collision=True)
 
         """
         self.check_initialization()
@@ -202,6 +219,10 @@ class integrator():
             self.aniso = aniso
             self.cpp_integrator.setAnisotropicMode(anisoMode)
 
+        if fuse_collision is not None:
+            self.fuse_collision = fuse_collision
+            self.cpp_integrator.fuse_collision = fuse_collision
+
     def update_methods(self):
         self.check_initialization()
 
@@ -324,7 +324,7 @@ class slit(_streaming_method):
             _mpcd.SlitGeometry(H, V, bc),
         )
 
-    def set_filler(self, density, kT, seed, type="A"):
+    def set_filler(self, density, kT, seed, type="A", persistent=False):
         r"""Add virtual particles to slit channel.
 
         Args:
@@ -332,6 +332,8 @@ class slit(_streaming_method):
             kT (float): Temperature of virtual particles.
             seed (int): Seed to pseudo-random number generator for virtual particles.
             type (str): Type of the MPCD particles to fill with.
+            persistent (bool): If True, reuse the positions of the virtual
+                particles between fills and only draw new velocities.
 
         The virtual particle filler draws particles within the volume *outside* the
         slit walls that could be overlapped by any cell that is partially *inside*
@@ -344,6 +346,14 @@ class slit(_streaming_method):
         The virtual particles will act as a weak thermostat on the fluid, and so energy
         is no longer conserved. Momentum will also be sunk into the walls.
 
+        With *persistent*, the positions of the virtual particles are drawn
+        once and then reused on every collision step, so that only their
+        velocities are drawn again. The positions are drawn again if the
+        box, cell size, density, type, or geometry changes. This is faster
+        for static walls, but the virtual particles no longer sample new
+        positions in the walls. Persistent filling is only supported on the
+        CPU.
+
         Example::
 
             slit.set_filler(density=5.0, kT=1.0, seed=42)
@@ -373,6 +383,7 @@ class slit(_streaming_method):
             self._filler.setType(type_id)
             self._filler.setTemperature(T.cpp_variant)
             self._filler.setSeed(seed)
+        self._filler.setPersistent(persistent)
 
     def remove_filler(self):
         """Remove the virtual particle filler.
@@ -478,7 +489,7 @@ class slit_pore(_streaming_method):
             _mpcd.SlitPoreGeometry(H, L, bc),
         )
 
-    def set_filler(self, density, kT, seed, type="A"):
+    def set_filler(self, density, kT, seed, type="A", persistent=False):
         r"""Add virtual particles to slit pore.
 
         Args:
@@ -486,6 +497,8 @@ class slit_pore(_streaming_method):
             kT (float): Temperature of virtual particles.
             seed (int): Seed to pseudo-random number generator for virtual particles.
             type (str): Type of the MPCD particles to fill with.
+            persistent (bool): If True, reuse the positions of the virtual
+                particles between fills and only draw new velocities.
 
         The virtual particle filler draws particles within the volume *outside* the
         slit pore boundaries that could be overlapped by any cell that is partially *inside*
@@ -497,6 +510,14 @@ class slit_pore(_streaming_method):
         The virtual particles will act as a weak thermostat on the fluid, and so energy
         is no longer conserved. Momentum will also be sunk into the walls.
 
+        With *persistent*, the positions of the virtual particles are drawn
+        once and then reused on every collision step, so that only their
+        velocities are drawn again. The positions are drawn again if the
+        box, cell size, density, type, or geometry changes. This is faster
+        for static walls, but the virtual particles no longer sample new
+        positions in the walls. Persistent filling is only supported on the
+        CPU.
+
         Example::
 
             slit_pore.set_filler(density=5.0, kT=1.0, seed=42)
@@ -523,6 +544,7 @@ class slit_pore(_streaming_method):
             self._filler.setType(type_id)
             self._filler.setTemperature(T.cpp_variant)
             self._filler.setSeed(seed)
+        self._filler.setPersistent(persistent)
 
     def remove_filler(self):
         """Remove the virtual particle filler.
@@ -566,3 +588,151 @@ class slit_pore(_streaming_method):
         self._cpp.geometry = _mpcd.SlitPoreGeometry(self.H, self.L, bc)
         if self._filler is not None:
             self._filler.setGeometry(self._cpp.geometry)
+
+
+class mesh(_streaming_method):
+    r"""Triangle mesh streaming geometry.
+
+    Args:
+        vertices ((*N*, 3) `numpy.ndarray` of float): Vertices of the mesh.
+        triangles ((*M*, 3) `numpy.ndarray` of int): Indexes of the three
+            vertices of each triangle.
+        boundary (str): boundary condition at wall ("slip" or "no_slip"")
+        period (int): Number of integration steps between collisions
+
+    The mesh geometry confines the fluid by solid surfaces made of triangles,
+    so that complex channels and obstacles can be simulated without a
+    dedicated geometry. The vertices of each triangle must be ordered
+    counterclockwise when viewed from the fluid, so that the triangle normal
+    points into the fluid. The "inside" of the :py:class:`mesh` is the space
+    in front of the closest triangle.
+
+    The triangles are stored in a bounding volume hierarchy, so the cost of
+    the bounce-back is roughly independent of the number of triangles.
+
+    The mesh is not periodic. Surfaces that cross a periodic boundary of the
+    simulation box must be continued past the boundary (by at least the
+    distance that a particle travels in one streaming step) consistently with
+    their periodic image. The walls are stationary.
+
+    Note:
+        The mesh geometry is only implemented on the CPU.
+
+    Examples::
+
+        stream.mesh(vertices=verts, triangles=tris, period=10)
+
+    """
+
+    def __init__(self, vertices, triangles, boundary="no_slip", period=1):
+        _streaming_method.__init__(self, period)
+
+        self.vertices = vertices
+        self.triangles = triangles
+        self.boundary = boundary
+
+        bc = self._process_boundary(boundary)
+
+        # create the base streaming class
+        if hoomd.context.current.device.cpp_exec_conf.isCUDAEnabled():
+            hoomd.context.current.device.cpp_msg.error(
+                "mpcd.stream: mesh geometry is not supported on the GPU.\n")
+            raise RuntimeError("Mesh geometry is not supported on the GPU")
+        self._cpp = _mpcd.ConfinedStreamingMethodMesh(
+            hoomd.context.current.mpcd.data,
+            hoomd.context.current.system.getCurrentTimeStep(),
+            self.period,
+            0,
+            _mpcd.MeshGeometry(vertices, triangles, bc),
+        )
+
+    def set_filler(self, density, kT, type="A", persistent=False):
+        r"""Add virtual particles to the cells cut by the mesh.
+
+        Args:
+            density (float): Density of virtual particles.
+            kT (float): Temperature of virtual particles.
+            type (str): Type of the MPCD particles to fill with.
+            persistent (bool): If True, reuse the positions of the virtual
+                particles between fills and only draw new velocities.
+
+        The virtual particle filler draws particles only in the cells that are
+        cut by a triangle of the mesh, in the part of those cells that is
+        *outside* the geometry. The particles are drawn from the velocity
+        distribution consistent with *kT* and with the given *density*, with
+        zero mean velocity. Typically, the virtual particle density and
+        temperature are set to the same conditions as the solvent.
+
+        With *persistent*, the positions of the virtual particles are drawn
+        once and then reused on every collision step, so that only their
+        velocities are drawn again. Because the grid shift changes between
+        collisions, all cells within one cell size of the mesh are filled in
+        this mode. The positions are drawn again if the box, cell size,
+        density, type, or mesh changes.
+
+        Example::
+
+            m.set_filler(density=5.0, kT=1.0)
+
+        """
+
+        type_id = hoomd.context.current.mpcd.particles.getTypeByName(type)
+        T = hoomd.variant._setup_variant_input(kT)
+
+        if self._filler is None:
+            self._filler = _mpcd.MeshGeometryFiller(
+                hoomd.context.current.mpcd.data,
+                density,
+                type_id,
+                T.cpp_variant,
+                self._cpp.geometry,
+            )
+        else:
+            self._filler.setDensity(density)
+            self._filler.setType(type_id)
+            self._filler.setTemperature(T.cpp_variant)
+        self._filler.setPersistent(persistent)
+
+    def remove_filler(self):
+        """Remove the virtual particle filler.
+
+        Example::
+
+            m.remove_filler()
+
+        """
+
+        self._filler = None
+
+    def set_params(self, vertices=None, triangles=None, boundary=None):
+        """Set parameters for the mesh geometry.
+
+        Args:
+            vertices ((*N*, 3) `numpy.ndarray` of float): Vertices of the mesh.
+            triangles ((*M*, 3) `numpy.ndarray` of int): Indexes of the three
+                vertices of each triangle.
+            boundary (str): boundary condition at wall ("slip" or "no_slip"")
+
+        Changing any of these parameters will require the geometry to be
+        constructed and validated, so do not change these too often.
+
+        Examples::
+
+            m.set_params(boundary="slip")
+
+        """
+
+        if vertices is not None:
+            self.vertices = vertices
+
+        if triangles is not None:
+            self.triangles = triangles
+
+        if boundary is not None:
+            self.boundary = boundary
+
+        bc = self._process_boundary(self.boundary)
+        self._cpp.geometry = _mpcd.MeshGeometry(self.vertices, self.triangles,
+                                                bc)
+        if self._filler is not None:
+            self._filler.setGeometry(self._cpp.geometry)
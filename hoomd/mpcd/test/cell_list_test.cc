@@ -6,6 +6,7 @@
 #include "hoomd/mpcd/CellListGPU.h"
 #endif // ENABLE_HIP
 
+#include "hoomd/RandomNumbers.h"
 #include "hoomd/SnapshotSystemData.h"
 #include "hoomd/filter/ParticleFilterAll.h"
 #include "hoomd/filter/ParticleFilterType.h"
@@ -651,6 +652,62 @@ template<class CL> void celllist_embed_test(std::shared_ptr<ExecutionConfigurati
         }
     }
 
+#ifdef ENABLE_TBB
+//! Test that the threaded cell list matches the serial one
+void celllist_threads_test()
+    {
+    // dense enough to overflow the default cell size and force a rebuild
+    const unsigned int N = 5000;
+    std::shared_ptr<SnapshotSystemData<Scalar>> snap(new SnapshotSystemData<Scalar>());
+    snap->global_box = std::make_shared<BoxDim>(10.0);
+    snap->particle_data.type_mapping.push_back("A");
+    snap->mpcd_data.resize(N);
+    snap->mpcd_data.type_mapping.push_back("A");
+    hoomd::RandomGenerator rng(hoomd::Seed(0, 1, 2), hoomd::Counter(3));
+    hoomd::UniformDistribution<Scalar> uniform(-5.0, 5.0);
+    for (unsigned int i = 0; i < N; ++i)
+        {
+        snap->mpcd_data.position[i] = vec3<Scalar>(uniform(rng), uniform(rng), uniform(rng));
+        }
+
+    auto make_cell_list = [&](unsigned int num_threads)
+    {
+        auto exec_conf = std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU);
+        exec_conf->setNumThreads(num_threads);
+        auto sysdef = std::make_shared<SystemDefinition>(snap, exec_conf);
+        auto cl = std::make_shared<mpcd::CellList>(sysdef);
+        cl->compute(0);
+        return cl;
+    };
+    auto serial = make_cell_list(1);
+    auto threaded = make_cell_list(4);
+
+    UP_ASSERT_EQUAL(threaded->getNCells(), serial->getNCells());
+    UP_ASSERT_EQUAL(threaded->getCellListIndexer().getW(), serial->getCellListIndexer().getW());
+    ArrayHandle<unsigned int> h_np_serial(serial->getCellSizeArray(),
+                                          access_location::host,
+                                          access_mode::read);
+    ArrayHandle<unsigned int> h_cl_serial(serial->getCellList(),
+                                          access_location::host,
+                                          access_mode::read);
+    ArrayHandle<unsigned int> h_np(threaded->getCellSizeArray(),
+                                   access_location::host,
+                                   access_mode::read);
+    ArrayHandle<unsigned int> h_cl(threaded->getCellList(),
+                                   access_location::host,
+                                   access_mode::read);
+    const Index2D& cli = serial->getCellListIndexer();
+    for (unsigned int cell = 0; cell < serial->getNCells(); ++cell)
+        {
+        UP_ASSERT_EQUAL(h_np.data[cell], h_np_serial.data[cell]);
+        for (unsigned int offset = 0; offset < h_np.data[cell]; ++offset)
+            {
+            UP_ASSERT_EQUAL(h_cl.data[cli(offset, cell)], h_cl_serial.data[cli(offset, cell)]);
+            }
+        }
+    }
+#endif // ENABLE_TBB
+
 //! dimension test case for MPCD CellList class
 UP_TEST(mpcd_cell_list_dimensions)
     {
@@ -679,6 +736,14 @@ UP_TEST(mpcd_cell_list_embed_test)
         new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+#ifdef ENABLE_TBB
+//! threaded build test case for MPCD CellList class
+UP_TEST(mpcd_cell_list_threads_test)
+    {
+    celllist_threads_test();
+    }
+#endif // ENABLE_TBB
+
 #ifdef ENABLE_HIP
 //! dimension test case for MPCD CellListGPU class
 UP_TEST(mpcd_cell_list_gpu_dimensions)
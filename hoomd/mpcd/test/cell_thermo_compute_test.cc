@@ -8,6 +8,7 @@
 #include "hoomd/mpcd/CellThermoComputeGPU.h"
 #endif // ENABLE_HIP
 
+#include "hoomd/RandomNumbers.h"
 #include "hoomd/SnapshotSystemData.h"
 #include "hoomd/filter/ParticleFilterAll.h"
 #include "hoomd/test/upp11_config.h"
@@ -325,6 +326,91 @@ template<class CT> void cell_thermo_embed_test(std::shared_ptr<ExecutionConfigur
         }
     }
 
+#ifdef ENABLE_TBB
+//! Test that the threaded cell properties match the serial ones with embedded particles
+void cell_thermo_threads_test()
+    {
+    const unsigned int N = 4000;
+    const unsigned int N_embed = 200;
+    std::shared_ptr<SnapshotSystemData<Scalar>> snap(new SnapshotSystemData<Scalar>());
+    snap->global_box = std::make_shared<BoxDim>(10.0);
+    hoomd::RandomGenerator rng(hoomd::Seed(0, 1, 2), hoomd::Counter(3));
+    hoomd::UniformDistribution<Scalar> uniform(-5.0, 5.0);
+    hoomd::UniformDistribution<Scalar> uniform_vel(-1.0, 1.0);
+        {
+        SnapshotParticleData<Scalar>& pdata_snap = snap->particle_data;
+        pdata_snap.type_mapping.push_back("A");
+        pdata_snap.resize(N_embed);
+        for (unsigned int i = 0; i < N_embed; ++i)
+            {
+            pdata_snap.pos[i] = vec3<Scalar>(uniform(rng), uniform(rng), uniform(rng));
+            pdata_snap.vel[i] = vec3<Scalar>(uniform_vel(rng), uniform_vel(rng), uniform_vel(rng));
+            pdata_snap.mass[i] = 5.0;
+            }
+        }
+    snap->mpcd_data.resize(N);
+    snap->mpcd_data.type_mapping.push_back("A");
+    for (unsigned int i = 0; i < N; ++i)
+        {
+        snap->mpcd_data.position[i] = vec3<Scalar>(uniform(rng), uniform(rng), uniform(rng));
+        snap->mpcd_data.velocity[i]
+            = vec3<Scalar>(uniform_vel(rng), uniform_vel(rng), uniform_vel(rng));
+        }
+
+    auto make_thermo = [&](unsigned int num_threads)
+    {
+        auto exec_conf = std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU);
+        exec_conf->setNumThreads(num_threads);
+        auto sysdef = std::make_shared<SystemDefinition>(snap, exec_conf);
+        std::shared_ptr<ParticleFilter> selector(new ParticleFilterAll());
+        auto group = std::make_shared<ParticleGroup>(sysdef, selector);
+        auto cl = std::make_shared<mpcd::CellList>(sysdef);
+        cl->setEmbeddedGroup(group);
+        auto thermo = std::make_shared<mpcd::CellThermoCompute>(sysdef, cl);
+        return thermo;
+    };
+    auto serial = make_thermo(1);
+    AllThermoRequest serial_req(serial);
+    serial->compute(0);
+    auto threaded = make_thermo(4);
+    AllThermoRequest threaded_req(threaded);
+    threaded->compute(0);
+
+        {
+        ArrayHandle<double4> h_vel_serial(serial->getCellVelocities(),
+                                          access_location::host,
+                                          access_mode::read);
+        ArrayHandle<double3> h_energy_serial(serial->getCellEnergies(),
+                                             access_location::host,
+                                             access_mode::read);
+        ArrayHandle<double4> h_vel(threaded->getCellVelocities(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<double3> h_energy(threaded->getCellEnergies(),
+                                      access_location::host,
+                                      access_mode::read);
+        for (unsigned int cell = 0; cell < serial->getCellVelocities().getNumElements(); ++cell)
+            {
+            CHECK_CLOSE(h_vel.data[cell].x, h_vel_serial.data[cell].x, tol_small);
+            CHECK_CLOSE(h_vel.data[cell].y, h_vel_serial.data[cell].y, tol_small);
+            CHECK_CLOSE(h_vel.data[cell].z, h_vel_serial.data[cell].z, tol_small);
+            CHECK_CLOSE(h_vel.data[cell].w, h_vel_serial.data[cell].w, tol_small);
+            CHECK_CLOSE(h_energy.data[cell].x, h_energy_serial.data[cell].x, tol_small);
+            CHECK_CLOSE(h_energy.data[cell].y, h_energy_serial.data[cell].y, tol_small);
+            UP_ASSERT_EQUAL(__double_as_int(h_energy.data[cell].z),
+                            __double_as_int(h_energy_serial.data[cell].z));
+            }
+        }
+
+    // the net properties are summed in a different order, so only check them to tolerance
+    CHECK_CLOSE(threaded->getNetMomentum().x, serial->getNetMomentum().x, tol);
+    CHECK_CLOSE(threaded->getNetMomentum().y, serial->getNetMomentum().y, tol);
+    CHECK_CLOSE(threaded->getNetMomentum().z, serial->getNetMomentum().z, tol);
+    CHECK_CLOSE(threaded->getNetEnergy(), serial->getNetEnergy(), tol);
+    CHECK_CLOSE(threaded->getTemperature(), serial->getTemperature(), tol);
+    }
+#endif // ENABLE_TBB
+
 UP_TEST(mpcd_cell_thermo_basic)
     {
     cell_thermo_basic_test<mpcd::CellThermoCompute>(std::shared_ptr<ExecutionConfiguration>(
@@ -335,6 +421,12 @@ UP_TEST(mpcd_cell_thermo_embed)
     cell_thermo_embed_test<mpcd::CellThermoCompute>(std::shared_ptr<ExecutionConfiguration>(
         new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+#ifdef ENABLE_TBB
+UP_TEST(mpcd_cell_thermo_threads)
+    {
+    cell_thermo_threads_test();
+    }
+#endif // ENABLE_TBB
 
 #ifdef ENABLE_HIP
 UP_TEST(mpcd_cell_thermo_basic_gpu)
@@ -897,6 +897,74 @@ void test_communicator_migrate_ortho(communicator_creator comm_creator,
         }
     }
 
+//! Test that particles migrated in advance are not migrated again by communicate
+void test_communicator_migrate_async(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // this test needs to be run on eight processors
+    int size;
+    MPI_Comm_size(exec_conf->getHOOMDWorldMPICommunicator(), &size);
+    UP_ASSERT_EQUAL(size, 8);
+
+    // place one particle in each domain of a 4x2x1 decomposition
+    std::shared_ptr<SnapshotSystemData<Scalar>> snap(new SnapshotSystemData<Scalar>());
+    snap->global_box = std::make_shared<BoxDim>(4.0, 2.0, 1.0);
+    snap->particle_data.type_mapping.push_back("A");
+    std::shared_ptr<DomainDecomposition> decomposition(
+        new DomainDecomposition(exec_conf, snap->global_box->getL(), 4, 2, 1));
+    snap->mpcd_data.resize(8);
+    snap->mpcd_data.type_mapping.push_back("A");
+    for (unsigned int i = 0; i < 8; ++i)
+        {
+        snap->mpcd_data.position[i] = vec3<Scalar>(Scalar(i % 4) - Scalar(1.5),
+                                                   Scalar(i / 4) - Scalar(0.5),
+                                                   0.0);
+        }
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf, decomposition));
+    auto cl = std::make_shared<mpcd::CellList>(sysdef);
+    cl->setCellSize(0.05);
+
+    std::shared_ptr<mpcd::Communicator> comm(new mpcd::Communicator(sysdef));
+    comm->setCellList(cl);
+    MigrateSelectOp migrate_op(comm);
+
+    std::shared_ptr<mpcd::ParticleData> pdata = sysdef->getMPCDParticleData();
+    const unsigned int rank = exec_conf->getRank();
+    UP_ASSERT_EQUAL(pdata->getN(), 1);
+    UP_ASSERT_EQUAL(pdata->getTag(0), rank);
+
+        // shift every particle one domain to the right
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        h_pos.data[0].x += Scalar(1.0);
+        }
+
+    // the particle leaves when the migration begins, and its neighbor arrives when it finishes
+    comm->beginCommunicate(2);
+    UP_ASSERT_EQUAL(pdata->getN(), 0);
+    comm->finishCommunicate();
+    UP_ASSERT_EQUAL(pdata->getN(), 1);
+    const unsigned int ref_tag = 4 * (rank / 4) + (rank + 3) % 4;
+    UP_ASSERT_EQUAL(pdata->getTag(0), ref_tag);
+
+        // shift again, which communicate should not catch because the migration was already done
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        h_pos.data[0].x += Scalar(1.0);
+        }
+    comm->communicate(2);
+    UP_ASSERT_EQUAL(pdata->getN(), 1);
+    UP_ASSERT_EQUAL(pdata->getTag(0), ref_tag);
+
+    // the next migration proceeds normally
+    comm->communicate(4);
+    UP_ASSERT_EQUAL(pdata->getN(), 1);
+    UP_ASSERT_EQUAL(pdata->getTag(0), 4 * (rank / 4) + (rank + 2) % 4);
+    }
+
 //! Test particle migration of Communicator
 void test_communicator_overdecompose(std::shared_ptr<ExecutionConfiguration> exec_conf,
                                      unsigned int nx,
@@ -978,6 +1046,15 @@ UP_TEST(mpcd_communicator_migrate_ortho_test)
     test_communicator_migrate_ortho(communicator_creator_base, exec_conf_cpu, 3);
     }
 
+UP_TEST(mpcd_communicator_migrate_async_test)
+    {
+    if (!exec_conf_cpu)
+        exec_conf_cpu = std::shared_ptr<ExecutionConfiguration>(
+            new ExecutionConfiguration(ExecutionConfiguration::CPU));
+
+    test_communicator_migrate_async(exec_conf_cpu);
+    }
+
 UP_TEST(mpcd_communicator_overdecompose_test)
     {
     if (!exec_conf_cpu)
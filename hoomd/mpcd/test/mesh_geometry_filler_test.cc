@@ -0,0 +1,153 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "hoomd/mpcd/MeshGeometryFiller.h"
+#include "hoomd/mpcd/SlitGeometry.h"
+
+#include "hoomd/SnapshotSystemData.h"
+#include "hoomd/test/upp11_config.h"
+
+HOOMD_UP_MAIN()
+
+using namespace hoomd;
+
+//! Make a slit channel of half width H from two square plates with half width L
+std::shared_ptr<const mpcd::detail::MeshGeometry>
+make_mesh_slit(Scalar H, Scalar L, mpcd::detail::boundary bc)
+    {
+    std::vector<Scalar3> vertices = {make_scalar3(-L, -L, H),
+                                     make_scalar3(L, -L, H),
+                                     make_scalar3(L, L, H),
+                                     make_scalar3(-L, L, H),
+                                     make_scalar3(-L, -L, -H),
+                                     make_scalar3(L, -L, -H),
+                                     make_scalar3(L, L, -H),
+                                     make_scalar3(-L, L, -H)};
+    // the upper plate faces down and the lower plate faces up into the channel
+    std::vector<uint3> triangles = {make_uint3(0, 2, 1),
+                                    make_uint3(0, 3, 2),
+                                    make_uint3(4, 5, 6),
+                                    make_uint3(4, 6, 7)};
+    return std::make_shared<const mpcd::detail::MeshGeometry>(vertices, triangles, bc);
+    }
+
+//! Test that the mesh geometry reproduces the slit geometry
+UP_TEST(mesh_geometry_slit)
+    {
+    for (auto bc : {mpcd::detail::boundary::no_slip, mpcd::detail::boundary::slip})
+        {
+        auto mesh = make_mesh_slit(5.0, 12.0, bc);
+        const mpcd::detail::SlitGeometry slit(5.0, 0.0, bc);
+        UP_ASSERT_EQUAL(mesh->getNumTriangles(), 4);
+
+        // particles crossing the upper and lower walls, and one staying inside
+        const Scalar3 pos[] = {make_scalar3(0.2, -0.4, 5.5),
+                               make_scalar3(-3.0, 7.0, -5.25),
+                               make_scalar3(1.0, 2.0, 3.0)};
+        const Scalar3 vel[] = {make_scalar3(1.0, 1.0, 1.0),
+                               make_scalar3(-0.5, 2.0, -1.0),
+                               make_scalar3(1.0, -1.0, 1.0)};
+        for (unsigned int i = 0; i < 3; ++i)
+            {
+            Scalar3 pos_mesh = pos[i], pos_slit = pos[i];
+            Scalar3 vel_mesh = vel[i], vel_slit = vel[i];
+            Scalar dt_mesh = 1.0, dt_slit = 1.0;
+            const bool collide_mesh = mesh->detectCollision(pos_mesh, vel_mesh, dt_mesh);
+            const bool collide_slit = slit.detectCollision(pos_slit, vel_slit, dt_slit);
+            UP_ASSERT_EQUAL(collide_mesh, collide_slit);
+            UP_ASSERT_EQUAL(mesh->isOutside(pos[i]), slit.isOutside(pos[i]));
+            CHECK_CLOSE(dt_mesh, dt_slit, tol_small);
+            if (collide_mesh)
+                {
+                CHECK_CLOSE(pos_mesh.x, pos_slit.x, tol_small);
+                CHECK_CLOSE(pos_mesh.y, pos_slit.y, tol_small);
+                CHECK_CLOSE(pos_mesh.z, pos_slit.z, tol_small);
+                CHECK_CLOSE(vel_mesh.x, vel_slit.x, tol_small);
+                CHECK_CLOSE(vel_mesh.y, vel_slit.y, tol_small);
+                CHECK_CLOSE(vel_mesh.z, vel_slit.z, tol_small);
+                }
+            }
+
+        // a particle that was just reflected from the wall does not collide again
+        Scalar3 pos_wall = make_scalar3(0.0, 0.0, 5.0);
+        Scalar3 vel_wall = make_scalar3(0.0, 0.0, -1.0);
+        Scalar dt_wall = 0.5;
+        pos_wall += dt_wall * vel_wall;
+        UP_ASSERT(!mesh->detectCollision(pos_wall, vel_wall, dt_wall));
+        UP_ASSERT(!mesh->isOutside(make_scalar3(0.0, 0.0, 5.0)));
+        }
+    }
+
+//! Test that virtual particles are only drawn in the cells cut by the mesh
+UP_TEST(mesh_fill_basic)
+    {
+    auto exec_conf = std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU);
+    std::shared_ptr<SnapshotSystemData<Scalar>> snap(new SnapshotSystemData<Scalar>());
+    snap->global_box = std::make_shared<BoxDim>(20.0);
+    snap->particle_data.type_mapping.push_back("A");
+    snap->mpcd_data.resize(1);
+    snap->mpcd_data.type_mapping.push_back("A");
+    snap->mpcd_data.position[0] = vec3<Scalar>(1, -2, 3);
+    snap->mpcd_data.velocity[0] = vec3<Scalar>(123, 456, 789);
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+
+    auto pdata = sysdef->getMPCDParticleData();
+    auto cl = std::make_shared<mpcd::CellList>(sysdef);
+    cl->setCellSize(2.0);
+
+    // slit walls at z = +/-5 cut through the middle of one layer of cells each
+    auto mesh = make_mesh_slit(5.0, 12.0, mpcd::detail::boundary::no_slip);
+    std::shared_ptr<Variant> kT = std::make_shared<VariantConstant>(1.5);
+    auto filler = std::make_shared<mpcd::MeshGeometryFiller>(sysdef, 2.0, 1, kT, mesh);
+    filler->setCellList(cl);
+
+    filler->fill(0);
+    UP_ASSERT_EQUAL(filler->getNumBoundaryCells(), 2 * 10 * 10);
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+
+        // ensure first particle did not get overwritten
+        CHECK_CLOSE(h_pos.data[0].x, 1, tol_small);
+        CHECK_CLOSE(h_vel.data[0].x, 123, tol_small);
+        UP_ASSERT_EQUAL(h_tag.data[0], 0);
+
+        // half of each boundary cell is in the solid, so 8 particles are expected per cell
+        const unsigned int N_virtual = pdata->getNVirtual();
+        UP_ASSERT(N_virtual > 1400 && N_virtual < 1800);
+        unsigned int N_lo(0), N_hi(0);
+        for (unsigned int i = pdata->getN(); i < pdata->getN() + N_virtual; ++i)
+            {
+            UP_ASSERT_EQUAL(h_tag.data[i], i);
+            UP_ASSERT_EQUAL(__scalar_as_int(h_pos.data[i].w), 1);
+
+            const Scalar z = h_pos.data[i].z;
+            if (z < Scalar(-5.0) && z >= Scalar(-6.0))
+                ++N_lo;
+            else if (z > Scalar(5.0) && z < Scalar(6.0))
+                ++N_hi;
+            }
+        UP_ASSERT_EQUAL(N_lo + N_hi, N_virtual);
+        UP_ASSERT(N_lo > 0 && N_hi > 0);
+        }
+
+    /*
+     * Shift the grid so that the walls lie closer to the cell edges, which still cut one layer.
+     */
+    pdata->removeVirtualParticles();
+    cl->setGridShift(make_scalar3(0.0, 0.0, -0.5));
+    filler->fill(1);
+    UP_ASSERT_EQUAL(filler->getNumBoundaryCells(), 2 * 10 * 10);
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        for (unsigned int i = pdata->getN(); i < pdata->getN() + pdata->getNVirtual(); ++i)
+            {
+            const Scalar z = h_pos.data[i].z;
+            UP_ASSERT((z < Scalar(-5.0) && z >= Scalar(-6.5))
+                      || (z > Scalar(5.0) && z < Scalar(5.5)));
+            }
+        }
+    }
@@ -185,11 +185,89 @@ template<class F> void slit_fill_basic_test(std::shared_ptr<ExecutionConfigurati
     CHECK_CLOSE(T_avg, 1.5, tol);
     }
 
+//! Test that persistent filling reuses the positions and draws new velocities
+void slit_fill_persistent_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr<SnapshotSystemData<Scalar>> snap(new SnapshotSystemData<Scalar>());
+    snap->global_box = std::make_shared<BoxDim>(20.0);
+    snap->particle_data.type_mapping.push_back("A");
+    snap->mpcd_data.resize(1);
+    snap->mpcd_data.type_mapping.push_back("A");
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+
+    auto pdata = sysdef->getMPCDParticleData();
+    auto cl = std::make_shared<mpcd::CellList>(sysdef);
+    cl->setCellSize(2.0);
+    auto slit = std::make_shared<const mpcd::detail::SlitGeometry>(5.0,
+                                                                   1.0,
+                                                                   mpcd::detail::boundary::no_slip);
+    std::shared_ptr<Variant> kT = std::make_shared<VariantConstant>(1.5);
+    auto filler = std::make_shared<mpcd::SlitGeometryFiller>(sysdef, 2.0, 1, kT, slit);
+    filler->setCellList(cl);
+    filler->setPersistent(true);
+
+    filler->fill(0);
+    const unsigned int N_virtual = pdata->getNVirtual();
+    std::vector<Scalar4> pos_0, vel_0;
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::read);
+        pos_0.assign(h_pos.data + 1, h_pos.data + 1 + N_virtual);
+        vel_0.assign(h_vel.data + 1, h_vel.data + 1 + N_virtual);
+        }
+
+    // the positions are reused with new velocities, which keep the wall velocity on each side
+    pdata->removeVirtualParticles();
+    filler->fill(1);
+    UP_ASSERT_EQUAL(pdata->getNVirtual(), N_virtual);
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+        unsigned int N_same_vel = 0;
+        Scalar v_lo(0), v_hi(0);
+        for (unsigned int i = 0; i < N_virtual; ++i)
+            {
+            const unsigned int pidx = 1 + i;
+            UP_ASSERT_EQUAL(h_pos.data[pidx].x, pos_0[i].x);
+            UP_ASSERT_EQUAL(h_pos.data[pidx].y, pos_0[i].y);
+            UP_ASSERT_EQUAL(h_pos.data[pidx].z, pos_0[i].z);
+            UP_ASSERT_EQUAL(__scalar_as_int(h_pos.data[pidx].w), 1);
+            UP_ASSERT_EQUAL(h_tag.data[pidx], pidx);
+            if (h_vel.data[pidx].x == vel_0[i].x)
+                ++N_same_vel;
+            if (h_pos.data[pidx].z < 0)
+                v_lo += h_vel.data[pidx].x;
+            else
+                v_hi += h_vel.data[pidx].x;
+            }
+        UP_ASSERT_EQUAL(N_same_vel, 0);
+        CHECK_CLOSE(v_lo / (N_virtual / 2), -1.0, 0.1);
+        CHECK_CLOSE(v_hi / (N_virtual / 2), 1.0, 0.1);
+        }
+
+    // changing the density draws the positions again
+    pdata->removeVirtualParticles();
+    filler->setDensity(1.0);
+    filler->fill(2);
+    UP_ASSERT_EQUAL(pdata->getNVirtual(), N_virtual / 2);
+    }
+
 UP_TEST(slit_fill_basic)
     {
     slit_fill_basic_test<mpcd::SlitGeometryFiller>(
         std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU));
     }
+
+UP_TEST(slit_fill_persistent)
+    {
+    slit_fill_persistent_test(
+        std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU));
+    }
 #ifdef ENABLE_HIP
 UP_TEST(slit_fill_basic_gpu)
     {
@@ -74,6 +74,11 @@ template<class T> void sorter_test(std::shared_ptr<ExecutionConfiguration> exec_
     std::shared_ptr<ParticleGroup> group(new ParticleGroup(sysdef, selector));
     cl->setEmbeddedGroup(group);
 
+    // the alternate arrays are not allocated until they are needed
+    UP_ASSERT(!sysdef->getMPCDParticleData()->hasAltPositions());
+    UP_ASSERT(!sysdef->getMPCDParticleData()->hasAltVelocities());
+    UP_ASSERT(!sysdef->getMPCDParticleData()->hasAltTags());
+
     // run the sorter
     std::shared_ptr<T> sorter = std::make_shared<T>(sysdef, 0, 1);
     sorter->setCellList(cl);
@@ -83,6 +88,11 @@ template<class T> void sorter_test(std::shared_ptr<ExecutionConfiguration> exec_
         {
         std::shared_ptr<mpcd::ParticleData> pdata = sysdef->getMPCDParticleData();
 
+        // the sorter allocates the alternate arrays on first use
+        UP_ASSERT(pdata->hasAltPositions());
+        UP_ASSERT(pdata->hasAltVelocities());
+        UP_ASSERT(pdata->hasAltTags());
+
         // tag order should be reversed
         ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
         UP_ASSERT_EQUAL(h_tag.data[0], 7);
@@ -1,7 +1,9 @@
 // Copyright (c) 2009-2024 The Regents of the University of Michigan.
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+#include "hoomd/mpcd/ConfinedStreamingMethod.h"
 #include "hoomd/mpcd/SRDCollisionMethod.h"
+#include "hoomd/mpcd/StreamingGeometry.h"
 #include "utils.h"
 #ifdef ENABLE_HIP
 #include "hoomd/mpcd/SRDCollisionMethodGPU.h"
@@ -380,6 +382,83 @@ void srd_collision_method_thermostat_test(std::shared_ptr<ExecutionConfiguration
         }
     }
 
+//! Test that computing the cell properties while streaming gives the same collisions
+void srd_collision_method_sweep_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    auto box = std::make_shared<BoxDim>(10.0);
+    auto geom = std::make_shared<const mpcd::detail::BulkGeometry>();
+
+    // two identical systems, the first one computes the cell properties during streaming
+    std::shared_ptr<mpcd::ParticleData> pdatas[2];
+    std::shared_ptr<mpcd::CellList> cls[2];
+    std::shared_ptr<mpcd::StreamingMethod> streams[2];
+    std::shared_ptr<mpcd::SRDCollisionMethod> collides[2];
+    std::unique_ptr<AllThermoRequest> thermo_reqs[2];
+    for (unsigned int i = 0; i < 2; ++i)
+        {
+        auto sysdef = std::make_shared<hoomd::SystemDefinition>(0, box, 1, 0, 0, 0, 0, exec_conf);
+        pdatas[i] = std::make_shared<mpcd::ParticleData>(10000, box, 1.0, 42, 3, exec_conf);
+        sysdef->setMPCDParticleData(pdatas[i]);
+
+        cls[i] = std::make_shared<mpcd::CellList>(sysdef);
+        streams[i] = std::make_shared<mpcd::ConfinedStreamingMethod<mpcd::detail::BulkGeometry>>(
+            sysdef,
+            0,
+            1,
+            -1,
+            geom);
+        streams[i]->setCellList(cls[i]);
+        streams[i]->setDeltaT(0.1);
+        collides[i] = std::make_shared<mpcd::SRDCollisionMethod>(sysdef, 0, 1, -1, 827);
+        collides[i]->setCellList(cls[i]);
+        collides[i]->setRotationAngle(130. * M_PI / 180.);
+        collides[i]->setTemperature(std::make_shared<VariantConstant>(1.5));
+        thermo_reqs[i].reset(new AllThermoRequest(collides[i]->getCellThermo()));
+        }
+
+    for (uint64_t timestep = 0; timestep < 10; ++timestep)
+        {
+        collides[0]->drawGridShift(timestep + 1);
+        streams[0]->setSweep(collides[0]->getCellThermo(), timestep + 1);
+        const uint64_t num_builds = cls[0]->getNumBuilds();
+        streams[0]->stream(timestep);
+        UP_ASSERT_EQUAL(cls[0]->getNumBuilds(), num_builds + 1);
+        collides[0]->collide(timestep + 1);
+        // the cell list should not have been rebuilt for the collision
+        UP_ASSERT_EQUAL(cls[0]->getNumBuilds(), num_builds + 1);
+
+        streams[1]->stream(timestep);
+        collides[1]->collide(timestep + 1);
+
+        CHECK_CLOSE(collides[0]->getCellThermo()->getTemperature(),
+                    collides[1]->getCellThermo()->getTemperature(),
+                    tol_small);
+        }
+
+    ArrayHandle<Scalar4> h_pos_0(pdatas[0]->getPositions(),
+                                 access_location::host,
+                                 access_mode::read);
+    ArrayHandle<Scalar4> h_vel_0(pdatas[0]->getVelocities(),
+                                 access_location::host,
+                                 access_mode::read);
+    ArrayHandle<Scalar4> h_pos_1(pdatas[1]->getPositions(),
+                                 access_location::host,
+                                 access_mode::read);
+    ArrayHandle<Scalar4> h_vel_1(pdatas[1]->getVelocities(),
+                                 access_location::host,
+                                 access_mode::read);
+    for (unsigned int i = 0; i < pdatas[0]->getN(); ++i)
+        {
+        CHECK_CLOSE(h_pos_0.data[i].x, h_pos_1.data[i].x, tol_small);
+        CHECK_CLOSE(h_pos_0.data[i].y, h_pos_1.data[i].y, tol_small);
+        CHECK_CLOSE(h_pos_0.data[i].z, h_pos_1.data[i].z, tol_small);
+        CHECK_CLOSE(h_vel_0.data[i].x, h_vel_1.data[i].x, tol_small);
+        CHECK_CLOSE(h_vel_0.data[i].y, h_vel_1.data[i].y, tol_small);
+        CHECK_CLOSE(h_vel_0.data[i].z, h_vel_1.data[i].z, tol_small);
+        UP_ASSERT_EQUAL(__scalar_as_int(h_vel_0.data[i].w), __scalar_as_int(h_vel_1.data[i].w));
+        }
+    }
+
 //! basic test case for MPCD SRDCollisionMethod class
 UP_TEST(srd_collision_method_basic)
     {
@@ -403,6 +482,12 @@ UP_TEST(srd_collision_method_thermostat)
     srd_collision_method_thermostat_test<mpcd::SRDCollisionMethod>(
         std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU));
     }
+//! test computing the cell properties during streaming
+UP_TEST(srd_collision_method_sweep)
+    {
+    srd_collision_method_sweep_test(
+        std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU));
+    }
 #ifdef ENABLE_HIP
 //! basic test case for MPCD SRDCollisionMethodGPU class
 UP_TEST(srd_collision_method_basic_gpu)
@@ -85,11 +85,40 @@ UP_TEST(virtual_add_remove_test)
     UP_ASSERT_EQUAL(pdata->getNVirtualGlobal(), 2);
 
     UP_ASSERT(pdata->getPositions().getNumElements() >= 3);
-    UP_ASSERT(pdata->getAltPositions().getNumElements() >= 3);
     UP_ASSERT(pdata->getVelocities().getNumElements() >= 3);
-    UP_ASSERT(pdata->getAltVelocities().getNumElements() >= 3);
     UP_ASSERT(pdata->getTags().getNumElements() >= 3);
-    UP_ASSERT(pdata->getAltTags().getNumElements() >= 3);
+
+    // the alternate arrays are not allocated until they are requested
+    UP_ASSERT(!pdata->hasAltPositions());
+    UP_ASSERT(!pdata->hasAltVelocities());
+    UP_ASSERT(!pdata->hasAltTags());
+
+    // requested alternate arrays match the size of the primary arrays
+    UP_ASSERT_EQUAL(pdata->getAltPositions().getNumElements(),
+                    pdata->getPositions().getNumElements());
+    UP_ASSERT_EQUAL(pdata->getAltVelocities().getNumElements(),
+                    pdata->getVelocities().getNumElements());
+    UP_ASSERT(pdata->hasAltPositions());
+    UP_ASSERT(pdata->hasAltVelocities());
+    UP_ASSERT(!pdata->hasAltTags());
+
+    // allocated alternate arrays are resized with the primary arrays, the others stay unallocated
+    pdata->addVirtualParticles(100);
+    UP_ASSERT_EQUAL(pdata->getNVirtual(), 102);
+    UP_ASSERT(pdata->getPositions().getNumElements() >= 103);
+    UP_ASSERT(pdata->hasAltPositions());
+    UP_ASSERT(pdata->hasAltVelocities());
+    UP_ASSERT(!pdata->hasAltTags());
+    UP_ASSERT_EQUAL(pdata->getAltPositions().getNumElements(),
+                    pdata->getPositions().getNumElements());
+    UP_ASSERT_EQUAL(pdata->getAltVelocities().getNumElements(),
+                    pdata->getVelocities().getNumElements());
+
+    // swapping keeps both arrays at the same size
+    pdata->swapVelocities();
+    UP_ASSERT_EQUAL(pdata->getAltVelocities().getNumElements(),
+                    pdata->getVelocities().getNumElements());
+    pdata->swapVelocities();
 
     // ensure virtual particles are popped off
     pdata->removeVirtualParticles();
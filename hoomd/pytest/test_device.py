@@ -162,3 +162,22 @@ def test_noticefile(device, tmp_path):
     if device.communicator.rank == 0:
         with open(device.message_filename) as fh:
             assert fh.read() == ""
+
+
+def test_memory_traceback(device, simulation_factory,
+                          lattice_snapshot_factory):
+    assert not device.memory_traceback
+    assert device.memory_usage == {}
+
+    device.memory_traceback = True
+    assert device.memory_traceback
+    sim = simulation_factory(lattice_snapshot_factory(n=10))
+
+    usage = device.memory_usage
+    N = sim.state._cpp_sys_def.getParticleData().getMaxN()
+    assert usage['m_pos'] >= N * 4 * 4
+    assert all(nbytes > 0 for nbytes in usage.values())
+
+    device.memory_traceback = False
+    assert not device.memory_traceback
+    assert device.memory_usage == {}
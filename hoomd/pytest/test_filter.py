@@ -210,6 +210,38 @@ def test_difference(make_filter_snapshot, simulation_factory, set_indices):
         assert difference_filter(sim.state) == combo_filter(sim.state)
 
 
+@pytest.mark.serial
+def test_group_matches_filter(make_filter_snapshot, simulation_factory,
+                              set_indices):
+    particle_types = ['A', 'B', 'C']
+    N = 10
+    filter_snapshot = make_filter_snapshot(n=N, particle_types=particle_types)
+    sim = simulation_factory(filter_snapshot)
+    A_indices, B_indices, C_indices = set_indices
+    s = sim.state.get_snapshot()
+    if s.communicator.rank == 0:
+        set_types(s, A_indices, particle_types, "A")
+        set_types(s, B_indices, particle_types, "B")
+        set_types(s, C_indices, particle_types, "C")
+    sim.state.set_snapshot(s)
+
+    # groups evaluate most filters per particle instead of by tags, which must
+    # select the same particles
+    filters = [
+        All(),
+        Null(),
+        Type(['A', 'C']),
+        Rigid(('center', 'free')),
+        Union(Type(['A']), Type(['B'])),
+        Intersection(Type(['A', 'B']), Type(['B', 'C'])),
+        SetDifference(All(), Type(['B'])),
+        Union(Type(['C']), Tags([0, 1, 2])),
+    ]
+    for filter_ in filters:
+        group_tags = sim.state._get_group(filter_).member_tags
+        assert list(group_tags) == sorted(filter_(sim.state))
+
+
 _filter_classes = [
     All,
     Tags,
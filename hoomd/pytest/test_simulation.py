@@ -116,6 +116,62 @@ def test_allows_compute_pressure(simulation_factory, lattice_snapshot_factory):
     assert sim.always_compute_pressure is True
 
 
+def test_shrink_to_fit_ratio(simulation_factory, lattice_snapshot_factory):
+    sim = simulation_factory()
+    assert sim.shrink_to_fit_ratio is None
+    with pytest.raises(ValueError):
+        sim.shrink_to_fit_ratio = 0.5
+
+    sim.shrink_to_fit_ratio = 2
+    assert sim.shrink_to_fit_ratio == 2.0
+
+    snapshot = lattice_snapshot_factory(n=10)
+    sim.create_state_from_snapshot(snapshot)
+    pdata = sim.state._cpp_sys_def.getParticleData()
+    sim.run(0)
+    max_n = pdata.getMaxN()
+
+    # removing particles does not release memory until the next run
+    if snapshot.communicator.rank == 0:
+        snapshot.particles.N = 10
+    sim.state.set_snapshot(snapshot)
+    assert pdata.getMaxN() == max_n
+    sim.run(0)
+    assert pdata.getMaxN() < max_n
+
+    sim.shrink_to_fit_ratio = None
+    assert sim.shrink_to_fit_ratio is None
+
+
+def test_shrink_to_fit_forces(simulation_factory, lattice_snapshot_factory):
+    snapshot = lattice_snapshot_factory(n=10, r=0.1)
+    sim = simulation_factory(snapshot)
+    pdata = sim.state._cpp_sys_def.getParticleData()
+
+    nlist = hoomd.md.nlist.Cell(buffer=0.4)
+    lj = hoomd.md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005, forces=[lj])
+
+    if snapshot.communicator.rank == 0:
+        snapshot.particles.N = 10
+    sim.state.set_snapshot(snapshot)
+    sim.run(0)
+    max_n = pdata.getMaxN()
+
+    # shrinking the arrays at a step where the forces were already computed
+    # must not leave them zeroed
+    sim.shrink_to_fit_ratio = 2
+    sim.run(0)
+    assert pdata.getMaxN() < max_n
+
+    forces = lj.forces
+    energy = lj.energy
+    if snapshot.communicator.rank == 0:
+        assert np.count_nonzero(forces) > 0
+        assert energy != 0
+
+
 def test_run(simulation_factory, lattice_snapshot_factory):
     sim = simulation_factory()
     with pytest.raises(RuntimeError):
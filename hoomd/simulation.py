@@ -62,6 +62,7 @@ class Simulation(metaclass=Loggable):
         self._operations._simulation = self
         self._timestep = None
         self._seed = None
+        self._shrink_to_fit_ratio = None
         if seed is not None:
             self.seed = seed
 
@@ -154,6 +155,9 @@ class Simulation(metaclass=Loggable):
         if self._seed is not None:
             self._state._cpp_sys_def.setSeed(self._seed)
 
+        if self._shrink_to_fit_ratio is not None:
+            self._cpp_sys.setShrinkToFitRatio(self._shrink_to_fit_ratio)
+
         self._init_communicator()
 
     def _init_communicator(self):
@@ -482,6 +486,42 @@ class Simulation(metaclass=Loggable):
             if value:
                 self._state._cpp_sys_def.getParticleData().setPressureFlag()
 
+    @property
+    def shrink_to_fit_ratio(self):
+        """float: Release memory when the allocated memory exceeds this \
+        ratio of the required memory (defaults to `None`).
+
+        HOOMD grows the particle data, neighbor list, and MPI communication
+        buffers as needed but does not shrink them, so they keep the memory
+        needed by the largest configuration seen (such as the densest state
+        during a compression). When `shrink_to_fit_ratio` is set, `run` shrinks
+        each of these buffers that holds more than `shrink_to_fit_ratio` times
+        the memory it currently needs before the first step. Set to `None` to
+        never shrink.
+
+        Note:
+            Shrinking and regrowing buffers takes time. Choose a ratio well
+            above 1 to leave room for fluctuations.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            simulation.shrink_to_fit_ratio = 2.0
+        """
+        return self._shrink_to_fit_ratio
+
+    @shrink_to_fit_ratio.setter
+    def shrink_to_fit_ratio(self, value):
+        if value is not None:
+            value = float(value)
+            if value < 1:
+                raise ValueError("shrink_to_fit_ratio must be at least 1.")
+
+        self._shrink_to_fit_ratio = value
+        if hasattr(self, '_cpp_sys'):
+            self._cpp_sys.setShrinkToFitRatio(0 if value is None else value)
+
     def run(self, steps, write_at_start=False):
         """Advance the simulation a number of steps.
 
@@ -356,3 +356,68 @@ UP_TEST(GPUVector_basic_tests)
     UP_ASSERT_EQUAL((unsigned int)vec[9], (unsigned int)890);
     }
 #endif
+
+//! Tests memory tracing and shrinking of GlobalArray and GlobalVector
+UP_TEST(GlobalArray_memory_traceback_tests)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    UP_ASSERT(!exec_conf->memoryTracingEnabled());
+    UP_ASSERT(exec_conf->getMemoryTraceback() == nullptr);
+
+    exec_conf->setMemoryTracing(true);
+    UP_ASSERT(exec_conf->memoryTracingEnabled());
+    MemoryTraceback* traceback = exec_conf->getMemoryTraceback();
+    UP_ASSERT(traceback != nullptr);
+    UP_ASSERT_EQUAL(traceback->getTotalBytes(), (size_t)0);
+
+        {
+        // tagged allocations are reported by tag, and follow resizes
+        GlobalArray<unsigned int> a(100, exec_conf);
+        TAG_ALLOCATION(a);
+        UP_ASSERT_EQUAL(exec_conf->getMemoryUsage()["a"], 100 * sizeof(unsigned int));
+
+        a.resize(1000);
+        UP_ASSERT_EQUAL(exec_conf->getMemoryUsage()["a"], 1000 * sizeof(unsigned int));
+
+        a.resize(10);
+        UP_ASSERT_EQUAL(exec_conf->getMemoryUsage()["a"], 10 * sizeof(unsigned int));
+
+        // copies keep the tag
+        GlobalArray<unsigned int> b(a);
+        UP_ASSERT_EQUAL(exec_conf->getMemoryUsage()["a"], 20 * sizeof(unsigned int));
+        }
+    UP_ASSERT_EQUAL(exec_conf->getMemoryUsage().count("a"), (size_t)0);
+    UP_ASSERT_EQUAL(traceback->getTotalBytes(), (size_t)0);
+
+    // the memory of a vector grows with its size, and is released with shrink_to_fit()
+    GlobalVector<unsigned int> vec(exec_conf);
+    for (unsigned int i = 0; i < 1000; ++i)
+        vec.push_back(i);
+    UP_ASSERT(vec.getNumElements() >= 1000);
+
+    vec.resize(10);
+    UP_ASSERT(vec.getNumElements() >= 1000);
+    UP_ASSERT_EQUAL(traceback->getTotalBytes(), vec.getNumElements() * sizeof(unsigned int));
+
+    vec.shrink_to_fit();
+    UP_ASSERT_EQUAL(vec.size(), (size_t)10);
+    UP_ASSERT_EQUAL(vec.getNumElements(), (size_t)10);
+    UP_ASSERT_EQUAL(traceback->getTotalBytes(), 10 * sizeof(unsigned int));
+    for (unsigned int i = 0; i < 10; ++i)
+        UP_ASSERT_EQUAL((unsigned int)vec[i], i);
+
+    // untagged allocations are reported by element type
+    std::map<std::string, size_t> usage = exec_conf->getMemoryUsage();
+    UP_ASSERT_EQUAL(usage.size(), (size_t)1);
+    UP_ASSERT_EQUAL(usage.begin()->first, std::string("anonymous [unsigned int]"));
+
+    // an empty vector keeps one element
+    vec.clear();
+    vec.shrink_to_fit();
+    UP_ASSERT_EQUAL(vec.getNumElements(), (size_t)1);
+
+    exec_conf->setMemoryTracing(false);
+    UP_ASSERT(exec_conf->getMemoryTraceback() == nullptr);
+    UP_ASSERT(exec_conf->getMemoryUsage().empty());
+    }
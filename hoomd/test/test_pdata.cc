@@ -13,7 +13,9 @@
 
 #include "hoomd/Initializers.h"
 #include "hoomd/ParticleData.h"
+#include "hoomd/SFCPackTuner.h"
 #include "hoomd/SnapshotSystemData.h"
+#include "hoomd/SystemDefinition.h"
 
 #include "upp11_config.h"
 
@@ -615,6 +617,78 @@ UP_TEST(ParticleData_test)
         }
     }
 
+//! Check that the structure-of-arrays positions match the positions of all particles
+void check_position_components(std::shared_ptr<ParticleData> pdata)
+    {
+    UP_ASSERT(pdata->getPositionComponentsEnabled());
+
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_pos_x(pdata->getPositionsX(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_pos_y(pdata->getPositionsY(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_pos_z(pdata->getPositionsZ(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_type_idx(pdata->getTypeIndices(),
+                                         access_location::host,
+                                         access_mode::read);
+
+    for (unsigned int i = 0; i < pdata->getN() + pdata->getNGhosts(); ++i)
+        {
+        UP_ASSERT_EQUAL(h_pos_x.data[i], h_pos.data[i].x);
+        UP_ASSERT_EQUAL(h_pos_y.data[i], h_pos.data[i].y);
+        UP_ASSERT_EQUAL(h_pos_z.data[i], h_pos.data[i].z);
+        UP_ASSERT_EQUAL(h_type_idx.data[i], (unsigned int)__scalar_as_int(h_pos.data[i].w));
+        }
+    }
+
+//! Tests that the structure-of-arrays positions follow the particles
+UP_TEST(ParticleData_position_components_test)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    std::shared_ptr<SystemDefinition> sysdef(
+        new SystemDefinition(100, BoxDim(10.0), 2, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    // scatter the particles through the box so that sorting reorders them
+    for (unsigned int tag = 0; tag < 100; ++tag)
+        {
+        pdata->setPosition(tag,
+                           make_scalar3(Scalar(4.5) - Scalar(0.09) * tag,
+                                        Scalar(0.09) * ((tag * 37) % 100) - Scalar(4.5),
+                                        Scalar(0.09) * ((tag * 61) % 100) - Scalar(4.5)),
+                           false);
+        pdata->setType(tag, tag % 2);
+        }
+
+    // the components are disabled by default
+    UP_ASSERT(!pdata->getPositionComponentsEnabled());
+    pdata->setPositionComponentsEnabled(true);
+    check_position_components(pdata);
+
+    // single particle changes
+    pdata->setPosition(3, make_scalar3(1.0, 2.0, 3.0), false);
+    pdata->setType(5, 0);
+    check_position_components(pdata);
+
+    // sort the particles
+    SFCPackTuner sorter(sysdef, std::make_shared<PeriodicTrigger>(1));
+    sorter.update(0);
+    check_position_components(pdata);
+
+    // add and remove particles, growing the arrays
+    pdata->removeParticle(10);
+    check_position_components(pdata);
+    for (unsigned int i = 0; i < 200; ++i)
+        {
+        unsigned int tag = pdata->addParticle(1);
+        pdata->setPosition(tag, make_scalar3(0.01 * i, -0.02 * i, 0.03 * i), false);
+        }
+    UP_ASSERT(pdata->getMaxN() >= 299);
+    check_position_components(pdata);
+
+    pdata->setPositionComponentsEnabled(false);
+    UP_ASSERT(!pdata->getPositionComponentsEnabled());
+    }
+
 //! Tests the RandomParticleInitializer class
 UP_TEST(Random_test)
     {
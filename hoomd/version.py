@@ -25,6 +25,9 @@ Attributes:
     cxx_compiler (str): Name and version of the C++ compiler used to build
         HOOMD.
 
+    fftw_enabled (bool): ``True`` when this build uses FFTW for CPU fast
+        Fourier transforms.
+
     floating_point_precision (tuple[int, int]): The **high precision** floating
         point width in bits  (element 0) and the **reduced precision** width in
         bits (element 1).
@@ -68,6 +71,7 @@ from hoomd.version_config import (
     compile_date,
     cuda_include_path,
     cuda_devrt_library,
+    fftw_enabled,
     git_branch,
     git_sha1,
     hpmc_built,